@@ -61,6 +61,8 @@ if(LINA_CLIENT_ENABLE_LOGGING)
 	target_compile_definitions(${PROJECT_NAME} PUBLIC LINA_CLIENT_ENABLE_LOGGING=1)
 endif()
 
+target_compile_definitions(${PROJECT_NAME} PUBLIC LINA_LOG_COMPILE_LEVEL=${LINA_LOG_COMPILE_LEVEL})
+
 if(LINA_ENABLE_EDITOR)
 	target_compile_definitions(${PROJECT_NAME} PUBLIC LINA_EDITOR=1)
 endif()
@@ -69,6 +71,15 @@ if(LINA_ENABLE_TIMEPROFILING)
 	target_compile_definitions(${PROJECT_NAME} PUBLIC LINA_ENABLE_TIMEPROFILING=1)
 endif()
 
+# Counting replaces the global operator new, so profiling builds enable it for every target at once.
+if(LINA_ENABLE_ALLOCATIONCOUNTING OR LINA_PROFILING_BUILD)
+	target_compile_definitions(${PROJECT_NAME} PUBLIC LINA_ENABLE_ALLOCATIONCOUNTING=1)
+endif()
+
+if(LINA_ENABLE_MEMORYTRACKING)
+	target_compile_definitions(${PROJECT_NAME} PUBLIC LINA_ENABLE_MEMORYTRACKING=1)
+endif()
+
 #--------------------------------------------------------------------
 # Build Type Config
 #--------------------------------------------------------------------
@@ -29,9 +29,8 @@ SOFTWARE.
 /*
 class: Action
 
-Defines action handler base and derived classes which are responsible for holding an action type,
-setting up conditions if desired, checking conditions and executing the function objects assigned
-to them.
+Defines the action types, each one is a slot on an EventBus. Event structs name their slot
+with a static s_actionType.
 
 Timestamp: 1/6/2019 5:41:20 AM
 */
@@ -41,9 +40,6 @@ Timestamp: 1/6/2019 5:41:20 AM
 #ifndef Action_HPP
 #define Action_HPP
 
-#include "Core/Common.hpp"
-#include <functional>
-
 namespace LinaEngine::Action
 {
 	enum ActionType
@@ -64,8 +60,9 @@ namespace LinaEngine::Action
 		LevelUninstalled,
 		WindowClosed,
 		WindowResized,
+		TextureLoaded,
 		EngineActionsStartIndex = MessageLogged,
-		EngineActionsEndIndex = WindowResized,
+		EngineActionsEndIndex = TextureLoaded,
 
 		// Editor actions
 		TextureSelected,
@@ -77,68 +74,11 @@ namespace LinaEngine::Action
 		Unselect,
 		MenuItemClicked,
 		EditorActionsStartIndex = TextureSelected,
-		EditorActionsEndIndex = MenuItemClicked
-	};
-
-	class ActionHandlerBase
-	{
-
-	public:
-
-		virtual ~ActionHandlerBase() {};
-		ActionType GetActionType() const { return m_actionType; }
-		bool GetUseCondition() const { return m_useCondition; }
-		size_t GetHashedID() const { return m_hashedID; }
-
-	protected:
-
-		ActionHandlerBase(ActionType at, size_t id) : m_actionType(at), m_hashedID(id) {};
-
-	protected:
-
-		size_t m_hashedID = 0;
-		bool m_useCondition = false;
-		ActionType m_actionType;
+		EditorActionsEndIndex = MenuItemClicked,
 
+		ActionTypeCount
 	};
-
-	template<typename T>
-	class ActionHandler : public ActionHandlerBase
-	{
-
-	public:
-	
-		virtual ~ActionHandler() {};
-
-		void SetCondition(const T& cond)
-		{ 
-			m_condition = cond;
-			m_useCondition = true; 
-		}
-
-		void SetCallback(const std::function<void(T)>& cb) { m_callback = cb; }
-
-		// Checks condition if one is used and invokes the callback.
-		void ControlExecute(const T& data) 
-		{ 
-			if (!m_useCondition || ( m_useCondition && m_condition == data))
-				m_callback(data);
-		}
-
-	private:
-
-		friend class ActionDispatcher;
-		ActionHandler(ActionType at, size_t id) : ActionHandlerBase(at, id) {};
-
-	private:
-
-		std::function<void(T)> m_callback;
-		T m_condition;
-	};
-
-
-	
 }
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,93 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: Delegate
+
+Type erased callable with inline storage, a replacement for std::function on hot paths. Callables
+must be trivially copyable & fit into DELEGATE_STORAGE_SIZE, so lambdas capturing this or a few
+values & free functions are fine, anything that would need the heap is a compile error.
+
+Timestamp: 11/5/2020 3:04:51 PM
+*/
+
+#pragma once
+
+#ifndef Delegate_HPP
+#define Delegate_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace LinaEngine::Action
+{
+#define DELEGATE_STORAGE_SIZE 32
+
+	template<typename Signature>
+	class Delegate;
+
+	template<typename R, typename... Args>
+	class Delegate<R(Args...)>
+	{
+	public:
+
+		Delegate() {};
+
+		template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate>>>
+		Delegate(F&& callable)
+		{
+			using Callable = std::decay_t<F>;
+			static_assert(sizeof(Callable) <= DELEGATE_STORAGE_SIZE, "Callable doesn't fit into the delegate storage, capture less.");
+			static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over aligned.");
+			static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>, "Delegates only hold trivially copyable callables, capture pointers instead of owning types.");
+
+			new (m_storage) Callable(std::forward<F>(callable));
+			m_invoke = [](void* storage, Args... args) -> R { return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...); };
+		}
+
+		// Binds a member function, same as connect<&Class::Method>(instance) on entt signals.
+		template<auto Method, typename Class>
+		static Delegate Bind(Class* instance)
+		{
+			return Delegate([instance](Args... args) -> R { return (instance->*Method)(std::forward<Args>(args)...); });
+		}
+
+		R operator()(Args... args) const { return m_invoke(const_cast<unsigned char*>(m_storage), std::forward<Args>(args)...); }
+		explicit operator bool() const { return m_invoke != nullptr; }
+		void Reset() { m_invoke = nullptr; }
+
+	private:
+
+		alignas(std::max_align_t) unsigned char m_storage[DELEGATE_STORAGE_SIZE];
+		R(*m_invoke)(void*, Args...) = nullptr;
+	};
+}
+
+#endif
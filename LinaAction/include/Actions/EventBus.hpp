@@ -0,0 +1,142 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: EventBus
+
+Typed event dispatch, replaces ActionDispatcher. Events are plain structs naming their slot with
+a static s_actionType, handlers of a type live contiguously & are called with a const reference to
+the event. Subscribing returns a token, unsubscribing through it is O(1) & safe during a dispatch.
+
+Timestamp: 11/5/2020 3:21:09 PM
+*/
+
+#pragma once
+
+#ifndef EventBus_HPP
+#define EventBus_HPP
+
+#include "Action.hpp"
+#include "Delegate.hpp"
+#include "Core/SizeDefinitions.hpp"
+#include <array>
+#include <vector>
+
+namespace LinaEngine::Action
+{
+#define EVENT_INVALID_SLOT 0xFFFFFFFF
+
+	struct EventToken
+	{
+		uint32 m_actionType = 0;
+		uint32 m_slot = EVENT_INVALID_SLOT;
+		uint32 m_generation = 0;
+
+		bool IsValid() const { return m_slot != EVENT_INVALID_SLOT; }
+	};
+
+	class EventBus
+	{
+
+	public:
+
+		EventBus() {};
+		~EventBus() {};
+
+		// Callable is invoked with const T&, see Delegate for what it may capture.
+		template<typename T, typename F>
+		EventToken Subscribe(F&& callback)
+		{
+			return AddHandler(T::s_actionType, EventDelegate([callback](const void* event) { callback(*static_cast<const T*>(event)); }));
+		}
+
+		// Binds a member function taking const T&.
+		template<typename T, auto Method, typename Class>
+		EventToken Subscribe(Class* instance)
+		{
+			return AddHandler(T::s_actionType, EventDelegate([instance](const void* event) { (instance->*Method)(*static_cast<const T*>(event)); }));
+		}
+
+		// Resets the token, invalid or already removed tokens are ignored.
+		void Unsubscribe(EventToken& token);
+
+		template<typename T>
+		void Dispatch(const T& event)
+		{
+			HandlerList& list = m_handlerLists[T::s_actionType];
+			if (list.m_handlers.empty())
+				return;
+
+			// Indexed & copied since handlers may subscribe, growing the array under us.
+			list.m_dispatchDepth++;
+			for (size_t i = 0; i < list.m_handlers.size(); i++)
+			{
+				const EventDelegate handler = list.m_handlers[i].m_delegate;
+				if (handler)
+					handler(&event);
+			}
+			list.m_dispatchDepth--;
+
+			if (list.m_dispatchDepth == 0 && list.m_removedCount != 0)
+				Compact(list);
+		}
+
+		uint32 GetHandlerCount(ActionType actionType) const { return (uint32)m_handlerLists[actionType].m_handlers.size() - m_handlerLists[actionType].m_removedCount; }
+
+	private:
+
+		typedef Delegate<void(const void*)> EventDelegate;
+
+		struct EventHandler
+		{
+			EventDelegate m_delegate;
+			uint32 m_slot = 0;
+		};
+
+		struct HandlerList
+		{
+			// Dense handlers, tokens point to slots which map to an index here.
+			std::vector<EventHandler> m_handlers;
+			std::vector<uint32> m_slotIndices;
+			std::vector<uint32> m_slotGenerations;
+			std::vector<uint32> m_freeSlots;
+			uint32 m_dispatchDepth = 0;
+			uint32 m_removedCount = 0;
+		};
+
+		EventToken AddHandler(ActionType actionType, const EventDelegate& handler);
+		void RemoveAt(HandlerList& list, uint32 index);
+		void Compact(HandlerList& list);
+
+	private:
+
+		std::array<HandlerList, ActionType::ActionTypeCount> m_handlerLists;
+	};
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: EventBus
+Timestamp: 11/5/2020 3:21:09 PM
+*/
+
+#include "Actions/EventBus.hpp"
+
+namespace LinaEngine::Action
+{
+	EventToken EventBus::AddHandler(ActionType actionType, const EventDelegate& handler)
+	{
+		HandlerList& list = m_handlerLists[actionType];
+
+		uint32 slot = 0;
+		if (list.m_freeSlots.empty())
+		{
+			slot = (uint32)list.m_slotIndices.size();
+			list.m_slotIndices.push_back(0);
+			list.m_slotGenerations.push_back(0);
+		}
+		else
+		{
+			slot = list.m_freeSlots.back();
+			list.m_freeSlots.pop_back();
+		}
+
+		list.m_slotIndices[slot] = (uint32)list.m_handlers.size();
+		list.m_handlers.push_back(EventHandler{ handler, slot });
+
+		EventToken token;
+		token.m_actionType = actionType;
+		token.m_slot = slot;
+		token.m_generation = list.m_slotGenerations[slot];
+		return token;
+	}
+
+	void EventBus::Unsubscribe(EventToken& token)
+	{
+		if (!token.IsValid() || token.m_actionType >= ActionType::ActionTypeCount)
+			return;
+
+		HandlerList& list = m_handlerLists[token.m_actionType];
+		if (token.m_slot >= list.m_slotIndices.size() || list.m_slotGenerations[token.m_slot] != token.m_generation)
+		{
+			token = EventToken();
+			return;
+		}
+
+		const uint32 index = list.m_slotIndices[token.m_slot];
+
+		// Bumping the generation invalidates copies of the token, the slot is reused afterwards.
+		list.m_slotGenerations[token.m_slot]++;
+		list.m_freeSlots.push_back(token.m_slot);
+		token = EventToken();
+
+		// Mid dispatch, moving handlers would skip one, they are compacted once the dispatch is done.
+		if (list.m_dispatchDepth != 0)
+		{
+			list.m_handlers[index].m_delegate.Reset();
+			list.m_removedCount++;
+			return;
+		}
+
+		RemoveAt(list, index);
+	}
+
+	void EventBus::RemoveAt(HandlerList& list, uint32 index)
+	{
+		const uint32 last = (uint32)list.m_handlers.size() - 1;
+		if (index != last)
+		{
+			list.m_handlers[index] = list.m_handlers[last];
+
+			// Removed handlers' slots may already be reused, only a live handler owns its slot.
+			if (list.m_handlers[index].m_delegate)
+				list.m_slotIndices[list.m_handlers[index].m_slot] = index;
+		}
+
+		list.m_handlers.pop_back();
+	}
+
+	void EventBus::Compact(HandlerList& list)
+	{
+		for (uint32 i = 0; i < list.m_handlers.size();)
+		{
+			if (list.m_handlers[i].m_delegate)
+				i++;
+			else
+				RemoveAt(list, i);
+		}
+
+		list.m_removedCount = 0;
+	}
+}
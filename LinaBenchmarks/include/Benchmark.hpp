@@ -0,0 +1,120 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: Benchmark
+
+Minimal micro-benchmark harness. Benchmarks register themselves with LINA_BENCHMARK, the runner
+doubles the iteration count until a run takes long enough to be measured reliably. Results can be
+saved as JSON & compared against a stored baseline to catch regressions.
+
+Timestamp: 11/2/2020 4:40:18 PM
+*/
+
+#pragma once
+
+#ifndef Benchmark_HPP
+#define Benchmark_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#ifdef LINA_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace LinaBenchmarks
+{
+	class BenchmarkState
+	{
+	public:
+
+		BenchmarkState(uint64 iterations) : m_iterations(iterations) { ResetTimer(); };
+
+		// Excludes the setup done so far from the measurement.
+		void ResetTimer() { m_start = std::chrono::high_resolution_clock::now(); }
+
+		// Work items per iteration, used to report throughput.
+		void SetItemsPerIteration(uint64 items) { m_itemsPerIteration = items; }
+
+		uint64 GetIterations() const { return m_iterations; }
+		uint64 GetItemsPerIteration() const { return m_itemsPerIteration; }
+		std::chrono::time_point<std::chrono::high_resolution_clock> GetStart() const { return m_start; }
+
+	private:
+
+		uint64 m_iterations = 1;
+		uint64 m_itemsPerIteration = 0;
+		std::chrono::time_point<std::chrono::high_resolution_clock> m_start;
+	};
+
+	typedef std::function<void(BenchmarkState&)> BenchmarkFunction;
+
+	struct BenchmarkResult
+	{
+		std::string m_name = "";
+		uint64 m_iterations = 0;
+		double m_nsPerIteration = 0.0;
+		double m_itemsPerSecond = 0.0;
+	};
+
+	// Adds a benchmark to the global list, returns a dummy value so it can be used in static initializers.
+	int RegisterBenchmark(const std::string& name, BenchmarkFunction function);
+
+	// Runs the benchmarks whose name contains the filter.
+	std::vector<BenchmarkResult> RunBenchmarks(const std::string& filter, double minTimeMS);
+
+	// One result per line, so the files diff well & are read back without a JSON library.
+	bool WriteResults(const std::vector<BenchmarkResult>& results, const std::string& path);
+	bool ReadResults(const std::string& path, std::vector<BenchmarkResult>& results);
+
+	// Prints the benchmarks found in both sets, returns how many got slower than the threshold.
+	uint32 CompareResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double thresholdPercent);
+
+	// Keeps the compiler from optimizing away the measured value, it has to assume the value is read.
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#ifdef LINA_COMPILER_MSVC
+		static const volatile void* s_sink = nullptr;
+		s_sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+}
+
+#define LINA_BENCHMARK(NAME) \
+	static void NAME(::LinaBenchmarks::BenchmarkState& state); \
+	static int NAME##_registration = ::LinaBenchmarks::RegisterBenchmark(#NAME, NAME); \
+	static void NAME(::LinaBenchmarks::BenchmarkState& state)
+
+#endif
@@ -0,0 +1,142 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: ActionBenchmarks
+
+Dispatch cost of the event bus with the handler counts & payloads the engine uses, window
+events with a few listeners, key handlers filtering a single key, log messages passed to every
+listener & the subscribe/unsubscribe churn of panels coming and going.
+
+Timestamp: 11/4/2020 5:20:03 PM
+*/
+
+#include "Benchmark.hpp"
+#include "Actions/EventBus.hpp"
+#include "Core/EngineEvents.hpp"
+#include "Input/InputEvents.hpp"
+#include <vector>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+	using namespace LinaEngine::Action;
+
+	#define ACTION_BENCHMARK_DISPATCHES 1000
+
+	static void DispatchToHandlers(BenchmarkState& state, uint32 handlerCount)
+	{
+		EventBus eventBus;
+
+		float sum = 0.0f;
+		for (uint32 i = 0; i < handlerCount; i++)
+			eventBus.Subscribe<WindowResizedEvent>([&sum](const WindowResizedEvent& event) { sum += event.m_size.x; });
+
+		state.SetItemsPerIteration(ACTION_BENCHMARK_DISPATCHES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < ACTION_BENCHMARK_DISPATCHES; j++)
+				eventBus.Dispatch(WindowResizedEvent{ Vector2((float)j, 1.0f) });
+		}
+
+		DoNotOptimize(sum);
+	}
+
+	LINA_BENCHMARK(Action_Dispatch_1Handler) { DispatchToHandlers(state, 1); }
+	LINA_BENCHMARK(Action_Dispatch_16Handlers) { DispatchToHandlers(state, 16); }
+
+	// Only one of the handlers matches the key, same as the input axis binders.
+	LINA_BENCHMARK(Action_Dispatch_16ConditionalHandlers)
+	{
+		EventBus eventBus;
+
+		uint32 calls = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			const Input::InputCode::Key key = (Input::InputCode::Key)i;
+			eventBus.Subscribe<Input::KeyPressedEvent>([&calls, key](const Input::KeyPressedEvent& event) { if (event.m_key == key) calls++; });
+		}
+
+		state.SetItemsPerIteration(ACTION_BENCHMARK_DISPATCHES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < ACTION_BENCHMARK_DISPATCHES; j++)
+				eventBus.Dispatch(Input::KeyPressedEvent{ (Input::InputCode::Key)(j % 16) });
+		}
+
+		DoNotOptimize(calls);
+	}
+
+	// Every log line is dispatched to the console panel & the application this way.
+	LINA_BENCHMARK(Action_Dispatch_LogDump)
+	{
+		EventBus eventBus;
+
+		size_t length = 0;
+		for (uint32 i = 0; i < 2; i++)
+			eventBus.Subscribe<MessageLoggedEvent>([&length](const MessageLoggedEvent& event) { length += event.m_dump.m_message.size(); });
+
+		const Log::LogDump dump(Log::LogLevel::Info, "Texture created. resources/textures/defaultDiffuse.png");
+		state.SetItemsPerIteration(ACTION_BENCHMARK_DISPATCHES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < ACTION_BENCHMARK_DISPATCHES; j++)
+				eventBus.Dispatch(MessageLoggedEvent{ dump });
+		}
+
+		DoNotOptimize(length);
+	}
+
+	// Unsubscribes in subscription order, each removal moves the last handler into the freed index.
+	LINA_BENCHMARK(Action_SubscribeUnsubscribe_16Handlers)
+	{
+		EventBus eventBus;
+		std::vector<EventToken> tokens(16);
+
+		float sum = 0.0f;
+		state.SetItemsPerIteration(16);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (EventToken& token : tokens)
+				token = eventBus.Subscribe<WindowResizedEvent>([&sum](const WindowResizedEvent& event) { sum += event.m_size.x; });
+
+			for (EventToken& token : tokens)
+				eventBus.Unsubscribe(token);
+		}
+
+		DoNotOptimize(sum);
+	}
+}
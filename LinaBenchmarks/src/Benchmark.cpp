@@ -0,0 +1,192 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: Benchmark
+
+Timestamp: 11/2/2020 4:40:18 PM
+*/
+
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+namespace LinaBenchmarks
+{
+	struct RegisteredBenchmark
+	{
+		std::string m_name;
+		BenchmarkFunction m_function;
+	};
+
+	// Function local so registration order across translation units doesn't matter.
+	static std::vector<RegisteredBenchmark>& GetRegistry()
+	{
+		static std::vector<RegisteredBenchmark> registry;
+		return registry;
+	}
+
+	int RegisterBenchmark(const std::string& name, BenchmarkFunction function)
+	{
+		GetRegistry().push_back({ name, function });
+		return 0;
+	}
+
+	std::vector<BenchmarkResult> RunBenchmarks(const std::string& filter, double minTimeMS)
+	{
+		std::vector<BenchmarkResult> results;
+
+		for (RegisteredBenchmark& benchmark : GetRegistry())
+		{
+			if (!filter.empty() && benchmark.m_name.find(filter) == std::string::npos)
+				continue;
+
+			uint64 iterations = 1;
+
+			while (true)
+			{
+				BenchmarkState state(iterations);
+				benchmark.m_function(state);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - state.GetStart();
+
+				// Keep doubling until the run is long enough, or give up on very slow ones.
+				if (elapsed.count() >= minTimeMS || iterations >= (1ull << 30))
+				{
+					BenchmarkResult result;
+					result.m_name = benchmark.m_name;
+					result.m_iterations = iterations;
+					result.m_nsPerIteration = elapsed.count() * 1000000.0 / (double)iterations;
+
+					if (state.GetItemsPerIteration() != 0)
+						result.m_itemsPerSecond = (double)(state.GetItemsPerIteration() * iterations) / (elapsed.count() / 1000.0);
+
+					std::cout << std::left << std::setw(48) << result.m_name << std::right << std::setw(14) << std::fixed << std::setprecision(1) << result.m_nsPerIteration << " ns/iter";
+
+					if (result.m_itemsPerSecond != 0.0)
+						std::cout << std::setw(16) << std::setprecision(0) << result.m_itemsPerSecond << " items/s";
+
+					std::cout << std::endl;
+					results.push_back(result);
+					break;
+				}
+
+				iterations *= 2;
+			}
+		}
+
+		return results;
+	}
+
+	bool WriteResults(const std::vector<BenchmarkResult>& results, const std::string& path)
+	{
+		std::ofstream stream(path);
+		if (!stream.is_open())
+			return false;
+
+		stream << "{\n\t\"benchmarks\": [\n";
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const BenchmarkResult& result = results[i];
+			stream << "\t\t{ \"name\": \"" << result.m_name << "\", \"iterations\": " << result.m_iterations
+				<< std::setprecision(17) << ", \"ns_per_iteration\": " << result.m_nsPerIteration << ", \"items_per_second\": " << result.m_itemsPerSecond
+				<< (i + 1 < results.size() ? " },\n" : " }\n");
+		}
+
+		stream << "\t]\n}\n";
+		return stream.good();
+	}
+
+	// Value of a key in a line written by WriteResults, empty if the key isn't there.
+	static std::string FindValue(const std::string& line, const std::string& key)
+	{
+		const size_t keyStart = line.find("\"" + key + "\":");
+		if (keyStart == std::string::npos)
+			return "";
+
+		size_t begin = keyStart + key.size() + 3;
+		while (begin < line.size() && line[begin] == ' ')
+			begin++;
+
+		if (begin < line.size() && line[begin] == '"')
+			return line.substr(begin + 1, line.find('"', begin + 1) - begin - 1);
+
+		return line.substr(begin, line.find_first_of(",}", begin) - begin);
+	}
+
+	bool ReadResults(const std::string& path, std::vector<BenchmarkResult>& results)
+	{
+		std::ifstream stream(path);
+		if (!stream.is_open())
+			return false;
+
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			const std::string name = FindValue(line, "name");
+			if (name.empty())
+				continue;
+
+			BenchmarkResult result;
+			result.m_name = name;
+			result.m_iterations = std::strtoull(FindValue(line, "iterations").c_str(), nullptr, 10);
+			result.m_nsPerIteration = std::strtod(FindValue(line, "ns_per_iteration").c_str(), nullptr);
+			result.m_itemsPerSecond = std::strtod(FindValue(line, "items_per_second").c_str(), nullptr);
+			results.push_back(result);
+		}
+
+		return true;
+	}
+
+	uint32 CompareResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double thresholdPercent)
+	{
+		uint32 regressions = 0;
+
+		for (const BenchmarkResult& result : current)
+		{
+			std::vector<BenchmarkResult>::const_iterator base = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchmarkResult& other) { return other.m_name == result.m_name; });
+			if (base == baseline.end() || base->m_nsPerIteration <= 0.0)
+				continue;
+
+			const double change = (result.m_nsPerIteration - base->m_nsPerIteration) / base->m_nsPerIteration * 100.0;
+			const bool regressed = change > thresholdPercent;
+			const char* verdict = regressed ? "  REGRESSION" : (change < -thresholdPercent ? "  improved" : "");
+
+			std::cout << std::left << std::setw(48) << result.m_name << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(14) << base->m_nsPerIteration << " ->" << std::setw(14) << result.m_nsPerIteration << " ns/iter"
+				<< std::showpos << std::setw(10) << change << "%" << std::noshowpos << verdict << std::endl;
+
+			if (regressed)
+				regressions++;
+		}
+
+		return regressions;
+	}
+}
@@ -0,0 +1,294 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: ECSBenchmarks
+
+Entity name & tag lookups through the registry indices at 100k entities, against the linear scan
+GetEntity used to do, and the cost the index adds to entity creation & renames. View iteration over
+the component sets the engine systems walk every frame.
+
+Timestamp: 11/3/2020 9:06:31 PM
+*/
+
+#include "Benchmark.hpp"
+#include "ECS/ECSSystem.hpp"
+#include "ECS/Components/TransformComponent.hpp"
+#include "ECS/Components/MeshRendererComponent.hpp"
+#include "ECS/Components/RigidbodyComponent.hpp"
+#include <random>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+	using namespace LinaEngine::ECS;
+
+	#define ECS_BENCHMARK_COUNT 100000
+	#define ECS_BENCHMARK_LOOKUPS 1000
+
+	// Every hundredth name is shared by ten entities, every entity has one of 16 tags.
+	static std::string GetBenchmarkName(uint32 index)
+	{
+		return index % 100 == 0 ? "Shared_" + std::to_string(index / 1000) : "Entity_" + std::to_string(index);
+	}
+
+	struct NamedRegistry
+	{
+		NamedRegistry()
+		{
+			for (uint32 i = 0; i < ECS_BENCHMARK_COUNT; i++)
+			{
+				ECSEntity entity = m_registry.CreateEntity(GetBenchmarkName(i));
+				m_registry.SetEntityTag(entity, "Tag_" + std::to_string(i % 16));
+			}
+
+			std::mt19937 rng(7);
+			std::uniform_int_distribution<uint32> index(0, ECS_BENCHMARK_COUNT - 1);
+
+			for (uint32 i = 0; i < ECS_BENCHMARK_LOOKUPS; i++)
+				m_lookups.push_back(GetBenchmarkName(index(rng)));
+		}
+
+		ECSRegistry m_registry;
+		std::vector<std::string> m_lookups;
+	};
+
+	static NamedRegistry& GetNamedRegistry()
+	{
+		static NamedRegistry registry;
+		return registry;
+	}
+
+	LINA_BENCHMARK(ECS_GetEntity_Indexed)
+	{
+		NamedRegistry& data = GetNamedRegistry();
+		state.SetItemsPerIteration(ECS_BENCHMARK_LOOKUPS);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (const std::string& name : data.m_lookups)
+				DoNotOptimize(data.m_registry.GetEntity(name));
+		}
+	}
+
+	// How GetEntity used to find entities.
+	LINA_BENCHMARK(ECS_GetEntity_LinearScan)
+	{
+		NamedRegistry& data = GetNamedRegistry();
+		auto view = data.m_registry.view<ECSEntityData>();
+		state.SetItemsPerIteration(ECS_BENCHMARK_LOOKUPS);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (const std::string& name : data.m_lookups)
+			{
+				ECSEntity found = entt::null;
+
+				for (ECSEntity entity : view)
+				{
+					if (view.get<ECSEntityData>(entity).m_name.compare(name) == 0)
+					{
+						found = entity;
+						break;
+					}
+				}
+
+				DoNotOptimize(found);
+			}
+		}
+	}
+
+	LINA_BENCHMARK(ECS_GetEntities_Duplicates)
+	{
+		NamedRegistry& data = GetNamedRegistry();
+		std::vector<ECSEntity> entities;
+		state.SetItemsPerIteration(ECS_BENCHMARK_LOOKUPS);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < ECS_BENCHMARK_LOOKUPS; j++)
+			{
+				entities.clear();
+				data.m_registry.GetEntities("Shared_" + std::to_string(j % 100), entities);
+				DoNotOptimize(entities.size());
+			}
+		}
+	}
+
+	LINA_BENCHMARK(ECS_GetEntitiesWithTag)
+	{
+		NamedRegistry& data = GetNamedRegistry();
+		std::vector<ECSEntity> entities;
+		const std::string tag = "Tag_3";
+		state.SetItemsPerIteration(ECS_BENCHMARK_COUNT / 16);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			entities.clear();
+			data.m_registry.GetEntitiesWithTag(tag, entities);
+			DoNotOptimize(entities.size());
+		}
+	}
+
+	// Index upkeep, creating & destroying 100k named entities.
+	LINA_BENCHMARK(ECS_CreateDestroyNamed100k)
+	{
+		std::vector<std::string> names;
+		for (uint32 i = 0; i < ECS_BENCHMARK_COUNT; i++)
+			names.push_back(GetBenchmarkName(i));
+
+		state.SetItemsPerIteration(ECS_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			ECSRegistry registry;
+
+			for (uint32 j = 0; j < ECS_BENCHMARK_COUNT; j++)
+				registry.CreateEntity(names[j]);
+
+			registry.clear();
+		}
+	}
+
+	LINA_BENCHMARK(ECS_SetEntityName)
+	{
+		NamedRegistry& data = GetNamedRegistry();
+		auto view = data.m_registry.view<ECSEntityData>();
+		std::vector<ECSEntity> entities(view.begin(), view.begin() + ECS_BENCHMARK_LOOKUPS);
+		state.SetItemsPerIteration(ECS_BENCHMARK_LOOKUPS * 2);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (ECSEntity entity : entities)
+			{
+				const std::string name = data.m_registry.get<ECSEntityData>(entity).m_name;
+				data.m_registry.SetEntityName(entity, "Renamed");
+				data.m_registry.SetEntityName(entity, name);
+			}
+		}
+	}
+
+	#define ECS_VIEW_BENCHMARK_COUNT 100000
+
+	// Every entity has a transform, three in four are rendered & one in eight is simulated.
+	struct SceneRegistry
+	{
+		SceneRegistry()
+		{
+			for (uint32 i = 0; i < ECS_VIEW_BENCHMARK_COUNT; i++)
+			{
+				ECSEntity entity = m_registry.CreateEntity("Entity_" + std::to_string(i));
+				TransformComponent& transform = m_registry.emplace<TransformComponent>(entity);
+				transform.transform.m_location = Vector3((float)i, 0.0f, 0.0f);
+				transform.m_worldMatrix = transform.transform.ToMatrix();
+
+				if (i % 4 != 0)
+				{
+					MeshRendererComponent& renderer = m_registry.emplace<MeshRendererComponent>(entity);
+					renderer.m_meshID = (int)(i % 32);
+					renderer.m_materialID = (int)(i % 8);
+				}
+
+				if (i % 8 == 0)
+					m_registry.emplace<RigidbodyComponent>(entity).m_mass = 1.0f;
+			}
+		}
+
+		ECSRegistry m_registry;
+	};
+
+	static SceneRegistry& GetSceneRegistry()
+	{
+		static SceneRegistry registry;
+		return registry;
+	}
+
+	LINA_BENCHMARK(ECS_View_Transform)
+	{
+		ECSRegistry& registry = GetSceneRegistry().m_registry;
+		auto view = registry.view<TransformComponent>();
+		state.SetItemsPerIteration(view.size());
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			float sum = 0.0f;
+
+			for (ECSEntity entity : view)
+				sum += view.get<TransformComponent>(entity).m_worldMatrix[3][0];
+
+			DoNotOptimize(sum);
+		}
+	}
+
+	// How the mesh renderer system walks the scene.
+	LINA_BENCHMARK(ECS_View_TransformMeshRenderer)
+	{
+		ECSRegistry& registry = GetSceneRegistry().m_registry;
+		auto view = registry.view<TransformComponent, MeshRendererComponent>();
+		state.SetItemsPerIteration(registry.size<MeshRendererComponent>());
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			float sum = 0.0f;
+
+			for (ECSEntity entity : view)
+			{
+				const MeshRendererComponent& renderer = view.get<MeshRendererComponent>(entity);
+				if (renderer.m_meshID >= 0)
+					sum += view.get<TransformComponent>(entity).m_worldMatrix[3][0];
+			}
+
+			DoNotOptimize(sum);
+		}
+	}
+
+	LINA_BENCHMARK(ECS_View_TransformRigidbody)
+	{
+		ECSRegistry& registry = GetSceneRegistry().m_registry;
+		auto view = registry.view<TransformComponent, RigidbodyComponent>();
+		state.SetItemsPerIteration(registry.size<RigidbodyComponent>());
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			float sum = 0.0f;
+
+			for (ECSEntity entity : view)
+				sum += view.get<TransformComponent>(entity).transform.m_location.x * view.get<RigidbodyComponent>(entity).m_mass;
+
+			DoNotOptimize(sum);
+		}
+	}
+}
@@ -0,0 +1,163 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: GraphicsBenchmarks
+
+CPU side of rendering, gathering mesh renderers into instanced batches & the transparent queue, and
+filling indexed models the way the model loader does.
+
+Timestamp: 11/4/2020 5:34:15 PM
+*/
+
+#include "Benchmark.hpp"
+#include "ECS/Systems/MeshRendererSystem.hpp"
+#include "Rendering/IndexedModel.hpp"
+#include "Core/FrameArena.hpp"
+#include <random>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+	using namespace LinaEngine::Graphics;
+
+	#define GRAPHICS_BENCHMARK_RENDERERS 10000
+	#define GRAPHICS_BENCHMARK_VERTEXARRAYS 16
+	#define GRAPHICS_BENCHMARK_MATERIALS 8
+	#define GRAPHICS_BENCHMARK_VERTICES 65536
+
+	// Batches are keyed by the vertex array & material addresses only, gathering never touches the objects
+	// so they don't need a render device.
+	struct BatchData
+	{
+		BatchData()
+		{
+			std::mt19937 rng(3);
+			std::uniform_real_distribution<float> range(-100.0f, 100.0f);
+
+			for (uint32 i = 0; i < GRAPHICS_BENCHMARK_RENDERERS; i++)
+			{
+				m_models.push_back(Matrix::Translate(Vector3(range(rng), range(rng), range(rng))));
+				m_vertexArrays.push_back(reinterpret_cast<VertexArray*>(&m_vertexArrayStorage[rng() % GRAPHICS_BENCHMARK_VERTEXARRAYS]));
+				m_materials.push_back(reinterpret_cast<Material*>(&m_materialStorage[rng() % GRAPHICS_BENCHMARK_MATERIALS]));
+				m_distances.push_back(range(rng));
+			}
+		}
+
+		uint64 m_vertexArrayStorage[GRAPHICS_BENCHMARK_VERTEXARRAYS];
+		uint64 m_materialStorage[GRAPHICS_BENCHMARK_MATERIALS];
+		std::vector<Matrix> m_models;
+		std::vector<VertexArray*> m_vertexArrays;
+		std::vector<Material*> m_materials;
+		std::vector<float> m_distances;
+	};
+
+	static BatchData& GetBatchData()
+	{
+		static BatchData data;
+		return data;
+	}
+
+	LINA_BENCHMARK(MeshRenderer_BatchOpaque)
+	{
+		BatchData& data = GetBatchData();
+		ECS::MeshRendererSystem system;
+		state.SetItemsPerIteration(GRAPHICS_BENCHMARK_RENDERERS);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < GRAPHICS_BENCHMARK_RENDERERS; j++)
+				system.RenderOpaque(*data.m_vertexArrays[j], *data.m_materials[j], data.m_models[j]);
+
+			system.ClearBatches();
+		}
+	}
+
+	LINA_BENCHMARK(MeshRenderer_GatherTransparent)
+	{
+		BatchData& data = GetBatchData();
+		ECS::MeshRendererSystem system;
+		state.SetItemsPerIteration(GRAPHICS_BENCHMARK_RENDERERS);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			FrameArena::BeginFrame();
+
+			for (uint32 j = 0; j < GRAPHICS_BENCHMARK_RENDERERS; j++)
+				system.RenderTransparent(*data.m_vertexArrays[j], *data.m_materials[j], data.m_models[j], data.m_distances[j]);
+
+			system.ClearBatches();
+		}
+	}
+
+	// Same layout as the models imported by the model loader, a grid of quads.
+	LINA_BENCHMARK(IndexedModel_Construct)
+	{
+		state.SetItemsPerIteration(GRAPHICS_BENCHMARK_VERTICES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			IndexedModel model;
+			model.AllocateElement(3, true);
+			model.AllocateElement(2, true);
+			model.AllocateElement(3, true);
+			model.AllocateElement(3, true);
+			model.AllocateElement(3, true);
+			model.SetStartIndex(5);
+			model.AllocateElement(16, true);
+			model.AllocateElement(16, true);
+
+			const uint32 side = 256;
+			for (uint32 v = 0; v < GRAPHICS_BENCHMARK_VERTICES; v++)
+			{
+				const float x = (float)(v % side);
+				const float z = (float)(v / side);
+				model.AddElement(0, x, 0.0f, z);
+				model.AddElement(1, x / side, z / side);
+				model.AddElement(2, 0.0f, 1.0f, 0.0f);
+				model.AddElement(3, 1.0f, 0.0f, 0.0f);
+				model.AddElement(4, 0.0f, 0.0f, 1.0f);
+			}
+
+			for (uint32 z = 0; z < side - 1; z++)
+			{
+				for (uint32 x = 0; x < side - 1; x++)
+				{
+					const uint32 corner = z * side + x;
+					model.AddIndices(corner, corner + side, corner + 1);
+					model.AddIndices(corner + 1, corner + side, corner + side + 1);
+				}
+			}
+
+			DoNotOptimize(model.GetIndexCount());
+		}
+	}
+}
@@ -0,0 +1,181 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: JobSystemBenchmarks
+
+Fork-join throughput, ParallelFor grain sizes, dependency chains & thread scaling of the job system.
+
+Timestamp: 11/2/2020 5:21:03 PM
+*/
+
+#include "Benchmark.hpp"
+#include "Core/JobSystem.hpp"
+#include <cmath>
+#include <map>
+#include <memory>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+
+	// Systems are kept alive between runs so thread startup isn't measured.
+	static JobSystem& GetJobSystem(uint32 workerCount)
+	{
+		static std::map<uint32, std::unique_ptr<JobSystem>> systems;
+		std::unique_ptr<JobSystem>& system = systems[workerCount];
+
+		if (system == nullptr)
+		{
+			system = std::make_unique<JobSystem>();
+			JobSystemOptions options;
+			options.m_workerCount = workerCount;
+			system->Initialize(options);
+		}
+
+		return *system;
+	}
+
+	static uint32 GetDefaultWorkerCount()
+	{
+		uint32 hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	// Compute bound work per element, heavy enough that scaling isn't memory bound.
+	static float HeavyWork(uint32 index)
+	{
+		float value = (float)index;
+		for (int i = 0; i < 32; i++)
+			value = std::sin(value) * 0.5f + std::cos(value * 0.25f);
+
+		return value;
+	}
+
+	LINA_BENCHMARK(JobSystem_ForkJoin_EmptyJobs)
+	{
+		JobSystem& jobSystem = GetJobSystem(GetDefaultWorkerCount());
+		const uint32 jobCount = 1024;
+		state.SetItemsPerIteration(jobCount);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			JobCounter counter;
+
+			for (uint32 j = 0; j < jobCount; j++)
+				jobSystem.Run([]() {}, &counter);
+
+			jobSystem.Wait(counter);
+		}
+	}
+
+	LINA_BENCHMARK(JobSystem_DependencyChain)
+	{
+		JobSystem& jobSystem = GetJobSystem(GetDefaultWorkerCount());
+		const uint32 chainLength = 256;
+		state.SetItemsPerIteration(chainLength);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			std::vector<JobCounter> counters(chainLength);
+			jobSystem.Run([]() {}, &counters[0]);
+
+			for (uint32 j = 1; j < chainLength; j++)
+				jobSystem.RunAfter(counters[j - 1], []() {}, &counters[j]);
+
+			jobSystem.Wait(counters[chainLength - 1]);
+		}
+	}
+
+	static void ParallelForGrain(BenchmarkState& state, uint32 grainSize)
+	{
+		JobSystem& jobSystem = GetJobSystem(GetDefaultWorkerCount());
+		const uint32 count = 1 << 20;
+		std::vector<float> data(count);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			jobSystem.ParallelFor(count, grainSize, [&data](uint32 begin, uint32 end)
+				{
+					for (uint32 j = begin; j < end; j++)
+						data[j] = std::sqrt((float)j) * 0.5f + data[j];
+				});
+		}
+
+		DoNotOptimize(data[count - 1]);
+	}
+
+	LINA_BENCHMARK(JobSystem_ParallelFor_Grain64) { ParallelForGrain(state, 64); }
+	LINA_BENCHMARK(JobSystem_ParallelFor_Grain1024) { ParallelForGrain(state, 1024); }
+	LINA_BENCHMARK(JobSystem_ParallelFor_Grain16384) { ParallelForGrain(state, 16384); }
+	LINA_BENCHMARK(JobSystem_ParallelFor_GrainAuto) { ParallelForGrain(state, 0); }
+
+	static void Scaling(BenchmarkState& state, uint32 workerCount)
+	{
+		const uint32 count = 1 << 14;
+		std::vector<float> data(count);
+		state.SetItemsPerIteration(count);
+
+		if (workerCount == 0)
+		{
+			state.ResetTimer();
+
+			for (uint64 i = 0; i < state.GetIterations(); i++)
+			{
+				for (uint32 j = 0; j < count; j++)
+					data[j] = HeavyWork(j);
+			}
+		}
+		else
+		{
+			JobSystem& jobSystem = GetJobSystem(workerCount);
+			state.ResetTimer();
+
+			for (uint64 i = 0; i < state.GetIterations(); i++)
+			{
+				jobSystem.ParallelFor(count, 0, [&data](uint32 begin, uint32 end)
+					{
+						for (uint32 j = begin; j < end; j++)
+							data[j] = HeavyWork(j);
+					});
+			}
+		}
+
+		DoNotOptimize(data[count - 1]);
+	}
+
+	// Thread counts include the main thread, serial runs the loop without the job system.
+	LINA_BENCHMARK(JobSystem_Scaling_Serial) { Scaling(state, 0); }
+	LINA_BENCHMARK(JobSystem_Scaling_Threads2) { Scaling(state, 1); }
+	LINA_BENCHMARK(JobSystem_Scaling_Threads4) { Scaling(state, 3); }
+	LINA_BENCHMARK(JobSystem_Scaling_Threads8) { Scaling(state, 7); }
+	LINA_BENCHMARK(JobSystem_Scaling_Threads16) { Scaling(state, 15); }
+}
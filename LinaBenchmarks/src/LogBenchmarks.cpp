@@ -0,0 +1,199 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: LogBenchmarks
+
+Cost of a log call with nothing listening, with a listener, with the formatting the engine's log
+lines usually do, and on the calling thread once the async writer takes over. Filtered & binary
+variants show what's left of a call once the level is masked out or formatting moves to the decoder.
+
+Timestamp: 11/4/2020 5:26:48 PM
+*/
+
+#include "Benchmark.hpp"
+#include "Utility/Log.hpp"
+#include <cstdio>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+
+	#define LOG_BENCHMARK_MESSAGES 1000
+
+	// Swaps the log listener for the duration of a benchmark.
+	class LogListenerScope
+	{
+	public:
+
+		LogListenerScope(const std::function<void(Log::LogDump)>& listener) : m_previous(Log::s_onLog) { Log::s_onLog = listener; }
+		~LogListenerScope() { Log::s_onLog = m_previous; }
+
+	private:
+
+		std::function<void(Log::LogDump)> m_previous;
+	};
+
+	LINA_BENCHMARK(Log_Message_NoListener)
+	{
+		LogListenerScope listener(nullptr);
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Trace, "Texture created. {0}", "resources/textures/defaultDiffuse.png");
+		}
+	}
+
+	LINA_BENCHMARK(Log_Message_Listener)
+	{
+		size_t length = 0;
+		LogListenerScope listener([&length](Log::LogDump dump) { length += dump.m_message.size(); });
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Trace, "Texture created. {0}", "resources/textures/defaultDiffuse.png");
+		}
+
+		DoNotOptimize(length);
+	}
+
+	LINA_BENCHMARK(Log_Message_ListenerFormatArgs)
+	{
+		size_t length = 0;
+		LogListenerScope listener([&length](Log::LogDump dump) { length += dump.m_message.size(); });
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Info, "Async texture batch finished, {0} textures in {1} ms. {2}", j, 12.5 + j, "resources/textures");
+		}
+
+		DoNotOptimize(length);
+	}
+
+	LINA_BENCHMARK(Log_Message_FilteredOut)
+	{
+		size_t length = 0;
+		LogListenerScope listener([&length](Log::LogDump dump) { length += dump.m_message.size(); });
+		const uint32 previousMask = Log::GetLevelMask();
+		Log::SetLevelMask(Log::GetLevelMaskFrom(Log::LogLevel::Warn));
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Info, "Async texture batch finished, {0} textures in {1} ms. {2}", j, 12.5 + j, "resources/textures");
+		}
+
+		Log::SetLevelMask(previousMask);
+		DoNotOptimize(length);
+	}
+
+	// The writer runs for the duration of a benchmark, the listener isn't called until DispatchPending.
+	class AsyncLogScope
+	{
+	public:
+
+		AsyncLogScope(const AsyncLogSettings& settings) : m_settings(settings) { Log::StartAsync(settings); }
+		~AsyncLogScope()
+		{
+			Log::StopAsync();
+			if (m_settings.m_filePath.empty())
+				return;
+
+			std::remove(m_settings.m_filePath.c_str());
+			for (uint32 i = 1; i <= m_settings.m_maxFileCount; i++)
+				std::remove((m_settings.m_filePath + "." + std::to_string(i)).c_str());
+		}
+
+	private:
+
+		AsyncLogSettings m_settings;
+	};
+
+	LINA_BENCHMARK(Log_Message_Async)
+	{
+		AsyncLogSettings settings;
+		settings.m_writeToConsole = false;
+		settings.m_filePath = "";
+		settings.m_forwardToListener = false;
+		AsyncLogScope async(settings);
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Info, "Async texture batch finished, {0} textures in {1} ms. {2}", j, 12.5 + j, "resources/textures");
+		}
+	}
+
+	LINA_BENCHMARK(Log_Message_AsyncFile)
+	{
+		AsyncLogSettings settings;
+		settings.m_writeToConsole = false;
+		settings.m_filePath = "benchmark_log.txt";
+		settings.m_forwardToListener = false;
+		AsyncLogScope async(settings);
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Info, "Async texture batch finished, {0} textures in {1} ms. {2}", j, 12.5 + j, "resources/textures");
+		}
+	}
+
+	LINA_BENCHMARK(Log_Message_AsyncBinaryFile)
+	{
+		AsyncLogSettings settings;
+		settings.m_writeToConsole = false;
+		settings.m_filePath = "benchmark_log.linalog";
+		settings.m_forwardToListener = false;
+		settings.m_recordMode = LogRecordMode::Binary;
+		AsyncLogScope async(settings);
+		state.SetItemsPerIteration(LOG_BENCHMARK_MESSAGES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < LOG_BENCHMARK_MESSAGES; j++)
+				Log::LogMessage(Log::LogLevel::Info, "Async texture batch finished, {0} textures in {1} ms. {2}", j, 12.5 + j, "resources/textures");
+		}
+	}
+}
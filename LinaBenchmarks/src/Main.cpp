@@ -0,0 +1,171 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: Main
+
+Entry point of the benchmark runner.
+Usage: LinaBenchmarks [--filter <name part>] [--min-time <ms>] [--output <results.json>]
+                      [--baseline <results.json>] [--threshold <percent>]
+       LinaBenchmarks --compare <baseline.json> <results.json> [--threshold <percent>]
+
+Runs compared against a baseline exit with 1 if any benchmark got slower than the threshold, 10% by default.
+Unreadable files exit with 2, unknown flags & invalid values print the usage and exit with 3.
+
+Timestamp: 11/2/2020 4:40:18 PM
+*/
+
+#include "Benchmark.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#define BENCHMARKS_EXIT_INVALID_ARGUMENTS 3
+
+static bool ParseDouble(const char* text, double& out)
+{
+	if (*text == '\0')
+		return false;
+
+	char* end = nullptr;
+	errno = 0;
+	const double value = std::strtod(text, &end);
+	if (errno != 0 || *end != '\0' || !std::isfinite(value))
+		return false;
+
+	out = value;
+	return true;
+}
+
+static int PrintUsage()
+{
+	std::cout << "Usage: LinaBenchmarks [--filter <name part>] [--min-time <ms>] [--output <results.json>]" << std::endl;
+	std::cout << "                      [--baseline <results.json>] [--threshold <percent>]" << std::endl;
+	std::cout << "       LinaBenchmarks --compare <baseline.json> <results.json> [--threshold <percent>]" << std::endl;
+	return BENCHMARKS_EXIT_INVALID_ARGUMENTS;
+}
+
+int main(int argc, char** argv)
+{
+	std::string filter = "";
+	std::string outputPath = "";
+	std::string baselinePath = "";
+	std::string comparedPath = "";
+	double minTimeMS = 200.0;
+	double thresholdPercent = 10.0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+
+		const int valueCount = arg == "--compare" ? 2 : 1;
+
+		if (arg != "--filter" && arg != "--min-time" && arg != "--output" && arg != "--baseline" && arg != "--threshold" && arg != "--compare")
+		{
+			std::cout << "Unknown argument " << arg << std::endl;
+			return PrintUsage();
+		}
+
+		if (i + valueCount >= argc)
+		{
+			std::cout << "Missing value for " << arg << std::endl;
+			return PrintUsage();
+		}
+
+		if (arg == "--filter")
+			filter = argv[++i];
+		else if (arg == "--min-time")
+		{
+			if (!ParseDouble(argv[++i], minTimeMS) || minTimeMS <= 0.0)
+			{
+				std::cout << "Invalid --min-time " << argv[i] << ", expected a positive number of milliseconds." << std::endl;
+				return PrintUsage();
+			}
+		}
+		else if (arg == "--output")
+			outputPath = argv[++i];
+		else if (arg == "--baseline")
+			baselinePath = argv[++i];
+		else if (arg == "--threshold")
+		{
+			if (!ParseDouble(argv[++i], thresholdPercent) || thresholdPercent < 0.0)
+			{
+				std::cout << "Invalid --threshold " << argv[i] << ", expected a non-negative percentage." << std::endl;
+				return PrintUsage();
+			}
+		}
+		else
+		{
+			baselinePath = argv[++i];
+			comparedPath = argv[++i];
+		}
+	}
+
+	std::vector<LinaBenchmarks::BenchmarkResult> baseline;
+	if (!baselinePath.empty() && !LinaBenchmarks::ReadResults(baselinePath, baseline))
+	{
+		std::cout << "Baseline " << baselinePath << " could not be read." << std::endl;
+		return 2;
+	}
+
+	std::vector<LinaBenchmarks::BenchmarkResult> results;
+
+	if (comparedPath.empty())
+	{
+		results = LinaBenchmarks::RunBenchmarks(filter, minTimeMS);
+
+		if (results.empty())
+			std::cout << "No benchmarks matched the filter." << std::endl;
+
+		if (!outputPath.empty() && !LinaBenchmarks::WriteResults(results, outputPath))
+		{
+			std::cout << "Results could not be written to " << outputPath << std::endl;
+			return 2;
+		}
+	}
+	else if (!LinaBenchmarks::ReadResults(comparedPath, results))
+	{
+		std::cout << "Results " << comparedPath << " could not be read." << std::endl;
+		return 2;
+	}
+
+	if (baselinePath.empty())
+		return 0;
+
+	std::cout << std::endl << "Compared against " << baselinePath << ", threshold " << thresholdPercent << "%" << std::endl;
+	const uint32 regressions = LinaBenchmarks::CompareResults(baseline, results, thresholdPercent);
+
+	if (regressions != 0)
+	{
+		std::cout << regressions << " benchmarks regressed." << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,266 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: MathBenchmarks
+
+Transformation & normal matrix throughput, batch kernels against the per matrix paths, and the
+quaternion operations used by transforms & cameras.
+
+Timestamp: 11/3/2020 4:02:37 PM
+*/
+
+#include "Benchmark.hpp"
+#include "Utility/Math/MatrixBatch.hpp"
+#include "glm/gtx/transform.hpp"
+#include <random>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+
+	#define MATH_BENCHMARK_COUNT 4096
+
+	struct TransformData
+	{
+		TransformData()
+		{
+			std::mt19937 rng(1);
+			std::uniform_real_distribution<float> range(-10.0f, 10.0f);
+			std::uniform_real_distribution<float> scaleRange(0.1f, 5.0f);
+
+			m_locations.resize(MATH_BENCHMARK_COUNT);
+			m_rotations.resize(MATH_BENCHMARK_COUNT);
+			m_scales.resize(MATH_BENCHMARK_COUNT);
+			m_matrices.resize(MATH_BENCHMARK_COUNT);
+			m_results.resize(MATH_BENCHMARK_COUNT);
+
+			for (uint32 i = 0; i < MATH_BENCHMARK_COUNT; i++)
+			{
+				m_locations[i] = Vector3(range(rng), range(rng), range(rng));
+				m_scales[i] = Vector3(scaleRange(rng), scaleRange(rng), scaleRange(rng));
+				glm::quat rotation = glm::normalize(glm::quat(range(rng), range(rng), range(rng), range(rng)));
+				m_rotations[i] = Quaternion(rotation.x, rotation.y, rotation.z, rotation.w);
+				m_matrices[i] = Matrix::TransformMatrix(m_locations[i], m_rotations[i], m_scales[i]);
+			}
+		}
+
+		std::vector<Vector3> m_locations;
+		std::vector<Quaternion> m_rotations;
+		std::vector<Vector3> m_scales;
+		std::vector<Matrix> m_matrices;
+		std::vector<Matrix> m_results;
+	};
+
+	static TransformData& GetTransformData()
+	{
+		static TransformData data;
+		return data;
+	}
+
+	// Translation, rotation & scale matrices multiplied together, how TransformMatrix used to work.
+	LINA_BENCHMARK(Math_TransformMatrix_MatrixProducts)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				data.m_results[j] = Matrix(glm::translate(glm::vec3(data.m_locations[j]))) * Matrix::InitRotation(data.m_rotations[j]) * Matrix(glm::scale(glm::vec3(data.m_scales[j])));
+
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_TransformMatrix_Scalar)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				data.m_results[j] = Matrix::TransformMatrix(data.m_locations[j], data.m_rotations[j], data.m_scales[j]);
+
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_TransformMatrix_Batch)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			MatrixBatch::TransformMatrices(&data.m_locations[0], &data.m_rotations[0], &data.m_scales[0], &data.m_results[0], MATH_BENCHMARK_COUNT);
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	// What the renderers used to do per instance.
+	LINA_BENCHMARK(Math_NormalMatrix_GeneralInverse)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				data.m_results[j] = data.m_matrices[j].Transpose().Inverse();
+
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_NormalMatrix_AffineScalar)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				data.m_results[j] = data.m_matrices[j].ToNormalMatrixAffine();
+
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_NormalMatrix_Batch)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			MatrixBatch::NormalMatrices(&data.m_matrices[0], &data.m_results[0], MATH_BENCHMARK_COUNT);
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_Inverse_General)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				data.m_results[j] = data.m_matrices[j].Inverse();
+
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_Inverse_Affine)
+	{
+		TransformData& data = GetTransformData();
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				data.m_results[j] = data.m_matrices[j].InverseAffine();
+
+			DoNotOptimize(data.m_results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_Quaternion_Multiply)
+	{
+		TransformData& data = GetTransformData();
+		std::vector<Quaternion> results(MATH_BENCHMARK_COUNT);
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				results[j] = data.m_rotations[j] * data.m_rotations[MATH_BENCHMARK_COUNT - 1 - j];
+
+			DoNotOptimize(results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_Quaternion_Rotate)
+	{
+		TransformData& data = GetTransformData();
+		std::vector<Vector3> results(MATH_BENCHMARK_COUNT);
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				results[j] = data.m_rotations[j].GetRotated(data.m_locations[j]);
+
+			DoNotOptimize(results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_Quaternion_Slerp)
+	{
+		TransformData& data = GetTransformData();
+		std::vector<Quaternion> results(MATH_BENCHMARK_COUNT);
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				results[j] = Quaternion::Slerp(data.m_rotations[j], data.m_rotations[MATH_BENCHMARK_COUNT - 1 - j], 0.35f);
+
+			DoNotOptimize(results[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Math_Quaternion_EulerRoundTrip)
+	{
+		TransformData& data = GetTransformData();
+		std::vector<Quaternion> results(MATH_BENCHMARK_COUNT);
+		state.SetItemsPerIteration(MATH_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MATH_BENCHMARK_COUNT; j++)
+				results[j] = Quaternion::Euler(data.m_rotations[j].GetEuler());
+
+			DoNotOptimize(results[0]);
+		}
+	}
+}
@@ -0,0 +1,257 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: MemoryBenchmarks
+
+Transient per frame containers, heap allocated against the frame arena. Engine-like allocation
+traces on the system allocator against the TLSF heap & object pools.
+
+Timestamp: 11/4/2020 12:14:52 AM
+*/
+
+#include "Benchmark.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/TLSFAllocator.hpp"
+#include "Core/PoolAllocator.hpp"
+#include "Utility/Math/Matrix.hpp"
+#include <random>
+#include <cstdlib>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+
+	#define MEMORY_BENCHMARK_COUNT 1024
+	#define MEMORY_TRACE_LENGTH 16384
+	#define MEMORY_TRACE_LIVE_LIMIT 2048
+
+	// Mostly small blocks like strings & components, some vertex & index data, rarely pixel buffers.
+	// Negative entries free the allocation at that slot.
+	struct AllocationTrace
+	{
+		AllocationTrace()
+		{
+			std::mt19937 rng(3);
+			std::vector<int32> liveSlots;
+			int32 slotCount = 0;
+
+			for (uint32 i = 0; i < MEMORY_TRACE_LENGTH; i++)
+			{
+				const bool allocate = liveSlots.empty() || (liveSlots.size() < MEMORY_TRACE_LIVE_LIMIT && rng() % 100 < 55);
+
+				if (allocate)
+				{
+					const uint32 kind = rng() % 100;
+					size_t size = 0;
+
+					if (kind < 65)
+						size = 16 + rng() % 112;
+					else if (kind < 99)
+						size = 256 + rng() % 16384;
+					else
+						size = 65536 + rng() % (1024 * 1024);
+
+					m_sizes.push_back(size);
+					m_slots.push_back(slotCount);
+					liveSlots.push_back(slotCount++);
+				}
+				else
+				{
+					const size_t index = rng() % liveSlots.size();
+					m_sizes.push_back(0);
+					m_slots.push_back(-liveSlots[index] - 1);
+					liveSlots[index] = liveSlots.back();
+					liveSlots.pop_back();
+				}
+			}
+
+			m_remaining = liveSlots;
+			m_pointers.resize(slotCount);
+		}
+
+		template<typename AllocateFunc, typename FreeFunc>
+		void Replay(AllocateFunc allocate, FreeFunc free)
+		{
+			for (size_t i = 0; i < m_slots.size(); i++)
+			{
+				if (m_slots[i] >= 0)
+				{
+					void* ptr = allocate(m_sizes[i]);
+					*(uint8*)ptr = (uint8)i;
+					m_pointers[m_slots[i]] = ptr;
+				}
+				else
+					free(m_pointers[-m_slots[i] - 1]);
+			}
+
+			for (int32 slot : m_remaining)
+				free(m_pointers[slot]);
+		}
+
+		std::vector<size_t> m_sizes;
+		std::vector<int32> m_slots;
+		std::vector<int32> m_remaining;
+		std::vector<void*> m_pointers;
+	};
+
+	static AllocationTrace& GetAllocationTrace()
+	{
+		static AllocationTrace trace;
+		return trace;
+	}
+
+	// Stand-in for resource objects, close to the size of a texture.
+	struct TraceObject
+	{
+		uint8 m_data[192];
+	};
+
+	// A list gathered & thrown away every frame, like the transparent draw list.
+	LINA_BENCHMARK(Memory_TransientVector_Heap)
+	{
+		state.SetItemsPerIteration(MEMORY_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			std::vector<Matrix> list;
+
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+				list.push_back(Matrix());
+
+			DoNotOptimize(list[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Memory_TransientVector_FrameArena)
+	{
+		state.SetItemsPerIteration(MEMORY_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			FrameArena::BeginFrame();
+			FrameVector<Matrix> list;
+
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+				list.push_back(Matrix());
+
+			DoNotOptimize(list[0]);
+		}
+	}
+
+	LINA_BENCHMARK(Memory_SmallAllocations_Heap)
+	{
+		state.SetItemsPerIteration(MEMORY_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+			{
+				uint64* value = new uint64(j);
+				DoNotOptimize(*value);
+				delete value;
+			}
+		}
+	}
+
+	LINA_BENCHMARK(Memory_SmallAllocations_FrameArena)
+	{
+		state.SetItemsPerIteration(MEMORY_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			FrameArena::BeginFrame();
+
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+			{
+				uint64* value = FrameArena::AllocateArray<uint64>(1);
+				*value = j;
+				DoNotOptimize(*value);
+			}
+		}
+	}
+
+	LINA_BENCHMARK(Memory_EngineTrace_System)
+	{
+		AllocationTrace& trace = GetAllocationTrace();
+		state.SetItemsPerIteration(MEMORY_TRACE_LENGTH);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+			trace.Replay([](size_t size) { return std::malloc(size); }, [](void* ptr) { std::free(ptr); });
+	}
+
+	LINA_BENCHMARK(Memory_EngineTrace_TLSF)
+	{
+		AllocationTrace& trace = GetAllocationTrace();
+		TLSFAllocator heap;
+		state.SetItemsPerIteration(MEMORY_TRACE_LENGTH);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+			trace.Replay([&heap](size_t size) { return heap.Allocate(size); }, [&heap](void* ptr) { heap.Free(ptr); });
+	}
+
+	LINA_BENCHMARK(Memory_ObjectChurn_System)
+	{
+		std::vector<TraceObject*> objects(MEMORY_BENCHMARK_COUNT);
+		state.SetItemsPerIteration(MEMORY_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+				objects[j] = new TraceObject();
+
+			// Released out of order like streamed resources.
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+				delete objects[(j * 7) % MEMORY_BENCHMARK_COUNT];
+		}
+	}
+
+	LINA_BENCHMARK(Memory_ObjectChurn_Pool)
+	{
+		ObjectPool<TraceObject> pool;
+		std::vector<TraceObject*> objects(MEMORY_BENCHMARK_COUNT);
+		state.SetItemsPerIteration(MEMORY_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+				objects[j] = pool.Create();
+
+			for (uint32 j = 0; j < MEMORY_BENCHMARK_COUNT; j++)
+				pool.Destroy(objects[(j * 7) % MEMORY_BENCHMARK_COUNT]);
+		}
+	}
+}
\ No newline at end of file
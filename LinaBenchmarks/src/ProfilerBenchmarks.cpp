@@ -0,0 +1,111 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: ProfilerBenchmarks
+
+Cost of entering & leaving profiler zones, including their collection at the frame marker, against
+the string keyed timer lookups they replaced.
+
+Timestamp: 11/4/2020 3:40:12 PM
+*/
+
+#include "Benchmark.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Timer.hpp"
+#include <map>
+#include <string>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+
+	#define PROFILER_BENCHMARK_ZONES 1024
+
+	static const ProfilerZone s_outerZone("Benchmark Outer", __FILE__, __LINE__);
+	static const ProfilerZone s_innerZone("Benchmark Inner", __FILE__, __LINE__);
+
+	// Zones are used directly so they're measured even when the profiling macros are compiled out.
+	LINA_BENCHMARK(Profiler_Zone)
+	{
+		state.SetItemsPerIteration(PROFILER_BENCHMARK_ZONES);
+		Profiler::MarkFrame();
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < PROFILER_BENCHMARK_ZONES; j++)
+			{
+				ProfileScope scope(s_innerZone);
+				DoNotOptimize(j);
+			}
+
+			Profiler::MarkFrame();
+		}
+	}
+
+	LINA_BENCHMARK(Profiler_NestedZones)
+	{
+		state.SetItemsPerIteration(PROFILER_BENCHMARK_ZONES);
+		Profiler::MarkFrame();
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < PROFILER_BENCHMARK_ZONES / 2; j++)
+			{
+				ProfileScope outer(s_outerZone);
+				ProfileScope inner(s_innerZone);
+				DoNotOptimize(j);
+			}
+
+			Profiler::MarkFrame();
+		}
+	}
+
+	// Looks the timer up by a temporary string on start & stop, like the old LINA_TIMER_START/STOP.
+	LINA_BENCHMARK(Profiler_TimerMap)
+	{
+		std::map<std::string, Timer*> timers;
+		timers["Benchmark Inner"] = new Timer();
+		state.SetItemsPerIteration(PROFILER_BENCHMARK_ZONES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32 j = 0; j < PROFILER_BENCHMARK_ZONES; j++)
+			{
+				timers[std::string("Benchmark Inner")]->Start();
+				DoNotOptimize(j);
+				timers[std::string("Benchmark Inner")]->Stop();
+			}
+		}
+
+		delete timers["Benchmark Inner"];
+	}
+}
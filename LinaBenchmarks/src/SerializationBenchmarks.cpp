@@ -0,0 +1,124 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: SerializationBenchmarks
+
+Saving & loading the registry snapshot of a level with 10k entities through cereal's binary archive,
+in memory so the disk isn't measured.
+
+Timestamp: 11/4/2020 5:41:52 PM
+*/
+
+#include "Benchmark.hpp"
+#include "World/LevelSnapshot.hpp"
+#include <cereal/archives/binary.hpp>
+#include <sstream>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+	using namespace LinaEngine::ECS;
+
+	#define SERIALIZATION_BENCHMARK_COUNT 10000
+
+	static void FillLevel(ECSRegistry& registry)
+	{
+		for (uint32 i = 0; i < SERIALIZATION_BENCHMARK_COUNT; i++)
+		{
+			ECSEntity entity = registry.CreateEntity("Entity_" + std::to_string(i));
+			registry.emplace<TransformComponent>(entity).transform.m_location = Vector3((float)i, 0.0f, (float)(i % 100));
+
+			if (i % 4 != 0)
+			{
+				MeshRendererComponent& renderer = registry.emplace<MeshRendererComponent>(entity);
+				renderer.m_meshID = (int)(i % 32);
+				renderer.m_materialID = (int)(i % 8);
+				renderer.m_meshPath = "resources/meshes/mesh_" + std::to_string(i % 32) + ".fbx";
+				renderer.m_materialPath = "resources/materials/material_" + std::to_string(i % 8) + ".mat";
+			}
+
+			if (i % 8 == 0)
+				registry.emplace<RigidbodyComponent>(entity).m_mass = 1.0f;
+
+			if (i % 64 == 0)
+				registry.emplace<PointLightComponent>(entity);
+		}
+	}
+
+	LINA_BENCHMARK(Level_SaveSnapshot)
+	{
+		ECSRegistry registry;
+		FillLevel(registry);
+		state.SetItemsPerIteration(SERIALIZATION_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			std::stringstream stream;
+			{
+				cereal::BinaryOutputArchive archive(stream);
+				World::SaveRegistrySnapshot(registry, archive);
+			}
+
+			DoNotOptimize(stream.tellp());
+		}
+	}
+
+	LINA_BENCHMARK(Level_LoadSnapshot)
+	{
+		std::string snapshot;
+		{
+			ECSRegistry registry;
+			FillLevel(registry);
+			std::stringstream stream;
+			{
+				cereal::BinaryOutputArchive archive(stream);
+				World::SaveRegistrySnapshot(registry, archive);
+			}
+
+			snapshot = stream.str();
+		}
+
+		ECSRegistry registry;
+		state.SetItemsPerIteration(SERIALIZATION_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			registry.clear();
+			std::stringstream stream(snapshot);
+			{
+				cereal::BinaryInputArchive archive(stream);
+				World::LoadRegistrySnapshot(registry, archive);
+			}
+
+			DoNotOptimize(registry.size<TransformComponent>());
+		}
+	}
+}
@@ -0,0 +1,394 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: SpatialBenchmarks
+
+Dynamic AABB tree with 100k proxies & 10% of them moving every frame. Refit only & background rebuild
+frame costs, builds & queries against the linear scans they replace.
+
+Timestamp: 11/3/2020 7:58:12 PM
+*/
+
+#include "Benchmark.hpp"
+#include "Utility/DynamicAABBTree.hpp"
+#include "Core/JobSystem.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include <random>
+
+namespace LinaBenchmarks
+{
+	using namespace LinaEngine;
+
+	#define SPATIAL_BENCHMARK_COUNT 100000
+	#define SPATIAL_BENCHMARK_MOVING 10000
+	#define SPATIAL_BENCHMARK_QUERIES 1000
+
+	// Objects spread over a 1km x 100m x 1km area, a tenth of them moving each frame in turns.
+	struct SpatialScene
+	{
+		SpatialScene()
+		{
+			std::mt19937 rng(3);
+			std::uniform_real_distribution<float> horizontal(-500.0f, 500.0f);
+			std::uniform_real_distribution<float> vertical(0.0f, 100.0f);
+			std::uniform_real_distribution<float> size(0.25f, 2.0f);
+			std::uniform_real_distribution<float> velocity(-0.3f, 0.3f);
+
+			m_boxes.resize(SPATIAL_BENCHMARK_COUNT);
+			m_velocities.resize(SPATIAL_BENCHMARK_COUNT);
+
+			for (uint32 i = 0; i < SPATIAL_BENCHMARK_COUNT; i++)
+			{
+				const Vector3 center = Vector3(horizontal(rng), vertical(rng), horizontal(rng));
+				m_boxes[i] = AABB::FromCenterExtents(center, Vector3(size(rng), size(rng), size(rng)));
+				m_velocities[i] = Vector3(velocity(rng), velocity(rng) * 0.25f, velocity(rng));
+			}
+
+			for (uint32 i = 0; i < SPATIAL_BENCHMARK_QUERIES; i++)
+			{
+				const Vector3 center = Vector3(horizontal(rng), vertical(rng), horizontal(rng));
+				m_queryBoxes.push_back(AABB::FromCenterExtents(center, Vector3(10.0f)));
+				m_rayOrigins.push_back(center);
+				m_rayDirections.push_back(glm::normalize(glm::vec3(velocity(rng), velocity(rng) * 0.25f, velocity(rng))));
+			}
+
+			const Matrix projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+			const Matrix view = glm::lookAt(glm::vec3(0.0f, 20.0f, 0.0f), glm::vec3(0.0f, 20.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+			m_frustum = Frustum::FromMatrix(projection * view);
+		}
+
+		// Advances the next tenth of the objects & moves their proxies.
+		void Step(DynamicAABBTree* tree, const std::vector<uint32>* proxies)
+		{
+			for (uint32 i = 0; i < SPATIAL_BENCHMARK_MOVING; i++)
+			{
+				const uint32 index = (m_nextMoving + i) % SPATIAL_BENCHMARK_COUNT;
+				AABB& box = m_boxes[index];
+				box = AABB(glm::vec3(box.m_min) + glm::vec3(m_velocities[index]), glm::vec3(box.m_max) + glm::vec3(m_velocities[index]));
+
+				if (tree != nullptr)
+					tree->MoveProxy((*proxies)[index], box);
+			}
+
+			m_nextMoving = (m_nextMoving + SPATIAL_BENCHMARK_MOVING) % SPATIAL_BENCHMARK_COUNT;
+		}
+
+		void Populate(DynamicAABBTree& tree, std::vector<uint32>& proxies)
+		{
+			proxies.resize(SPATIAL_BENCHMARK_COUNT);
+			for (uint32 i = 0; i < SPATIAL_BENCHMARK_COUNT; i++)
+				proxies[i] = tree.CreateProxy(m_boxes[i], i);
+		}
+
+		std::vector<AABB> m_boxes;
+		std::vector<Vector3> m_velocities;
+		std::vector<AABB> m_queryBoxes;
+		std::vector<Vector3> m_rayOrigins;
+		std::vector<Vector3> m_rayDirections;
+		Frustum m_frustum;
+		uint32 m_nextMoving = 0;
+	};
+
+	static SpatialScene& GetScene()
+	{
+		static SpatialScene scene;
+		return scene;
+	}
+
+	// Built with SAH once, shared by the query benchmarks.
+	static DynamicAABBTree& GetQueryTree()
+	{
+		static DynamicAABBTree tree;
+		static std::vector<uint32> proxies;
+
+		if (tree.GetProxyCount() == 0)
+		{
+			GetScene().Populate(tree, proxies);
+			tree.Rebuild();
+		}
+
+		return tree;
+	}
+
+	static JobSystem& GetJobSystem()
+	{
+		static JobSystem jobSystem;
+
+		if (!jobSystem.GetIsInitialized())
+		{
+			JobSystemOptions options;
+			options.m_workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+			jobSystem.Initialize(options);
+		}
+
+		return jobSystem;
+	}
+
+	LINA_BENCHMARK(Spatial_Build_Insert100k)
+	{
+		SpatialScene& scene = GetScene();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_COUNT);
+		std::vector<uint32> proxies;
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			DynamicAABBTree tree;
+			scene.Populate(tree, proxies);
+			DoNotOptimize(tree.GetHeight());
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_Build_SAH100k)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree tree;
+		std::vector<uint32> proxies;
+		scene.Populate(tree, proxies);
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			tree.Rebuild();
+			DoNotOptimize(tree.GetHeight());
+		}
+	}
+
+	// Moving objects only refit their ancestors, the tree is never rebuilt.
+	LINA_BENCHMARK(Spatial_Frame_10PercentMoving_RefitOnly)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree tree;
+		std::vector<uint32> proxies;
+		scene.Populate(tree, proxies);
+		tree.Rebuild();
+		tree.SetRebuildThreshold(1e9f);
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_MOVING);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			scene.Step(&tree, &proxies);
+			tree.Update();
+		}
+	}
+
+	// Same frame with the quality driven rebuilds running on a worker.
+	LINA_BENCHMARK(Spatial_Frame_10PercentMoving_BackgroundRebuild)
+	{
+		SpatialScene& scene = GetScene();
+		JobSystem& jobSystem = GetJobSystem();
+		DynamicAABBTree tree;
+		std::vector<uint32> proxies;
+		scene.Populate(tree, proxies);
+		tree.Rebuild();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_MOVING);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			scene.Step(&tree, &proxies);
+			tree.Update(&jobSystem);
+		}
+	}
+
+	// Frustum culling on a tree that has been refit for 300 frames without a rebuild.
+	LINA_BENCHMARK(Spatial_QueryFrustum_Degraded)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree tree;
+		std::vector<uint32> proxies;
+		scene.Populate(tree, proxies);
+		tree.Rebuild();
+		tree.SetRebuildThreshold(1e9f);
+
+		for (uint32 i = 0; i < 300; i++)
+			scene.Step(&tree, &proxies);
+
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			uint32 visible = 0;
+			tree.QueryFrustum(scene.m_frustum, [&visible](uint32 data) { visible++; return true; });
+			DoNotOptimize(visible);
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_QueryFrustum_Tree)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree& tree = GetQueryTree();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_COUNT);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			uint32 visible = 0;
+			tree.QueryFrustum(scene.m_frustum, [&visible](uint32 data) { visible++; return true; });
+			DoNotOptimize(visible);
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_QueryFrustum_Linear)
+	{
+		SpatialScene& scene = GetScene();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_COUNT);
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			uint32 visible = 0;
+			for (uint32 j = 0; j < SPATIAL_BENCHMARK_COUNT; j++)
+			{
+				if (scene.m_frustum.Test(scene.m_boxes[j]) != FrustumResult::Outside)
+					visible++;
+			}
+
+			DoNotOptimize(visible);
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_QueryAABB_Tree)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree& tree = GetQueryTree();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_QUERIES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			uint32 found = 0;
+			for (const AABB& query : scene.m_queryBoxes)
+				tree.QueryAABB(query, [&found](uint32 data) { found++; return true; });
+
+			DoNotOptimize(found);
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_QueryAABB_Linear)
+	{
+		SpatialScene& scene = GetScene();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_QUERIES);
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			uint32 found = 0;
+			for (const AABB& query : scene.m_queryBoxes)
+			{
+				for (uint32 j = 0; j < SPATIAL_BENCHMARK_COUNT; j++)
+				{
+					if (query.Overlaps(scene.m_boxes[j]))
+						found++;
+				}
+			}
+
+			DoNotOptimize(found);
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_QuerySphere_Tree)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree& tree = GetQueryTree();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_QUERIES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			uint32 found = 0;
+			for (const Vector3& center : scene.m_rayOrigins)
+				tree.QuerySphere(center, 10.0f, [&found](uint32 data) { found++; return true; });
+
+			DoNotOptimize(found);
+		}
+	}
+
+	// Closest hit against the boxes themselves, the tree only narrows down the candidates.
+	LINA_BENCHMARK(Spatial_RayCast_Tree)
+	{
+		SpatialScene& scene = GetScene();
+		DynamicAABBTree& tree = GetQueryTree();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_QUERIES);
+		state.ResetTimer();
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			float total = 0.0f;
+
+			for (uint32 j = 0; j < SPATIAL_BENCHMARK_QUERIES; j++)
+			{
+				const Vector3& origin = scene.m_rayOrigins[j];
+				const Vector3 inverseDirection = glm::vec3(1.0f) / glm::vec3(scene.m_rayDirections[j]);
+				float closest = 500.0f;
+
+				tree.RayCast(origin, scene.m_rayDirections[j], closest, [&](uint32 data, float entry)
+					{
+						float distance = 0.0f;
+						if (scene.m_boxes[data].IntersectsRay(origin, inverseDirection, closest, distance))
+							closest = distance;
+
+						return closest;
+					});
+
+				total += closest;
+			}
+
+			DoNotOptimize(total);
+		}
+	}
+
+	LINA_BENCHMARK(Spatial_RayCast_Linear)
+	{
+		SpatialScene& scene = GetScene();
+		state.SetItemsPerIteration(SPATIAL_BENCHMARK_QUERIES);
+
+		for (uint64 i = 0; i < state.GetIterations(); i++)
+		{
+			float total = 0.0f;
+
+			for (uint32 j = 0; j < SPATIAL_BENCHMARK_QUERIES; j++)
+			{
+				const Vector3& origin = scene.m_rayOrigins[j];
+				const Vector3 inverseDirection = glm::vec3(1.0f) / glm::vec3(scene.m_rayDirections[j]);
+				float closest = 500.0f;
+
+				for (uint32 k = 0; k < SPATIAL_BENCHMARK_COUNT; k++)
+				{
+					float distance = 0.0f;
+					if (scene.m_boxes[k].IntersectsRay(origin, inverseDirection, closest, distance))
+						closest = distance;
+				}
+
+				total += closest;
+			}
+
+			DoNotOptimize(total);
+		}
+	}
+}
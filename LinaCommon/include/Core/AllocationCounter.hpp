@@ -0,0 +1,88 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: AllocationCounter
+
+Counts the global heap allocations by replacing operator new & delete, the main loop
+marks the frame boundaries so the allocations of the last frame can be inspected. Counting
+is compiled out unless LINA_ENABLE_ALLOCATIONCOUNTING is defined.
+
+Timestamp: 11/3/2020 11:58:03 PM
+*/
+
+#pragma once
+
+#ifndef AllocationCounter_HPP
+#define AllocationCounter_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace LinaEngine
+{
+	class AllocationCounter
+	{
+	public:
+
+		// Closes the previous frame's count.
+		static void BeginFrame();
+
+		static void RecordAllocation(size_t size)
+		{
+			s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+			s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+
+		static uint64 GetFrameAllocationCount() { return s_frameAllocationCount.load(std::memory_order_relaxed); }
+		static uint64 GetFrameAllocatedBytes() { return s_frameAllocatedBytes.load(std::memory_order_relaxed); }
+		static uint64 GetTotalAllocationCount() { return s_allocationCount.load(std::memory_order_relaxed); }
+		static uint64 GetTotalAllocatedBytes() { return s_allocatedBytes.load(std::memory_order_relaxed); }
+
+		static bool GetIsEnabled()
+		{
+#ifdef LINA_ENABLE_ALLOCATIONCOUNTING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+	private:
+
+		static std::atomic<uint64> s_allocationCount;
+		static std::atomic<uint64> s_allocatedBytes;
+		static std::atomic<uint64> s_frameStartCount;
+		static std::atomic<uint64> s_frameStartBytes;
+		static std::atomic<uint64> s_frameAllocationCount;
+		static std::atomic<uint64> s_frameAllocatedBytes;
+	};
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: FrameArena
+
+Per-thread linear allocator for transient data. Every thread owns two buffers which are swapped
+each frame, an allocation stays valid until the end of the frame after the one it was made in so
+data gathered during the update can still be read while rendering. Nothing is freed individually,
+a buffer is reset as a whole when it comes around again & grows to the high water mark if it had to
+overflow into the heap.
+
+Timestamp: 11/3/2020 11:42:18 PM
+*/
+
+#pragma once
+
+#ifndef FrameArena_HPP
+#define FrameArena_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#define FRAMEARENA_INITIAL_SIZE (256 * 1024)
+
+namespace LinaEngine
+{
+	class FrameArena
+	{
+	public:
+
+		// Called once per frame by the main loop before anything is allocated.
+		static void BeginFrame();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		static T* AllocateArray(size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		static uint64 GetFrameIndex() { return s_frameIndex.load(std::memory_order_acquire); }
+
+		// Bytes the calling thread used in the current frame, including the overflow.
+		static size_t GetUsedBytes();
+
+		// Bytes reserved by the calling thread's buffers.
+		static size_t GetCapacity();
+
+	private:
+
+		static std::atomic<uint64> s_frameIndex;
+	};
+
+	// Stl adapter, deallocation is a no-op so containers using it must not outlive the next frame.
+	template<typename T>
+	class FrameAllocator
+	{
+	public:
+
+		typedef T value_type;
+
+		FrameAllocator() noexcept {};
+
+		template<typename U>
+		FrameAllocator(const FrameAllocator<U>&) noexcept {};
+
+		T* allocate(size_t count) { return FrameArena::AllocateArray<T>(count); }
+		void deallocate(T*, size_t) noexcept {};
+	};
+
+	template<typename T, typename U>
+	bool operator==(const FrameAllocator<T>&, const FrameAllocator<U>&) { return true; }
+
+	template<typename T, typename U>
+	bool operator!=(const FrameAllocator<T>&, const FrameAllocator<U>&) { return false; }
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: JobSystem
+
+Work stealing job system. Every thread has its own deque, owners push & pop from the back
+while idle threads steal from the front of the others. Jobs can be grouped with counters,
+chained after other counters & waited on, waiting threads run jobs instead of blocking.
+
+Timestamp: 11/2/2020 10:12:37 AM
+*/
+
+#pragma once
+
+#ifndef JobSystem_HPP
+#define JobSystem_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include "Core/Common.hpp"
+#include "PackageManager/Generic/GenericMemory.hpp"
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <condition_variable>
+
+namespace LinaEngine
+{
+	class JobCounter;
+
+	struct Job
+	{
+		std::function<void()> m_task;
+		JobCounter* m_counter = nullptr;
+
+		// Memory scope of the scheduling thread, the job's allocations are tracked under it.
+		MemorySubsystem m_memorySubsystem = MemorySubsystem::General;
+	};
+
+	// Counts the unfinished jobs of a group, jobs can be chained to run once it reaches zero.
+	class JobCounter
+	{
+	public:
+
+		JobCounter() {};
+
+		// Also waits for the last job to stop touching the counter, so it's safe to destroy once done.
+		bool IsDone() const { return m_value.load() == 0 && m_finishingJobs.load() == 0; }
+		int32 GetValue() const { return m_value.load(); }
+
+	private:
+
+		friend class JobSystem;
+		std::atomic<int32> m_value{ 0 };
+		std::atomic<int32> m_finishingJobs{ 0 };
+		std::mutex m_mutex;
+		std::vector<Job> m_waitingJobs;
+
+		DISALLOW_COPY_ASSIGN_MOVE(JobCounter)
+	};
+
+	struct JobSystemOptions
+	{
+		// 0 uses hardware concurrency - 1, the thread calling Initialize participates as well.
+		uint32 m_workerCount = 0;
+
+		// Pins worker i to core i + 1, leaving core 0 for the main thread.
+		bool m_pinThreads = false;
+
+		// Workers are named as prefix + index for debuggers & profilers.
+		std::string m_threadNamePrefix = "Lina Worker ";
+	};
+
+	class JobSystem
+	{
+	public:
+
+		JobSystem() {};
+		~JobSystem();
+
+		// Spawns the workers, the calling thread becomes thread 0.
+		void Initialize(const JobSystemOptions& options = JobSystemOptions());
+
+		// Finishes the queued jobs & joins all workers.
+		void Shutdown();
+
+		// Queues a job, counter is incremented now & decremented once the job is finished.
+		void Run(const std::function<void()>& task, JobCounter* counter = nullptr);
+
+		// Queues a job that starts once the dependency reaches zero.
+		void RunAfter(JobCounter& dependency, const std::function<void()>& task, JobCounter* counter = nullptr);
+
+		// Runs queued jobs on the calling thread until the counter reaches zero.
+		void Wait(JobCounter& counter);
+
+		// Splits [0, count) into ranges of grainSize & blocks until all are processed. 0 picks a grain size
+		// that gives each thread a few ranges to balance uneven work.
+		void ParallelFor(uint32 count, uint32 grainSize, const std::function<void(uint32 begin, uint32 end)>& func);
+
+		// Number of background workers, excluding the main thread.
+		uint32 GetWorkerCount() const { return (uint32)m_workers.size(); }
+		uint32 GetThreadCount() const { return (uint32)m_queues.size(); }
+		bool GetIsInitialized() const { return !m_queues.empty(); }
+
+		// Index of the calling thread in the system, -1 if it doesn't belong to one.
+		static int32 GetCurrentThreadIndex();
+
+		static void SetCurrentThreadName(const std::string& name);
+		static bool SetCurrentThreadAffinity(uint32 core);
+
+	private:
+
+		struct WorkerQueue
+		{
+			std::mutex m_mutex;
+			std::deque<Job> m_jobs;
+		};
+
+		void WorkerLoop(uint32 index);
+		void Push(Job&& job);
+		bool TryRunJob(uint32 index);
+		bool PopOrSteal(uint32 index, Job& job);
+		void FinishJob(Job& job);
+		uint32 GetQueueIndex() const;
+
+	private:
+
+		JobSystemOptions m_options;
+		std::vector<std::thread> m_workers;
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+		std::atomic<int32> m_queuedJobs{ 0 };
+		std::atomic<int32> m_sleepingWorkers{ 0 };
+		std::atomic<bool> m_stopping{ false };
+
+		DISALLOW_COPY_ASSIGN_MOVE(JobSystem)
+	};
+}
+
+#endif
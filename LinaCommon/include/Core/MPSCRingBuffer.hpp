@@ -0,0 +1,146 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: MPSCRingBuffer
+
+Bounded lock-free queue for many producers & a single consumer. Every cell carries a sequence
+number, producers claim a position with a CAS & publish the cell by advancing its sequence, so
+they never wait on each other or on the consumer. Pushing fails instead of blocking when full.
+
+Timestamp: 11/5/2020 11:02:17 AM
+*/
+
+#pragma once
+
+#ifndef MPSCRingBuffer_HPP
+#define MPSCRingBuffer_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include "Core/Common.hpp"
+#include <atomic>
+#include <memory>
+
+#define MPSC_CACHE_LINE_SIZE 64
+
+namespace LinaEngine
+{
+	template<typename T>
+	class MPSCRingBuffer
+	{
+	public:
+
+		MPSCRingBuffer() {};
+		~MPSCRingBuffer() {};
+
+		// Capacity is rounded up to a power of two. Not thread safe, has to be called before producers start.
+		void Initialize(uint32 capacity)
+		{
+			uint32 size = 1;
+			while (size < capacity)
+				size <<= 1;
+
+			m_cells.reset(new Cell[size]);
+			m_mask = size - 1;
+
+			for (uint32 i = 0; i < size; i++)
+				m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+
+			m_pushPosition.store(0, std::memory_order_relaxed);
+			m_popPosition.store(0, std::memory_order_release);
+		}
+
+		// Claims a cell & calls write on it, the value is visible to the consumer once write returns.
+		template<typename F>
+		bool TryPush(F&& write)
+		{
+			uint64 position = m_pushPosition.load(std::memory_order_relaxed);
+			Cell* cell = nullptr;
+
+			while (true)
+			{
+				cell = &m_cells[position & m_mask];
+				const int64 difference = (int64)cell->m_sequence.load(std::memory_order_acquire) - (int64)position;
+
+				if (difference == 0)
+				{
+					if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+					return false;
+				else
+					position = m_pushPosition.load(std::memory_order_relaxed);
+			}
+
+			write(cell->m_value);
+			cell->m_sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer only. Calls read on the oldest published value, the cell is reused once read returns.
+		template<typename F>
+		bool TryPop(F&& read)
+		{
+			const uint64 position = m_popPosition.load(std::memory_order_relaxed);
+			Cell& cell = m_cells[position & m_mask];
+
+			if (cell.m_sequence.load(std::memory_order_acquire) != position + 1)
+				return false;
+
+			read(const_cast<const T&>(cell.m_value));
+			cell.m_sequence.store(position + m_mask + 1, std::memory_order_release);
+			m_popPosition.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Claimed & consumed counts since Initialize, claimed cells might not be published yet.
+		uint64 GetPushCount() const { return m_pushPosition.load(std::memory_order_acquire); }
+		uint64 GetPopCount() const { return m_popPosition.load(std::memory_order_acquire); }
+		uint32 GetCapacity() const { return m_cells ? m_mask + 1 : 0; }
+
+	private:
+
+		struct Cell
+		{
+			std::atomic<uint64> m_sequence{ 0 };
+			T m_value;
+		};
+
+		std::unique_ptr<Cell[]> m_cells;
+		uint32 m_mask = 0;
+
+		// Kept on separate cache lines, producers & the consumer would invalidate each other otherwise.
+		alignas(MPSC_CACHE_LINE_SIZE) std::atomic<uint64> m_pushPosition{ 0 };
+		alignas(MPSC_CACHE_LINE_SIZE) std::atomic<uint64> m_popPosition{ 0 };
+
+		DISALLOW_COPY_ASSIGN_MOVE(MPSCRingBuffer)
+	};
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: MemoryTracker
+
+Tracks live heap memory by subsystem. Allocations made through GenericMemory, the engine pools & the
+global operator new carry a record which links them into a per subsystem list, global new uses the
+subsystem of the innermost LINA_MEMORY_SCOPE on the calling thread. Live & peak bytes, allocation
+rates, snapshots & leak reports are built from those. Everything is compiled out unless
+LINA_ENABLE_MEMORYTRACKING is defined, the queries then return empty results.
+
+Timestamp: 11/4/2020 2:21:09 PM
+*/
+
+#pragma once
+
+#ifndef MemoryTracker_HPP
+#define MemoryTracker_HPP
+
+#include "PackageManager/Generic/GenericMemory.hpp"
+#include <cstddef>
+
+#define MEMORYTRACKER_RECORD_SIZE 64
+#define MEMORYTRACKER_CONCAT_IMPL(A, B) A##B
+#define MEMORYTRACKER_CONCAT(A, B) MEMORYTRACKER_CONCAT_IMPL(A, B)
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+#define LINA_MEMORY_SCOPE(SUBSYSTEM) ::LinaEngine::MemoryScope MEMORYTRACKER_CONCAT(memoryScope, __LINE__)(::LinaEngine::MemorySubsystem::SUBSYSTEM)
+#else
+#define LINA_MEMORY_SCOPE(SUBSYSTEM)
+#endif
+
+// Memory::malloc with the call site recorded for the leak reports.
+#define LINA_MALLOC(SIZE, SUBSYSTEM) ::LinaEngine::GenericMemory::malloc(SIZE, ::LinaEngine::GenericMemory::DefaultAlignment, ::LinaEngine::MemorySubsystem::SUBSYSTEM, __FILE__, __LINE__)
+
+namespace LinaEngine
+{
+	struct MemorySubsystemStats
+	{
+		uint64 m_liveBytes = 0;
+		uint64 m_liveAllocations = 0;
+		uint64 m_peakBytes = 0;
+		uint64 m_totalAllocations = 0;
+		uint64 m_totalBytes = 0;
+
+		// Allocation rate over the last frame.
+		uint64 m_frameAllocations = 0;
+		uint64 m_frameBytes = 0;
+	};
+
+	struct MemorySnapshot
+	{
+		// Allocations made after the snapshot have larger ids.
+		uint64 m_allocationID = 0;
+		MemorySubsystemStats m_subsystems[(size_t)MemorySubsystem::Count];
+	};
+
+	struct MemorySnapshotDiff
+	{
+		int64 m_liveBytes[(size_t)MemorySubsystem::Count] = {};
+		int64 m_liveAllocations[(size_t)MemorySubsystem::Count] = {};
+		uint64 m_allocations[(size_t)MemorySubsystem::Count] = {};
+		uint64 m_allocatedBytes[(size_t)MemorySubsystem::Count] = {};
+	};
+
+	class MemoryTracker
+	{
+	public:
+
+		static bool GetIsEnabled()
+		{
+#ifdef LINA_ENABLE_MEMORYTRACKING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		// Closes the allocation rate counters of the previous frame.
+		static void BeginFrame();
+
+		static MemorySubsystemStats GetStats(MemorySubsystem subsystem);
+
+		static MemorySnapshot TakeSnapshot();
+		static MemorySnapshotDiff Diff(const MemorySnapshot& from, const MemorySnapshot& to);
+
+		// Logs the allocations made after the snapshot that are still alive, grouped by subsystem & call site.
+		static void ReportAllocationsSince(const MemorySnapshot& snapshot, const char* title);
+
+		// Logs every tracked allocation that's still alive.
+		static void ReportLeaks();
+
+		static MemorySubsystem GetCurrentSubsystem();
+		static void SetCurrentSubsystem(MemorySubsystem subsystem);
+
+		// Used by the allocators, record points to MEMORYTRACKER_RECORD_SIZE bytes they reserve in the block.
+		static void OnAllocate(void* record, void* base, size_t size, MemorySubsystem subsystem, const char* file, int line);
+		static void OnFree(void* record);
+
+		// Start of the block the record was placed in.
+		static void* GetBase(void* record);
+	};
+
+	class MemoryScope
+	{
+	public:
+
+		MemoryScope(MemorySubsystem subsystem) : m_previous(MemoryTracker::GetCurrentSubsystem()) { MemoryTracker::SetCurrentSubsystem(subsystem); };
+		~MemoryScope() { MemoryTracker::SetCurrentSubsystem(m_previous); };
+
+	private:
+
+		MemorySubsystem m_previous;
+	};
+}
+
+#endif
@@ -0,0 +1,180 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: PoolAllocator
+
+Fixed size block allocator. Blocks are carved out of chunks & handed out from an intrusive free list,
+chunks are only returned to the system when the pool is destroyed. Not thread safe, LINA_POOLED_CLASS
+routes a class' new & delete through a shared, locked pool instead.
+
+Timestamp: 11/4/2020 1:37:45 AM
+*/
+
+#pragma once
+
+#ifndef PoolAllocator_HPP
+#define PoolAllocator_HPP
+
+#include "PackageManager/Generic/GenericMemory.hpp"
+#include <vector>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#define POOLALLOCATOR_DEFAULT_CHUNK_BLOCKS 64
+
+namespace LinaEngine
+{
+	class PoolAllocator
+	{
+	public:
+
+		PoolAllocator(size_t blockSize, size_t blocksPerChunk = POOLALLOCATOR_DEFAULT_CHUNK_BLOCKS, size_t alignment = GenericMemory::DefaultAlignment, MemorySubsystem subsystem = MemorySubsystem::General);
+		~PoolAllocator();
+
+		void* Allocate();
+		void Free(void* ptr);
+
+		size_t GetBlockSize() const { return m_blockSize; }
+		AllocatorStats GetStats() const;
+
+	private:
+
+		struct FreeBlock
+		{
+			FreeBlock* m_next;
+		};
+
+		void AddChunk();
+
+	private:
+
+		size_t m_blockSize = 0;
+		size_t m_blocksPerChunk = 0;
+		size_t m_alignment = 0;
+		MemorySubsystem m_subsystem = MemorySubsystem::General;
+		FreeBlock* m_freeList = nullptr;
+		std::vector<void*> m_chunks;
+		AllocatorStats m_stats;
+
+		DISALLOW_COPY_ASSIGN_MOVE(PoolAllocator)
+	};
+
+	template<typename T>
+	class ObjectPool
+	{
+	public:
+
+		ObjectPool(size_t objectsPerChunk = POOLALLOCATOR_DEFAULT_CHUNK_BLOCKS, MemorySubsystem subsystem = MemorySubsystem::General) : m_pool(sizeof(T), objectsPerChunk, alignof(T), subsystem) {};
+
+		template<typename... Args>
+		T* Create(Args&&... args)
+		{
+			return new (m_pool.Allocate()) T(std::forward<Args>(args)...);
+		}
+
+		void Destroy(T* object)
+		{
+			if (object == nullptr)
+				return;
+
+			object->~T();
+			m_pool.Free(object);
+		}
+
+		AllocatorStats GetStats() const { return m_pool.GetStats(); }
+
+	private:
+
+		PoolAllocator m_pool;
+	};
+
+	// Shared pool for the objects of a class, constructed on first use & never destroyed so objects
+	// released during static destruction are still fine. Derived classes fall back to the global heap.
+	template<typename T, MemorySubsystem Subsystem>
+	class SharedObjectPool
+	{
+	public:
+
+		static void* Allocate(size_t size)
+		{
+			if (size != sizeof(T))
+				return ::operator new(size);
+
+			std::lock_guard<std::mutex> lock(GetMutex());
+			return GetPool().Allocate();
+		}
+
+		static void Free(void* ptr, size_t size)
+		{
+			if (ptr == nullptr)
+				return;
+
+			if (size != sizeof(T))
+			{
+				::operator delete(ptr);
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(GetMutex());
+			GetPool().Free(ptr);
+		}
+
+		static AllocatorStats GetStats()
+		{
+			std::lock_guard<std::mutex> lock(GetMutex());
+			return GetPool().GetStats();
+		}
+
+	private:
+
+		static PoolAllocator& GetPool()
+		{
+			alignas(PoolAllocator) static uint8 s_storage[sizeof(PoolAllocator)];
+			static PoolAllocator* s_pool = new (s_storage) PoolAllocator(sizeof(T), POOLALLOCATOR_DEFAULT_CHUNK_BLOCKS, alignof(T), Subsystem);
+			return *s_pool;
+		}
+
+		static std::mutex& GetMutex()
+		{
+			static std::mutex s_mutex;
+			return s_mutex;
+		}
+	};
+}
+
+// Pool chunks come from the subsystem's heap.
+#define LINA_POOLED_CLASS(CLASS, SUBSYSTEM) \
+	public: \
+	typedef ::LinaEngine::SharedObjectPool<CLASS, ::LinaEngine::MemorySubsystem::SUBSYSTEM> Pool; \
+	static void* operator new(size_t size) { return Pool::Allocate(size); } \
+	static void operator delete(void* ptr, size_t size) { Pool::Free(ptr, size); } \
+	static ::LinaEngine::AllocatorStats GetPoolStats() { return Pool::GetStats(); }
+
+#endif
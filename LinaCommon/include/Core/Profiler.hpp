@@ -0,0 +1,202 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: Profiler
+
+Hierarchical CPU profiler. LINA_PROFILE_SCOPE opens a zone for the rest of the scope through a static
+handle per call site, closed zones are written to a lock-free ring buffer owned by the thread. At every
+frame marker the buffers are drained & the zones of each thread are merged into a call tree with the
+frame's time & call count for every node. A capture keeps every zone & counter of the next frames and
+writes them as a Chrome trace, which chrome://tracing & Perfetto can open. Compiled out unless
+LINA_ENABLE_TIMEPROFILING is defined.
+
+Timestamp: 11/4/2020 3:02:47 PM
+*/
+
+#pragma once
+
+#ifndef Profiler_HPP
+#define Profiler_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <string>
+#include <vector>
+
+// Zones a thread can close between two frame markers before the oldest ones are dropped, power of two.
+#define PROFILER_THREAD_EVENT_COUNT 8192
+#define PROFILER_MAX_DEPTH 64
+#define PROFILER_AVERAGE_WEIGHT 0.05
+#define PROFILER_DEFAULT_CAPTURE_FRAMES 300
+#define PROFILER_DEFAULT_CAPTURE_PATH "profiler_capture.json"
+#define PROFILER_CONCAT_IMPL(A, B) A##B
+#define PROFILER_CONCAT(A, B) PROFILER_CONCAT_IMPL(A, B)
+
+#ifdef LINA_ENABLE_TIMEPROFILING
+
+#define LINA_PROFILE_SCOPE(NAME) \
+	static const ::LinaEngine::ProfilerZone PROFILER_CONCAT(profilerZone, __LINE__)(NAME, __FILE__, __LINE__); \
+	::LinaEngine::ProfileScope PROFILER_CONCAT(profileScope, __LINE__)(PROFILER_CONCAT(profilerZone, __LINE__))
+
+#define LINA_PROFILE_FUNCTION() LINA_PROFILE_SCOPE(__FUNCTION__)
+#define LINA_PROFILE_FRAME() ::LinaEngine::Profiler::MarkFrame()
+#define LINA_PROFILE_THREAD(NAME) ::LinaEngine::Profiler::SetThreadName(NAME)
+
+// Only recorded while capturing.
+#define LINA_PROFILE_COUNTER(NAME, VALUE) \
+	static const ::LinaEngine::ProfilerZone PROFILER_CONCAT(profilerCounter, __LINE__)(NAME, __FILE__, __LINE__); \
+	::LinaEngine::Profiler::RecordCounter(PROFILER_CONCAT(profilerCounter, __LINE__), (double)(VALUE))
+
+#else
+
+#define LINA_PROFILE_SCOPE(NAME)
+#define LINA_PROFILE_FUNCTION()
+#define LINA_PROFILE_FRAME()
+#define LINA_PROFILE_THREAD(NAME)
+#define LINA_PROFILE_COUNTER(NAME, VALUE)
+
+#endif
+
+namespace LinaEngine
+{
+	// Call site of a zone, constant initialized so entering a zone doesn't check a static guard.
+	struct ProfilerZone
+	{
+		constexpr ProfilerZone(const char* name, const char* file, int32 line) : m_name(name), m_file(file), m_line(line) {};
+
+		const char* m_name;
+		const char* m_file;
+		int32 m_line;
+	};
+
+	// Begin & end are in profiler ticks.
+	struct ProfilerEvent
+	{
+		const ProfilerZone* m_zone = nullptr;
+		int64 m_begin = 0;
+		int64 m_end = 0;
+		uint32 m_depth = 0;
+	};
+
+	// Node of a thread's call tree, the first node is the root & has no zone.
+	struct ProfilerNode
+	{
+		const ProfilerZone* m_zone = nullptr;
+		int32 m_parent = -1;
+		int32 m_firstChild = -1;
+		int32 m_nextSibling = -1;
+		uint32 m_depth = 0;
+
+		uint32 m_frameCalls = 0;
+		double m_frameMs = 0.0;
+		double m_averageMs = 0.0;
+	};
+
+	struct ProfilerThread
+	{
+		std::string m_name = "";
+		std::vector<ProfilerNode> m_nodes;
+
+		// Zones overwritten before they were collected.
+		uint64 m_droppedEvents = 0;
+	};
+
+	class Profiler
+	{
+	public:
+
+		// Time stamp counter where available, nanoseconds on a steady clock otherwise.
+		static int64 GetTicks();
+		static double TicksToMs(int64 ticks) { return (double)ticks * s_msPerTick; }
+
+		// Used by ProfileScope, returns the start time.
+		static int64 BeginZone();
+		static void EndZone(const ProfilerZone& zone, int64 begin);
+
+		// Collects the zones closed since the last marker, should be called out of any zone.
+		static void MarkFrame();
+
+		static void SetThreadName(const char* name);
+
+		static uint64 GetFrameIndex() { return s_frameIndex; }
+		static double GetFrameMs() { return s_frameMs; }
+
+		// Call trees of the threads that opened a zone, only valid on the thread marking the frames.
+		static const std::vector<ProfilerThread>& GetThreads() { return s_threads; }
+
+		// First node of a zone with the given name in any thread, null if it wasn't entered.
+		static const ProfilerNode* FindNode(const char* name);
+
+		// Records the frames between the next frame marker & the frame count'th one after it, then writes
+		// the trace to the path. Ending early writes the frames recorded so far.
+		static void BeginCapture(uint32 frameCount, const std::string& path);
+		static void EndCapture();
+		static bool GetIsCapturing();
+
+		static void RecordCounter(const ProfilerZone& counter, double value);
+
+		static bool GetIsEnabled()
+		{
+#ifdef LINA_ENABLE_TIMEPROFILING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+	private:
+
+		static void MergeEvents(ProfilerThread& thread, const std::vector<ProfilerEvent>& events);
+		static void CalibrateTicks();
+		static bool WriteCapture();
+
+	private:
+
+		static double s_msPerTick;
+		static uint64 s_frameIndex;
+		static int64 s_frameStart;
+		static double s_frameMs;
+		static std::vector<ProfilerThread> s_threads;
+		static std::vector<ProfilerEvent> s_collectedEvents;
+	};
+
+	class ProfileScope
+	{
+	public:
+
+		ProfileScope(const ProfilerZone& zone) : m_zone(zone), m_begin(Profiler::BeginZone()) {};
+		~ProfileScope() { Profiler::EndZone(m_zone, m_begin); };
+
+	private:
+
+		const ProfilerZone& m_zone;
+		int64 m_begin;
+	};
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: TLSFAllocator
+
+Two level segregated fit heap. Free blocks are kept in lists bucketed by a power of two & a linear
+subdivision of it, two bitmaps find the first non-empty bucket that fits a request so allocation &
+free are O(1). Neighbouring free blocks are merged immediately. Memory is reserved in pools, extra
+pools are returned to the system once they are entirely free. Not thread safe.
+
+Timestamp: 11/4/2020 1:03:27 AM
+*/
+
+#pragma once
+
+#ifndef TLSFAllocator_HPP
+#define TLSFAllocator_HPP
+
+#include "PackageManager/Generic/GenericMemory.hpp"
+#include <cstddef>
+
+#define TLSF_SL_INDEX_COUNT_LOG2 5
+#define TLSF_ALIGN_SIZE_LOG2 4
+#define TLSF_FL_INDEX_MAX 36
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_SL_INDEX_COUNT_LOG2 - TLSF_ALIGN_SIZE_LOG2 + 1)
+#define TLSF_DEFAULT_POOL_SIZE (4 * 1024 * 1024)
+
+namespace LinaEngine
+{
+	class TLSFAllocator
+	{
+	public:
+
+		TLSFAllocator(size_t poolSize = TLSF_DEFAULT_POOL_SIZE);
+		~TLSFAllocator();
+
+		// Alignment has to be a power of two, blocks are at least 16 byte aligned.
+		void* Allocate(size_t size, size_t alignment = ALIGN_SIZE);
+		void Free(void* ptr);
+
+		// Usable size of the block, may be larger than requested.
+		size_t GetAllocationSize(void* ptr) const;
+
+		// Walks the free lists to find the free bytes & the largest block.
+		AllocatorStats GetStats() const;
+
+		static const size_t ALIGN_SIZE = (size_t)1 << TLSF_ALIGN_SIZE_LOG2;
+
+	private:
+
+		struct Block;
+		struct Pool;
+
+		bool AddPool(size_t minimumSize);
+		void RemovePool(Pool* pool);
+		Block* LocateFree(size_t size);
+		void InsertFree(Block* block);
+		void RemoveFree(Block* block, uint32 fl, uint32 sl);
+		void RemoveFree(Block* block);
+		void SplitTrailing(Block* block, size_t size);
+
+	private:
+
+		size_t m_poolSize = 0;
+		Pool* m_pools = nullptr;
+		uint32 m_poolCount = 0;
+		uint32 m_emptyPoolCount = 0;
+		uint32 m_flBitmap = 0;
+		uint32 m_slBitmap[TLSF_FL_INDEX_COUNT] = {};
+		Block* m_blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT] = {};
+		AllocatorStats m_stats;
+
+		DISALLOW_COPY_ASSIGN_MOVE(TLSFAllocator)
+	};
+}
+
+#endif
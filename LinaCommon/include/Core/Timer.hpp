@@ -30,6 +30,7 @@ SOFTWARE.
 Class: Timer
 
 Simple timer class that can be used to record the execution time of a function, block, loop etc.
+Per frame timings of the engine are recorded with the profiler zones instead, see Profiler.
 
 Timestamp: 10/22/2020 11:04:40 PM
 */
@@ -40,21 +41,6 @@ Timestamp: 10/22/2020 11:04:40 PM
 #define Timer_HPP
 
 #include <chrono>
-#include <string>
-#include <map>
-
-#ifdef LINA_ENABLE_TIMEPROFILING
-
-#define LINA_TIMER_START(...) ::LinaEngine::Timer::GetTimer(__VA_ARGS__).Start()
-#define LINA_TIMER_STOP(...) ::LinaEngine::Timer::GetTimer(__VA_ARGS__).Stop()
-
-
-#else
-
-#define LINA_TIMER_START(...)
-#define LINA_TIMER_END(...)
-
-#endif
 
 namespace LinaEngine
 {
@@ -70,7 +56,7 @@ namespace LinaEngine
 		void Start()
 		{
 			m_active = true;
-			m_startTimePoint = std::chrono::high_resolution_clock::now();
+			m_startTimePoint = std::chrono::steady_clock::now();
 		}
 
 		void Stop();
@@ -80,17 +66,16 @@ namespace LinaEngine
 			return m_duration; 
 		}
 
-		static const std::map<std::string, Timer*>& GetTimerMap() { return s_activeTimers; }
-		static Timer& GetTimer(const std::string& name);
-		static void UnloadTimers();
+		bool GetIsActive()
+		{
+			return m_active;
+		}
 
 	private:
 
-		const char* m_name = "";;
 		std::chrono::time_point<std::chrono::steady_clock> m_startTimePoint;
 		bool m_active = false;
 		double m_duration = 0;
-		static std::map<std::string, Timer*> s_activeTimers;
 	};
 }
 
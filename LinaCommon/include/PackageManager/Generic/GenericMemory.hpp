@@ -29,7 +29,9 @@ SOFTWARE.
 /*
 Class: GenericMemory
 
-Memory manager wrapper.
+Memory manager wrapper. Every subsystem allocates from its own heap, which is either the system
+allocator or a TLSF heap, the heap an allocation came from is recorded in its header so it can be
+freed after the selection changes.
 
 Timestamp: 4/8/2019 9:04:58 PM
 
@@ -49,6 +51,35 @@ Timestamp: 4/8/2019 9:04:58 PM
 
 namespace LinaEngine
 {
+	enum class MemorySubsystem : uint8
+	{
+		General = 0,
+		Graphics,
+		Physics,
+		ECS,
+		Editor,
+		Count
+	};
+
+	enum class MemoryHeapType : uint8
+	{
+		System = 0,
+		TLSF
+	};
+
+	struct AllocatorStats
+	{
+		uint64 m_usedBytes = 0;
+		uint64 m_peakUsedBytes = 0;
+		uint64 m_reservedBytes = 0;
+		uint64 m_freeBytes = 0;
+		uint64 m_largestFreeBlock = 0;
+		uint64 m_liveAllocations = 0;
+		uint64 m_totalAllocations = 0;
+
+		// 0 when all the free memory is in one block, approaches 1 as it's split into small pieces.
+		float GetFragmentation() const { return m_freeBytes == 0 ? 0.0f : 1.0f - (float)m_largestFreeBlock / (float)m_freeBytes; }
+	};
 
 	struct GenericMemory
 	{
@@ -107,11 +138,20 @@ namespace LinaEngine
 			return (T)(((intptr)ptr + alignment - 1) & ~(alignment - 1));
 		}
 
-		static void* malloc(uintptr amt, uint32 alignment = DefaultAlignment);
-		static void* realloc(void* ptr, uintptr amt, uint32 alignment);
+		// File & line are reported by the memory tracker, see LINA_MALLOC.
+		static void* malloc(uintptr amt, uint32 alignment = DefaultAlignment, MemorySubsystem subsystem = MemorySubsystem::General, const char* file = nullptr, int line = 0);
+		static void* realloc(void* ptr, uintptr amt, uint32 alignment, MemorySubsystem subsystem = MemorySubsystem::General, const char* file = nullptr, int line = 0);
 		static void* free(void* ptr);
 		static uintptr getAllocSize(void* ptr);
 
+		// Only affects the allocations made afterwards.
+		static void setHeapType(MemorySubsystem subsystem, MemoryHeapType type);
+		static MemoryHeapType getHeapType(MemorySubsystem subsystem);
+
+		// Empty for subsystems using the system heap.
+		static AllocatorStats getHeapStats(MemorySubsystem subsystem);
+		static const char* getSubsystemName(MemorySubsystem subsystem);
+
 	private:
 
 		static void bigmemswap(void* a, void* b, uintptr size);
@@ -0,0 +1,405 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: DynamicAABBTree
+
+Binary tree of fattened bounding boxes for broad phase queries. Moving proxies only refit their
+ancestors, so the tree stays valid but its quality slowly degrades. Quality is tracked with the
+surface area heuristic cost & once it grows past a threshold the tree is rebuilt with a binned
+SAH builder on a background job, the changes made in the meantime are replayed on the new tree.
+
+Timestamp: 11/3/2020 5:40:26 PM
+*/
+
+#pragma once
+
+#ifndef DynamicAABBTree_HPP
+#define DynamicAABBTree_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include "Core/Common.hpp"
+#include "Utility/Math/AABB.hpp"
+#include <vector>
+#include <memory>
+
+namespace LinaEngine
+{
+	class JobSystem;
+
+	#define AABBTREE_NULL_NODE -1
+	#define AABBTREE_STACK_SIZE 64
+
+	class DynamicAABBTree
+	{
+	public:
+
+		DynamicAABBTree();
+		~DynamicAABBTree();
+
+		// Proxies keep their ids over rebuilds, user data is what the queries report back.
+		uint32 CreateProxy(const AABB& aabb, uint32 userData);
+		void DestroyProxy(uint32 proxy);
+
+		// Returns false if the box still fits in the fattened one. The leaf is refit in place, boxes
+		// that jumped away from their old position are reinserted.
+		bool MoveProxy(uint32 proxy, const AABB& aabb);
+
+		uint32 GetUserData(uint32 proxy) const { return m_proxies[proxy].m_userData; }
+		const AABB& GetFatAABB(uint32 proxy) const { return m_nodes[m_proxies[proxy].m_node].m_aabb; }
+
+		// Swaps in a finished background build, or starts one if the cost grew past the threshold.
+		// Builds on the calling thread without a job system that has workers.
+		void Update(JobSystem* jobSystem = nullptr);
+
+		// Builds the tree from scratch on the calling thread, waits for a background build first.
+		void Rebuild();
+
+		// Removes all proxies.
+		void Clear();
+
+		// Callbacks receive the user data & return false to stop the query.
+		template<typename Callback>
+		void QueryAABB(const AABB& aabb, Callback callback) const;
+
+		template<typename Callback>
+		void QuerySphere(const Vector3& center, float radius, Callback callback) const;
+
+		// Subtrees that are fully inside are reported without testing their children.
+		template<typename Callback>
+		void QueryFrustum(const Frustum& frustum, Callback callback) const;
+
+		// Callback receives the user data & the distance the ray enters the fat box, returns the distance
+		// to clip the ray to, usually the closest hit so far. Returning 0 stops the cast.
+		template<typename Callback>
+		void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Callback callback) const;
+
+		// Sum of the internal node areas relative to the leaf areas, lower is better.
+		float GetCost() const;
+		uint32 GetHeight() const { return m_root == AABBTREE_NULL_NODE ? 0 : m_nodes[m_root].m_height; }
+		uint32 GetProxyCount() const { return m_proxyCount; }
+		bool GetIsRebuilding() const { return m_build != nullptr; }
+
+		// Boxes are fattened by the margin so small movements don't touch the tree.
+		void SetMargin(float margin) { m_margin = margin; }
+
+		// Rebuilds once the cost grows past threshold times the cost after the last build.
+		void SetRebuildThreshold(float threshold) { m_rebuildThreshold = threshold; }
+
+	private:
+
+		struct Node
+		{
+			bool IsLeaf() const { return m_child1 == AABBTREE_NULL_NODE; }
+
+			AABB m_aabb;
+
+			// Next free node while in the free list.
+			int32 m_parent = AABBTREE_NULL_NODE;
+			int32 m_child1 = AABBTREE_NULL_NODE;
+			int32 m_child2 = AABBTREE_NULL_NODE;
+
+			// Leaves are 0, free nodes -1.
+			int32 m_height = 0;
+			uint32 m_proxy = 0;
+		};
+
+		struct Proxy
+		{
+			int32 m_node = AABBTREE_NULL_NODE;
+			uint32 m_userData = 0;
+			bool m_alive = false;
+			bool m_touched = false;
+		};
+
+		struct BuildPrimitive
+		{
+			AABB m_aabb;
+			glm::vec3 m_centroid;
+			uint32 m_proxy;
+		};
+
+		struct BuildState;
+
+		// Fixed size stack for the traversals, spills to the heap for very deep trees.
+		template<typename T>
+		class TraversalStack
+		{
+		public:
+
+			void Push(const T& value)
+			{
+				if (m_count < AABBTREE_STACK_SIZE)
+					m_fixed[m_count] = value;
+				else
+					m_overflow.push_back(value);
+
+				m_count++;
+			}
+
+			T Pop()
+			{
+				m_count--;
+				if (m_count < AABBTREE_STACK_SIZE)
+					return m_fixed[m_count];
+
+				T value = m_overflow.back();
+				m_overflow.pop_back();
+				return value;
+			}
+
+			bool IsEmpty() const { return m_count == 0; }
+
+		private:
+
+			T m_fixed[AABBTREE_STACK_SIZE];
+			std::vector<T> m_overflow;
+			uint32 m_count = 0;
+		};
+
+		int32 AllocateNode();
+		void FreeNode(int32 node);
+		void InsertLeaf(int32 leaf);
+		void RemoveLeaf(int32 leaf);
+		void RefitAncestors(int32 node);
+		int32 Balance(int32 node);
+		void SetInternalAABB(int32 node, const AABB& aabb);
+		void SetLeafAABB(int32 node, const AABB& aabb);
+		void TouchProxy(uint32 proxy);
+		void StartBuild();
+		void FinishBuild();
+		void WaitForBuild();
+		static void BuildNodes(BuildState& build);
+		static uint32 FindSplit(std::vector<BuildPrimitive>& primitives, uint32 begin, uint32 end);
+
+		template<typename Callback>
+		bool VisitSubtree(int32 root, Callback& callback) const;
+
+	private:
+
+		std::vector<Node> m_nodes;
+		std::vector<Proxy> m_proxies;
+		std::vector<uint32> m_freeProxies;
+		int32 m_root = AABBTREE_NULL_NODE;
+		int32 m_freeNode = AABBTREE_NULL_NODE;
+		uint32 m_proxyCount = 0;
+		float m_margin = 0.1f;
+
+		// Half area sums of the internal nodes & the leaves, kept up to date for the cost.
+		double m_internalArea = 0.0;
+		double m_leafArea = 0.0;
+		float m_builtCost = 0.0f;
+		float m_rebuildThreshold = 1.3f;
+
+		// Background build & the proxies changed since its snapshot was taken.
+		std::unique_ptr<BuildState> m_build;
+		JobSystem* m_jobSystem = nullptr;
+		std::vector<uint32> m_touchedProxies;
+
+		DISALLOW_COPY_ASSIGN_MOVE(DynamicAABBTree)
+	};
+
+	template<typename Callback>
+	bool DynamicAABBTree::VisitSubtree(int32 root, Callback& callback) const
+	{
+		TraversalStack<int32> stack;
+		stack.Push(root);
+
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_nodes[stack.Pop()];
+
+			if (node.IsLeaf())
+			{
+				if (!callback(m_proxies[node.m_proxy].m_userData))
+					return false;
+			}
+			else
+			{
+				stack.Push(node.m_child1);
+				stack.Push(node.m_child2);
+			}
+		}
+
+		return true;
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::QueryAABB(const AABB& aabb, Callback callback) const
+	{
+		if (m_root == AABBTREE_NULL_NODE)
+			return;
+
+		TraversalStack<int32> stack;
+		stack.Push(m_root);
+
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_nodes[stack.Pop()];
+
+			if (!node.m_aabb.Overlaps(aabb))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if (!callback(m_proxies[node.m_proxy].m_userData))
+					return;
+			}
+			else
+			{
+				stack.Push(node.m_child1);
+				stack.Push(node.m_child2);
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::QuerySphere(const Vector3& center, float radius, Callback callback) const
+	{
+		if (m_root == AABBTREE_NULL_NODE)
+			return;
+
+		TraversalStack<int32> stack;
+		stack.Push(m_root);
+
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_nodes[stack.Pop()];
+
+			if (!node.m_aabb.OverlapsSphere(center, radius))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if (!callback(m_proxies[node.m_proxy].m_userData))
+					return;
+			}
+			else
+			{
+				stack.Push(node.m_child1);
+				stack.Push(node.m_child2);
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::QueryFrustum(const Frustum& frustum, Callback callback) const
+	{
+		if (m_root == AABBTREE_NULL_NODE)
+			return;
+
+		TraversalStack<int32> stack;
+		stack.Push(m_root);
+
+		while (!stack.IsEmpty())
+		{
+			const int32 index = stack.Pop();
+			const Node& node = m_nodes[index];
+			const FrustumResult result = frustum.Test(node.m_aabb);
+
+			if (result == FrustumResult::Outside)
+				continue;
+
+			if (result == FrustumResult::Inside || node.IsLeaf())
+			{
+				if (!VisitSubtree(index, callback))
+					return;
+			}
+			else
+			{
+				stack.Push(node.m_child1);
+				stack.Push(node.m_child2);
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Callback callback) const
+	{
+		if (m_root == AABBTREE_NULL_NODE)
+			return;
+
+		const Vector3 inverseDirection = glm::vec3(1.0f) / glm::vec3(direction);
+		float entry = 0.0f;
+
+		if (!m_nodes[m_root].m_aabb.IntersectsRay(origin, inverseDirection, maxDistance, entry))
+			return;
+
+		// Nodes are pushed with their entry distance, the closer child is visited first.
+		TraversalStack<std::pair<int32, float>> stack;
+		stack.Push(std::make_pair(m_root, entry));
+
+		while (!stack.IsEmpty())
+		{
+			const std::pair<int32, float> item = stack.Pop();
+
+			// The ray might have been clipped since the node was pushed.
+			if (item.second > maxDistance)
+				continue;
+
+			const Node& node = m_nodes[item.first];
+
+			if (node.IsLeaf())
+			{
+				maxDistance = callback(m_proxies[node.m_proxy].m_userData, item.second);
+				if (maxDistance <= 0.0f)
+					return;
+
+				continue;
+			}
+
+			float entry1 = 0.0f;
+			float entry2 = 0.0f;
+			const bool hit1 = m_nodes[node.m_child1].m_aabb.IntersectsRay(origin, inverseDirection, maxDistance, entry1);
+			const bool hit2 = m_nodes[node.m_child2].m_aabb.IntersectsRay(origin, inverseDirection, maxDistance, entry2);
+
+			if (hit1 && hit2)
+			{
+				if (entry1 <= entry2)
+				{
+					stack.Push(std::make_pair(node.m_child2, entry2));
+					stack.Push(std::make_pair(node.m_child1, entry1));
+				}
+				else
+				{
+					stack.Push(std::make_pair(node.m_child1, entry1));
+					stack.Push(std::make_pair(node.m_child2, entry2));
+				}
+			}
+			else if (hit1)
+			{
+				stack.Push(std::make_pair(node.m_child1, entry1));
+			}
+			else if (hit2)
+			{
+				stack.Push(std::make_pair(node.m_child2, entry2));
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: HandleAllocator
+
+Hands out generational integer handles. The lower bits index a slot, the upper bits store the
+generation of that slot, so a handle to a released resource can be detected in constant time
+even after its slot is reused.
+
+Timestamp: 10/27/2020 6:41:12 PM
+*/
+
+#pragma once
+
+#ifndef HandleAllocator_HPP
+#define HandleAllocator_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <vector>
+
+namespace LinaEngine
+{
+	class HandleAllocator
+	{
+	public:
+
+		static constexpr uint32 INDEX_BITS = 20;
+		static constexpr uint32 INDEX_MASK = (1u << INDEX_BITS) - 1;
+		static constexpr uint32 GENERATION_MASK = (1u << (31 - INDEX_BITS)) - 1;
+
+		// All handles are greater or equal to this, values below are free for fixed ids e.g. primitives.
+		static constexpr int FIRST_HANDLE = 1 << INDEX_BITS;
+
+		HandleAllocator() {};
+		~HandleAllocator() {};
+
+		// Returns a new handle, released slots are reused with a bumped generation.
+		int Allocate();
+
+		// Marks the handle's slot as alive again, e.g. for handles restored from serialized data.
+		// Fails if the slot is in use by another handle.
+		bool Acquire(int handle);
+
+		// Invalidates the handle & frees its slot.
+		void Release(int handle);
+
+		// Returns true if the handle was allocated & not released.
+		bool IsValid(int handle) const;
+
+		// Returns true if the value is in the range of the handles, not a fixed id.
+		static bool IsHandle(int value) { return value >= FIRST_HANDLE; }
+		static uint32 GetIndex(int handle) { return (uint32)handle & INDEX_MASK; }
+		static uint32 GetGeneration(int handle) { return ((uint32)handle >> INDEX_BITS) & GENERATION_MASK; }
+
+	private:
+
+		static int MakeHandle(uint32 index, uint32 generation) { return (int)((generation << INDEX_BITS) | index); }
+
+	private:
+
+		std::vector<uint32> m_generations;
+		std::vector<bool> m_alive;
+		std::vector<uint32> m_freeIndices;
+	};
+}
+
+#endif
@@ -29,7 +29,9 @@ SOFTWARE.
 /*
 Class: Log
 
-Defines macros for logging used within the engine as well as from clients.
+Defines macros for logging used within the engine as well as from clients. Once async logging is
+started messages are formatted into a lock-free ring buffer & a background thread writes them to the
+console & log file, listeners get them on the main thread through DispatchPending.
 
 Timestamp: 12/30/2018 1:54:10 AM
 */
@@ -40,17 +42,68 @@ Timestamp: 12/30/2018 1:54:10 AM
 #define Log_HPP
 
 #include "Core/LinaAPI.hpp"
-#include "fmt/core.h"
+#include "Core/MPSCRingBuffer.hpp"
+#include "fmt/format.h"
 #include <functional>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <type_traits>
+#include <string_view>
+
+// Calls below the compile time level are removed entirely, LINA_LOG_COMPILE_LEVEL is set from CMake.
+#define LINA_LOG_LEVEL_TRACE 0
+#define LINA_LOG_LEVEL_DEBUG 1
+#define LINA_LOG_LEVEL_INFO 2
+#define LINA_LOG_LEVEL_WARN 3
+#define LINA_LOG_LEVEL_ERROR 4
+#define LINA_LOG_LEVEL_CRITICAL 5
+
+#ifndef LINA_LOG_COMPILE_LEVEL
+#define LINA_LOG_COMPILE_LEVEL LINA_LOG_LEVEL_TRACE
+#endif
+
+#if LINA_LOG_COMPILE_LEVEL <= LINA_LOG_LEVEL_TRACE
+#define LINA_LOG_TRACE(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Trace, __VA_ARGS__);
+#else
+#define LINA_LOG_TRACE(...)
+#endif
+
+#if LINA_LOG_COMPILE_LEVEL <= LINA_LOG_LEVEL_DEBUG
+#define LINA_LOG_DEBUG(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Debug, __VA_ARGS__);
+#else
+#define LINA_LOG_DEBUG(...)
+#endif
+
+#if LINA_LOG_COMPILE_LEVEL <= LINA_LOG_LEVEL_INFO
+#define LINA_LOG_INFO(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Info, __VA_ARGS__);
+#else
+#define LINA_LOG_INFO(...)
+#endif
+
+#if LINA_LOG_COMPILE_LEVEL <= LINA_LOG_LEVEL_WARN
+#define LINA_LOG_WARN(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Warn, __VA_ARGS__);
+#else
+#define LINA_LOG_WARN(...)
+#endif
+
+#if LINA_LOG_COMPILE_LEVEL <= LINA_LOG_LEVEL_ERROR
+#define LINA_LOG_ERR(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Error, __VA_ARGS__);
+#else
+#define LINA_LOG_ERR(...)
+#endif
+
+#define LINA_LOG_CRITICAL(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Critical, __VA_ARGS__);
 
 #ifdef LINA_CORE_ENABLE_LOGGING
 
-#define LINA_CORE_ERR(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Error, __VA_ARGS__);
-#define LINA_CORE_WARN(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Warn,__VA_ARGS__); 
-#define LINA_CORE_INFO(...)			::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Info,__VA_ARGS__); 
-#define LINA_CORE_TRACE(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Trace,__VA_ARGS__);
-#define LINA_CORE_DEBUG(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Debug,__VA_ARGS__); 
-#define LINA_CORE_CRITICAL(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Critical,__VA_ARGS__);
+#define LINA_CORE_ERR(...)			LINA_LOG_ERR(__VA_ARGS__)
+#define LINA_CORE_WARN(...)			LINA_LOG_WARN(__VA_ARGS__)
+#define LINA_CORE_INFO(...)			LINA_LOG_INFO(__VA_ARGS__)
+#define LINA_CORE_TRACE(...)		LINA_LOG_TRACE(__VA_ARGS__)
+#define LINA_CORE_DEBUG(...)		LINA_LOG_DEBUG(__VA_ARGS__)
+#define LINA_CORE_CRITICAL(...)		LINA_LOG_CRITICAL(__VA_ARGS__)
 
 #else
 
@@ -58,20 +111,20 @@ Timestamp: 12/30/2018 1:54:10 AM
 #define LINA_CORE_WARN(...)		
 #define LINA_CORE_INFO(...)		
 #define LINA_CORE_TRACE(...)	
+#define LINA_CORE_DEBUG(...)
+#define LINA_CORE_CRITICAL(...)
 #define LINA_CORE_FATAL(...)	
 
 #endif
 
 #ifdef LINA_CLIENT_ENABLE_LOGGING
 
-
-
-#define LINA_CLIENT_ERR(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Error, __VA_ARGS__);
-#define LINA_CLIENT_WARN(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Warn,__VA_ARGS__); 
-#define LINA_CLIENT_INFO(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Info,__VA_ARGS__); 
-#define LINA_CLIENT_TRACE(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Trace,__VA_ARGS__);
-#define LINA_CLIENT_DEBUG(...)		::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Debug,__VA_ARGS__); 
-#define LINA_CLIENT_CRITICAL(...)	::LinaEngine::Log::LogMessage(::LinaEngine::Log::LogLevel::Critical,__VA_ARGS__);
+#define LINA_CLIENT_ERR(...)		LINA_LOG_ERR(__VA_ARGS__)
+#define LINA_CLIENT_WARN(...)		LINA_LOG_WARN(__VA_ARGS__)
+#define LINA_CLIENT_INFO(...)		LINA_LOG_INFO(__VA_ARGS__)
+#define LINA_CLIENT_TRACE(...)		LINA_LOG_TRACE(__VA_ARGS__)
+#define LINA_CLIENT_DEBUG(...)		LINA_LOG_DEBUG(__VA_ARGS__)
+#define LINA_CLIENT_CRITICAL(...)	LINA_LOG_CRITICAL(__VA_ARGS__)
 
 #else
 
@@ -80,6 +133,8 @@ Timestamp: 12/30/2018 1:54:10 AM
 #define LINA_CLIENT_WARN(...)		
 #define LINA_CLIENT_INFO(...)		
 #define LINA_CLIENT_TRACE(...)
+#define LINA_CLIENT_DEBUG(...)
+#define LINA_CLIENT_CRITICAL(...)
 #define LINA_CLIENT_FATAL(...)
 
 #endif
@@ -99,12 +154,48 @@ Timestamp: 12/30/2018 1:54:10 AM
 #endif
 
 #define CORE_LOG_LOCATION "logs/core_log.txt"
+#define CORE_BINARY_LOG_LOCATION "logs/core_log.linalog"
 #define CLIENT_LOG_LOCATION "logs/client_log.txt"
 #define MAX_BACKTRACE_SIZE 32
 #define FMT_HEADER_ONLY
 
+#define LOG_RECORD_MESSAGE_SIZE 256
+#define LOG_TRUNCATED_SUFFIX " [truncated]"
+#define LOG_DEFAULT_RING_CAPACITY 4096
+#define LOG_DEFAULT_MAX_FILE_SIZE (8 * 1024 * 1024)
+#define LOG_DEFAULT_MAX_FILE_COUNT 3
+#define LOG_MAX_PENDING_DISPATCH 256
+#define LOG_BINARY_FILE_MAGIC "LINALOG1"
+
 namespace LinaEngine
 {
+	enum class LogRecordMode
+	{
+		// Messages are formatted on the logging thread.
+		Formatted,
+
+		// The format string pointer & the raw arguments are queued, the writer formats them. The file sink
+		// writes binary records that are turned into text with LinaLogDecoder.
+		Binary
+	};
+
+	struct AsyncLogSettings
+	{
+		// Records the ring buffer holds, rounded up to a power of two.
+		uint32 m_capacity = LOG_DEFAULT_RING_CAPACITY;
+		bool m_writeToConsole = true;
+
+		// Empty disables the file sink. Files are rotated as path.1, path.2 ... once they reach the max size.
+		std::string m_filePath = CORE_LOG_LOCATION;
+		uint64 m_maxFileSize = LOG_DEFAULT_MAX_FILE_SIZE;
+		uint32 m_maxFileCount = LOG_DEFAULT_MAX_FILE_COUNT;
+
+		// Queues the messages for s_onLog, which is then called from DispatchPending.
+		bool m_forwardToListener = true;
+
+		LogRecordMode m_recordMode = LogRecordMode::Formatted;
+	};
+
 	class  Log
 	{
 	public:
@@ -140,14 +231,241 @@ namespace LinaEngine
 		};
 
 
+		// Tags of the encoded arguments in binary records.
+		enum class ArgType : uint8
+		{
+			Bool,
+			Char,
+			Int64,
+			UInt64,
+			Float,
+			Double,
+			String
+		};
+
+		// Fixed size so that logging threads write in place without allocating. Holds the formatted message, or
+		// the encoded arguments if the format is set. Longer errors are moved to the heap & owned by the writer,
+		// other longer messages are truncated & marked.
+		struct LogRecord
+		{
+			LogLevel m_level = LogLevel::Info;
+			const char* m_format = nullptr;
+			std::string* m_overflow = nullptr;
+			bool m_truncated = false;
+			uint32 m_length = 0;
+			char m_data[LOG_RECORD_MESSAGE_SIZE];
+		};
+
 		template<typename... Args>
 		static void LogMessage(LogLevel level, const Args &... args)
 		{
+			// Filtered before anything is formatted.
+			if (!IsLevelEnabled(level))
+				return;
+
+			if (s_isAsync.load(std::memory_order_relaxed))
+			{
+				// StopAsync waits for the producers that made it past the second check, so the writer sees their records.
+				AsyncProducerScope producer;
+				if (s_isAsync.load())
+				{
+					PushRecord(level, args...);
+					return;
+				}
+			}
+
 			if (s_onLog)
 				s_onLog(LogDump(level, fmt::format(args...)));
 		}
 
+		// Starts the writer thread, messages logged afterwards don't block the calling thread.
+		static void StartAsync(const AsyncLogSettings& settings = AsyncLogSettings());
+
+		// Writes everything queued so far & joins the writer, logging falls back to calling s_onLog directly.
+		static void StopAsync();
+
+		// Blocks until the messages logged before the call are written to the sinks.
+		static void Flush();
+
+		// Main thread only, calls s_onLog for the messages the writer has forwarded since the last call.
+		static void DispatchPending();
+
+		// Formats encoded arguments into out, false if the data or the format is invalid.
+		static bool FormatBinaryRecord(const char* format, const uint8* data, uint32 length, std::string& out);
+
+		// Turns a binary log file written in LogRecordMode::Binary into text.
+		static bool DecodeBinaryLog(const std::string& inputPath, const std::string& outputPath);
+
+		// Levels are bit flags, only the levels in the mask are logged.
+		static void SetLevelMask(uint32 mask) { s_levelMask.store(mask, std::memory_order_relaxed); }
+		static uint32 GetLevelMask() { return s_levelMask.load(std::memory_order_relaxed); }
+		static bool IsLevelEnabled(LogLevel level) { return (s_levelMask.load(std::memory_order_relaxed) & level) != 0; }
+
+		// Mask of the given level & everything more severe, trace < debug < info < warn < error < critical.
+		static uint32 GetLevelMaskFrom(LogLevel minimum);
+		static bool ParseLevel(const std::string& name, LogLevel& level);
+
+		static bool GetIsAsync() { return s_isAsync.load(std::memory_order_acquire); }
+		static uint64 GetDroppedCount() { return s_totalDropped.load(std::memory_order_relaxed); }
+
 		static std::function<void(LogDump)> s_onLog;
+
+	private:
+
+		struct AsyncProducerScope
+		{
+			AsyncProducerScope() { s_asyncProducers.fetch_add(1); }
+			~AsyncProducerScope() { s_asyncProducers.fetch_sub(1, std::memory_order_release); }
+		};
+
+		template<typename... Args>
+		static void PushRecord(LogLevel level, const Args &... args)
+		{
+			// Under a flood the buffer fills up, the rest is dropped & reported by the writer instead of stalling the frame.
+			// Errors are worth the wait though.
+			const bool mustWrite = level == LogLevel::Error || level == LogLevel::Critical;
+
+			auto write = [&](LogRecord& record)
+			{
+				record.m_level = level;
+				record.m_overflow = nullptr;
+				record.m_truncated = false;
+
+				if (s_deferFormatting && EncodeRecord(record, args...))
+					return;
+
+				// format_to_n writes long string arguments past the end of a raw pointer in this fmt version, the
+				// buffer only allocates once the message doesn't fit the record anyway.
+				fmt::basic_memory_buffer<char, LOG_RECORD_MESSAGE_SIZE> buffer;
+				fmt::format_to(buffer, args...);
+
+				record.m_format = nullptr;
+				record.m_length = (uint32)(buffer.size() < LOG_RECORD_MESSAGE_SIZE ? buffer.size() : LOG_RECORD_MESSAGE_SIZE);
+				std::memcpy(record.m_data, buffer.data(), record.m_length);
+
+				if (buffer.size() <= LOG_RECORD_MESSAGE_SIZE)
+					return;
+
+				// Long errors are kept whole, shader info logs for instance.
+				if (mustWrite)
+					record.m_overflow = new std::string(buffer.data(), buffer.size());
+				else
+					record.m_truncated = true;
+			};
+
+			while (!s_records.TryPush(write))
+			{
+				if (!mustWrite)
+				{
+					s_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				// StopAsync waits for this producer, so once it starts the record is logged like in sync mode instead.
+				if (!s_isAsync.load(std::memory_order_acquire))
+				{
+					if (s_onLog)
+						s_onLog(LogDump(level, fmt::format(args...)));
+					return;
+				}
+
+				WakeWriter();
+				std::this_thread::yield();
+			}
+
+			if (mustWrite)
+				WakeWriter();
+		}
+
+		// Only literal formats are kept by pointer, they have to outlive the record. Falls back to formatting if
+		// an argument can't be encoded or the arguments don't fit, strings aren't cut.
+		template<size_t N, typename... Args>
+		static bool EncodeRecord(LogRecord& record, const char(&format)[N], const Args &... args)
+		{
+			if constexpr ((IsEncodable<Args>() && ...))
+			{
+				uint8* begin = reinterpret_cast<uint8*>(record.m_data);
+				uint8* cursor = begin;
+
+				if (!(EncodeArg(cursor, begin + LOG_RECORD_MESSAGE_SIZE, args) && ...))
+					return false;
+
+				record.m_format = format;
+				record.m_length = (uint32)(cursor - begin);
+				return true;
+			}
+			else
+				return false;
+		}
+
+		template<typename... Args>
+		static bool EncodeRecord(LogRecord& record, const Args &... args)
+		{
+			return false;
+		}
+
+		template<typename T>
+		static constexpr bool IsEncodable()
+		{
+			using U = std::decay_t<T>;
+			return std::is_arithmetic_v<U> || std::is_same_v<U, const char*> || std::is_same_v<U, char*> || std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view> || std::is_same_v<U, fmt::string_view>;
+		}
+
+		template<typename T>
+		static bool EncodeArg(uint8*& cursor, const uint8* end, const T& value)
+		{
+			using U = std::decay_t<T>;
+
+			if constexpr (std::is_same_v<U, bool>)
+				return EncodeValue(cursor, end, ArgType::Bool, value);
+			else if constexpr (std::is_same_v<U, char>)
+				return EncodeValue(cursor, end, ArgType::Char, value);
+			else if constexpr (std::is_same_v<U, float>)
+				return EncodeValue(cursor, end, ArgType::Float, value);
+			else if constexpr (std::is_floating_point_v<U>)
+				return EncodeValue(cursor, end, ArgType::Double, (double)value);
+			else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+				return EncodeValue(cursor, end, ArgType::Int64, (int64)value);
+			else if constexpr (std::is_integral_v<U>)
+				return EncodeValue(cursor, end, ArgType::UInt64, (uint64)value);
+			else
+			{
+				const fmt::string_view text(value);
+				if (cursor + 1 + sizeof(uint32) + text.size() > end)
+					return false;
+
+				const uint32 length = (uint32)text.size();
+				*cursor++ = (uint8)ArgType::String;
+				std::memcpy(cursor, &length, sizeof(uint32));
+				std::memcpy(cursor + sizeof(uint32), text.data(), length);
+				cursor += sizeof(uint32) + length;
+				return true;
+			}
+		}
+
+		template<typename T>
+		static bool EncodeValue(uint8*& cursor, const uint8* end, ArgType type, const T& value)
+		{
+			if (cursor + 1 + sizeof(T) > end)
+				return false;
+
+			*cursor++ = (uint8)type;
+			std::memcpy(cursor, &value, sizeof(T));
+			cursor += sizeof(T);
+			return true;
+		}
+
+		static void WakeWriter();
+		static void WriterLoop();
+		static uint32 WriteRecords();
+
+		static MPSCRingBuffer<LogRecord> s_records;
+		static std::atomic<bool> s_isAsync;
+		static std::atomic<uint32> s_asyncProducers;
+		static std::atomic<uint64> s_droppedRecords;
+		static std::atomic<uint64> s_totalDropped;
+		static std::atomic<uint32> s_levelMask;
+		static bool s_deferFormatting;
 	};
 }
 
@@ -0,0 +1,123 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: AABB
+
+Axis aligned bounding box & the intersection tests used by the spatial structures. Frustum planes
+are extracted from a view projection matrix & point inwards.
+
+Timestamp: 11/3/2020 5:12:08 PM
+*/
+
+#pragma once
+
+#ifndef AABB_HPP
+#define AABB_HPP
+
+#include "Utility/Math/Vector.hpp"
+#include "Utility/Math/Matrix.hpp"
+
+namespace LinaEngine
+{
+	class AABB
+	{
+	public:
+
+		AABB() {};
+		AABB(const Vector3& min, const Vector3& max) : m_min(min), m_max(max) {};
+
+		static AABB FromCenterExtents(const Vector3& center, const Vector3& extents) { return AABB(glm::vec3(center) - glm::vec3(extents), glm::vec3(center) + glm::vec3(extents)); }
+		static AABB Merge(const AABB& a, const AABB& b) { return AABB(glm::min(glm::vec3(a.m_min), glm::vec3(b.m_min)), glm::max(glm::vec3(a.m_max), glm::vec3(b.m_max))); }
+
+		Vector3 GetCenter() const { return (glm::vec3(m_min) + glm::vec3(m_max)) * 0.5f; }
+		Vector3 GetExtents() const { return (glm::vec3(m_max) - glm::vec3(m_min)) * 0.5f; }
+
+		// Half of the surface area, the constant factor doesn't matter for the SAH comparisons.
+		float GetHalfArea() const
+		{
+			const float x = m_max.x - m_min.x;
+			const float y = m_max.y - m_min.y;
+			const float z = m_max.z - m_min.z;
+			return x * y + y * z + z * x;
+		}
+
+		AABB Expanded(float margin) const { return AABB(glm::vec3(m_min) - margin, glm::vec3(m_max) + margin); }
+
+		bool Contains(const AABB& other) const
+		{
+			return m_min.x <= other.m_min.x && m_min.y <= other.m_min.y && m_min.z <= other.m_min.z
+				&& m_max.x >= other.m_max.x && m_max.y >= other.m_max.y && m_max.z >= other.m_max.z;
+		}
+
+		bool Overlaps(const AABB& other) const
+		{
+			return m_min.x <= other.m_max.x && m_min.y <= other.m_max.y && m_min.z <= other.m_max.z
+				&& m_max.x >= other.m_min.x && m_max.y >= other.m_min.y && m_max.z >= other.m_min.z;
+		}
+
+		bool OverlapsSphere(const Vector3& center, float radius) const
+		{
+			const glm::vec3 closest = glm::clamp(glm::vec3(center), glm::vec3(m_min), glm::vec3(m_max));
+			const glm::vec3 delta = closest - glm::vec3(center);
+			return glm::dot(delta, delta) <= radius * radius;
+		}
+
+		// Slab test, inverse direction is passed in so it's calculated once per ray. Outputs the entry distance.
+		bool IntersectsRay(const Vector3& origin, const Vector3& inverseDirection, float maxDistance, float& distance) const;
+
+		// Box enclosing this one after being transformed by an affine matrix.
+		AABB Transformed(const Matrix& matrix) const;
+
+		Vector3 m_min = Vector3(0.0f);
+		Vector3 m_max = Vector3(0.0f);
+	};
+
+	enum class FrustumResult
+	{
+		Outside,
+		Intersects,
+		Inside
+	};
+
+	class Frustum
+	{
+	public:
+
+		Frustum() {};
+
+		// Planes of the volume clip space maps to, in the space the matrix transforms from.
+		static Frustum FromMatrix(const Matrix& viewProjection);
+
+		FrustumResult Test(const AABB& aabb) const;
+
+		// Planes as normal & distance, in left, right, bottom, top, near, far order.
+		glm::vec4 m_planes[6];
+	};
+}
+
+#endif
@@ -72,7 +72,14 @@ namespace LinaEngine
 		Matrix ToNormalMatrix() const;
 		Matrix Transpose() const;
 		Matrix Inverse() const;
+
+		// Cheaper versions for matrices whose last row is (0, 0, 0, 1), e.g. TRS transforms.
+		Matrix InverseAffine() const;
+		Matrix ToNormalMatrixAffine() const;
 		Matrix ApplyScale(const Vector3& scale);
+
+		// Rotation of the upper 3x3 with the scale divided out, assumes there's no shear.
+		Quaternion GetRotation() const;
 		std::string ToString();
 
 		template<class Archive>
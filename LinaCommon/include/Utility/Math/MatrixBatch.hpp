@@ -0,0 +1,63 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: MatrixBatch
+
+Batch kernels for building affine transformation matrices from location, rotation & scale arrays
+and for calculating normal matrices. Processes 4 transforms per iteration with SSE and falls back
+to the scalar Matrix functions for the remainder & on other architectures.
+
+Timestamp: 11/3/2020 2:40:51 PM
+*/
+
+#pragma once
+
+#ifndef MatrixBatch_HPP
+#define MatrixBatch_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include "Utility/Math/Matrix.hpp"
+
+namespace LinaEngine
+{
+	class MatrixBatch
+	{
+	public:
+
+		// Same result as Matrix::TransformMatrix for each element.
+		static void TransformMatrices(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix* out, uint32 count);
+
+		// Transpose of the inverse for affine matrices, same result as matrix.Transpose().Inverse() within float precision.
+		static void NormalMatrices(const Matrix* matrices, Matrix* out, uint32 count);
+
+		// Instruction set the kernels were compiled with, for reports.
+		static const char* GetInstructionSet();
+	};
+}
+
+#endif
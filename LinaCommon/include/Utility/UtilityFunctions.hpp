@@ -45,18 +45,13 @@ namespace LinaEngine
 {
 	namespace Utility
 	{
-		static int s_uniqueID = 100;
-
-		// Creates a GUID.
-		int GetUniqueID();
-
 		bool FileExists(const std::string& path);
 
-		// Converts the current GUID to string via to_string and simply returns that.
-		std::string GetUniqueIDString();
-
 		size_t StringToHash(const std::string& str);
 
+		// FNV-1a hash of the file's bytes, returns 0 if the file can't be read.
+		unsigned long long HashFileContents(const std::string& path);
+
 		std::vector<std::string> Split(const std::string& s, char delim);
 
 		std::string GetFilePath(const std::string& fileName);
@@ -0,0 +1,198 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: AllocationCounter
+
+Timestamp: 11/3/2020 11:58:03 PM
+*/
+
+#include "Core/AllocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace LinaEngine
+{
+	std::atomic<uint64> AllocationCounter::s_allocationCount{ 0 };
+	std::atomic<uint64> AllocationCounter::s_allocatedBytes{ 0 };
+	std::atomic<uint64> AllocationCounter::s_frameStartCount{ 0 };
+	std::atomic<uint64> AllocationCounter::s_frameStartBytes{ 0 };
+	std::atomic<uint64> AllocationCounter::s_frameAllocationCount{ 0 };
+	std::atomic<uint64> AllocationCounter::s_frameAllocatedBytes{ 0 };
+
+	void AllocationCounter::BeginFrame()
+	{
+		uint64 count = s_allocationCount.load(std::memory_order_relaxed);
+		uint64 bytes = s_allocatedBytes.load(std::memory_order_relaxed);
+		s_frameAllocationCount.store(count - s_frameStartCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		s_frameAllocatedBytes.store(bytes - s_frameStartBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		s_frameStartCount.store(count, std::memory_order_relaxed);
+		s_frameStartBytes.store(bytes, std::memory_order_relaxed);
+	}
+}
+
+#if defined(LINA_ENABLE_ALLOCATIONCOUNTING) || defined(LINA_ENABLE_MEMORYTRACKING)
+
+// Replacements are defined in the same translation unit as the counter so linking the counter from the
+// static library always brings them along. When memory tracking is on, every block starts with the
+// tracker's record & is tagged with the subsystem of the current scope.
+
+#include "Core/MemoryTracker.hpp"
+
+namespace
+{
+	void* SystemAllocateAligned(size_t size, size_t alignment)
+	{
+#ifdef LINA_COMPILER_MSVC
+		return _aligned_malloc(size, alignment);
+#else
+		void* ptr = nullptr;
+		return posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) == 0 ? ptr : nullptr;
+#endif
+	}
+
+	void SystemFreeAligned(void* ptr)
+	{
+#ifdef LINA_COMPILER_MSVC
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+	void* CountedAllocate(size_t size)
+	{
+#ifdef LINA_ENABLE_ALLOCATIONCOUNTING
+		LinaEngine::AllocationCounter::RecordAllocation(size);
+#endif
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+		void* block = std::malloc(size + MEMORYTRACKER_RECORD_SIZE);
+		if (block == nullptr) return nullptr;
+		LinaEngine::MemoryTracker::OnAllocate(block, block, size, LinaEngine::MemoryTracker::GetCurrentSubsystem(), nullptr, 0);
+		return (uint8*)block + MEMORYTRACKER_RECORD_SIZE;
+#else
+		return std::malloc(size == 0 ? 1 : size);
+#endif
+	}
+
+	void* CountedAllocateAligned(size_t size, size_t alignment)
+	{
+#ifdef LINA_ENABLE_ALLOCATIONCOUNTING
+		LinaEngine::AllocationCounter::RecordAllocation(size);
+#endif
+		if (size == 0) size = 1;
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+		// The record sits right before the result, the block is offset by a multiple of the alignment.
+		size_t offset = alignment < MEMORYTRACKER_RECORD_SIZE ? MEMORYTRACKER_RECORD_SIZE : alignment;
+		offset = (offset + alignment - 1) & ~(alignment - 1);
+		void* block = SystemAllocateAligned(size + offset, alignment);
+		if (block == nullptr) return nullptr;
+		uint8* result = (uint8*)block + offset;
+		LinaEngine::MemoryTracker::OnAllocate(result - MEMORYTRACKER_RECORD_SIZE, block, size, LinaEngine::MemoryTracker::GetCurrentSubsystem(), nullptr, 0);
+		return result;
+#else
+		return SystemAllocateAligned(size, alignment);
+#endif
+	}
+
+	void CountedFree(void* ptr)
+	{
+#ifdef LINA_ENABLE_MEMORYTRACKING
+		if (ptr == nullptr) return;
+		void* record = (uint8*)ptr - MEMORYTRACKER_RECORD_SIZE;
+		LinaEngine::MemoryTracker::OnFree(record);
+		std::free(record);
+#else
+		std::free(ptr);
+#endif
+	}
+
+	void FreeAligned(void* ptr)
+	{
+#ifdef LINA_ENABLE_MEMORYTRACKING
+		if (ptr == nullptr) return;
+		void* record = (uint8*)ptr - MEMORYTRACKER_RECORD_SIZE;
+		LinaEngine::MemoryTracker::OnFree(record);
+		SystemFreeAligned(LinaEngine::MemoryTracker::GetBase(record));
+#else
+		SystemFreeAligned(ptr);
+#endif
+	}
+}
+
+void* operator new(size_t size)
+{
+	void* ptr = CountedAllocate(size);
+	if (ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	void* ptr = CountedAllocate(size);
+	if (ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* ptr = CountedAllocateAligned(size, (size_t)alignment);
+	if (ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	void* ptr = CountedAllocateAligned(size, (size_t)alignment);
+	if (ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return CountedAllocateAligned(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return CountedAllocateAligned(size, (size_t)alignment); }
+
+void operator delete(void* ptr) noexcept { CountedFree(ptr); }
+void operator delete[](void* ptr) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { CountedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { CountedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { CountedFree(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+
+#endif
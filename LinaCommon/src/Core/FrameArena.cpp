@@ -0,0 +1,150 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: FrameArena
+
+Timestamp: 11/3/2020 11:42:18 PM
+*/
+
+#include "Core/FrameArena.hpp"
+#include "PackageManager/PAMMemory.hpp"
+
+namespace LinaEngine
+{
+	std::atomic<uint64> FrameArena::s_frameIndex{ 0 };
+
+	namespace
+	{
+		struct ArenaBuffer
+		{
+			uint8* m_data = nullptr;
+			size_t m_capacity = 0;
+			size_t m_offset = 0;
+			size_t m_overflowBytes = 0;
+			std::vector<void*> m_overflow;
+
+			void Reset()
+			{
+				for (void* ptr : m_overflow)
+					Memory::free(ptr);
+
+				// Grow to what the last frame needed so the overflow doesn't repeat.
+				if (m_overflowBytes != 0 || m_data == nullptr)
+				{
+					size_t required = m_offset + m_overflowBytes;
+					size_t capacity = m_capacity == 0 ? FRAMEARENA_INITIAL_SIZE : m_capacity;
+					while (capacity < required)
+						capacity *= 2;
+
+					if (m_data != nullptr)
+						Memory::free(m_data);
+
+					m_data = (uint8*)Memory::malloc(capacity, GenericMemory::DefaultAlignment);
+					m_capacity = capacity;
+				}
+
+				m_overflow.clear();
+				m_offset = 0;
+				m_overflowBytes = 0;
+			}
+
+			void* Allocate(size_t size, size_t alignment)
+			{
+				size_t offset = GenericMemory::align(m_offset, alignment);
+
+				if (offset + size <= m_capacity)
+				{
+					m_offset = offset + size;
+					return m_data + offset;
+				}
+
+				const uint32 defaultAlignment = GenericMemory::DefaultAlignment;
+				void* ptr = Memory::malloc(size, alignment < defaultAlignment ? defaultAlignment : (uint32)alignment);
+				m_overflow.push_back(ptr);
+				m_overflowBytes += size + alignment;
+				return ptr;
+			}
+
+			~ArenaBuffer()
+			{
+				for (void* ptr : m_overflow)
+					Memory::free(ptr);
+
+				if (m_data != nullptr)
+					Memory::free(m_data);
+			}
+		};
+
+		struct ThreadArena
+		{
+			ArenaBuffer m_buffers[2];
+			uint64 m_frame = ~(uint64)0;
+		};
+
+		thread_local ThreadArena s_threadArena;
+
+		ArenaBuffer& GetCurrentBuffer()
+		{
+			ThreadArena& arena = s_threadArena;
+			uint64 frame = FrameArena::GetFrameIndex();
+			ArenaBuffer& buffer = arena.m_buffers[frame & 1];
+
+			// First allocation of this thread in a new frame, the buffer was last used two or more frames ago.
+			if (arena.m_frame != frame)
+			{
+				buffer.Reset();
+				arena.m_frame = frame;
+			}
+
+			return buffer;
+		}
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		s_frameIndex.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	void* FrameArena::Allocate(size_t size, size_t alignment)
+	{
+		return GetCurrentBuffer().Allocate(size == 0 ? 1 : size, alignment);
+	}
+
+	size_t FrameArena::GetUsedBytes()
+	{
+		ArenaBuffer& buffer = GetCurrentBuffer();
+		return buffer.m_offset + buffer.m_overflowBytes;
+	}
+
+	size_t FrameArena::GetCapacity()
+	{
+		ThreadArena& arena = s_threadArena;
+		return arena.m_buffers[0].m_capacity + arena.m_buffers[1].m_capacity;
+	}
+}
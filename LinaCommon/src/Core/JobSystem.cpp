@@ -0,0 +1,364 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: JobSystem
+
+Timestamp: 11/2/2020 10:12:37 AM
+*/
+
+#include "Core/JobSystem.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "Core/Profiler.hpp"
+#include <algorithm>
+
+#if defined(LINA_PLATFORM_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(LINA_PLATFORM_UNIX) || defined(LINA_PLATFORM_APPLE)
+#include <pthread.h>
+#endif
+
+namespace LinaEngine
+{
+	static thread_local int32 s_threadIndex = -1;
+	static thread_local JobSystem* s_threadSystem = nullptr;
+
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::Initialize(const JobSystemOptions& options)
+	{
+		if (!m_queues.empty())
+			return;
+
+		m_options = options;
+		uint32 workerCount = options.m_workerCount;
+
+		if (workerCount == 0)
+		{
+			uint32 hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		m_stopping = false;
+
+		// Queue 0 belongs to the initializing thread.
+		for (uint32 i = 0; i < workerCount + 1; i++)
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+
+		s_threadIndex = 0;
+		s_threadSystem = this;
+
+		for (uint32 i = 1; i < workerCount + 1; i++)
+			m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (m_queues.empty())
+			return;
+
+		// Drain what's left so no counter is left hanging.
+		while (TryRunJob(GetQueueIndex())) {}
+
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_stopping = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+
+		m_workers.clear();
+		m_queues.clear();
+
+		if (s_threadSystem == this)
+		{
+			s_threadIndex = -1;
+			s_threadSystem = nullptr;
+		}
+	}
+
+	void JobSystem::Run(const std::function<void()>& task, JobCounter* counter)
+	{
+		// Run inline if the system is not initialized.
+		if (m_queues.empty())
+		{
+			task();
+			return;
+		}
+
+		if (counter != nullptr)
+			counter->m_value.fetch_add(1, std::memory_order_relaxed);
+
+		Push(Job{ task, counter, MemoryTracker::GetCurrentSubsystem() });
+	}
+
+	void JobSystem::RunAfter(JobCounter& dependency, const std::function<void()>& task, JobCounter* counter)
+	{
+		if (m_queues.empty())
+		{
+			task();
+			return;
+		}
+
+		if (counter != nullptr)
+			counter->m_value.fetch_add(1, std::memory_order_relaxed);
+
+		Job job{ task, counter, MemoryTracker::GetCurrentSubsystem() };
+
+		{
+			// Checked under the lock, FinishJob releases the waiting list under the same lock after reaching zero.
+			std::unique_lock<std::mutex> lock(dependency.m_mutex);
+
+			if (dependency.m_value.load() != 0)
+			{
+				dependency.m_waitingJobs.push_back(std::move(job));
+				return;
+			}
+		}
+
+		Push(std::move(job));
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		const uint32 index = GetQueueIndex();
+
+		while (!counter.IsDone())
+		{
+			if (!TryRunJob(index))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(uint32 count, uint32 grainSize, const std::function<void(uint32 begin, uint32 end)>& func)
+	{
+		if (count == 0)
+			return;
+
+		if (grainSize == 0)
+			grainSize = std::max(1u, count / (std::max(1u, GetThreadCount()) * 4));
+
+		if (m_queues.empty() || grainSize >= count)
+		{
+			func(0, count);
+			return;
+		}
+
+		JobCounter counter;
+
+		for (uint32 begin = 0; begin < count; begin += grainSize)
+		{
+			const uint32 end = std::min(count, begin + grainSize);
+			Run([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+
+		Wait(counter);
+	}
+
+	int32 JobSystem::GetCurrentThreadIndex()
+	{
+		return s_threadIndex;
+	}
+
+	void JobSystem::SetCurrentThreadName(const std::string& name)
+	{
+		Profiler::SetThreadName(name.c_str());
+
+#if defined(LINA_PLATFORM_WINDOWS)
+		std::wstring wideName(name.begin(), name.end());
+		SetThreadDescription(GetCurrentThread(), wideName.c_str());
+#elif defined(LINA_PLATFORM_APPLE)
+		pthread_setname_np(name.c_str());
+#elif defined(LINA_PLATFORM_UNIX)
+		// Linux limits the names to 15 characters.
+		pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+	}
+
+	bool JobSystem::SetCurrentThreadAffinity(uint32 core)
+	{
+		if (core >= std::thread::hardware_concurrency())
+			return false;
+
+#if defined(LINA_PLATFORM_WINDOWS)
+		return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core) != 0;
+#elif defined(LINA_PLATFORM_UNIX) && defined(__linux__)
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(core, &cpuSet);
+		return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+		return false;
+#endif
+	}
+
+	void JobSystem::WorkerLoop(uint32 index)
+	{
+		s_threadIndex = (int32)index;
+		s_threadSystem = this;
+		SetCurrentThreadName(m_options.m_threadNamePrefix + std::to_string(index));
+
+		if (m_options.m_pinThreads)
+			SetCurrentThreadAffinity(index);
+
+		while (true)
+		{
+			if (TryRunJob(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+			// Pushers only notify if someone is sleeping, the counter is raised before checking for jobs
+			// so either this thread sees the new job or the pusher sees the sleeper.
+			m_sleepingWorkers.fetch_add(1);
+			m_sleepCondition.wait(lock, [this] { return m_stopping || m_queuedJobs.load() > 0; });
+			m_sleepingWorkers.fetch_sub(1);
+
+			if (m_stopping && m_queuedJobs.load() == 0)
+				return;
+		}
+	}
+
+	void JobSystem::Push(Job&& job)
+	{
+		WorkerQueue& queue = *m_queues[GetQueueIndex()];
+
+		{
+			std::unique_lock<std::mutex> lock(queue.m_mutex);
+			queue.m_jobs.push_back(std::move(job));
+		}
+
+		m_queuedJobs.fetch_add(1);
+
+		if (m_sleepingWorkers.load() > 0)
+		{
+			// Taking the lock makes sure the sleeper is actually waiting before the notify.
+			{ std::unique_lock<std::mutex> lock(m_sleepMutex); }
+			m_sleepCondition.notify_one();
+		}
+	}
+
+	bool JobSystem::TryRunJob(uint32 index)
+	{
+		Job job;
+
+		if (!PopOrSteal(index, job))
+			return false;
+
+		{
+#ifdef LINA_ENABLE_MEMORYTRACKING
+			MemoryScope memoryScope(job.m_memorySubsystem);
+#endif
+			LINA_PROFILE_SCOPE("Job");
+			job.m_task();
+		}
+
+		FinishJob(job);
+		return true;
+	}
+
+	bool JobSystem::PopOrSteal(uint32 index, Job& job)
+	{
+		const uint32 queueCount = (uint32)m_queues.size();
+
+		// Newest from our own queue is the hottest in cache.
+		{
+			WorkerQueue& queue = *m_queues[index];
+			std::unique_lock<std::mutex> lock(queue.m_mutex);
+
+			if (!queue.m_jobs.empty())
+			{
+				job = std::move(queue.m_jobs.back());
+				queue.m_jobs.pop_back();
+				m_queuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		// Oldest from the others, they tend to be the biggest chunks of work.
+		for (uint32 i = 1; i < queueCount; i++)
+		{
+			WorkerQueue& queue = *m_queues[(index + i) % queueCount];
+			std::unique_lock<std::mutex> lock(queue.m_mutex, std::try_to_lock);
+
+			if (lock.owns_lock() && !queue.m_jobs.empty())
+			{
+				job = std::move(queue.m_jobs.front());
+				queue.m_jobs.pop_front();
+				m_queuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::FinishJob(Job& job)
+	{
+		JobCounter* counter = job.m_counter;
+
+		if (counter == nullptr)
+			return;
+
+		counter->m_finishingJobs.fetch_add(1);
+
+		if (counter->m_value.fetch_sub(1) == 1)
+		{
+			// Counter reached zero, release the jobs chained after it.
+			std::vector<Job> released;
+
+			{
+				std::unique_lock<std::mutex> lock(counter->m_mutex);
+				released.swap(counter->m_waitingJobs);
+			}
+
+			for (Job& releasedJob : released)
+				Push(std::move(releasedJob));
+		}
+
+		// Last access, the owner may destroy the counter after this.
+		counter->m_finishingJobs.fetch_sub(1);
+	}
+
+	uint32 JobSystem::GetQueueIndex() const
+	{
+		// Threads outside the system share the main thread's queue.
+		return s_threadSystem == this ? (uint32)s_threadIndex : 0;
+	}
+}
@@ -0,0 +1,303 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: MemoryTracker
+
+Timestamp: 11/4/2020 2:21:09 PM
+*/
+
+#include "Core/MemoryTracker.hpp"
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+
+#include "Utility/Log.hpp"
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <utility>
+
+namespace LinaEngine
+{
+	namespace
+	{
+		struct AllocationRecord
+		{
+			AllocationRecord* m_prev;
+			AllocationRecord* m_next;
+			void* m_base;
+			const char* m_file;
+			uint64 m_size;
+			uint64 m_id;
+			int32 m_line;
+			MemorySubsystem m_subsystem;
+			bool m_linked;
+		};
+
+		static_assert(sizeof(AllocationRecord) <= MEMORYTRACKER_RECORD_SIZE, "Allocation record doesn't fit in the reserved space.");
+
+		struct SubsystemRecords
+		{
+			std::mutex m_mutex;
+			AllocationRecord* m_head = nullptr;
+			std::atomic<uint64> m_liveBytes{ 0 };
+			std::atomic<uint64> m_liveAllocations{ 0 };
+			std::atomic<uint64> m_peakBytes{ 0 };
+			std::atomic<uint64> m_totalAllocations{ 0 };
+			std::atomic<uint64> m_totalBytes{ 0 };
+			std::atomic<uint64> m_frameStartAllocations{ 0 };
+			std::atomic<uint64> m_frameStartBytes{ 0 };
+			std::atomic<uint64> m_frameAllocations{ 0 };
+			std::atomic<uint64> m_frameBytes{ 0 };
+		};
+
+		struct CallSite
+		{
+			uint64 m_allocations = 0;
+			uint64 m_bytes = 0;
+		};
+
+		// Constant initialized, the global operator new may run before the dynamic initializers.
+		SubsystemRecords s_records[(size_t)MemorySubsystem::Count];
+		std::atomic<uint64> s_nextAllocationID{ 1 };
+
+		thread_local MemorySubsystem s_currentSubsystem = MemorySubsystem::General;
+
+		// Set while a report runs, its own allocations aren't linked so the lists can stay locked.
+		thread_local bool s_reporting = false;
+	}
+
+	void MemoryTracker::BeginFrame()
+	{
+		for (SubsystemRecords& records : s_records)
+		{
+			uint64 allocations = records.m_totalAllocations.load(std::memory_order_relaxed);
+			uint64 bytes = records.m_totalBytes.load(std::memory_order_relaxed);
+			records.m_frameAllocations.store(allocations - records.m_frameStartAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			records.m_frameBytes.store(bytes - records.m_frameStartBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			records.m_frameStartAllocations.store(allocations, std::memory_order_relaxed);
+			records.m_frameStartBytes.store(bytes, std::memory_order_relaxed);
+		}
+	}
+
+	MemorySubsystemStats MemoryTracker::GetStats(MemorySubsystem subsystem)
+	{
+		SubsystemRecords& records = s_records[(size_t)subsystem];
+		MemorySubsystemStats stats;
+		stats.m_liveBytes = records.m_liveBytes.load(std::memory_order_relaxed);
+		stats.m_liveAllocations = records.m_liveAllocations.load(std::memory_order_relaxed);
+		stats.m_peakBytes = records.m_peakBytes.load(std::memory_order_relaxed);
+		stats.m_totalAllocations = records.m_totalAllocations.load(std::memory_order_relaxed);
+		stats.m_totalBytes = records.m_totalBytes.load(std::memory_order_relaxed);
+		stats.m_frameAllocations = records.m_frameAllocations.load(std::memory_order_relaxed);
+		stats.m_frameBytes = records.m_frameBytes.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	MemorySnapshot MemoryTracker::TakeSnapshot()
+	{
+		MemorySnapshot snapshot;
+		snapshot.m_allocationID = s_nextAllocationID.load(std::memory_order_relaxed) - 1;
+
+		for (size_t i = 0; i < (size_t)MemorySubsystem::Count; i++)
+			snapshot.m_subsystems[i] = GetStats((MemorySubsystem)i);
+
+		return snapshot;
+	}
+
+	MemorySnapshotDiff MemoryTracker::Diff(const MemorySnapshot& from, const MemorySnapshot& to)
+	{
+		MemorySnapshotDiff diff;
+
+		for (size_t i = 0; i < (size_t)MemorySubsystem::Count; i++)
+		{
+			diff.m_liveBytes[i] = (int64)to.m_subsystems[i].m_liveBytes - (int64)from.m_subsystems[i].m_liveBytes;
+			diff.m_liveAllocations[i] = (int64)to.m_subsystems[i].m_liveAllocations - (int64)from.m_subsystems[i].m_liveAllocations;
+			diff.m_allocations[i] = to.m_subsystems[i].m_totalAllocations - from.m_subsystems[i].m_totalAllocations;
+			diff.m_allocatedBytes[i] = to.m_subsystems[i].m_totalBytes - from.m_subsystems[i].m_totalBytes;
+		}
+
+		return diff;
+	}
+
+	void MemoryTracker::ReportAllocationsSince(const MemorySnapshot& snapshot, const char* title)
+	{
+		s_reporting = true;
+		{
+			uint64 totalAllocations = 0;
+			uint64 totalBytes = 0;
+
+			for (size_t i = 0; i < (size_t)MemorySubsystem::Count; i++)
+			{
+				std::map<std::pair<const char*, int32>, CallSite> callSites;
+				uint64 allocations = 0;
+				uint64 bytes = 0;
+
+				{
+					SubsystemRecords& records = s_records[i];
+					std::lock_guard<std::mutex> lock(records.m_mutex);
+
+					for (AllocationRecord* record = records.m_head; record != nullptr; record = record->m_next)
+					{
+						if (record->m_id <= snapshot.m_allocationID)
+							continue;
+
+						CallSite& site = callSites[std::make_pair(record->m_file, record->m_line)];
+						site.m_allocations++;
+						site.m_bytes += record->m_size;
+						allocations++;
+						bytes += record->m_size;
+					}
+				}
+
+				if (allocations == 0)
+					continue;
+
+				LINA_CORE_WARN("{0}: {1} allocations, {2} bytes alive in {3}", title, allocations, bytes, GenericMemory::getSubsystemName((MemorySubsystem)i));
+
+				for (auto& pair : callSites)
+				{
+					// Global new doesn't know its call site.
+					if (pair.first.first == nullptr)
+					{
+						LINA_CORE_WARN("    operator new: {0} allocations, {1} bytes", pair.second.m_allocations, pair.second.m_bytes);
+					}
+					else
+					{
+						LINA_CORE_WARN("    {0}({1}): {2} allocations, {3} bytes", pair.first.first, pair.first.second, pair.second.m_allocations, pair.second.m_bytes);
+					}
+				}
+
+				totalAllocations += allocations;
+				totalBytes += bytes;
+			}
+
+			if (totalAllocations == 0)
+				LINA_CORE_INFO("{0}: no allocations alive.", title);
+		}
+		s_reporting = false;
+	}
+
+	void MemoryTracker::ReportLeaks()
+	{
+		ReportAllocationsSince(MemorySnapshot(), "Memory leaks");
+	}
+
+	MemorySubsystem MemoryTracker::GetCurrentSubsystem()
+	{
+		return s_currentSubsystem;
+	}
+
+	void MemoryTracker::SetCurrentSubsystem(MemorySubsystem subsystem)
+	{
+		s_currentSubsystem = subsystem;
+	}
+
+	void MemoryTracker::OnAllocate(void* recordPtr, void* base, size_t size, MemorySubsystem subsystem, const char* file, int line)
+	{
+		AllocationRecord* record = (AllocationRecord*)recordPtr;
+		record->m_prev = nullptr;
+		record->m_next = nullptr;
+		record->m_base = base;
+		record->m_file = file;
+		record->m_size = size;
+		record->m_line = line;
+		record->m_subsystem = subsystem;
+		record->m_linked = !s_reporting;
+		record->m_id = 0;
+
+		if (!record->m_linked)
+			return;
+
+		SubsystemRecords& records = s_records[(size_t)subsystem];
+		record->m_id = s_nextAllocationID.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			std::lock_guard<std::mutex> lock(records.m_mutex);
+			record->m_next = records.m_head;
+			if (records.m_head != nullptr)
+				records.m_head->m_prev = record;
+			records.m_head = record;
+		}
+
+		records.m_liveAllocations.fetch_add(1, std::memory_order_relaxed);
+		records.m_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+		records.m_totalBytes.fetch_add(size, std::memory_order_relaxed);
+		uint64 live = records.m_liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		uint64 peak = records.m_peakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !records.m_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+	}
+
+	void MemoryTracker::OnFree(void* recordPtr)
+	{
+		AllocationRecord* record = (AllocationRecord*)recordPtr;
+		if (!record->m_linked)
+			return;
+
+		SubsystemRecords& records = s_records[(size_t)record->m_subsystem];
+
+		{
+			std::lock_guard<std::mutex> lock(records.m_mutex);
+			if (record->m_prev != nullptr)
+				record->m_prev->m_next = record->m_next;
+			else
+				records.m_head = record->m_next;
+
+			if (record->m_next != nullptr)
+				record->m_next->m_prev = record->m_prev;
+		}
+
+		records.m_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		records.m_liveBytes.fetch_sub(record->m_size, std::memory_order_relaxed);
+		record->m_linked = false;
+	}
+
+	void* MemoryTracker::GetBase(void* record)
+	{
+		return ((AllocationRecord*)record)->m_base;
+	}
+}
+
+#else
+
+namespace LinaEngine
+{
+	void MemoryTracker::BeginFrame() {}
+	MemorySubsystemStats MemoryTracker::GetStats(MemorySubsystem subsystem) { return MemorySubsystemStats(); }
+	MemorySnapshot MemoryTracker::TakeSnapshot() { return MemorySnapshot(); }
+	MemorySnapshotDiff MemoryTracker::Diff(const MemorySnapshot& from, const MemorySnapshot& to) { return MemorySnapshotDiff(); }
+	void MemoryTracker::ReportAllocationsSince(const MemorySnapshot& snapshot, const char* title) {}
+	void MemoryTracker::ReportLeaks() {}
+	MemorySubsystem MemoryTracker::GetCurrentSubsystem() { return MemorySubsystem::General; }
+	void MemoryTracker::SetCurrentSubsystem(MemorySubsystem subsystem) {}
+	void MemoryTracker::OnAllocate(void* record, void* base, size_t size, MemorySubsystem subsystem, const char* file, int line) {}
+	void MemoryTracker::OnFree(void* record) {}
+	void* MemoryTracker::GetBase(void* record) { return record; }
+}
+
+#endif
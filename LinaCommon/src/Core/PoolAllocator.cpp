@@ -0,0 +1,120 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: PoolAllocator
+
+Timestamp: 11/4/2020 1:37:45 AM
+*/
+
+#include "Core/PoolAllocator.hpp"
+
+namespace LinaEngine
+{
+	PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerChunk, size_t alignment, MemorySubsystem subsystem)
+	{
+		m_subsystem = subsystem;
+
+		// Free blocks hold the list link.
+		m_alignment = alignment < sizeof(FreeBlock*) ? sizeof(FreeBlock*) : alignment;
+		m_blockSize = GenericMemory::align(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize, m_alignment);
+		m_blocksPerChunk = blocksPerChunk == 0 ? 1 : blocksPerChunk;
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		for (void* chunk : m_chunks)
+			GenericMemory::free(chunk);
+	}
+
+	void* PoolAllocator::Allocate()
+	{
+		if (m_freeList == nullptr)
+		{
+			AddChunk();
+			if (m_freeList == nullptr)
+				return nullptr;
+		}
+
+		FreeBlock* block = m_freeList;
+		m_freeList = block->m_next;
+
+		m_stats.m_usedBytes += m_blockSize;
+		m_stats.m_freeBytes -= m_blockSize;
+		m_stats.m_liveAllocations++;
+		m_stats.m_totalAllocations++;
+		if (m_stats.m_usedBytes > m_stats.m_peakUsedBytes)
+			m_stats.m_peakUsedBytes = m_stats.m_usedBytes;
+
+		return block;
+	}
+
+	void PoolAllocator::Free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		FreeBlock* block = (FreeBlock*)ptr;
+		block->m_next = m_freeList;
+		m_freeList = block;
+
+		m_stats.m_usedBytes -= m_blockSize;
+		m_stats.m_freeBytes += m_blockSize;
+		m_stats.m_liveAllocations--;
+	}
+
+	AllocatorStats PoolAllocator::GetStats() const
+	{
+		// Any free block serves any request, so a pool doesn't fragment.
+		AllocatorStats stats = m_stats;
+		stats.m_largestFreeBlock = stats.m_freeBytes;
+		return stats;
+	}
+
+	void PoolAllocator::AddChunk()
+	{
+		const size_t chunkSize = m_blockSize * m_blocksPerChunk;
+		void* chunk = GenericMemory::malloc(chunkSize, (uint32)m_alignment, m_subsystem, __FILE__, __LINE__);
+		if (chunk == nullptr)
+			return;
+
+		m_chunks.push_back(chunk);
+
+		// Blocks are linked in address order so consecutive allocations are adjacent.
+		uint8* begin = (uint8*)chunk;
+		for (size_t i = m_blocksPerChunk; i > 0; i--)
+		{
+			FreeBlock* block = (FreeBlock*)(begin + (i - 1) * m_blockSize);
+			block->m_next = m_freeList;
+			m_freeList = block;
+		}
+
+		m_stats.m_reservedBytes += chunkSize;
+		m_stats.m_freeBytes += chunkSize;
+	}
+}
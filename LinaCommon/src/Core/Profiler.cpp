@@ -0,0 +1,538 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: Profiler
+
+Timestamp: 11/4/2020 3:02:47 PM
+*/
+
+#include "Core/Profiler.hpp"
+#include "Utility/Log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+
+// The time stamp counter is read in a few cycles, the clocks of the OS can take tens of nanoseconds.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PROFILER_USE_TSC
+#ifdef LINA_COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace LinaEngine
+{
+#ifdef PROFILER_USE_TSC
+	double Profiler::s_msPerTick = 1.0 / 3000000.0;
+#else
+	double Profiler::s_msPerTick = 1.0 / 1000000.0;
+#endif
+	uint64 Profiler::s_frameIndex = 0;
+	int64 Profiler::s_frameStart = 0;
+	double Profiler::s_frameMs = 0.0;
+	std::vector<ProfilerThread> Profiler::s_threads;
+	std::vector<ProfilerEvent> Profiler::s_collectedEvents;
+
+	namespace
+	{
+		// Single producer ring, written by the owning thread & drained by the thread marking the frames.
+		struct ThreadBuffer
+		{
+			ProfilerEvent m_events[PROFILER_THREAD_EVENT_COUNT];
+			std::atomic<uint64> m_writeIndex{ 0 };
+			std::atomic<bool> m_inUse{ true };
+			uint64 m_readIndex = 0;
+			uint32 m_depth = 0;
+
+			// Guarded by the registry mutex.
+			std::string m_name = "";
+		};
+
+		// Buffers of exited threads are handed to new ones, their ring & call tree are reused.
+		struct ThreadBufferHandle
+		{
+			ThreadBuffer* m_buffer = nullptr;
+			~ThreadBufferHandle() { if (m_buffer != nullptr) m_buffer->m_inUse.store(false, std::memory_order_release); }
+		};
+
+		std::mutex s_registryMutex;
+		std::vector<ThreadBuffer*> s_bufferSnapshot;
+
+		struct CapturedEvent
+		{
+			ProfilerEvent m_event;
+			uint32 m_thread = 0;
+		};
+
+		struct CapturedCounter
+		{
+			const ProfilerZone* m_counter = nullptr;
+			int64 m_ticks = 0;
+			double m_value = 0.0;
+		};
+
+		// Set from the call to BeginCapture until the trace is written, counters are only locked for while it's set.
+		std::atomic<bool> s_capturing{ false };
+		std::mutex s_captureMutex;
+		bool s_captureStarted = false;
+		uint32 s_captureFramesLeft = 0;
+		int64 s_captureStartTicks = 0;
+		std::string s_capturePath = "";
+		std::vector<CapturedEvent> s_capturedEvents;
+		std::vector<int64> s_capturedFrames;
+		std::vector<CapturedCounter> s_capturedCounters;
+
+		// The plain pointer is what zones read, the handle's destructor would add an initialization check.
+		thread_local ThreadBuffer* s_threadBuffer = nullptr;
+		thread_local ThreadBufferHandle s_threadBufferHandle;
+
+		int64 GetSteadyNanoseconds()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		int64 ReadTicks()
+		{
+#ifdef PROFILER_USE_TSC
+			return (int64)__rdtsc();
+#else
+			return GetSteadyNanoseconds();
+#endif
+		}
+
+		// The tick rate is measured against the steady clock over the lifetime of the program.
+		const int64 s_originTicks = ReadTicks();
+		const int64 s_originNanoseconds = GetSteadyNanoseconds();
+
+		// Never destroyed, threads may still close zones during static destruction.
+		std::vector<ThreadBuffer*>& GetBuffers()
+		{
+			static std::vector<ThreadBuffer*>* s_buffers = new std::vector<ThreadBuffer*>();
+			return *s_buffers;
+		}
+
+		ThreadBuffer& RegisterThread()
+		{
+			std::lock_guard<std::mutex> lock(s_registryMutex);
+			std::vector<ThreadBuffer*>& buffers = GetBuffers();
+			ThreadBuffer* buffer = nullptr;
+
+			for (ThreadBuffer* retired : buffers)
+			{
+				bool inUse = false;
+				if (retired->m_inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+				{
+					buffer = retired;
+					buffer->m_depth = 0;
+					break;
+				}
+			}
+
+			// Taken from the system heap, buffers live as long as the program & shouldn't show up in the memory reports.
+			if (buffer == nullptr)
+			{
+				buffer = new (std::malloc(sizeof(ThreadBuffer))) ThreadBuffer();
+				buffers.push_back(buffer);
+			}
+
+			buffer->m_name = "Thread " + std::to_string(std::find(buffers.begin(), buffers.end(), buffer) - buffers.begin());
+			s_threadBuffer = buffer;
+			s_threadBufferHandle.m_buffer = buffer;
+			return *buffer;
+		}
+
+		inline ThreadBuffer& GetThreadBuffer()
+		{
+			return s_threadBuffer != nullptr ? *s_threadBuffer : RegisterThread();
+		}
+
+		void DrainBuffer(ThreadBuffer& buffer, std::vector<ProfilerEvent>& events, uint64& dropped)
+		{
+			const uint64 mask = PROFILER_THREAD_EVENT_COUNT - 1;
+			const uint64 write = buffer.m_writeIndex.load(std::memory_order_acquire);
+			uint64 read = buffer.m_readIndex;
+
+			if (write - read > PROFILER_THREAD_EVENT_COUNT)
+			{
+				dropped += write - read - PROFILER_THREAD_EVENT_COUNT;
+				read = write - PROFILER_THREAD_EVENT_COUNT;
+			}
+
+			const size_t first = events.size();
+			for (uint64 i = read; i < write; i++)
+				events.push_back(buffer.m_events[i & mask]);
+
+			// The owner keeps writing while we copy, slots it has lapped in the meantime can't be trusted.
+			const uint64 after = buffer.m_writeIndex.load(std::memory_order_acquire);
+			if (after - read > PROFILER_THREAD_EVENT_COUNT)
+			{
+				const uint64 overwritten = std::min(after - read - PROFILER_THREAD_EVENT_COUNT, write - read);
+				events.erase(events.begin() + first, events.begin() + first + (size_t)overwritten);
+				dropped += overwritten;
+			}
+
+			buffer.m_readIndex = write;
+		}
+
+		void WriteJsonString(std::ofstream& stream, const char* text)
+		{
+			stream << '"';
+			for (const char* c = text; *c != '\0'; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					stream << '\\' << *c;
+				else if ((unsigned char)*c < 0x20)
+				{
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)(unsigned char)*c);
+					stream << escaped;
+				}
+				else
+					stream << *c;
+			}
+			stream << '"';
+		}
+
+		int32 FindOrAddChild(std::vector<ProfilerNode>& nodes, int32 parent, const ProfilerZone* zone)
+		{
+			for (int32 child = nodes[parent].m_firstChild; child != -1; child = nodes[child].m_nextSibling)
+			{
+				if (nodes[child].m_zone == zone)
+					return child;
+			}
+
+			// Zones are merged from the last one to close, prepending keeps the children in the order they were entered.
+			ProfilerNode node;
+			node.m_zone = zone;
+			node.m_parent = parent;
+			node.m_depth = nodes[parent].m_depth + 1;
+			node.m_nextSibling = nodes[parent].m_firstChild;
+			nodes.push_back(node);
+
+			const int32 index = (int32)nodes.size() - 1;
+			nodes[parent].m_firstChild = index;
+			return index;
+		}
+	}
+
+	int64 Profiler::GetTicks()
+	{
+		return ReadTicks();
+	}
+
+	int64 Profiler::BeginZone()
+	{
+		GetThreadBuffer().m_depth++;
+		return ReadTicks();
+	}
+
+	void Profiler::EndZone(const ProfilerZone& zone, int64 begin)
+	{
+		const int64 end = ReadTicks();
+		ThreadBuffer& buffer = GetThreadBuffer();
+		const uint64 index = buffer.m_writeIndex.load(std::memory_order_relaxed);
+
+		ProfilerEvent& event = buffer.m_events[index & (PROFILER_THREAD_EVENT_COUNT - 1)];
+		event.m_zone = &zone;
+		event.m_begin = begin;
+		event.m_end = end;
+		event.m_depth = --buffer.m_depth;
+
+		buffer.m_writeIndex.store(index + 1, std::memory_order_release);
+	}
+
+	void Profiler::MarkFrame()
+	{
+		CalibrateTicks();
+
+		const int64 now = ReadTicks();
+		if (s_frameStart != 0)
+			s_frameMs = TicksToMs(now - s_frameStart);
+
+		s_frameStart = now;
+		s_frameIndex++;
+
+		{
+			std::lock_guard<std::mutex> lock(s_registryMutex);
+			s_bufferSnapshot = GetBuffers();
+
+			if (s_threads.size() < s_bufferSnapshot.size())
+				s_threads.resize(s_bufferSnapshot.size());
+
+			for (size_t i = 0; i < s_bufferSnapshot.size(); i++)
+			{
+				if (s_threads[i].m_name != s_bufferSnapshot[i]->m_name)
+					s_threads[i].m_name = s_bufferSnapshot[i]->m_name;
+			}
+		}
+
+		const bool capturing = s_capturing.load(std::memory_order_acquire);
+
+		for (size_t i = 0; i < s_bufferSnapshot.size(); i++)
+		{
+			s_collectedEvents.clear();
+			DrainBuffer(*s_bufferSnapshot[i], s_collectedEvents, s_threads[i].m_droppedEvents);
+			MergeEvents(s_threads[i], s_collectedEvents);
+
+			if (capturing && s_captureStarted)
+			{
+				for (const ProfilerEvent& event : s_collectedEvents)
+				{
+					// Zones that were opened before the capture began are left out.
+					if (event.m_begin >= s_captureStartTicks)
+						s_capturedEvents.push_back({ event, (uint32)i });
+				}
+			}
+		}
+
+		if (!capturing)
+			return;
+
+		bool finished = false;
+		{
+			std::lock_guard<std::mutex> lock(s_captureMutex);
+
+			if (!s_captureStarted)
+			{
+				s_captureStarted = true;
+				s_captureStartTicks = now;
+			}
+			else
+				finished = --s_captureFramesLeft == 0;
+
+			s_capturedFrames.push_back(now);
+		}
+
+		if (finished)
+			EndCapture();
+	}
+
+	void Profiler::BeginCapture(uint32 frameCount, const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(s_captureMutex);
+
+		if (s_capturing.load(std::memory_order_relaxed))
+		{
+			LINA_CORE_WARN("Profiler -> A capture is already in progress, {0} will not be written.", path);
+			return;
+		}
+
+		s_captureStarted = false;
+		s_captureFramesLeft = std::max(frameCount, (uint32)1);
+		s_capturePath = path;
+		s_capturedEvents.clear();
+		s_capturedFrames.clear();
+		s_capturedCounters.clear();
+		s_capturing.store(true, std::memory_order_release);
+	}
+
+	void Profiler::EndCapture()
+	{
+		if (!s_capturing.load(std::memory_order_acquire))
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(s_captureMutex);
+			s_capturing.store(false, std::memory_order_release);
+		}
+
+		if (!s_captureStarted)
+			return;
+
+		if (WriteCapture())
+		{
+			LINA_CORE_INFO("Profiler -> Captured {0} frames, {1} zones to {2}", s_capturedFrames.size() - 1, s_capturedEvents.size(), s_capturePath);
+		}
+		else
+		{
+			LINA_CORE_ERR("Profiler -> Capture could not be written to {0}", s_capturePath);
+		}
+
+		s_captureStarted = false;
+		s_capturedEvents = std::vector<CapturedEvent>();
+		s_capturedFrames = std::vector<int64>();
+		s_capturedCounters = std::vector<CapturedCounter>();
+	}
+
+	bool Profiler::GetIsCapturing()
+	{
+		return s_capturing.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::RecordCounter(const ProfilerZone& counter, double value)
+	{
+		if (!s_capturing.load(std::memory_order_relaxed))
+			return;
+
+		const int64 ticks = ReadTicks();
+		std::lock_guard<std::mutex> lock(s_captureMutex);
+		if (s_captureStarted && s_capturing.load(std::memory_order_relaxed))
+			s_capturedCounters.push_back({ &counter, ticks, value });
+	}
+
+	bool Profiler::WriteCapture()
+	{
+		std::ofstream stream(s_capturePath, std::ios::binary);
+		if (!stream.is_open())
+			return false;
+
+		// Chrome trace format, times are in microseconds from the start of the capture.
+		const double usPerTick = s_msPerTick * 1000.0;
+		char buffer[128];
+		bool first = true;
+
+		auto separate = [&]()
+		{
+			stream << (first ? "\n" : ",\n");
+			first = false;
+		};
+
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		for (size_t i = 0; i < s_threads.size(); i++)
+		{
+			separate();
+			stream << "{\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+			WriteJsonString(stream, s_threads[i].m_name.c_str());
+			stream << "}}";
+		}
+
+		for (size_t i = 0; i < s_capturedFrames.size(); i++)
+		{
+			separate();
+			std::snprintf(buffer, sizeof(buffer), "{\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"name\":\"Frame %zu\",\"ts\":%.3f}",
+				i, (double)(s_capturedFrames[i] - s_captureStartTicks) * usPerTick);
+			stream << buffer;
+		}
+
+		for (const CapturedEvent& captured : s_capturedEvents)
+		{
+			separate();
+			stream << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << captured.m_thread << ",\"name\":";
+			WriteJsonString(stream, captured.m_event.m_zone->m_name);
+			std::snprintf(buffer, sizeof(buffer), ",\"ts\":%.3f,\"dur\":%.3f}",
+				(double)(captured.m_event.m_begin - s_captureStartTicks) * usPerTick, (double)(captured.m_event.m_end - captured.m_event.m_begin) * usPerTick);
+			stream << buffer;
+		}
+
+		for (const CapturedCounter& counter : s_capturedCounters)
+		{
+			separate();
+			stream << "{\"ph\":\"C\",\"pid\":0,\"tid\":0,\"name\":";
+			WriteJsonString(stream, counter.m_counter->m_name);
+			std::snprintf(buffer, sizeof(buffer), ",\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+				(double)(counter.m_ticks - s_captureStartTicks) * usPerTick, counter.m_value);
+			stream << buffer;
+		}
+
+		stream << "\n]}\n";
+		return stream.good();
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		buffer.m_name = name;
+	}
+
+	const ProfilerNode* Profiler::FindNode(const char* name)
+	{
+		for (const ProfilerThread& thread : s_threads)
+		{
+			for (const ProfilerNode& node : thread.m_nodes)
+			{
+				if (node.m_zone != nullptr && std::strcmp(node.m_zone->m_name, name) == 0)
+					return &node;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void Profiler::MergeEvents(ProfilerThread& thread, const std::vector<ProfilerEvent>& events)
+	{
+		std::vector<ProfilerNode>& nodes = thread.m_nodes;
+		if (nodes.empty())
+			nodes.push_back(ProfilerNode());
+
+		for (ProfilerNode& node : nodes)
+		{
+			node.m_frameCalls = 0;
+			node.m_frameMs = 0.0;
+		}
+
+		// Zones are written as they close, so a parent comes after all of its children. Walking backwards
+		// every zone comes after its parent, the last zone seen at each depth is the parent of the next one below it.
+		int32 path[PROFILER_MAX_DEPTH];
+		uint32 pathLength = 0;
+
+		for (size_t i = events.size(); i > 0; i--)
+		{
+			const ProfilerEvent& event = events[i - 1];
+
+			// Zones whose parent is still open or was dropped are attached to the deepest known one.
+			const uint32 depth = std::min(std::min(event.m_depth, pathLength), (uint32)PROFILER_MAX_DEPTH - 1);
+			const int32 parent = depth == 0 ? 0 : path[depth - 1];
+			const int32 node = FindOrAddChild(nodes, parent, event.m_zone);
+			const double ms = TicksToMs(event.m_end - event.m_begin);
+
+			nodes[node].m_frameCalls++;
+			nodes[node].m_frameMs += ms;
+			path[depth] = node;
+			pathLength = depth + 1;
+
+			if (depth == 0)
+				nodes[0].m_frameMs += ms;
+		}
+
+		for (ProfilerNode& node : nodes)
+			node.m_averageMs = node.m_averageMs == 0.0 ? node.m_frameMs : node.m_averageMs + (node.m_frameMs - node.m_averageMs) * PROFILER_AVERAGE_WEIGHT;
+	}
+
+	void Profiler::CalibrateTicks()
+	{
+#ifdef PROFILER_USE_TSC
+		const int64 elapsedNanoseconds = GetSteadyNanoseconds() - s_originNanoseconds;
+		const int64 elapsedTicks = ReadTicks() - s_originTicks;
+
+		// Too short to be measured reliably, the initial guess is kept until then.
+		if (elapsedNanoseconds > 1000000 && elapsedTicks > 0)
+			s_msPerTick = (double)elapsedNanoseconds / 1000000.0 / (double)elapsedTicks;
+#endif
+	}
+}
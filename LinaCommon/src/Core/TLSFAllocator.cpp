@@ -0,0 +1,438 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: TLSFAllocator
+
+Timestamp: 11/4/2020 1:03:27 AM
+*/
+
+#include "Core/TLSFAllocator.hpp"
+#include <cstdlib>
+
+#ifdef LINA_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace LinaEngine
+{
+	namespace
+	{
+		const size_t BLOCK_FREE_BIT = 1;
+
+		// Every block starts with the previous physical block & its size, the payload follows.
+		const size_t BLOCK_OVERHEAD = TLSFAllocator::ALIGN_SIZE;
+
+		// Free blocks keep their list links in the payload.
+		const size_t MIN_BLOCK_SIZE = TLSFAllocator::ALIGN_SIZE;
+
+		const uint32 FL_INDEX_SHIFT = TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2;
+		const size_t SMALL_BLOCK_SIZE = (size_t)1 << FL_INDEX_SHIFT;
+
+		inline uint32 FindFirstSet(uint32 word)
+		{
+#ifdef LINA_COMPILER_MSVC
+			unsigned long index;
+			_BitScanForward(&index, word);
+			return (uint32)index;
+#else
+			return (uint32)__builtin_ctz(word);
+#endif
+		}
+
+		inline uint32 FindLastSet(size_t size)
+		{
+#if defined(LINA_COMPILER_MSVC) && defined(_WIN64)
+			unsigned long index;
+			_BitScanReverse64(&index, size);
+			return (uint32)index;
+#elif defined(LINA_COMPILER_MSVC)
+			unsigned long index;
+			_BitScanReverse(&index, (unsigned long)size);
+			return (uint32)index;
+#else
+			return 63 - (uint32)__builtin_clzll((unsigned long long)size);
+#endif
+		}
+
+		inline size_t AdjustSize(size_t size)
+		{
+			size = GenericMemory::align(size, TLSFAllocator::ALIGN_SIZE);
+			return size < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : size;
+		}
+
+		// Rounds up to the next bucket so every block of the bucket found for it fits.
+		inline size_t RoundUpForSearch(size_t size)
+		{
+			if (size >= SMALL_BLOCK_SIZE)
+				size += ((size_t)1 << (FindLastSet(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+
+			return size;
+		}
+
+		inline void MappingInsert(size_t size, uint32& fl, uint32& sl)
+		{
+			if (size < SMALL_BLOCK_SIZE)
+			{
+				fl = 0;
+				sl = (uint32)(size / (SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+			}
+			else
+			{
+				uint32 bit = FindLastSet(size);
+				sl = (uint32)(size >> (bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ (uint32)TLSF_SL_INDEX_COUNT;
+				fl = bit - (FL_INDEX_SHIFT - 1);
+			}
+		}
+	}
+
+	struct TLSFAllocator::Block
+	{
+		Block* m_prevPhysical;
+		size_t m_size;
+
+		size_t GetSize() const { return m_size & ~BLOCK_FREE_BIT; }
+		void SetSize(size_t size) { m_size = size | (m_size & BLOCK_FREE_BIT); }
+		bool IsFree() const { return (m_size & BLOCK_FREE_BIT) != 0; }
+		void SetFree(bool isFree) { m_size = isFree ? (m_size | BLOCK_FREE_BIT) : (m_size & ~BLOCK_FREE_BIT); }
+
+		// Free block spanning a whole pool.
+		bool IsPoolSized() { return m_prevPhysical == nullptr && GetNext()->GetSize() == 0; }
+
+		uint8* GetPtr() { return (uint8*)this + BLOCK_OVERHEAD; }
+		Block* GetNext() { return (Block*)(GetPtr() + GetSize()); }
+		Block*& NextFree() { return ((Block**)GetPtr())[0]; }
+		Block*& PrevFree() { return ((Block**)GetPtr())[1]; }
+
+		static Block* FromPtr(const void* ptr) { return (Block*)((uint8*)ptr - BLOCK_OVERHEAD); }
+	};
+
+	struct TLSFAllocator::Pool
+	{
+		Pool* m_next;
+		Pool* m_prev;
+		void* m_raw;
+		size_t m_size;
+	};
+
+	namespace
+	{
+		const size_t POOL_OVERHEAD = GenericMemory::align(sizeof(void*) * 4, TLSFAllocator::ALIGN_SIZE);
+	}
+
+	TLSFAllocator::TLSFAllocator(size_t poolSize) : m_poolSize(poolSize)
+	{
+
+	}
+
+	TLSFAllocator::~TLSFAllocator()
+	{
+		while (m_pools != nullptr)
+		{
+			Pool* next = m_pools->m_next;
+			std::free(m_pools->m_raw);
+			m_pools = next;
+		}
+	}
+
+	void* TLSFAllocator::Allocate(size_t size, size_t alignment)
+	{
+		if (alignment < ALIGN_SIZE)
+			alignment = ALIGN_SIZE;
+
+		const size_t adjusted = AdjustSize(size);
+
+		// Leaves room for a free block in front of the aligned pointer.
+		const size_t searchSize = alignment > ALIGN_SIZE ? adjusted + alignment + BLOCK_OVERHEAD + MIN_BLOCK_SIZE : adjusted;
+
+		Block* block = LocateFree(searchSize);
+
+		if (block == nullptr)
+		{
+			if (!AddPool(searchSize))
+				return nullptr;
+
+			block = LocateFree(searchSize);
+			if (block == nullptr)
+				return nullptr;
+		}
+
+		if (alignment > ALIGN_SIZE)
+		{
+			uint8* ptr = block->GetPtr();
+			uint8* aligned = GenericMemory::align(ptr, alignment);
+			size_t gap = (size_t)(aligned - ptr);
+
+			// The gap has to fit a block on its own.
+			if (gap != 0 && gap < BLOCK_OVERHEAD + MIN_BLOCK_SIZE)
+			{
+				aligned = GenericMemory::align(ptr + BLOCK_OVERHEAD + MIN_BLOCK_SIZE, alignment);
+				gap = (size_t)(aligned - ptr);
+			}
+
+			if (gap != 0)
+			{
+				Block* alignedBlock = (Block*)(aligned - BLOCK_OVERHEAD);
+				alignedBlock->m_size = block->GetSize() - gap;
+				alignedBlock->m_prevPhysical = block;
+				alignedBlock->GetNext()->m_prevPhysical = alignedBlock;
+
+				block->SetSize(gap - BLOCK_OVERHEAD);
+				InsertFree(block);
+				block = alignedBlock;
+			}
+		}
+
+		SplitTrailing(block, adjusted);
+		block->SetFree(false);
+
+		m_stats.m_usedBytes += block->GetSize();
+		m_stats.m_liveAllocations++;
+		m_stats.m_totalAllocations++;
+		if (m_stats.m_usedBytes > m_stats.m_peakUsedBytes)
+			m_stats.m_peakUsedBytes = m_stats.m_usedBytes;
+
+		return block->GetPtr();
+	}
+
+	void TLSFAllocator::Free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		Block* block = Block::FromPtr(ptr);
+		m_stats.m_usedBytes -= block->GetSize();
+		m_stats.m_liveAllocations--;
+		block->SetFree(true);
+
+		// Merge with the physical neighbours.
+		Block* prev = block->m_prevPhysical;
+		if (prev != nullptr && prev->IsFree())
+		{
+			RemoveFree(prev);
+			prev->SetSize(prev->GetSize() + BLOCK_OVERHEAD + block->GetSize());
+			prev->GetNext()->m_prevPhysical = prev;
+			block = prev;
+		}
+
+		Block* next = block->GetNext();
+		if (next->IsFree())
+		{
+			RemoveFree(next);
+			block->SetSize(block->GetSize() + BLOCK_OVERHEAD + next->GetSize());
+			block->GetNext()->m_prevPhysical = block;
+		}
+
+		// One empty pool is kept around so allocations going up & down around a pool boundary don't
+		// reserve & release it every time, the rest are given back.
+		if (block->IsPoolSized())
+		{
+			if (m_emptyPoolCount != 0 && m_poolCount > 1)
+			{
+				RemovePool((Pool*)((uint8*)block - POOL_OVERHEAD));
+				return;
+			}
+
+			m_emptyPoolCount++;
+		}
+
+		InsertFree(block);
+	}
+
+	size_t TLSFAllocator::GetAllocationSize(void* ptr) const
+	{
+		return Block::FromPtr(ptr)->GetSize();
+	}
+
+	AllocatorStats TLSFAllocator::GetStats() const
+	{
+		AllocatorStats stats = m_stats;
+
+		for (uint32 fl = 0; fl < TLSF_FL_INDEX_COUNT; fl++)
+		{
+			for (uint32 sl = 0; sl < TLSF_SL_INDEX_COUNT; sl++)
+			{
+				for (Block* block = m_blocks[fl][sl]; block != nullptr; block = block->NextFree())
+				{
+					stats.m_freeBytes += block->GetSize();
+					if (block->GetSize() > stats.m_largestFreeBlock)
+						stats.m_largestFreeBlock = block->GetSize();
+				}
+			}
+		}
+
+		return stats;
+	}
+
+	bool TLSFAllocator::AddPool(size_t minimumSize)
+	{
+		size_t payload = m_poolSize > POOL_OVERHEAD + BLOCK_OVERHEAD * 2 ? m_poolSize - POOL_OVERHEAD - BLOCK_OVERHEAD * 2 : 0;
+		payload &= ~(ALIGN_SIZE - 1);
+
+		const size_t required = AdjustSize(RoundUpForSearch(minimumSize));
+		if (payload < required)
+			payload = required;
+
+		if (payload >= ((size_t)1 << (TLSF_FL_INDEX_MAX - 1)))
+			return false;
+
+		const size_t size = POOL_OVERHEAD + BLOCK_OVERHEAD + payload + BLOCK_OVERHEAD;
+		void* raw = std::malloc(size + ALIGN_SIZE);
+		if (raw == nullptr)
+			return false;
+
+		Pool* pool = (Pool*)GenericMemory::align((uint8*)raw, ALIGN_SIZE);
+		pool->m_raw = raw;
+		pool->m_size = size;
+		pool->m_prev = nullptr;
+		pool->m_next = m_pools;
+		if (m_pools != nullptr)
+			m_pools->m_prev = pool;
+		m_pools = pool;
+		m_poolCount++;
+		m_stats.m_reservedBytes += size;
+
+		// One free block spanning the pool, followed by a used sentinel of size 0.
+		Block* block = (Block*)((uint8*)pool + POOL_OVERHEAD);
+		block->m_prevPhysical = nullptr;
+		block->m_size = payload | BLOCK_FREE_BIT;
+
+		Block* sentinel = block->GetNext();
+		sentinel->m_prevPhysical = block;
+		sentinel->m_size = 0;
+
+		m_emptyPoolCount++;
+		InsertFree(block);
+		return true;
+	}
+
+	void TLSFAllocator::RemovePool(Pool* pool)
+	{
+		if (pool->m_prev != nullptr)
+			pool->m_prev->m_next = pool->m_next;
+		else
+			m_pools = pool->m_next;
+
+		if (pool->m_next != nullptr)
+			pool->m_next->m_prev = pool->m_prev;
+
+		m_poolCount--;
+		m_stats.m_reservedBytes -= pool->m_size;
+		std::free(pool->m_raw);
+	}
+
+	TLSFAllocator::Block* TLSFAllocator::LocateFree(size_t size)
+	{
+		uint32 fl, sl;
+		MappingInsert(RoundUpForSearch(size), fl, sl);
+
+		if (fl >= TLSF_FL_INDEX_COUNT)
+			return nullptr;
+
+		// First non-empty list in this level, otherwise the first one of a larger level.
+		uint32 slMap = m_slBitmap[fl] & (~0u << sl);
+
+		if (slMap == 0)
+		{
+			const uint32 flMap = fl + 1 < 32 ? m_flBitmap & (~0u << (fl + 1)) : 0;
+			if (flMap == 0)
+				return nullptr;
+
+			fl = FindFirstSet(flMap);
+			slMap = m_slBitmap[fl];
+		}
+
+		sl = FindFirstSet(slMap);
+		Block* block = m_blocks[fl][sl];
+		RemoveFree(block, fl, sl);
+
+		if (block->IsPoolSized())
+			m_emptyPoolCount--;
+
+		return block;
+	}
+
+	void TLSFAllocator::InsertFree(Block* block)
+	{
+		uint32 fl, sl;
+		MappingInsert(block->GetSize(), fl, sl);
+
+		block->SetFree(true);
+		block->PrevFree() = nullptr;
+		block->NextFree() = m_blocks[fl][sl];
+		if (m_blocks[fl][sl] != nullptr)
+			m_blocks[fl][sl]->PrevFree() = block;
+
+		m_blocks[fl][sl] = block;
+		m_flBitmap |= 1u << fl;
+		m_slBitmap[fl] |= 1u << sl;
+	}
+
+	void TLSFAllocator::RemoveFree(Block* block, uint32 fl, uint32 sl)
+	{
+		Block* prev = block->PrevFree();
+		Block* next = block->NextFree();
+
+		if (prev != nullptr)
+			prev->NextFree() = next;
+		if (next != nullptr)
+			next->PrevFree() = prev;
+
+		if (m_blocks[fl][sl] == block)
+		{
+			m_blocks[fl][sl] = next;
+
+			if (next == nullptr)
+			{
+				m_slBitmap[fl] &= ~(1u << sl);
+				if (m_slBitmap[fl] == 0)
+					m_flBitmap &= ~(1u << fl);
+			}
+		}
+	}
+
+	void TLSFAllocator::RemoveFree(Block* block)
+	{
+		uint32 fl, sl;
+		MappingInsert(block->GetSize(), fl, sl);
+		RemoveFree(block, fl, sl);
+	}
+
+	void TLSFAllocator::SplitTrailing(Block* block, size_t size)
+	{
+		if (block->GetSize() < size + BLOCK_OVERHEAD + MIN_BLOCK_SIZE)
+			return;
+
+		Block* remainder = (Block*)(block->GetPtr() + size);
+		remainder->m_size = block->GetSize() - size - BLOCK_OVERHEAD;
+		remainder->m_prevPhysical = block;
+		block->SetSize(size);
+		remainder->GetNext()->m_prevPhysical = remainder;
+		InsertFree(remainder);
+	}
+}
@@ -27,33 +27,14 @@ SOFTWARE.
 */
 
 #include "Core/Timer.hpp"
-#include "Utility/Log.hpp"
 
 namespace LinaEngine
 {
-	std::map<std::string, Timer*> Timer::s_activeTimers;
-
 	void Timer::Stop()
 	{
-		std::chrono::time_point<std::chrono::high_resolution_clock> now = std::chrono::high_resolution_clock::now();
+		std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
 		std::chrono::duration<double, std::milli> ms = now - m_startTimePoint;
 		m_duration = ms.count();
 		m_active = false;
 	}
-
-	Timer& Timer::GetTimer(const std::string& name)
-	{
-		if (s_activeTimers.find(name) == s_activeTimers.end())
-			s_activeTimers[name] = new Timer();
-
-		return *s_activeTimers[name];
-	}
-
-	void Timer::UnloadTimers()
-	{
-		for (std::map<std::string, Timer*>::iterator it = s_activeTimers.begin(); it != s_activeTimers.end(); ++it)
-			delete it->second;
-
-		s_activeTimers.clear();
-	}
-}
\ No newline at end of file
+}
@@ -28,29 +28,88 @@ SOFTWARE.
 
 
 #include "PackageManager/Generic/GenericMemory.hpp"  
+#include "Core/TLSFAllocator.hpp"
+#include "Core/MemoryTracker.hpp"
 #include "Utility/Math/Math.hpp"
 #include <cstdlib>
 #include <stdio.h>
+#include <atomic>
+#include <mutex>
+
+// Original pointer, size & the heap the allocation came from, stored right before the returned pointer.
+// The memory tracker's record goes in front of them.
+#define GENERIC_MEMORY_INFO_SIZE (sizeof(void*) + sizeof(uintptr) * 2)
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+#define GENERIC_MEMORY_HEADER_SIZE (GENERIC_MEMORY_INFO_SIZE + MEMORYTRACKER_RECORD_SIZE)
+#else
+#define GENERIC_MEMORY_HEADER_SIZE GENERIC_MEMORY_INFO_SIZE
+#endif
 
 namespace LinaEngine
 {
+	namespace
+	{
+		struct SubsystemHeap
+		{
+			std::atomic<MemoryHeapType> m_type{ MemoryHeapType::System };
+			std::mutex m_mutex;
+
+			// Created on first selection & never destroyed, allocations may be freed during static destruction.
+			TLSFAllocator* m_tlsf = nullptr;
+		};
 
-	void* GenericMemory::malloc(uintptr amt, uint32 alignment)
+		SubsystemHeap s_heaps[(size_t)MemorySubsystem::Count];
+
+		const char* s_subsystemNames[(size_t)MemorySubsystem::Count] = { "General", "Graphics", "Physics", "ECS", "Editor" };
+
+		inline void* GetOriginalPtr(void* ptr) { return *((void**)((uint8*)ptr - sizeof(void*))); }
+		inline uintptr GetHeapInfo(void* ptr) { return *((uintptr*)((uint8*)ptr - GENERIC_MEMORY_INFO_SIZE)); }
+	}
+
+	void* GenericMemory::malloc(uintptr amt, uint32 alignment, MemorySubsystem subsystem, const char* file, int line)
 	{
 		alignment = Math::Max(amt >= 16 ? 16u : 8u, alignment);
-		void* ptr = ::malloc(amt + alignment + sizeof(void*) + sizeof(uintptr));
-		void* result = align((uint8*)ptr + sizeof(void*) + sizeof(uintptr), (uintptr)alignment);
+		SubsystemHeap& heap = s_heaps[(size_t)subsystem];
+		MemoryHeapType type = heap.m_type.load(std::memory_order_acquire);
+		void* ptr = nullptr;
+		void* result = nullptr;
+
+		if (type == MemoryHeapType::TLSF)
+		{
+			// TLSF aligns the block itself, the header is padded to keep the alignment.
+			uintptr headerSize = align((uintptr)GENERIC_MEMORY_HEADER_SIZE, (uintptr)alignment);
+			std::lock_guard<std::mutex> lock(heap.m_mutex);
+			ptr = heap.m_tlsf->Allocate(amt + headerSize, alignment);
+			if (ptr == nullptr) return nullptr;
+			result = (uint8*)ptr + headerSize;
+		}
+		else
+		{
+			ptr = ::malloc(amt + alignment + GENERIC_MEMORY_HEADER_SIZE);
+			if (ptr == nullptr) return nullptr;
+			result = align((uint8*)ptr + GENERIC_MEMORY_HEADER_SIZE, (uintptr)alignment);
+		}
+
 		*((void**)((uint8*)result - sizeof(void*))) = ptr;
 		*((uintptr*)((uint8*)result - sizeof(void*) - sizeof(uintptr))) = amt;
+		*((uintptr*)((uint8*)result - GENERIC_MEMORY_INFO_SIZE)) = ((uintptr)type << 8) | (uintptr)subsystem;
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+		// General allocations are attributed to the subsystem whose scope they're made in.
+		MemorySubsystem tag = subsystem == MemorySubsystem::General ? MemoryTracker::GetCurrentSubsystem() : subsystem;
+		MemoryTracker::OnAllocate((uint8*)result - GENERIC_MEMORY_HEADER_SIZE, ptr, amt, tag, file, line);
+#endif
+
 		return result;
 	}
 
-	void* GenericMemory::realloc(void* ptr, uintptr amt, uint32 alignment)
+	void* GenericMemory::realloc(void* ptr, uintptr amt, uint32 alignment, MemorySubsystem subsystem, const char* file, int line)
 	{
 		alignment = Math::Max(amt >= 16 ? 16u : 8u, alignment);
 
 		if (ptr == nullptr) 
-			return GenericMemory::malloc(amt, alignment);
+			return GenericMemory::malloc(amt, alignment, subsystem, file, line);
 
 		if (amt == 0) 
 		{
@@ -58,7 +117,7 @@ namespace LinaEngine
 			return nullptr;
 		}
 
-		void* result = malloc(amt, alignment);
+		void* result = malloc(amt, alignment, subsystem, file, line);
 		uintptr size = GenericMemory::getAllocSize(ptr);
 		GenericMemory::memcpy(result, ptr, Math::Min(size, amt));
 		free(ptr);
@@ -68,8 +127,23 @@ namespace LinaEngine
 
 	void* GenericMemory::free(void* ptr)
 	{
-		if (ptr) 
-			::free(*((void**)((uint8*)ptr - sizeof(void*))));	
+		if (ptr == nullptr)
+			return nullptr;
+
+#ifdef LINA_ENABLE_MEMORYTRACKING
+		MemoryTracker::OnFree((uint8*)ptr - GENERIC_MEMORY_HEADER_SIZE);
+#endif
+
+		uintptr info = GetHeapInfo(ptr);
+
+		if ((MemoryHeapType)(info >> 8) == MemoryHeapType::TLSF)
+		{
+			SubsystemHeap& heap = s_heaps[info & 0xFF];
+			std::lock_guard<std::mutex> lock(heap.m_mutex);
+			heap.m_tlsf->Free(GetOriginalPtr(ptr));
+		}
+		else
+			::free(GetOriginalPtr(ptr));
 
 		return nullptr;
 	}
@@ -79,6 +153,34 @@ namespace LinaEngine
 		return *((uintptr*)((uint8*)ptr - sizeof(void*) - sizeof(uintptr)));
 	}
 
+	void GenericMemory::setHeapType(MemorySubsystem subsystem, MemoryHeapType type)
+	{
+		SubsystemHeap& heap = s_heaps[(size_t)subsystem];
+		std::lock_guard<std::mutex> lock(heap.m_mutex);
+
+		if (type == MemoryHeapType::TLSF && heap.m_tlsf == nullptr)
+			heap.m_tlsf = new TLSFAllocator();
+
+		heap.m_type.store(type, std::memory_order_release);
+	}
+
+	MemoryHeapType GenericMemory::getHeapType(MemorySubsystem subsystem)
+	{
+		return s_heaps[(size_t)subsystem].m_type.load(std::memory_order_acquire);
+	}
+
+	AllocatorStats GenericMemory::getHeapStats(MemorySubsystem subsystem)
+	{
+		SubsystemHeap& heap = s_heaps[(size_t)subsystem];
+		std::lock_guard<std::mutex> lock(heap.m_mutex);
+		return heap.m_tlsf == nullptr ? AllocatorStats() : heap.m_tlsf->GetStats();
+	}
+
+	const char* GenericMemory::getSubsystemName(MemorySubsystem subsystem)
+	{
+		return s_subsystemNames[(size_t)subsystem];
+	}
+
 	void GenericMemory::bigmemswap(void* a, void* b, uintptr size)
 	{
 		uint64* ptr1 = (uint64*)a;
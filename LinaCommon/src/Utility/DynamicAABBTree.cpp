@@ -0,0 +1,729 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: DynamicAABBTree
+
+Timestamp: 11/3/2020 5:40:26 PM
+*/
+
+#include "Utility/DynamicAABBTree.hpp"
+#include "Core/JobSystem.hpp"
+#include "Utility/Log.hpp"
+#include <algorithm>
+
+namespace LinaEngine
+{
+	// Trees smaller than this are cheap to query no matter how they are built.
+	#define AABBTREE_MIN_REBUILD_PROXIES 64
+	#define AABBTREE_BIN_COUNT 16
+
+	struct DynamicAABBTree::BuildState
+	{
+		JobCounter m_counter;
+		std::vector<BuildPrimitive> m_primitives;
+		std::vector<Node> m_nodes;
+		int32 m_root = AABBTREE_NULL_NODE;
+		double m_internalArea = 0.0;
+		double m_leafArea = 0.0;
+	};
+
+	DynamicAABBTree::DynamicAABBTree()
+	{
+	}
+
+	DynamicAABBTree::~DynamicAABBTree()
+	{
+		WaitForBuild();
+	}
+
+	uint32 DynamicAABBTree::CreateProxy(const AABB& aabb, uint32 userData)
+	{
+		uint32 proxy = 0;
+
+		if (m_freeProxies.empty())
+		{
+			proxy = (uint32)m_proxies.size();
+			m_proxies.emplace_back();
+		}
+		else
+		{
+			proxy = m_freeProxies.back();
+			m_freeProxies.pop_back();
+		}
+
+		const int32 leaf = AllocateNode();
+		SetLeafAABB(leaf, aabb.Expanded(m_margin));
+		m_nodes[leaf].m_proxy = proxy;
+		InsertLeaf(leaf);
+
+		Proxy& data = m_proxies[proxy];
+		data.m_node = leaf;
+		data.m_userData = userData;
+		data.m_alive = true;
+		m_proxyCount++;
+		TouchProxy(proxy);
+		return proxy;
+	}
+
+	void DynamicAABBTree::DestroyProxy(uint32 proxy)
+	{
+		Proxy& data = m_proxies[proxy];
+
+		if (!data.m_alive)
+		{
+			LINA_CORE_WARN("Trying to destroy an AABB tree proxy that doesn't exist.");
+			return;
+		}
+
+		RemoveLeaf(data.m_node);
+		SetLeafAABB(data.m_node, AABB());
+		FreeNode(data.m_node);
+		data.m_node = AABBTREE_NULL_NODE;
+		data.m_alive = false;
+		m_freeProxies.push_back(proxy);
+		m_proxyCount--;
+		TouchProxy(proxy);
+	}
+
+	bool DynamicAABBTree::MoveProxy(uint32 proxy, const AABB& aabb)
+	{
+		const int32 leaf = m_proxies[proxy].m_node;
+		Node& node = m_nodes[leaf];
+
+		if (node.m_aabb.Contains(aabb))
+			return false;
+
+		const AABB fatAABB = aabb.Expanded(m_margin);
+
+		// Refitting a box that jumped across the tree would stretch all of its ancestors.
+		if (node.m_aabb.Overlaps(fatAABB))
+		{
+			SetLeafAABB(leaf, fatAABB);
+			RefitAncestors(node.m_parent);
+		}
+		else
+		{
+			RemoveLeaf(leaf);
+			SetLeafAABB(leaf, fatAABB);
+			InsertLeaf(leaf);
+		}
+
+		TouchProxy(proxy);
+		return true;
+	}
+
+	void DynamicAABBTree::Update(JobSystem* jobSystem)
+	{
+		if (m_build != nullptr)
+		{
+			if (m_build->m_counter.IsDone())
+				FinishBuild();
+
+			return;
+		}
+
+		if (m_proxyCount < AABBTREE_MIN_REBUILD_PROXIES)
+			return;
+
+		// Trees that were only built by insertion don't have a reference cost yet.
+		if (m_builtCost > 0.0f && GetCost() <= m_builtCost * m_rebuildThreshold)
+			return;
+
+		StartBuild();
+
+		if (jobSystem != nullptr && jobSystem->GetIsInitialized() && jobSystem->GetWorkerCount() > 0)
+		{
+			BuildState* build = m_build.get();
+			m_jobSystem = jobSystem;
+			jobSystem->Run([build]() { BuildNodes(*build); }, &build->m_counter);
+		}
+		else
+		{
+			BuildNodes(*m_build);
+			FinishBuild();
+		}
+	}
+
+	void DynamicAABBTree::Rebuild()
+	{
+		WaitForBuild();
+
+		if (m_build != nullptr)
+			FinishBuild();
+
+		StartBuild();
+		BuildNodes(*m_build);
+		FinishBuild();
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		WaitForBuild();
+		m_build.reset();
+		m_nodes.clear();
+		m_proxies.clear();
+		m_freeProxies.clear();
+		m_touchedProxies.clear();
+		m_root = AABBTREE_NULL_NODE;
+		m_freeNode = AABBTREE_NULL_NODE;
+		m_proxyCount = 0;
+		m_internalArea = 0.0;
+		m_leafArea = 0.0;
+		m_builtCost = 0.0f;
+	}
+
+	float DynamicAABBTree::GetCost() const
+	{
+		if (m_root == AABBTREE_NULL_NODE)
+			return 0.0f;
+
+		// Leaf areas don't depend on the topology, unlike the root area they don't jump when a single proxy moves far away.
+		return m_leafArea > 0.0 ? (float)(m_internalArea / m_leafArea) : 0.0f;
+	}
+
+	int32 DynamicAABBTree::AllocateNode()
+	{
+		int32 node = m_freeNode;
+
+		if (node == AABBTREE_NULL_NODE)
+		{
+			node = (int32)m_nodes.size();
+			m_nodes.emplace_back();
+		}
+		else
+		{
+			m_freeNode = m_nodes[node].m_parent;
+			m_nodes[node] = Node();
+		}
+
+		return node;
+	}
+
+	void DynamicAABBTree::FreeNode(int32 node)
+	{
+		m_nodes[node].m_parent = m_freeNode;
+		m_nodes[node].m_height = -1;
+		m_freeNode = node;
+	}
+
+	void DynamicAABBTree::SetInternalAABB(int32 node, const AABB& aabb)
+	{
+		m_internalArea += (double)aabb.GetHalfArea() - (double)m_nodes[node].m_aabb.GetHalfArea();
+		m_nodes[node].m_aabb = aabb;
+	}
+
+	void DynamicAABBTree::SetLeafAABB(int32 node, const AABB& aabb)
+	{
+		m_leafArea += (double)aabb.GetHalfArea() - (double)m_nodes[node].m_aabb.GetHalfArea();
+		m_nodes[node].m_aabb = aabb;
+	}
+
+	void DynamicAABBTree::TouchProxy(uint32 proxy)
+	{
+		// Only needed to replay the changes on a tree that is being built.
+		if (m_build == nullptr || m_proxies[proxy].m_touched)
+			return;
+
+		m_proxies[proxy].m_touched = true;
+		m_touchedProxies.push_back(proxy);
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32 leaf)
+	{
+		if (m_root == AABBTREE_NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].m_parent = AABBTREE_NULL_NODE;
+			return;
+		}
+
+		// Walk down to the sibling with the lowest cost, the cost of a node is the area it would add to the tree.
+		const AABB leafAABB = m_nodes[leaf].m_aabb;
+		int32 index = m_root;
+
+		while (!m_nodes[index].IsLeaf())
+		{
+			const Node& node = m_nodes[index];
+			const float area = node.m_aabb.GetHalfArea();
+			const float combinedArea = AABB::Merge(node.m_aabb, leafAABB).GetHalfArea();
+
+			// Cost of making a new parent for this node & the leaf, and the area pushed down to the children.
+			const float cost = 2.0f * combinedArea;
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			const int32 children[2] = { node.m_child1, node.m_child2 };
+
+			for (int i = 0; i < 2; i++)
+			{
+				const Node& child = m_nodes[children[i]];
+				const float mergedArea = AABB::Merge(child.m_aabb, leafAABB).GetHalfArea();
+				childCosts[i] = (child.IsLeaf() ? mergedArea : mergedArea - child.m_aabb.GetHalfArea()) + inheritanceCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+				break;
+
+			index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+		}
+
+		const int32 sibling = index;
+		const int32 oldParent = m_nodes[sibling].m_parent;
+		const int32 newParent = AllocateNode();
+		m_nodes[newParent].m_parent = oldParent;
+		m_nodes[newParent].m_child1 = sibling;
+		m_nodes[newParent].m_child2 = leaf;
+		m_nodes[newParent].m_height = m_nodes[sibling].m_height + 1;
+		SetInternalAABB(newParent, AABB::Merge(leafAABB, m_nodes[sibling].m_aabb));
+		m_nodes[sibling].m_parent = newParent;
+		m_nodes[leaf].m_parent = newParent;
+
+		if (oldParent == AABBTREE_NULL_NODE)
+			m_root = newParent;
+		else if (m_nodes[oldParent].m_child1 == sibling)
+			m_nodes[oldParent].m_child1 = newParent;
+		else
+			m_nodes[oldParent].m_child2 = newParent;
+
+		// Fix the heights & boxes on the way back up.
+		index = m_nodes[leaf].m_parent;
+
+		while (index != AABBTREE_NULL_NODE)
+		{
+			index = Balance(index);
+
+			Node& node = m_nodes[index];
+			node.m_height = 1 + std::max(m_nodes[node.m_child1].m_height, m_nodes[node.m_child2].m_height);
+			SetInternalAABB(index, AABB::Merge(m_nodes[node.m_child1].m_aabb, m_nodes[node.m_child2].m_aabb));
+			index = m_nodes[index].m_parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32 leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = AABBTREE_NULL_NODE;
+			return;
+		}
+
+		const int32 parent = m_nodes[leaf].m_parent;
+		const int32 grandParent = m_nodes[parent].m_parent;
+		const int32 sibling = m_nodes[parent].m_child1 == leaf ? m_nodes[parent].m_child2 : m_nodes[parent].m_child1;
+
+		m_internalArea -= m_nodes[parent].m_aabb.GetHalfArea();
+		m_nodes[sibling].m_parent = grandParent;
+		FreeNode(parent);
+
+		if (grandParent == AABBTREE_NULL_NODE)
+		{
+			m_root = sibling;
+			return;
+		}
+
+		if (m_nodes[grandParent].m_child1 == parent)
+			m_nodes[grandParent].m_child1 = sibling;
+		else
+			m_nodes[grandParent].m_child2 = sibling;
+
+		int32 index = grandParent;
+
+		while (index != AABBTREE_NULL_NODE)
+		{
+			index = Balance(index);
+
+			Node& node = m_nodes[index];
+			node.m_height = 1 + std::max(m_nodes[node.m_child1].m_height, m_nodes[node.m_child2].m_height);
+			SetInternalAABB(index, AABB::Merge(m_nodes[node.m_child1].m_aabb, m_nodes[node.m_child2].m_aabb));
+			index = m_nodes[index].m_parent;
+		}
+	}
+
+	void DynamicAABBTree::RefitAncestors(int32 node)
+	{
+		while (node != AABBTREE_NULL_NODE)
+		{
+			const Node& current = m_nodes[node];
+			const AABB aabb = AABB::Merge(m_nodes[current.m_child1].m_aabb, m_nodes[current.m_child2].m_aabb);
+
+			// Nothing above changes once a box stays the same.
+			if (aabb.Contains(current.m_aabb) && current.m_aabb.Contains(aabb))
+				return;
+
+			SetInternalAABB(node, aabb);
+			node = current.m_parent;
+		}
+	}
+
+	int32 DynamicAABBTree::Balance(int32 iA)
+	{
+		// Rotates the taller child up if the subtree is out of balance, returns the new subtree root.
+		Node& A = m_nodes[iA];
+		if (A.IsLeaf() || A.m_height < 2)
+			return iA;
+
+		const int32 iB = A.m_child1;
+		const int32 iC = A.m_child2;
+		Node& B = m_nodes[iB];
+		Node& C = m_nodes[iC];
+		const int32 balance = C.m_height - B.m_height;
+
+		if (balance > 1)
+		{
+			const int32 iF = C.m_child1;
+			const int32 iG = C.m_child2;
+			Node& F = m_nodes[iF];
+			Node& G = m_nodes[iG];
+
+			C.m_child1 = iA;
+			C.m_parent = A.m_parent;
+			A.m_parent = iC;
+
+			if (C.m_parent == AABBTREE_NULL_NODE)
+				m_root = iC;
+			else if (m_nodes[C.m_parent].m_child1 == iA)
+				m_nodes[C.m_parent].m_child1 = iC;
+			else
+				m_nodes[C.m_parent].m_child2 = iC;
+
+			if (F.m_height > G.m_height)
+			{
+				C.m_child2 = iF;
+				A.m_child2 = iG;
+				G.m_parent = iA;
+				SetInternalAABB(iA, AABB::Merge(B.m_aabb, G.m_aabb));
+				SetInternalAABB(iC, AABB::Merge(A.m_aabb, F.m_aabb));
+				A.m_height = 1 + std::max(B.m_height, G.m_height);
+				C.m_height = 1 + std::max(A.m_height, F.m_height);
+			}
+			else
+			{
+				C.m_child2 = iG;
+				A.m_child2 = iF;
+				F.m_parent = iA;
+				SetInternalAABB(iA, AABB::Merge(B.m_aabb, F.m_aabb));
+				SetInternalAABB(iC, AABB::Merge(A.m_aabb, G.m_aabb));
+				A.m_height = 1 + std::max(B.m_height, F.m_height);
+				C.m_height = 1 + std::max(A.m_height, G.m_height);
+			}
+
+			return iC;
+		}
+
+		if (balance < -1)
+		{
+			const int32 iD = B.m_child1;
+			const int32 iE = B.m_child2;
+			Node& D = m_nodes[iD];
+			Node& E = m_nodes[iE];
+
+			B.m_child1 = iA;
+			B.m_parent = A.m_parent;
+			A.m_parent = iB;
+
+			if (B.m_parent == AABBTREE_NULL_NODE)
+				m_root = iB;
+			else if (m_nodes[B.m_parent].m_child1 == iA)
+				m_nodes[B.m_parent].m_child1 = iB;
+			else
+				m_nodes[B.m_parent].m_child2 = iB;
+
+			if (D.m_height > E.m_height)
+			{
+				B.m_child2 = iD;
+				A.m_child1 = iE;
+				E.m_parent = iA;
+				SetInternalAABB(iA, AABB::Merge(C.m_aabb, E.m_aabb));
+				SetInternalAABB(iB, AABB::Merge(A.m_aabb, D.m_aabb));
+				A.m_height = 1 + std::max(C.m_height, E.m_height);
+				B.m_height = 1 + std::max(A.m_height, D.m_height);
+			}
+			else
+			{
+				B.m_child2 = iE;
+				A.m_child1 = iD;
+				D.m_parent = iA;
+				SetInternalAABB(iA, AABB::Merge(C.m_aabb, D.m_aabb));
+				SetInternalAABB(iB, AABB::Merge(A.m_aabb, E.m_aabb));
+				A.m_height = 1 + std::max(C.m_height, D.m_height);
+				B.m_height = 1 + std::max(A.m_height, E.m_height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void DynamicAABBTree::StartBuild()
+	{
+		m_build = std::make_unique<BuildState>();
+		m_build->m_primitives.reserve(m_proxyCount);
+
+		for (uint32 i = 0; i < m_proxies.size(); i++)
+		{
+			if (!m_proxies[i].m_alive)
+				continue;
+
+			const AABB& aabb = m_nodes[m_proxies[i].m_node].m_aabb;
+			m_build->m_primitives.push_back(BuildPrimitive{ aabb, aabb.GetCenter(), i });
+		}
+	}
+
+	void DynamicAABBTree::WaitForBuild()
+	{
+		if (m_build != nullptr && !m_build->m_counter.IsDone())
+			m_jobSystem->Wait(m_build->m_counter);
+	}
+
+	void DynamicAABBTree::FinishBuild()
+	{
+		// Current boxes of the proxies changed during the build live in the old nodes.
+		std::vector<AABB> touchedAABBs(m_touchedProxies.size());
+		for (uint32 i = 0; i < m_touchedProxies.size(); i++)
+		{
+			const Proxy& proxy = m_proxies[m_touchedProxies[i]];
+			if (proxy.m_alive)
+				touchedAABBs[i] = m_nodes[proxy.m_node].m_aabb;
+		}
+
+		m_nodes = std::move(m_build->m_nodes);
+		m_root = m_build->m_root;
+		m_internalArea = m_build->m_internalArea;
+		m_leafArea = m_build->m_leafArea;
+		m_freeNode = AABBTREE_NULL_NODE;
+		m_builtCost = GetCost();
+		m_build.reset();
+
+		for (Proxy& proxy : m_proxies)
+			proxy.m_node = AABBTREE_NULL_NODE;
+
+		for (uint32 i = 0; i < m_nodes.size(); i++)
+		{
+			if (m_nodes[i].IsLeaf())
+				m_proxies[m_nodes[i].m_proxy].m_node = (int32)i;
+		}
+
+		// Replay the changes made since the snapshot, leaves of the snapshot are refit like any other move.
+		for (uint32 i = 0; i < m_touchedProxies.size(); i++)
+		{
+			Proxy& proxy = m_proxies[m_touchedProxies[i]];
+			proxy.m_touched = false;
+
+			if (!proxy.m_alive)
+			{
+				if (proxy.m_node != AABBTREE_NULL_NODE)
+				{
+					RemoveLeaf(proxy.m_node);
+					SetLeafAABB(proxy.m_node, AABB());
+					FreeNode(proxy.m_node);
+					proxy.m_node = AABBTREE_NULL_NODE;
+				}
+			}
+			else if (proxy.m_node != AABBTREE_NULL_NODE)
+			{
+				SetLeafAABB(proxy.m_node, touchedAABBs[i]);
+				RefitAncestors(m_nodes[proxy.m_node].m_parent);
+			}
+			else
+			{
+				const int32 leaf = AllocateNode();
+				SetLeafAABB(leaf, touchedAABBs[i]);
+				m_nodes[leaf].m_proxy = m_touchedProxies[i];
+				InsertLeaf(leaf);
+				proxy.m_node = leaf;
+			}
+		}
+
+		m_touchedProxies.clear();
+	}
+
+	void DynamicAABBTree::BuildNodes(BuildState& build)
+	{
+		std::vector<BuildPrimitive>& primitives = build.m_primitives;
+		std::vector<Node>& nodes = build.m_nodes;
+		const uint32 count = (uint32)primitives.size();
+		nodes.clear();
+
+		if (count == 0)
+		{
+			build.m_root = AABBTREE_NULL_NODE;
+			return;
+		}
+
+		struct Task
+		{
+			uint32 m_begin;
+			uint32 m_end;
+			int32 m_parent;
+		};
+
+		// Top down, parents are always stored before their children.
+		nodes.reserve(count * 2 - 1);
+		std::vector<Task> tasks;
+		tasks.push_back(Task{ 0, count, AABBTREE_NULL_NODE });
+
+		while (!tasks.empty())
+		{
+			const Task task = tasks.back();
+			tasks.pop_back();
+
+			const int32 index = (int32)nodes.size();
+			nodes.emplace_back();
+			nodes[index].m_parent = task.m_parent;
+
+			if (task.m_parent != AABBTREE_NULL_NODE)
+			{
+				if (nodes[task.m_parent].m_child1 == AABBTREE_NULL_NODE)
+					nodes[task.m_parent].m_child1 = index;
+				else
+					nodes[task.m_parent].m_child2 = index;
+			}
+
+			if (task.m_end - task.m_begin == 1)
+			{
+				nodes[index].m_aabb = primitives[task.m_begin].m_aabb;
+				nodes[index].m_proxy = primitives[task.m_begin].m_proxy;
+				build.m_leafArea += nodes[index].m_aabb.GetHalfArea();
+				continue;
+			}
+
+			const uint32 split = FindSplit(primitives, task.m_begin, task.m_end);
+			tasks.push_back(Task{ split, task.m_end, index });
+			tasks.push_back(Task{ task.m_begin, split, index });
+		}
+
+		// Boxes & heights bottom up.
+		double internalArea = 0.0;
+
+		for (int32 i = (int32)nodes.size() - 1; i >= 0; i--)
+		{
+			Node& node = nodes[i];
+			if (node.IsLeaf())
+				continue;
+
+			node.m_aabb = AABB::Merge(nodes[node.m_child1].m_aabb, nodes[node.m_child2].m_aabb);
+			node.m_height = 1 + std::max(nodes[node.m_child1].m_height, nodes[node.m_child2].m_height);
+			internalArea += node.m_aabb.GetHalfArea();
+		}
+
+		build.m_root = 0;
+		build.m_internalArea = internalArea;
+	}
+
+	uint32 DynamicAABBTree::FindSplit(std::vector<BuildPrimitive>& primitives, uint32 begin, uint32 end)
+	{
+		const uint32 middle = begin + (end - begin) / 2;
+
+		if (end - begin == 2)
+			return middle;
+
+		glm::vec3 centroidMin = primitives[begin].m_centroid;
+		glm::vec3 centroidMax = centroidMin;
+
+		for (uint32 i = begin + 1; i < end; i++)
+		{
+			centroidMin = glm::min(centroidMin, primitives[i].m_centroid);
+			centroidMax = glm::max(centroidMax, primitives[i].m_centroid);
+		}
+
+		const glm::vec3 extents = centroidMax - centroidMin;
+		const int axis = extents.x > extents.y ? (extents.x > extents.z ? 0 : 2) : (extents.y > extents.z ? 1 : 2);
+
+		// All centroids at the same spot, any split is as good as the other.
+		if (extents[axis] <= 0.0f)
+			return middle;
+
+		struct Bin
+		{
+			AABB m_aabb;
+			uint32 m_count = 0;
+		};
+
+		Bin bins[AABBTREE_BIN_COUNT];
+		const float binScale = (float)AABBTREE_BIN_COUNT / extents[axis] * 0.9999f;
+		const float binMin = centroidMin[axis];
+
+		for (uint32 i = begin; i < end; i++)
+		{
+			const int bin = std::min((int)((primitives[i].m_centroid[axis] - binMin) * binScale), AABBTREE_BIN_COUNT - 1);
+			bins[bin].m_aabb = bins[bin].m_count == 0 ? primitives[i].m_aabb : AABB::Merge(bins[bin].m_aabb, primitives[i].m_aabb);
+			bins[bin].m_count++;
+		}
+
+		// Area times count of everything right of each split plane.
+		float rightCosts[AABBTREE_BIN_COUNT];
+		AABB rightAABB;
+		uint32 rightCount = 0;
+
+		for (int i = AABBTREE_BIN_COUNT - 1; i > 0; i--)
+		{
+			if (bins[i].m_count > 0)
+			{
+				rightAABB = rightCount == 0 ? bins[i].m_aabb : AABB::Merge(rightAABB, bins[i].m_aabb);
+				rightCount += bins[i].m_count;
+			}
+
+			rightCosts[i] = rightCount == 0 ? 0.0f : rightAABB.GetHalfArea() * (float)rightCount;
+		}
+
+		AABB leftAABB;
+		uint32 leftCount = 0;
+		float bestCost = 0.0f;
+		int bestSplit = -1;
+
+		for (int i = 0; i < AABBTREE_BIN_COUNT - 1; i++)
+		{
+			if (bins[i].m_count > 0)
+			{
+				leftAABB = leftCount == 0 ? bins[i].m_aabb : AABB::Merge(leftAABB, bins[i].m_aabb);
+				leftCount += bins[i].m_count;
+			}
+
+			if (leftCount == 0 || leftCount == end - begin)
+				continue;
+
+			const float cost = leftAABB.GetHalfArea() * (float)leftCount + rightCosts[i + 1];
+			if (bestSplit == -1 || cost < bestCost)
+			{
+				bestCost = cost;
+				bestSplit = i;
+			}
+		}
+
+		if (bestSplit == -1)
+			return middle;
+
+		auto it = std::partition(primitives.begin() + begin, primitives.begin() + end, [axis, binMin, binScale, bestSplit](const BuildPrimitive& primitive)
+			{
+				return std::min((int)((primitive.m_centroid[axis] - binMin) * binScale), AABBTREE_BIN_COUNT - 1) <= bestSplit;
+			});
+
+		return (uint32)(it - primitives.begin());
+	}
+}
@@ -0,0 +1,96 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "Utility/HandleAllocator.hpp"
+#include <algorithm>
+
+namespace LinaEngine
+{
+	int HandleAllocator::Allocate()
+	{
+		uint32 index = 0;
+
+		if (m_freeIndices.size() != 0)
+		{
+			index = m_freeIndices.back();
+			m_freeIndices.pop_back();
+		}
+		else
+		{
+			index = (uint32)m_generations.size();
+			m_generations.push_back(1);
+			m_alive.push_back(false);
+		}
+
+		m_alive[index] = true;
+		return MakeHandle(index, m_generations[index]);
+	}
+
+	bool HandleAllocator::Acquire(int handle)
+	{
+		if (!IsHandle(handle)) return false;
+
+		uint32 index = GetIndex(handle);
+
+		// Grow up to the index, slots in between are free.
+		while (m_generations.size() <= index)
+		{
+			m_freeIndices.push_back((uint32)m_generations.size());
+			m_generations.push_back(1);
+			m_alive.push_back(false);
+		}
+
+		if (m_alive[index])
+			return m_generations[index] == GetGeneration(handle);
+
+		m_freeIndices.erase(std::remove(m_freeIndices.begin(), m_freeIndices.end(), index), m_freeIndices.end());
+		m_generations[index] = GetGeneration(handle);
+		m_alive[index] = true;
+		return true;
+	}
+
+	void HandleAllocator::Release(int handle)
+	{
+		if (!IsValid(handle)) return;
+
+		uint32 index = GetIndex(handle);
+		m_alive[index] = false;
+
+		// Generation 0 is never used so that handles stay above FIRST_HANDLE.
+		uint32 generation = (m_generations[index] + 1) & GENERATION_MASK;
+		m_generations[index] = generation == 0 ? 1 : generation;
+		m_freeIndices.push_back(index);
+	}
+
+	bool HandleAllocator::IsValid(int handle) const
+	{
+		if (!IsHandle(handle)) return false;
+
+		uint32 index = GetIndex(handle);
+		return index < m_generations.size() && m_alive[index] && m_generations[index] == GetGeneration(handle);
+	}
+}
@@ -27,10 +27,564 @@ SOFTWARE.
 */
 
 #include "Utility/Log.hpp"
+#include "Core/JobSystem.hpp"
 #include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+#include <iterator>
+#include "fmt/format.h"
+
+#define LOG_WRITER_INTERVAL_MS 5
+#define LOG_WRITER_BATCH_SIZE 512
 
 namespace LinaEngine
 {
 	std::function<void(Log::LogDump)> Log::s_onLog;
-}
+	MPSCRingBuffer<Log::LogRecord> Log::s_records;
+	std::atomic<bool> Log::s_isAsync{ false };
+	std::atomic<uint32> Log::s_asyncProducers{ 0 };
+	std::atomic<uint64> Log::s_droppedRecords{ 0 };
+	std::atomic<uint64> Log::s_totalDropped{ 0 };
+	std::atomic<uint32> Log::s_levelMask{ Log::Trace | Log::Debug | Log::Info | Log::Warn | Log::Error | Log::Critical };
+	bool Log::s_deferFormatting = false;
+
+	namespace
+	{
+		AsyncLogSettings s_settings;
+		std::thread s_writer;
+
+		// Guards the writer's wake up & flush state.
+		std::mutex s_writerMutex;
+		std::condition_variable s_writerCondition;
+		std::condition_variable s_flushCondition;
+		bool s_stopRequested = false;
+		bool s_flushRequested = false;
+		uint64 s_writtenCount = 0;
+
+		// Forwarded messages waiting for the main thread.
+		std::mutex s_pendingMutex;
+		std::deque<Log::LogDump> s_pendingDumps;
+
+		// Sink state, only touched by the writer thread.
+		std::string s_consoleBuffer;
+		std::string s_fileBuffer;
+		std::ofstream s_file;
+		uint64 s_fileSize = 0;
+
+		// Binary files store every format string once, records refer to it by index.
+		std::unordered_map<const char*, uint32> s_formatIndices;
+		std::string s_formatBuffer;
+
+		// Binary file entries, all integers are little endian as written by the engine.
+		enum BinaryEntry : uint8
+		{
+			FormatEntry = 'F',
+			RecordEntry = 'R',
+			MessageEntry = 'M'
+		};
+
+		template<typename T>
+		void AppendValue(std::string& buffer, const T& value)
+		{
+			buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		bool ReadValue(std::istream& stream, T& value)
+		{
+			return (bool)stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+		}
+
+		bool IsBinaryFile()
+		{
+			return s_settings.m_recordMode == LogRecordMode::Binary;
+		}
+
+		void OpenLogFile()
+		{
+			std::error_code error;
+			const std::filesystem::path directory = std::filesystem::path(s_settings.m_filePath).parent_path();
+			if (!directory.empty())
+				std::filesystem::create_directories(directory, error);
+
+			s_file.open(s_settings.m_filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+			s_fileSize = 0;
+			s_formatIndices.clear();
+
+			if (IsBinaryFile() && s_file.is_open())
+			{
+				s_file.write(LOG_BINARY_FILE_MAGIC, sizeof(LOG_BINARY_FILE_MAGIC) - 1);
+				s_fileSize = sizeof(LOG_BINARY_FILE_MAGIC) - 1;
+			}
+		}
+
+		void RotateLogFile()
+		{
+			s_file.close();
+
+			// path.N is the oldest, everything moves one step up & the current file becomes path.1.
+			const std::string& path = s_settings.m_filePath;
+			if (s_settings.m_maxFileCount > 0)
+			{
+				std::remove((path + "." + std::to_string(s_settings.m_maxFileCount)).c_str());
+
+				for (uint32 i = s_settings.m_maxFileCount - 1; i > 0; i--)
+					std::rename((path + "." + std::to_string(i)).c_str(), (path + "." + std::to_string(i + 1)).c_str());
+
+				std::rename(path.c_str(), (path + ".1").c_str());
+			}
+
+			OpenLogFile();
+		}
+
+		bool IsFileFull()
+		{
+			return s_settings.m_maxFileSize > 0 && s_fileSize + s_fileBuffer.size() > s_settings.m_maxFileSize;
+		}
+
+		void WriteFileBuffer()
+		{
+			s_file.write(s_fileBuffer.data(), s_fileBuffer.size());
+			s_fileSize += s_fileBuffer.size();
+			s_fileBuffer.clear();
+		}
+
+		// Format is null for messages that are already formatted.
+		void WriteBinaryEntry(Log::LogLevel level, const char* format, const char* data, uint32 length)
+		{
+			// Records refer to formats written earlier in the same file, the new file starts with an empty table.
+			if (IsFileFull())
+			{
+				WriteFileBuffer();
+				RotateLogFile();
+			}
+
+			if (format == nullptr)
+			{
+				s_fileBuffer.push_back((char)MessageEntry);
+				AppendValue(s_fileBuffer, (uint32)level);
+				AppendValue(s_fileBuffer, length);
+				s_fileBuffer.append(data, length);
+				return;
+			}
+
+			auto it = s_formatIndices.find(format);
+			if (it == s_formatIndices.end())
+			{
+				it = s_formatIndices.emplace(format, (uint32)s_formatIndices.size()).first;
+				const uint32 formatLength = (uint32)std::strlen(format);
+				s_fileBuffer.push_back((char)FormatEntry);
+				AppendValue(s_fileBuffer, it->second);
+				AppendValue(s_fileBuffer, formatLength);
+				s_fileBuffer.append(format, formatLength);
+			}
+
+			s_fileBuffer.push_back((char)RecordEntry);
+			AppendValue(s_fileBuffer, (uint32)level);
+			AppendValue(s_fileBuffer, it->second);
+			AppendValue(s_fileBuffer, length);
+			s_fileBuffer.append(data, length);
+		}
+
+		void WriteLine(Log::LogLevel level, const char* message, size_t length)
+		{
+			if (s_settings.m_writeToConsole)
+			{
+				s_consoleBuffer.append(message, length);
+				s_consoleBuffer.push_back('\n');
+			}
+
+			if (s_file.is_open() && !IsBinaryFile())
+			{
+				s_fileBuffer.append(message, length);
+				s_fileBuffer.push_back('\n');
+			}
+
+			if (s_settings.m_forwardToListener)
+			{
+				std::lock_guard<std::mutex> lock(s_pendingMutex);
+
+				// Nobody is dispatching while a level loads, only the latest messages are kept for the editor.
+				if (s_pendingDumps.size() == LOG_MAX_PENDING_DISPATCH)
+					s_pendingDumps.pop_front();
+
+				s_pendingDumps.emplace_back(level, std::string(message, length));
+			}
+		}
+
+		void WriteMessage(Log::LogLevel level, const char* message, uint32 length)
+		{
+			WriteLine(level, message, length);
+
+			if (s_file.is_open() && IsBinaryFile())
+				WriteBinaryEntry(level, nullptr, message, length);
+		}
+
+		void WriteRecord(const Log::LogRecord& record)
+		{
+			if (record.m_overflow != nullptr)
+			{
+				WriteMessage(record.m_level, record.m_overflow->data(), (uint32)record.m_overflow->size());
+				delete record.m_overflow;
+				return;
+			}
+
+			if (record.m_truncated)
+			{
+				s_formatBuffer.assign(record.m_data, record.m_length);
+				s_formatBuffer.append(LOG_TRUNCATED_SUFFIX);
+				WriteMessage(record.m_level, s_formatBuffer.data(), (uint32)s_formatBuffer.size());
+				return;
+			}
+
+			if (record.m_format == nullptr)
+			{
+				WriteMessage(record.m_level, record.m_data, record.m_length);
+				return;
+			}
+
+			if (s_file.is_open() && IsBinaryFile())
+				WriteBinaryEntry(record.m_level, record.m_format, record.m_data, record.m_length);
+
+			// Deferred formatting happens here, if the binary file is the only sink it doesn't happen at all.
+			if (!s_settings.m_writeToConsole && !s_settings.m_forwardToListener && (IsBinaryFile() || !s_file.is_open()))
+				return;
+
+			s_formatBuffer.clear();
+			if (!Log::FormatBinaryRecord(record.m_format, reinterpret_cast<const uint8*>(record.m_data), record.m_length, s_formatBuffer))
+				s_formatBuffer = fmt::format("Invalid log record, format: {0}", record.m_format);
+
+			WriteLine(record.m_level, s_formatBuffer.data(), s_formatBuffer.size());
+		}
+
+		void FlushSinks()
+		{
+			if (!s_consoleBuffer.empty())
+			{
+				std::fwrite(s_consoleBuffer.data(), 1, s_consoleBuffer.size(), stdout);
+				std::fflush(stdout);
+				s_consoleBuffer.clear();
+			}
+
+			if (!s_fileBuffer.empty() && s_file.is_open())
+			{
+				// Binary files are rotated per entry, see WriteBinaryEntry.
+				if (!IsBinaryFile() && s_fileSize > 0 && IsFileFull())
+					RotateLogFile();
+
+				WriteFileBuffer();
+				s_file.flush();
+			}
+
+			s_fileBuffer.clear();
+		}
+	}
+
+	void Log::StartAsync(const AsyncLogSettings& settings)
+	{
+		if (s_isAsync.load(std::memory_order_acquire))
+			return;
+
+		s_settings = settings;
+		s_deferFormatting = settings.m_recordMode == LogRecordMode::Binary;
+		s_records.Initialize(settings.m_capacity);
+		s_droppedRecords.store(0, std::memory_order_relaxed);
+		s_stopRequested = false;
+		s_flushRequested = false;
+		s_writtenCount = 0;
+
+		if (!s_settings.m_filePath.empty())
+			OpenLogFile();
+
+		s_writer = std::thread(&Log::WriterLoop);
+		s_isAsync.store(true, std::memory_order_release);
+	}
+
+	void Log::StopAsync()
+	{
+		if (!s_isAsync.exchange(false))
+			return;
+
+		// No new records after this, the writer drains until the pop count catches up with the last push.
+		while (s_asyncProducers.load(std::memory_order_acquire) != 0)
+			std::this_thread::yield();
 
+		{
+			std::lock_guard<std::mutex> lock(s_writerMutex);
+			s_stopRequested = true;
+		}
+
+		s_writerCondition.notify_one();
+		s_writer.join();
+
+		if (s_file.is_open())
+			s_file.close();
+
+		// Nothing dispatches these anymore.
+		std::lock_guard<std::mutex> lock(s_pendingMutex);
+		s_pendingDumps.clear();
+		s_pendingDumps.shrink_to_fit();
+	}
+
+	void Log::Flush()
+	{
+		if (!s_isAsync.load(std::memory_order_acquire))
+			return;
+
+		const uint64 target = s_records.GetPushCount();
+		std::unique_lock<std::mutex> lock(s_writerMutex);
+		s_flushRequested = true;
+		s_writerCondition.notify_one();
+		s_flushCondition.wait(lock, [target]() { return s_writtenCount >= target || s_stopRequested; });
+	}
+
+	void Log::DispatchPending()
+	{
+		std::deque<LogDump> dumps;
+
+		{
+			std::lock_guard<std::mutex> lock(s_pendingMutex);
+			if (s_pendingDumps.empty())
+				return;
+
+			dumps.swap(s_pendingDumps);
+		}
+
+		if (s_onLog)
+		{
+			for (const LogDump& dump : dumps)
+				s_onLog(dump);
+		}
+	}
+
+	void Log::WakeWriter()
+	{
+		// A missed wake up only costs one writer interval, no need to take the lock here.
+		s_writerCondition.notify_one();
+	}
+
+	void Log::WriterLoop()
+	{
+		JobSystem::SetCurrentThreadName("Lina Log Writer");
+
+		while (true)
+		{
+			const uint32 written = WriteRecords();
+
+			std::unique_lock<std::mutex> lock(s_writerMutex);
+			s_writtenCount = s_records.GetPopCount();
+			s_flushCondition.notify_all();
+
+			// Keep going while the buffer has more than a batch in it.
+			if (written == LOG_WRITER_BATCH_SIZE)
+				continue;
+
+			if (s_stopRequested && s_records.GetPopCount() == s_records.GetPushCount())
+				break;
+
+			s_writerCondition.wait_for(lock, std::chrono::milliseconds(LOG_WRITER_INTERVAL_MS), []() { return s_stopRequested || s_flushRequested; });
+			s_flushRequested = false;
+		}
+	}
+
+	uint32 Log::WriteRecords()
+	{
+		uint32 written = 0;
+		auto write = [](const LogRecord& record) { WriteRecord(record); };
+
+		while (written < LOG_WRITER_BATCH_SIZE && s_records.TryPop(write))
+			written++;
+
+		const uint64 dropped = s_droppedRecords.exchange(0, std::memory_order_relaxed);
+		if (dropped > 0)
+		{
+			s_totalDropped.fetch_add(dropped, std::memory_order_relaxed);
+			const std::string message = fmt::format("{0} log messages were dropped, the log buffer was full.", dropped);
+			WriteMessage(LogLevel::Warn, message.c_str(), (uint32)message.size());
+		}
+
+		if (written > 0 || dropped > 0)
+			FlushSinks();
+
+		return written;
+	}
+
+	bool Log::FormatBinaryRecord(const char* format, const uint8* data, uint32 length, std::string& out)
+	{
+		thread_local fmt::dynamic_format_arg_store<fmt::format_context> s_arguments;
+		s_arguments.clear();
+
+		const uint8* cursor = data;
+		const uint8* end = data + length;
+
+		while (cursor < end)
+		{
+			const ArgType type = (ArgType)*cursor++;
+			size_t size = 0;
+
+			if (type == ArgType::Bool || type == ArgType::Char)
+				size = 1;
+			else if (type == ArgType::Float)
+				size = sizeof(float);
+			else if (type == ArgType::Int64 || type == ArgType::UInt64 || type == ArgType::Double)
+				size = sizeof(uint64);
+			else if (type == ArgType::String)
+				size = sizeof(uint32);
+			else
+				return false;
+
+			if (cursor + size > end)
+				return false;
+
+			if (type == ArgType::Bool)
+				s_arguments.push_back(*cursor != 0);
+			else if (type == ArgType::Char)
+				s_arguments.push_back((char)*cursor);
+			else if (type == ArgType::Float)
+			{
+				float value;
+				std::memcpy(&value, cursor, size);
+				s_arguments.push_back(value);
+			}
+			else if (type == ArgType::Double)
+			{
+				double value;
+				std::memcpy(&value, cursor, size);
+				s_arguments.push_back(value);
+			}
+			else if (type == ArgType::Int64)
+			{
+				int64 value;
+				std::memcpy(&value, cursor, size);
+				s_arguments.push_back(value);
+			}
+			else if (type == ArgType::UInt64)
+			{
+				uint64 value;
+				std::memcpy(&value, cursor, size);
+				s_arguments.push_back(value);
+			}
+			else
+			{
+				uint32 textLength;
+				std::memcpy(&textLength, cursor, size);
+				if (cursor + size + textLength > end)
+					return false;
+
+				// Views into the record, it outlives the formatting below.
+				s_arguments.push_back(fmt::string_view(reinterpret_cast<const char*>(cursor + size), textLength));
+				size += textLength;
+			}
+
+			cursor += size;
+		}
+
+		try
+		{
+			fmt::vformat_to(std::back_inserter(out), format, s_arguments);
+		}
+		catch (const fmt::format_error&)
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Log::DecodeBinaryLog(const std::string& inputPath, const std::string& outputPath)
+	{
+		std::ifstream input(inputPath, std::ios::in | std::ios::binary);
+		std::ofstream output(outputPath, std::ios::out | std::ios::trunc);
+		if (!input.is_open() || !output.is_open())
+			return false;
+
+		char magic[sizeof(LOG_BINARY_FILE_MAGIC) - 1];
+		if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_BINARY_FILE_MAGIC, sizeof(magic)) != 0)
+			return false;
+
+		std::vector<std::string> formats;
+		std::string data;
+		std::string line;
+		char entry;
+
+		while (input.get(entry))
+		{
+			uint32 level = 0;
+			uint32 index = 0;
+			uint32 length = 0;
+
+			if (entry == FormatEntry)
+			{
+				if (!ReadValue(input, index) || !ReadValue(input, length) || index != formats.size())
+					return false;
+
+				formats.emplace_back(length, '\0');
+				if (!input.read(&formats.back()[0], length))
+					return false;
+			}
+			else if (entry == RecordEntry || entry == MessageEntry)
+			{
+				if (!ReadValue(input, level) || (entry == RecordEntry && !ReadValue(input, index)) || !ReadValue(input, length))
+					return false;
+
+				data.resize(length);
+				if (length > 0 && !input.read(&data[0], length))
+					return false;
+
+				if (entry == RecordEntry && index >= formats.size())
+					return false;
+
+				line.clear();
+				if (entry == MessageEntry)
+					line = data;
+				else if (!FormatBinaryRecord(formats[index].c_str(), reinterpret_cast<const uint8*>(data.data()), length, line))
+					line = fmt::format("Invalid log record, format: {0}", formats[index]);
+
+				output << line << '\n';
+			}
+			else
+				return false;
+		}
+
+		return true;
+	}
+
+	uint32 Log::GetLevelMaskFrom(LogLevel minimum)
+	{
+		const LogLevel severityOrder[] = { Trace, Debug, Info, Warn, Error, Critical };
+		uint32 mask = 0;
+		bool reached = false;
+
+		for (LogLevel level : severityOrder)
+		{
+			reached = reached || level == minimum;
+			if (reached)
+				mask |= level;
+		}
+
+		return mask;
+	}
+
+	bool Log::ParseLevel(const std::string& name, LogLevel& level)
+	{
+		const std::pair<const char*, LogLevel> names[] = { {"trace", Trace}, {"debug", Debug}, {"info", Info}, {"warn", Warn}, {"error", Error}, {"critical", Critical} };
+
+		for (const std::pair<const char*, LogLevel>& pair : names)
+		{
+			if (name == pair.first)
+			{
+				level = pair.second;
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
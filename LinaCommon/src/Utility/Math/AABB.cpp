@@ -0,0 +1,116 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: AABB
+
+Timestamp: 11/3/2020 5:12:08 PM
+*/
+
+#include "Utility/Math/AABB.hpp"
+
+namespace LinaEngine
+{
+	bool AABB::IntersectsRay(const Vector3& origin, const Vector3& inverseDirection, float maxDistance, float& distance) const
+	{
+		const glm::vec3 t0 = (glm::vec3(m_min) - glm::vec3(origin)) * glm::vec3(inverseDirection);
+		const glm::vec3 t1 = (glm::vec3(m_max) - glm::vec3(origin)) * glm::vec3(inverseDirection);
+		const glm::vec3 tMin = glm::min(t0, t1);
+		const glm::vec3 tMax = glm::max(t0, t1);
+		const float entry = glm::max(glm::max(tMin.x, tMin.y), glm::max(tMin.z, 0.0f));
+		const float exit = glm::min(glm::min(tMax.x, tMax.y), glm::min(tMax.z, maxDistance));
+
+		if (entry > exit)
+			return false;
+
+		distance = entry;
+		return true;
+	}
+
+	AABB AABB::Transformed(const Matrix& matrix) const
+	{
+		// Arvo's method, each axis of the matrix contributes its min & max to the result.
+		glm::vec3 min = glm::vec3(matrix[3]);
+		glm::vec3 max = min;
+
+		for (int c = 0; c < 3; c++)
+		{
+			const glm::vec3 axis = glm::vec3(matrix[c]);
+			const glm::vec3 a = axis * glm::vec3(m_min)[c];
+			const glm::vec3 b = axis * glm::vec3(m_max)[c];
+			min += glm::min(a, b);
+			max += glm::max(a, b);
+		}
+
+		return AABB(min, max);
+	}
+
+	Frustum Frustum::FromMatrix(const Matrix& viewProjection)
+	{
+		// Gribb & Hartmann, planes are sums & differences of the fourth row with the others.
+		const glm::mat4& m = viewProjection;
+		const glm::vec4 row0 = glm::vec4(m[0][0], m[1][0], m[2][0], m[3][0]);
+		const glm::vec4 row1 = glm::vec4(m[0][1], m[1][1], m[2][1], m[3][1]);
+		const glm::vec4 row2 = glm::vec4(m[0][2], m[1][2], m[2][2], m[3][2]);
+		const glm::vec4 row3 = glm::vec4(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+		Frustum frustum;
+		frustum.m_planes[0] = row3 + row0;
+		frustum.m_planes[1] = row3 - row0;
+		frustum.m_planes[2] = row3 + row1;
+		frustum.m_planes[3] = row3 - row1;
+		frustum.m_planes[4] = row3 + row2;
+		frustum.m_planes[5] = row3 - row2;
+
+		for (int i = 0; i < 6; i++)
+			frustum.m_planes[i] /= glm::length(glm::vec3(frustum.m_planes[i]));
+
+		return frustum;
+	}
+
+	FrustumResult Frustum::Test(const AABB& aabb) const
+	{
+		const glm::vec3 center = aabb.GetCenter();
+		const glm::vec3 extents = aabb.GetExtents();
+		FrustumResult result = FrustumResult::Inside;
+
+		for (int i = 0; i < 6; i++)
+		{
+			const glm::vec3 normal = glm::vec3(m_planes[i]);
+			const float distance = glm::dot(normal, center) + m_planes[i].w;
+			const float radius = glm::dot(extents, glm::abs(normal));
+
+			if (distance < -radius)
+				return FrustumResult::Outside;
+
+			if (distance < radius)
+				result = FrustumResult::Intersects;
+		}
+
+		return result;
+	}
+}
@@ -29,6 +29,7 @@ SOFTWARE.
 #include "Utility/Math/Matrix.hpp"  
 #include "Utility/Math/Quaternion.hpp"
 #include "glm/gtx/transform.hpp"
+#include "glm/gtc/quaternion.hpp"
 
 namespace LinaEngine
 {
@@ -72,10 +73,22 @@ namespace LinaEngine
 
 	Matrix Matrix::TransformMatrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
 	{
-		Matrix trans = glm::translate(translation);
-		Matrix rot = InitRotation(rotation);
-		Matrix sc = glm::scale(scale);
-		return trans * rot * sc;
+		// Same as translation * rotation * scale without the matrix products, matches MatrixBatch::TransformMatrices.
+		float xx2 = 2.0f * rotation.x * rotation.x;
+		float yy2 = 2.0f * rotation.y * rotation.y;
+		float zz2 = 2.0f * rotation.z * rotation.z;
+		float xy2 = 2.0f * rotation.x * rotation.y;
+		float xz2 = 2.0f * rotation.x * rotation.z;
+		float yz2 = 2.0f * rotation.y * rotation.z;
+		float wx2 = 2.0f * rotation.w * rotation.x;
+		float wy2 = 2.0f * rotation.w * rotation.y;
+		float wz2 = 2.0f * rotation.w * rotation.z;
+
+		glm::vec4 a = glm::vec4((1.0f - (yy2 + zz2)) * scale.x, (xy2 + wz2) * scale.x, (xz2 - wy2) * scale.x, 0.0f);
+		glm::vec4 b = glm::vec4((xy2 - wz2) * scale.y, (1.0f - (xx2 + zz2)) * scale.y, (yz2 + wx2) * scale.y, 0.0f);
+		glm::vec4 c = glm::vec4((xz2 + wy2) * scale.z, (yz2 - wx2) * scale.z, (1.0f - (xx2 + yy2)) * scale.z, 0.0f);
+		glm::vec4 d = glm::vec4(translation.x, translation.y, translation.z, 1.0f);
+		return Matrix(a, b, c, d);
 	}
 
 	Matrix Matrix::Transpose() const
@@ -93,6 +106,57 @@ namespace LinaEngine
 		return glm::inverse(*this);
 	}
 
+	// Cofactors of the upper 3x3 part, cofactors[r][c] uses the element at row r & column c, i.e. m[c][r].
+	static float AffineCofactors(const Matrix& m, float cofactors[3][3])
+	{
+		cofactors[0][0] = m[1][1] * m[2][2] - m[2][1] * m[1][2];
+		cofactors[0][1] = m[2][1] * m[0][2] - m[0][1] * m[2][2];
+		cofactors[0][2] = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+		cofactors[1][0] = m[2][0] * m[1][2] - m[1][0] * m[2][2];
+		cofactors[1][1] = m[0][0] * m[2][2] - m[2][0] * m[0][2];
+		cofactors[1][2] = m[1][0] * m[0][2] - m[0][0] * m[1][2];
+		cofactors[2][0] = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+		cofactors[2][1] = m[2][0] * m[0][1] - m[0][0] * m[2][1];
+		cofactors[2][2] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+
+		// Returns the inverse determinant.
+		return 1.0f / (m[0][0] * cofactors[0][0] + m[1][0] * cofactors[0][1] + m[2][0] * cofactors[0][2]);
+	}
+
+	Matrix Matrix::InverseAffine() const
+	{
+		float cofactors[3][3];
+		const float invDet = AffineCofactors(*this, cofactors);
+		const glm::vec4& t = (*this)[3];
+
+		// Inverse of the upper 3x3 is the transposed cofactors over the determinant, translation is -inverse * t.
+		glm::vec4 a = glm::vec4(cofactors[0][0] * invDet, cofactors[0][1] * invDet, cofactors[0][2] * invDet, 0.0f);
+		glm::vec4 b = glm::vec4(cofactors[1][0] * invDet, cofactors[1][1] * invDet, cofactors[1][2] * invDet, 0.0f);
+		glm::vec4 c = glm::vec4(cofactors[2][0] * invDet, cofactors[2][1] * invDet, cofactors[2][2] * invDet, 0.0f);
+		glm::vec4 d = -(a * t.x + b * t.y + c * t.z);
+		d.w = 1.0f;
+		return Matrix(a, b, c, d);
+	}
+
+	Matrix Matrix::ToNormalMatrixAffine() const
+	{
+		float cofactors[3][3];
+		const float invDet = AffineCofactors(*this, cofactors);
+		const glm::vec4& t = (*this)[3];
+
+		// Transpose of InverseAffine, matches MatrixBatch::NormalMatrices.
+		glm::vec4 columns[3];
+		for (int c = 0; c < 3; c++)
+		{
+			const float r0 = cofactors[0][c] * invDet;
+			const float r1 = cofactors[1][c] * invDet;
+			const float r2 = cofactors[2][c] * invDet;
+			columns[c] = glm::vec4(r0, r1, r2, 0.0f - ((r0 * t.x + r1 * t.y) + r2 * t.z));
+		}
+
+		return Matrix(columns[0], columns[1], columns[2], glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	}
+
 	Matrix Matrix::InitRotationFromVectors(const Vector3& u, const Vector3& v, const Vector3& n)
 	{
 		return glm::mat4(
@@ -148,6 +212,15 @@ namespace LinaEngine
 	}
 
 
+	Quaternion Matrix::GetRotation() const
+	{
+		glm::mat3 rotation = glm::mat3(*this);
+		rotation[0] = glm::normalize(rotation[0]);
+		rotation[1] = glm::normalize(rotation[1]);
+		rotation[2] = glm::normalize(rotation[2]);
+		return Quaternion(glm::quat_cast(rotation));
+	}
+
 	Matrix Matrix::ToNormalMatrix() const
 	{
 		// TODO: There *should* be a faster and easier way to do this!
@@ -0,0 +1,242 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: MatrixBatch
+
+Timestamp: 11/3/2020 2:40:51 PM
+*/
+
+#include "Utility/Math/MatrixBatch.hpp"
+#include "PackageManager/PAMSIMD.hpp"
+
+namespace LinaEngine
+{
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Batch kernels expect tightly packed vectors.");
+	static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Batch kernels expect tightly packed quaternions.");
+	static_assert(sizeof(Matrix) == sizeof(float) * 16, "Batch kernels expect tightly packed matrices.");
+
+#if (SIMD_CPU_ARCH != SIMD_CPU_ARCH_OTHER) && (SIMD_SUPPORTED_LEVEL >= SIMD_LEVEL_x86_SSE)
+
+	// Short names for the intrinsics used by the kernels.
+	static inline __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+	static inline __m128 Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+	static inline __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+	static inline __m128 Div(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+
+	// Inputs are quaternion x, y, z, w, location x, y, z & scale x, y, z for 4 transforms. Outputs the
+	// first three rows of the four columns, column major, in the same order as Matrix::TransformMatrix.
+	static inline void TransformKernel(const __m128* in, __m128* out)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+
+		const __m128 x2 = Mul(two, in[0]);
+		const __m128 y2 = Mul(two, in[1]);
+		const __m128 z2 = Mul(two, in[2]);
+		const __m128 xx2 = Mul(x2, in[0]);
+		const __m128 yy2 = Mul(y2, in[1]);
+		const __m128 zz2 = Mul(z2, in[2]);
+		const __m128 xy2 = Mul(x2, in[1]);
+		const __m128 xz2 = Mul(x2, in[2]);
+		const __m128 yz2 = Mul(y2, in[2]);
+		const __m128 wx2 = Mul(Mul(two, in[3]), in[0]);
+		const __m128 wy2 = Mul(Mul(two, in[3]), in[1]);
+		const __m128 wz2 = Mul(Mul(two, in[3]), in[2]);
+
+		out[0] = Mul(Sub(one, Add(yy2, zz2)), in[7]);
+		out[1] = Mul(Add(xy2, wz2), in[7]);
+		out[2] = Mul(Sub(xz2, wy2), in[7]);
+		out[3] = Mul(Sub(xy2, wz2), in[8]);
+		out[4] = Mul(Sub(one, Add(xx2, zz2)), in[8]);
+		out[5] = Mul(Add(yz2, wx2), in[8]);
+		out[6] = Mul(Add(xz2, wy2), in[9]);
+		out[7] = Mul(Sub(yz2, wx2), in[9]);
+		out[8] = Mul(Sub(one, Add(xx2, yy2)), in[9]);
+		out[9] = in[4];
+		out[10] = in[5];
+		out[11] = in[6];
+	}
+
+	// Input is m[c][r] at in[c * 4 + r]. Outputs the rows of the first three columns of the inverse transpose
+	// at out[c * 4 + r], the last column of an affine normal matrix is always (0, 0, 0, 1).
+	static inline void NormalKernel(const __m128* in, __m128* out)
+	{
+		#define M(c, r) in[(c) * 4 + (r)]
+
+		// Cofactors of the upper 3x3, C(r, c) uses a(r, c) = m[c][r].
+		const __m128 c00 = Sub(Mul(M(1, 1), M(2, 2)), Mul(M(2, 1), M(1, 2)));
+		const __m128 c01 = Sub(Mul(M(2, 1), M(0, 2)), Mul(M(0, 1), M(2, 2)));
+		const __m128 c02 = Sub(Mul(M(0, 1), M(1, 2)), Mul(M(1, 1), M(0, 2)));
+		const __m128 c10 = Sub(Mul(M(2, 0), M(1, 2)), Mul(M(1, 0), M(2, 2)));
+		const __m128 c11 = Sub(Mul(M(0, 0), M(2, 2)), Mul(M(2, 0), M(0, 2)));
+		const __m128 c12 = Sub(Mul(M(1, 0), M(0, 2)), Mul(M(0, 0), M(1, 2)));
+		const __m128 c20 = Sub(Mul(M(1, 0), M(2, 1)), Mul(M(2, 0), M(1, 1)));
+		const __m128 c21 = Sub(Mul(M(2, 0), M(0, 1)), Mul(M(0, 0), M(2, 1)));
+		const __m128 c22 = Sub(Mul(M(0, 0), M(1, 1)), Mul(M(1, 0), M(0, 1)));
+
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 invDet = Div(one, Add(Add(Mul(M(0, 0), c00), Mul(M(1, 0), c01)), Mul(M(2, 0), c02)));
+		const __m128 cofactors[3][3] = { { c00, c01, c02 }, { c10, c11, c12 }, { c20, c21, c22 } };
+
+		for (int c = 0; c < 3; c++)
+		{
+			const __m128 r0 = Mul(cofactors[0][c], invDet);
+			const __m128 r1 = Mul(cofactors[1][c], invDet);
+			const __m128 r2 = Mul(cofactors[2][c], invDet);
+
+			out[c * 4 + 0] = r0;
+			out[c * 4 + 1] = r1;
+			out[c * 4 + 2] = r2;
+			out[c * 4 + 3] = Sub(zero, Add(Add(Mul(r0, M(3, 0)), Mul(r1, M(3, 1))), Mul(r2, M(3, 2))));
+		}
+
+		#undef M
+	}
+
+	// Splits 4 packed Vector3s to x, y & z registers.
+	static inline void LoadVector3x4(const Vector3* v, __m128& x, __m128& y, __m128& z)
+	{
+		const float* f = &v->x;
+		const __m128 a = _mm_loadu_ps(f);
+		const __m128 b = _mm_loadu_ps(f + 4);
+		const __m128 c = _mm_loadu_ps(f + 8);
+		x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	// Loads 4 quaternions as x, y, z & w registers.
+	static inline void LoadQuaternionx4(const Quaternion* q, __m128* out)
+	{
+		const float* f = &q->x;
+		out[0] = _mm_loadu_ps(f);
+		out[1] = _mm_loadu_ps(f + 4);
+		out[2] = _mm_loadu_ps(f + 8);
+		out[3] = _mm_loadu_ps(f + 12);
+		_MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+	}
+
+	// Loads column c of 4 matrices as row registers.
+	static inline void LoadMatrixColumnx4(const Matrix* m, int c, __m128* out)
+	{
+		out[0] = _mm_loadu_ps(&m[0][c][0]);
+		out[1] = _mm_loadu_ps(&m[1][c][0]);
+		out[2] = _mm_loadu_ps(&m[2][c][0]);
+		out[3] = _mm_loadu_ps(&m[3][c][0]);
+		_MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+	}
+
+	// Stores the row registers of column c to 4 matrices.
+	static inline void StoreMatrixColumnx4(Matrix* m, int c, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+	{
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(&m[0][c][0], r0);
+		_mm_storeu_ps(&m[1][c][0], r1);
+		_mm_storeu_ps(&m[2][c][0], r2);
+		_mm_storeu_ps(&m[3][c][0], r3);
+	}
+
+	// Loads 4 transforms into the layout TransformKernel expects.
+	static inline void LoadTransformx4(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, __m128* in)
+	{
+		LoadQuaternionx4(rotations, in);
+		LoadVector3x4(locations, in[4], in[5], in[6]);
+		LoadVector3x4(scales, in[7], in[8], in[9]);
+	}
+
+	static inline void StoreTransformx4(Matrix* out, const __m128* result)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		StoreMatrixColumnx4(out, 0, result[0], result[1], result[2], zero);
+		StoreMatrixColumnx4(out, 1, result[3], result[4], result[5], zero);
+		StoreMatrixColumnx4(out, 2, result[6], result[7], result[8], zero);
+		StoreMatrixColumnx4(out, 3, result[9], result[10], result[11], _mm_set1_ps(1.0f));
+	}
+
+	static inline void StoreNormalx4(Matrix* out, const __m128* result)
+	{
+		for (int c = 0; c < 3; c++)
+			StoreMatrixColumnx4(out, c, result[c * 4 + 0], result[c * 4 + 1], result[c * 4 + 2], result[c * 4 + 3]);
+
+		const __m128 lastColumn = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+		for (int i = 0; i < 4; i++)
+			_mm_storeu_ps(&out[i][3][0], lastColumn);
+	}
+
+#endif
+
+	void MatrixBatch::TransformMatrices(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix* out, uint32 count)
+	{
+		uint32 i = 0;
+
+#if (SIMD_CPU_ARCH != SIMD_CPU_ARCH_OTHER) && (SIMD_SUPPORTED_LEVEL >= SIMD_LEVEL_x86_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 in[10], result[12];
+			LoadTransformx4(locations + i, rotations + i, scales + i, in);
+			TransformKernel(in, result);
+			StoreTransformx4(out + i, result);
+		}
+#endif
+
+		for (; i < count; i++)
+			out[i] = Matrix::TransformMatrix(locations[i], rotations[i], scales[i]);
+	}
+
+	void MatrixBatch::NormalMatrices(const Matrix* matrices, Matrix* out, uint32 count)
+	{
+		uint32 i = 0;
+
+#if (SIMD_CPU_ARCH != SIMD_CPU_ARCH_OTHER) && (SIMD_SUPPORTED_LEVEL >= SIMD_LEVEL_x86_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 in[16], result[12];
+			for (int c = 0; c < 4; c++)
+				LoadMatrixColumnx4(matrices + i, c, in + c * 4);
+
+			NormalKernel(in, result);
+			StoreNormalx4(out + i, result);
+		}
+#endif
+
+		for (; i < count; i++)
+			out[i] = matrices[i].ToNormalMatrixAffine();
+	}
+
+	const char* MatrixBatch::GetInstructionSet()
+	{
+#if (SIMD_CPU_ARCH != SIMD_CPU_ARCH_OTHER) && (SIMD_SUPPORTED_LEVEL >= SIMD_LEVEL_x86_AVX)
+		return "SSE (VEX encoded)";
+#elif (SIMD_CPU_ARCH != SIMD_CPU_ARCH_OTHER) && (SIMD_SUPPORTED_LEVEL >= SIMD_LEVEL_x86_SSE)
+		return "SSE";
+#else
+		return "Scalar";
+#endif
+	}
+}
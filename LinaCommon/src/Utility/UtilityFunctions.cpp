@@ -42,20 +42,35 @@ namespace LinaEngine
 			return (stat(path.c_str(), &buffer) == 0);
 		}
 
-		int GetUniqueID()
+		size_t StringToHash(const std::string& str)
 		{
-			return ++s_uniqueID;
+			std::hash<std::string> hasher;
+			return hasher(str);
 		}
 
-		std::string GetUniqueIDString()
+		unsigned long long HashFileContents(const std::string& path)
 		{
-			return std::to_string(++s_uniqueID);
-		}
+			std::ifstream file(path, std::ios::binary);
 
-		size_t StringToHash(const std::string& str)
-		{
-			std::hash<std::string> hasher;
-			return hasher(str);
+			if (!file)
+				return 0;
+
+			unsigned long long hash = 14695981039346656037ULL;
+			char buffer[64 * 1024];
+
+			while (file)
+			{
+				file.read(buffer, sizeof(buffer));
+				const std::streamsize count = file.gcount();
+
+				for (std::streamsize i = 0; i < count; i++)
+				{
+					hash ^= (unsigned char)buffer[i];
+					hash *= 1099511628211ULL;
+				}
+			}
+
+			return hash;
 		}
 
 		std::vector<std::string> Split(const std::string& s, char delim)
@@ -31,7 +31,8 @@ SOFTWARE.
 Class: ECSTransformComponent
 
 Represents transformations for objects so that they could have
-location, rotation and scale in the world.
+location, rotation and scale in the world. Transforms can be parented to other
+entities, in which case the transformation is local to the parent.
 
 Timestamp: 4/9/2019 1:28:05 PM
 
@@ -45,6 +46,7 @@ Timestamp: 4/9/2019 1:28:05 PM
 
 #include "Utility/Math/Transformation.hpp"
 #include "ECS/ECSComponent.hpp"
+#include "ECS/ECSSystem.hpp"
 
 namespace LinaEngine::ECS
 {
@@ -52,6 +54,15 @@ namespace LinaEngine::ECS
 	{
 		LinaEngine::Transformation transform;
 
+		// Set through TransformHierarchy::SetParent, null for root transforms.
+		ECSEntity m_parent = entt::null;
+
+		// Cached by the transform hierarchy every frame, renderers & physics should use this instead of the local transformation.
+		Matrix m_worldMatrix = Matrix::Identity();
+
+		Vector3 GetWorldLocation() const { return Vector3(m_worldMatrix[3][0], m_worldMatrix[3][1], m_worldMatrix[3][2]); }
+		Quaternion GetWorldRotation() const { return m_worldMatrix.GetRotation(); }
+
 		template<class Archive>
 		void serialize(Archive& archive)
 		{
@@ -31,6 +31,7 @@ Class: ECSSystem
 
 Defines ECSRegistry wrapper, base ECS system class that defines functions for updating entity components
 as well as an ECS Systems class responsible for iterating & calling update functions of containted systems.
+Systems declare the components they read & write so that the list can update non-conflicting ones in parallel.
 
 Timestamp: 4/8/2019 5:28:34 PM
 */
@@ -41,11 +42,23 @@ Timestamp: 4/8/2019 5:28:34 PM
 #define ECSSystem_HPP
 
 #include "Core/Common.hpp"
+#include "Core/SizeDefinitions.hpp"
 #include "entt/entity/registry.hpp"
 #include "entt/entity/entity.hpp"
 #include <cereal/types/string.hpp>
 #include <cereal/types/map.hpp>
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+namespace LinaEngine
+{
+	class JobSystem;
+	class JobCounter;
+}
 
 namespace LinaEngine::ECS
 {
@@ -59,6 +72,9 @@ namespace LinaEngine::ECS
 		bool m_isEnabled = true;
 		std::string m_name = "";
 
+		// Levels save tags apart from the snapshot so the ones saved before tags still load.
+		std::string m_tag = "";
+
 		template<class Archive>
 		void serialize(Archive& archive)
 		{
@@ -77,11 +93,50 @@ namespace LinaEngine::ECS
 	{
 	public:
 
-		ECSRegistry() {  };
-		virtual ~ECSRegistry() {};
+		ECSRegistry();
+		virtual ~ECSRegistry();
 
 		ECSEntity CreateEntity(const std::string& name);
+
+		// Lookups go through hash indices kept up to date by the entity data signals. Names & tags don't have to
+		// be unique, single lookups return any one of the matching entities.
 		ECSEntity GetEntity(const std::string& name);
+		void GetEntities(const std::string& name, std::vector<ECSEntity>& entities);
+		ECSEntity GetEntityWithTag(const std::string& tag);
+		void GetEntitiesWithTag(const std::string& tag, std::vector<ECSEntity>& entities);
+
+		// Entity data has to be changed through these or patch, writing to the component directly skips the index.
+		void SetEntityName(ECSEntity entity, const std::string& name);
+		void SetEntityTag(ECSEntity entity, const std::string& tag);
+
+	private:
+
+		typedef std::unordered_map<std::string, std::vector<ECSEntity>> EntityIndex;
+
+		// Positions in the name & tag buckets, removal swaps the last entity of the bucket into the freed position.
+		struct IndexedEntity
+		{
+			std::string m_name;
+			std::string m_tag;
+			uint32 m_namePosition = 0;
+			uint32 m_tagPosition = 0;
+		};
+
+		void OnEntityDataConstructed(entt::registry& registry, entt::entity entity);
+		void OnEntityDataUpdated(entt::registry& registry, entt::entity entity);
+		void OnEntityDataDestroyed(entt::registry& registry, entt::entity entity);
+		void AddToIndex(EntityIndex& index, const std::string& key, ECSEntity entity, uint32& position);
+		void RemoveFromIndex(EntityIndex& index, const std::string& key, uint32 position, uint32 IndexedEntity::* positionMember);
+
+	private:
+
+		EntityIndex m_nameIndex;
+		EntityIndex m_tagIndex;
+
+		// What each entity is indexed under, entity data is already changed when the update signal fires.
+		std::unordered_map<ECSEntity, IndexedEntity> m_indexedEntities;
+
+		DISALLOW_COPY_ASSIGN_MOVE(ECSRegistry)
 	};
 	
 
@@ -94,36 +149,122 @@ namespace LinaEngine::ECS
 		virtual void UpdateComponents(float delta) = 0;
 		virtual void SystemActivation(bool active) { m_isActive = active; }
 
+		const std::string& GetName() const { return m_name; }
+		const std::vector<ECSTypeID>& GetReadTypes() const { return m_readTypes; }
+		const std::vector<ECSTypeID>& GetWriteTypes() const { return m_writeTypes; }
+
+		// Systems that don't declare their access can touch anything, so they never run alongside others.
+		bool GetIsExclusive() const { return m_isMainThreadOnly || (m_readTypes.empty() && m_writeTypes.empty()); }
+
 	protected:
 
 		virtual void Construct(ECSRegistry& reg) { m_ecs = &reg; };
+
+		// Component access declarations, systems without conflicting access are updated concurrently.
+		// Pools are created up front as entt creates them lazily, which is not safe across threads.
+		template<typename T>
+		void ReadsComponent() { m_ecs->prepare<T>(); AddAccess(m_readTypes, GetTypeID<T>()); }
+
+		template<typename T>
+		void WritesComponent() { m_ecs->prepare<T>(); AddAccess(m_writeTypes, GetTypeID<T>()); }
+
+		// Non-component state shared between systems, e.g. the render engine or another system's data.
+		template<typename T>
+		void ReadsResource() { AddAccess(m_readTypes, GetTypeID<T>()); }
+
+		template<typename T>
+		void WritesResource() { AddAccess(m_writeTypes, GetTypeID<T>()); }
+
+		// For systems calling into APIs bound to the main thread, like windowing or input.
+		void SetMainThreadOnly(bool mainThreadOnly) { m_isMainThreadOnly = mainThreadOnly; }
+		void SetName(const std::string& name) { m_name = name; }
+
 		ECSRegistry* m_ecs = nullptr;
 		bool m_isActive = false;
 
+	private:
+
+		void AddAccess(std::vector<ECSTypeID>& types, ECSTypeID id)
+		{
+			if (std::find(types.begin(), types.end(), id) == types.end())
+				types.push_back(id);
+		}
+
+		std::string m_name = "ECSSystem";
+		std::vector<ECSTypeID> m_readTypes;
+		std::vector<ECSTypeID> m_writeTypes;
+		bool m_isMainThreadOnly = false;
 	};
 
+	struct ECSSystemTiming
+	{
+		std::string m_name = "";
+		double m_lastUpdateMS = 0.0;
+		double m_averageUpdateMS = 0.0;
+		uint64 m_updateCount = 0;
+	};
+
+	// Runs a pipeline of systems. The systems are ordered into a dependency graph where a system depends on the
+	// earlier added ones it conflicts with, so the results match updating them one by one in insertion order.
 	class ECSSystemList
 	{
 	public:
 
+		ECSSystemList() {};
+		~ECSSystemList() {};
+
 		bool AddSystem(BaseECSSystem& system)
 		{
 			m_systems.push_back(&system);
+			m_graphDirty = true;
 			return true;
 		}
 
-		void UpdateSystems(float delta)
-		{
-			for (auto s : m_systems)
-				s->UpdateComponents(delta);
-		}
-
 		bool RemoveSystem(BaseECSSystem& system);
 
+		// Updates the systems, concurrently if a job system is set & the serial mode is off.
+		void UpdateSystems(float delta);
+
+		// Without a job system the systems are updated on the calling thread.
+		void SetJobSystem(JobSystem* jobSystem) { m_jobSystem = jobSystem; }
+
+		// Updates the systems one by one in insertion order, for debugging & deterministic runs.
+		void SetSerialMode(bool serial) { m_serialMode = serial; }
+		bool GetSerialMode() const { return m_serialMode; }
+
+		// Timings of the last update & the running average, in insertion order.
+		const std::vector<ECSSystemTiming>& GetTimings();
+		void ResetTimings();
+
+		// Logs the dependency graph, useful to see why systems don't run concurrently.
+		void LogGraph();
+
 	private:
 
-		std::vector<BaseECSSystem*> m_systems;
+		struct SystemNode
+		{
+			std::vector<uint32> m_successors;
+			uint32 m_dependencyCount = 0;
+			double m_lastUpdateMS = 0.0;
+			double m_totalUpdateMS = 0.0;
+			uint64 m_updateCount = 0;
+		};
+
+		void BuildGraph();
+		void UpdateSystem(uint32 index, float delta);
+		void UpdateSegment(uint32 begin, uint32 end, float delta);
+		void RunNode(uint32 index, float delta, JobCounter* counter);
+		static bool SystemsConflict(const BaseECSSystem& a, const BaseECSSystem& b);
 
+		std::vector<BaseECSSystem*> m_systems;
+		std::vector<SystemNode> m_nodes;
+		std::unique_ptr<std::atomic<uint32>[]> m_remainingDependencies;
+		std::vector<ECSSystemTiming> m_timings;
+		JobSystem* m_jobSystem = nullptr;
+		bool m_serialMode = false;
+		bool m_graphDirty = true;
+
+		DISALLOW_COPY_ASSIGN_MOVE(ECSSystemList)
 	};
 }
 
@@ -0,0 +1,118 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: TransformHierarchy
+
+Keeps the parent-child relationships of transform components in depth sorted arrays & caches
+world matrices. Local transformations are compared against their cached copies every update so
+that only the changed subtrees are recalculated, levels are processed in parallel.
+
+Timestamp: 11/3/2020 9:14:22 AM
+*/
+
+#pragma once
+
+#ifndef TransformHierarchy_HPP
+#define TransformHierarchy_HPP
+
+#include "ECS/ECSSystem.hpp"
+#include "Utility/Math/Matrix.hpp"
+#include <vector>
+
+namespace LinaEngine
+{
+	class JobSystem;
+}
+
+namespace LinaEngine::ECS
+{
+	struct TransformComponent;
+
+	class TransformHierarchy
+	{
+	public:
+
+		TransformHierarchy() {};
+		~TransformHierarchy();
+
+		// Listens to transform construction & destruction to know when to rebuild the layout.
+		void Initialize(ECSRegistry& registry);
+		void Shutdown();
+
+		// Recalculates the world matrices of changed subtrees & writes them to the components.
+		void Update(JobSystem* jobSystem = nullptr);
+
+		// Parents child to parent, null parent makes it a root. Fails if it would create a cycle.
+		bool SetParent(ECSEntity child, ECSEntity parent);
+		ECSEntity GetParent(ECSEntity entity);
+		void GetChildren(ECSEntity entity, std::vector<ECSEntity>& children);
+
+		// Walks the parent chain of the entity, for when the world matrix is needed before the next update.
+		static Matrix CalculateWorldMatrix(entt::registry& registry, ECSEntity entity);
+
+		// Parent links aren't a part of the transform component archive, levels save them as a list of pairs.
+		void GetParentPairs(std::vector<std::pair<uint32, uint32>>& pairs);
+		void SetParentPairs(const std::vector<std::pair<uint32, uint32>>& pairs);
+
+		// Entities whose world matrix changed in the last update, all of them after a rebuild.
+		const std::vector<ECSEntity>& GetChangedEntities() const { return m_changedEntities; }
+
+		uint32 GetNodeCount() const { return (uint32)m_entities.size(); }
+		uint32 GetDepth() const { return m_levelOffsets.empty() ? 0 : (uint32)m_levelOffsets.size() - 1; }
+
+	private:
+
+		void OnTransformConstructed(entt::registry& registry, entt::entity entity) { m_structureDirty = true; }
+		void OnTransformDestroyed(entt::registry& registry, entt::entity entity) { m_structureDirty = true; }
+		void Rebuild();
+		void DetectChanges(uint32 begin, uint32 end);
+		void UpdateNodes(uint32 begin, uint32 end);
+
+	private:
+
+		ECSRegistry* m_registry = nullptr;
+		bool m_structureDirty = true;
+
+		// Depth sorted, parents always come before their children. Level i spans [m_levelOffsets[i], m_levelOffsets[i + 1]).
+		std::vector<ECSEntity> m_entities;
+		std::vector<int32> m_parentIndices;
+		std::vector<uint32> m_levelOffsets;
+
+		// Cached local transformations & the resulting world matrices.
+		std::vector<Vector3> m_locations;
+		std::vector<Quaternion> m_rotations;
+		std::vector<Vector3> m_scales;
+		std::vector<Matrix> m_worldMatrices;
+		std::vector<uint8> m_dirty;
+		std::vector<ECSEntity> m_changedEntities;
+
+		DISALLOW_COPY_ASSIGN_MOVE(TransformHierarchy)
+	};
+}
+
+#endif
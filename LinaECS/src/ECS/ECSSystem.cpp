@@ -27,7 +27,9 @@ SOFTWARE.
 */
 
 #include "ECS/ECSSystem.hpp"  
+#include "Core/JobSystem.hpp"
 #include "Utility/Log.hpp"
+#include <chrono>
 
 namespace LinaEngine::ECS
 {
@@ -39,6 +41,7 @@ namespace LinaEngine::ECS
 			if (&system == m_systems[i])
 			{
 				m_systems.erase(m_systems.begin() + i);
+				m_graphDirty = true;
 				return true;
 			}
 		}
@@ -46,6 +49,205 @@ namespace LinaEngine::ECS
 		return false;
 	}
 
+	void ECSSystemList::UpdateSystems(float delta)
+	{
+		if (m_graphDirty)
+			BuildGraph();
+
+		// Serial mode, insertion order is a valid order of the graph.
+		if (m_serialMode || m_jobSystem == nullptr || !m_jobSystem->GetIsInitialized())
+		{
+			for (uint32 i = 0; i < m_systems.size(); i++)
+				UpdateSystem(i, delta);
+
+			return;
+		}
+
+		// Exclusive systems act as barriers, they are updated on this thread between the parallel segments.
+		uint32 segmentBegin = 0;
+		for (uint32 i = 0; i < m_systems.size(); i++)
+		{
+			if (m_systems[i]->GetIsExclusive())
+			{
+				UpdateSegment(segmentBegin, i, delta);
+				UpdateSystem(i, delta);
+				segmentBegin = i + 1;
+			}
+		}
+
+		UpdateSegment(segmentBegin, (uint32)m_systems.size(), delta);
+	}
+
+	void ECSSystemList::UpdateSegment(uint32 begin, uint32 end, float delta)
+	{
+		if (begin >= end)
+			return;
+
+		// Not worth the scheduling overhead.
+		if (end - begin == 1)
+		{
+			UpdateSystem(begin, delta);
+			return;
+		}
+
+		for (uint32 i = begin; i < end; i++)
+			m_remainingDependencies[i].store(m_nodes[i].m_dependencyCount);
+
+		JobCounter counter;
+
+		for (uint32 i = begin; i < end; i++)
+		{
+			if (m_nodes[i].m_dependencyCount == 0)
+				m_jobSystem->Run([this, i, delta, &counter]() { RunNode(i, delta, &counter); }, &counter);
+		}
+
+		// The calling thread picks up systems as well while waiting.
+		m_jobSystem->Wait(counter);
+	}
+
+	void ECSSystemList::RunNode(uint32 index, float delta, JobCounter* counter)
+	{
+		UpdateSystem(index, delta);
+
+		// Successors are queued before this job finishes, so the counter can't reach zero early.
+		for (uint32 successor : m_nodes[index].m_successors)
+		{
+			if (m_remainingDependencies[successor].fetch_sub(1) == 1)
+				m_jobSystem->Run([this, successor, delta, counter]() { RunNode(successor, delta, counter); }, counter);
+		}
+	}
+
+	void ECSSystemList::UpdateSystem(uint32 index, float delta)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		m_systems[index]->UpdateComponents(delta);
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		// Each node is only touched by the thread updating it.
+		SystemNode& node = m_nodes[index];
+		node.m_lastUpdateMS = ms;
+		node.m_totalUpdateMS += ms;
+		node.m_updateCount++;
+	}
+
+	void ECSSystemList::BuildGraph()
+	{
+		m_nodes.clear();
+		m_nodes.resize(m_systems.size());
+		m_remainingDependencies.reset(new std::atomic<uint32>[m_systems.size()]);
+
+		// A system depends on every earlier system in its segment that it conflicts with. Edges are never
+		// added to or across exclusive systems since those already wait for & block everything.
+		uint32 segmentBegin = 0;
+		for (uint32 i = 0; i < m_systems.size(); i++)
+		{
+			if (m_systems[i]->GetIsExclusive())
+			{
+				segmentBegin = i + 1;
+				continue;
+			}
+
+			for (uint32 j = segmentBegin; j < i; j++)
+			{
+				if (SystemsConflict(*m_systems[j], *m_systems[i]))
+				{
+					m_nodes[j].m_successors.push_back(i);
+					m_nodes[i].m_dependencyCount++;
+				}
+			}
+		}
+
+		m_graphDirty = false;
+	}
+
+	bool ECSSystemList::SystemsConflict(const BaseECSSystem& a, const BaseECSSystem& b)
+	{
+		if (a.GetIsExclusive() || b.GetIsExclusive())
+			return true;
+
+		auto contains = [](const std::vector<ECSTypeID>& types, ECSTypeID id) { return std::find(types.begin(), types.end(), id) != types.end(); };
+
+		// Write - write & read - write pairs conflict, readers can share.
+		for (ECSTypeID id : a.GetWriteTypes())
+		{
+			if (contains(b.GetWriteTypes(), id) || contains(b.GetReadTypes(), id))
+				return true;
+		}
+
+		for (ECSTypeID id : a.GetReadTypes())
+		{
+			if (contains(b.GetWriteTypes(), id))
+				return true;
+		}
+
+		return false;
+	}
+
+	const std::vector<ECSSystemTiming>& ECSSystemList::GetTimings()
+	{
+		if (m_graphDirty)
+			BuildGraph();
+
+		m_timings.resize(m_systems.size());
+
+		for (uint32 i = 0; i < m_systems.size(); i++)
+		{
+			ECSSystemTiming& timing = m_timings[i];
+			timing.m_name = m_systems[i]->GetName();
+			timing.m_lastUpdateMS = m_nodes[i].m_lastUpdateMS;
+			timing.m_updateCount = m_nodes[i].m_updateCount;
+			timing.m_averageUpdateMS = m_nodes[i].m_updateCount == 0 ? 0.0 : m_nodes[i].m_totalUpdateMS / (double)m_nodes[i].m_updateCount;
+		}
+
+		return m_timings;
+	}
+
+	void ECSSystemList::ResetTimings()
+	{
+		for (SystemNode& node : m_nodes)
+		{
+			node.m_lastUpdateMS = 0.0;
+			node.m_totalUpdateMS = 0.0;
+			node.m_updateCount = 0;
+		}
+	}
+
+	void ECSSystemList::LogGraph()
+	{
+		if (m_graphDirty)
+			BuildGraph();
+
+		for (uint32 i = 0; i < m_systems.size(); i++)
+		{
+			std::string successors = "";
+			for (uint32 successor : m_nodes[i].m_successors)
+				successors += m_systems[successor]->GetName() + " ";
+
+			if (m_systems[i]->GetIsExclusive())
+			{
+				LINA_CORE_TRACE("[ECS Graph] {0} (exclusive)", m_systems[i]->GetName());
+			}
+			else
+			{
+				LINA_CORE_TRACE("[ECS Graph] {0} -> {1}", m_systems[i]->GetName(), successors);
+			}
+		}
+	}
+
+	ECSRegistry::ECSRegistry()
+	{
+		on_construct<ECSEntityData>().connect<&ECSRegistry::OnEntityDataConstructed>(this);
+		on_update<ECSEntityData>().connect<&ECSRegistry::OnEntityDataUpdated>(this);
+		on_destroy<ECSEntityData>().connect<&ECSRegistry::OnEntityDataDestroyed>(this);
+	}
+
+	ECSRegistry::~ECSRegistry()
+	{
+		on_construct<ECSEntityData>().disconnect<&ECSRegistry::OnEntityDataConstructed>(this);
+		on_update<ECSEntityData>().disconnect<&ECSRegistry::OnEntityDataUpdated>(this);
+		on_destroy<ECSEntityData>().disconnect<&ECSRegistry::OnEntityDataDestroyed>(this);
+	}
+
 	entt::entity ECSRegistry::CreateEntity(const std::string& name)
 	{
 		entt::entity ent = create();
@@ -55,16 +257,128 @@ namespace LinaEngine::ECS
 
 	ECSEntity ECSRegistry::GetEntity(const std::string& name)
 	{
-		auto singleView = view<ECSEntityData>();
+		auto it = m_nameIndex.find(name);
+
+		if (it == m_nameIndex.end())
+		{
+			LINA_CORE_WARN("Entity with the name {0} could not be found, returning null entity.", name);
+			return entt::null;
+		}
+
+		return it->second.front();
+	}
+
+	void ECSRegistry::GetEntities(const std::string& name, std::vector<ECSEntity>& entities)
+	{
+		auto it = m_nameIndex.find(name);
+
+		if (it != m_nameIndex.end())
+			entities.insert(entities.end(), it->second.begin(), it->second.end());
+	}
+
+	ECSEntity ECSRegistry::GetEntityWithTag(const std::string& tag)
+	{
+		auto it = m_tagIndex.find(tag);
+
+		if (it == m_tagIndex.end())
+		{
+			LINA_CORE_WARN("Entity with the tag {0} could not be found, returning null entity.", tag);
+			return entt::null;
+		}
+
+		return it->second.front();
+	}
+
+	void ECSRegistry::GetEntitiesWithTag(const std::string& tag, std::vector<ECSEntity>& entities)
+	{
+		auto it = m_tagIndex.find(tag);
+
+		if (it != m_tagIndex.end())
+			entities.insert(entities.end(), it->second.begin(), it->second.end());
+	}
+
+	void ECSRegistry::SetEntityName(ECSEntity entity, const std::string& name)
+	{
+		if (get<ECSEntityData>(entity).m_name != name)
+			patch<ECSEntityData>(entity, [&name](ECSEntityData& data) { data.m_name = name; });
+	}
+
+	void ECSRegistry::SetEntityTag(ECSEntity entity, const std::string& tag)
+	{
+		if (get<ECSEntityData>(entity).m_tag != tag)
+			patch<ECSEntityData>(entity, [&tag](ECSEntityData& data) { data.m_tag = tag; });
+	}
 
-		for(auto entity : singleView)
+	void ECSRegistry::OnEntityDataConstructed(entt::registry& registry, entt::entity entity)
+	{
+		const ECSEntityData& data = registry.get<ECSEntityData>(entity);
+		IndexedEntity& indexed = m_indexedEntities[entity];
+		indexed.m_name = data.m_name;
+		indexed.m_tag = data.m_tag;
+		AddToIndex(m_nameIndex, data.m_name, entity, indexed.m_namePosition);
+		AddToIndex(m_tagIndex, data.m_tag, entity, indexed.m_tagPosition);
+	}
+
+	void ECSRegistry::OnEntityDataUpdated(entt::registry& registry, entt::entity entity)
+	{
+		const ECSEntityData& data = registry.get<ECSEntityData>(entity);
+		IndexedEntity& indexed = m_indexedEntities[entity];
+
+		if (indexed.m_name != data.m_name)
 		{
-			if (singleView.get<ECSEntityData>(entity).m_name.compare(name) == 0)
-				return entity;
+			RemoveFromIndex(m_nameIndex, indexed.m_name, indexed.m_namePosition, &IndexedEntity::m_namePosition);
+			AddToIndex(m_nameIndex, data.m_name, entity, indexed.m_namePosition);
+			indexed.m_name = data.m_name;
 		}
 
-		LINA_CORE_WARN("Entity with the name {0} could not be found, returning null entity.", name);
-		return entt::null;
+		if (indexed.m_tag != data.m_tag)
+		{
+			RemoveFromIndex(m_tagIndex, indexed.m_tag, indexed.m_tagPosition, &IndexedEntity::m_tagPosition);
+			AddToIndex(m_tagIndex, data.m_tag, entity, indexed.m_tagPosition);
+			indexed.m_tag = data.m_tag;
+		}
+	}
+
+	void ECSRegistry::OnEntityDataDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		auto it = m_indexedEntities.find(entity);
+		if (it == m_indexedEntities.end())
+			return;
+
+		RemoveFromIndex(m_nameIndex, it->second.m_name, it->second.m_namePosition, &IndexedEntity::m_namePosition);
+		RemoveFromIndex(m_tagIndex, it->second.m_tag, it->second.m_tagPosition, &IndexedEntity::m_tagPosition);
+		m_indexedEntities.erase(it);
+	}
+
+	void ECSRegistry::AddToIndex(EntityIndex& index, const std::string& key, ECSEntity entity, uint32& position)
+	{
+		// Unnamed & untagged entities aren't looked up, no need to keep them.
+		if (key.empty())
+			return;
+
+		std::vector<ECSEntity>& entities = index[key];
+		position = (uint32)entities.size();
+		entities.push_back(entity);
+	}
+
+	void ECSRegistry::RemoveFromIndex(EntityIndex& index, const std::string& key, uint32 position, uint32 IndexedEntity::* positionMember)
+	{
+		auto it = index.find(key);
+		if (it == index.end())
+			return;
+
+		// Swap removal keeps destroying many entities sharing a name linear.
+		std::vector<ECSEntity>& entities = it->second;
+		if (position != entities.size() - 1)
+		{
+			entities[position] = entities.back();
+			m_indexedEntities[entities[position]].*positionMember = position;
+		}
+
+		entities.pop_back();
+
+		if (entities.empty())
+			index.erase(it);
 	}
 
 }
@@ -0,0 +1,329 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: TransformHierarchy
+
+Timestamp: 11/3/2020 9:14:22 AM
+*/
+
+#include "ECS/TransformHierarchy.hpp"
+#include "ECS/Components/TransformComponent.hpp"
+#include "Core/JobSystem.hpp"
+#include "Utility/Log.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace LinaEngine::ECS
+{
+	// Levels smaller than this are updated on the calling thread.
+	#define TRANSFORMHIERARCHY_PARALLEL_THRESHOLD 512
+	#define TRANSFORMHIERARCHY_GRAIN_SIZE 256
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		Shutdown();
+	}
+
+	void TransformHierarchy::Initialize(ECSRegistry& registry)
+	{
+		m_registry = &registry;
+		m_registry->on_construct<TransformComponent>().connect<&TransformHierarchy::OnTransformConstructed>(this);
+		m_registry->on_update<TransformComponent>().connect<&TransformHierarchy::OnTransformConstructed>(this);
+		m_registry->on_destroy<TransformComponent>().connect<&TransformHierarchy::OnTransformDestroyed>(this);
+		m_structureDirty = true;
+	}
+
+	void TransformHierarchy::Shutdown()
+	{
+		if (m_registry == nullptr)
+			return;
+
+		m_registry->on_construct<TransformComponent>().disconnect<&TransformHierarchy::OnTransformConstructed>(this);
+		m_registry->on_update<TransformComponent>().disconnect<&TransformHierarchy::OnTransformConstructed>(this);
+		m_registry->on_destroy<TransformComponent>().disconnect<&TransformHierarchy::OnTransformDestroyed>(this);
+		m_registry = nullptr;
+	}
+
+	void TransformHierarchy::Update(JobSystem* jobSystem)
+	{
+		if (m_registry == nullptr)
+			return;
+
+		if (m_structureDirty)
+			Rebuild();
+
+		const uint32 count = (uint32)m_entities.size();
+		const bool parallel = jobSystem != nullptr && jobSystem->GetIsInitialized();
+
+		// Pick up the local transformations changed since the last update.
+		if (parallel && count >= TRANSFORMHIERARCHY_PARALLEL_THRESHOLD)
+			jobSystem->ParallelFor(count, TRANSFORMHIERARCHY_GRAIN_SIZE, [this](uint32 begin, uint32 end) { DetectChanges(begin, end); });
+		else
+			DetectChanges(0, count);
+
+		// Parents are finished by the time their level is done, so each level only depends on the previous one.
+		for (uint32 level = 0; level + 1 < m_levelOffsets.size(); level++)
+		{
+			const uint32 begin = m_levelOffsets[level];
+			const uint32 end = m_levelOffsets[level + 1];
+
+			if (parallel && end - begin >= TRANSFORMHIERARCHY_PARALLEL_THRESHOLD)
+				jobSystem->ParallelFor(end - begin, TRANSFORMHIERARCHY_GRAIN_SIZE, [this, begin](uint32 rangeBegin, uint32 rangeEnd) { UpdateNodes(begin + rangeBegin, begin + rangeEnd); });
+			else
+				UpdateNodes(begin, end);
+		}
+
+		m_changedEntities.clear();
+		for (uint32 i = 0; i < count; i++)
+		{
+			if (m_dirty[i])
+				m_changedEntities.push_back(m_entities[i]);
+		}
+
+		std::fill(m_dirty.begin(), m_dirty.end(), (uint8)0);
+	}
+
+	void TransformHierarchy::DetectChanges(uint32 begin, uint32 end)
+	{
+		for (uint32 i = begin; i < end; i++)
+		{
+			const Transformation& transform = m_registry->get<TransformComponent>(m_entities[i]).transform;
+			const Vector3& location = transform.m_location;
+			const Quaternion& rotation = transform.m_rotation;
+			const Vector3& scale = transform.m_scale;
+
+			const bool changed = location.x != m_locations[i].x || location.y != m_locations[i].y || location.z != m_locations[i].z
+				|| rotation.x != m_rotations[i].x || rotation.y != m_rotations[i].y || rotation.z != m_rotations[i].z || rotation.w != m_rotations[i].w
+				|| scale.x != m_scales[i].x || scale.y != m_scales[i].y || scale.z != m_scales[i].z;
+
+			if (changed)
+			{
+				m_locations[i] = location;
+				m_rotations[i] = rotation;
+				m_scales[i] = scale;
+				m_dirty[i] = 1;
+			}
+		}
+	}
+
+	void TransformHierarchy::UpdateNodes(uint32 begin, uint32 end)
+	{
+		for (uint32 i = begin; i < end; i++)
+		{
+			const int32 parent = m_parentIndices[i];
+
+			// A changed parent invalidates the whole subtree.
+			if (parent != -1 && m_dirty[parent])
+				m_dirty[i] = 1;
+
+			if (!m_dirty[i])
+				continue;
+
+			const Matrix local = Matrix::TransformMatrix(m_locations[i], m_rotations[i], m_scales[i]);
+			m_worldMatrices[i] = parent == -1 ? local : Matrix(m_worldMatrices[parent] * local);
+			m_registry->get<TransformComponent>(m_entities[i]).m_worldMatrix = m_worldMatrices[i];
+		}
+	}
+
+	void TransformHierarchy::Rebuild()
+	{
+		auto view = m_registry->view<TransformComponent>();
+		const uint32 count = (uint32)view.size();
+
+		// Find the depth of each transform, links to missing parents & cycles are broken.
+		std::unordered_map<ECSEntity, uint32> depths;
+		depths.reserve(count);
+		std::vector<ECSEntity> chain;
+
+		for (ECSEntity entity : view)
+		{
+			chain.clear();
+			ECSEntity current = entity;
+			uint32 depth = 0;
+
+			while (true)
+			{
+				auto it = depths.find(current);
+				if (it != depths.end())
+				{
+					depth = it->second + 1;
+					break;
+				}
+
+				chain.push_back(current);
+				TransformComponent& transform = m_registry->get<TransformComponent>(current);
+
+				if (transform.m_parent != entt::null)
+				{
+					const bool invalid = !m_registry->valid(transform.m_parent) || !m_registry->has<TransformComponent>(transform.m_parent);
+					if (invalid || std::find(chain.begin(), chain.end(), transform.m_parent) != chain.end())
+					{
+						LINA_CORE_WARN("Transform parent is invalid or creates a cycle, the transform is made a root.");
+						transform.m_parent = entt::null;
+					}
+				}
+
+				if (transform.m_parent == entt::null)
+					break;
+
+				current = transform.m_parent;
+			}
+
+			// Chain goes from the child to the root, or to the first transform with a known depth.
+			for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+				depths[*it] = depth++;
+		}
+
+		m_entities.assign(view.begin(), view.end());
+		std::sort(m_entities.begin(), m_entities.end(), [&depths](ECSEntity a, ECSEntity b)
+			{
+				const uint32 depthA = depths[a];
+				const uint32 depthB = depths[b];
+				return depthA != depthB ? depthA < depthB : entt::to_integral(a) < entt::to_integral(b);
+			});
+
+		std::unordered_map<ECSEntity, int32> indices;
+		indices.reserve(count);
+		m_parentIndices.resize(count);
+		m_levelOffsets.clear();
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const ECSEntity entity = m_entities[i];
+			const ECSEntity parent = m_registry->get<TransformComponent>(entity).m_parent;
+			indices[entity] = (int32)i;
+			m_parentIndices[i] = parent == entt::null ? -1 : indices[parent];
+
+			while (m_levelOffsets.size() <= depths[entity])
+				m_levelOffsets.push_back(i);
+		}
+
+		m_levelOffsets.push_back(count);
+
+		// Everything is recalculated after a rebuild.
+		m_locations.resize(count);
+		m_rotations.resize(count);
+		m_scales.resize(count);
+		m_worldMatrices.resize(count);
+		m_dirty.assign(count, 1);
+
+		m_structureDirty = false;
+	}
+
+	Matrix TransformHierarchy::CalculateWorldMatrix(entt::registry& registry, ECSEntity entity)
+	{
+		Matrix world = Matrix::Identity();
+
+		for (ECSEntity current = entity; current != entt::null && registry.valid(current); )
+		{
+			const TransformComponent* transform = registry.try_get<TransformComponent>(current);
+			if (transform == nullptr)
+				break;
+
+			const Transformation& local = transform->transform;
+			world = Matrix::TransformMatrix(local.m_location, local.m_rotation, local.m_scale) * world;
+			current = transform->m_parent;
+		}
+
+		return world;
+	}
+
+	bool TransformHierarchy::SetParent(ECSEntity child, ECSEntity parent)
+	{
+		TransformComponent* transform = m_registry->try_get<TransformComponent>(child);
+
+		if (transform == nullptr)
+		{
+			LINA_CORE_ERR("Can not set the parent of an entity without a transform component.");
+			return false;
+		}
+
+		if (parent != entt::null)
+		{
+			if (!m_registry->has<TransformComponent>(parent))
+			{
+				LINA_CORE_ERR("Can not parent to an entity without a transform component.");
+				return false;
+			}
+
+			for (ECSEntity current = parent; current != entt::null; current = m_registry->get<TransformComponent>(current).m_parent)
+			{
+				if (current == child)
+				{
+					LINA_CORE_ERR("Can not parent an entity to one of its children.");
+					return false;
+				}
+			}
+		}
+
+		transform->m_parent = parent;
+		m_structureDirty = true;
+		return true;
+	}
+
+	ECSEntity TransformHierarchy::GetParent(ECSEntity entity)
+	{
+		TransformComponent* transform = m_registry->try_get<TransformComponent>(entity);
+		return transform == nullptr ? entt::null : transform->m_parent;
+	}
+
+	void TransformHierarchy::GetChildren(ECSEntity entity, std::vector<ECSEntity>& children)
+	{
+		auto view = m_registry->view<TransformComponent>();
+
+		for (ECSEntity child : view)
+		{
+			if (view.get<TransformComponent>(child).m_parent == entity)
+				children.push_back(child);
+		}
+	}
+
+	void TransformHierarchy::GetParentPairs(std::vector<std::pair<uint32, uint32>>& pairs)
+	{
+		auto view = m_registry->view<TransformComponent>();
+
+		for (ECSEntity entity : view)
+		{
+			const ECSEntity parent = view.get<TransformComponent>(entity).m_parent;
+			if (parent != entt::null)
+				pairs.push_back(std::make_pair((uint32)entt::to_integral(entity), (uint32)entt::to_integral(parent)));
+		}
+	}
+
+	void TransformHierarchy::SetParentPairs(const std::vector<std::pair<uint32, uint32>>& pairs)
+	{
+		for (const std::pair<uint32, uint32>& pair : pairs)
+		{
+			const ECSEntity child = (ECSEntity)pair.first;
+			const ECSEntity parent = (ECSEntity)pair.second;
+
+			if (m_registry->valid(child) && m_registry->valid(parent))
+				SetParent(child, parent);
+		}
+	}
+}
@@ -40,7 +40,8 @@ Timestamp: 10/15/2020 10:44:39 PM
 #ifndef EditorApplication_HPP
 #define EditorApplication_HPP
 
-#include "Actions/ActionDispatcher.hpp"
+#include "Actions/EventBus.hpp"
+#include "Core/EditorEvents.hpp"
 #include "Utility/Log.hpp"
 #include "ECS/Systems/FreeLookSystem.hpp"
 #include "Core/GUILayer.hpp"
@@ -66,12 +67,12 @@ namespace LinaEditor
 		void Setup();
 		void Refresh();
 		void LevelInstalled(LinaEngine::World::Level* level);
-		static LinaEngine::Action::ActionDispatcher& GetEditorDispatcher() { return s_editorDispatcher; }
+		static LinaEngine::Action::EventBus& GetEditorEventBus() { return s_editorEventBus; }
 
 	private:
 
 		LinaEngine::ECS::FreeLookSystem m_freeLookSystem;
-		static LinaEngine::Action::ActionDispatcher s_editorDispatcher;
+		static LinaEngine::Action::EventBus s_editorEventBus;
 		GUILayer m_guiLayer;
 	};
 }
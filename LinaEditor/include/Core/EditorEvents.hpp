@@ -0,0 +1,105 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: EditorEvents
+
+Events panels & drawers dispatch through the editor EventBus.
+
+Timestamp: 11/5/2020 4:05:13 PM
+*/
+
+#pragma once
+
+#ifndef EditorEvents_HPP
+#define EditorEvents_HPP
+
+#include "Actions/Action.hpp"
+#include "ECS/ECSSystem.hpp"
+
+namespace LinaEngine::Graphics
+{
+	class Texture;
+	class Material;
+	class Mesh;
+}
+
+namespace LinaEditor
+{
+	enum class MenuBarItems;
+
+	struct TextureSelectedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::TextureSelected;
+		LinaEngine::Graphics::Texture* m_texture;
+	};
+
+	struct MaterialTextureSelectedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::MaterialTextureSelected;
+		LinaEngine::Graphics::Texture* m_texture;
+	};
+
+	struct TextureReimportedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::TextureReimported;
+		LinaEngine::Graphics::Texture* m_selected;
+		LinaEngine::Graphics::Texture* m_reimported;
+	};
+
+	struct EntitySelectedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::EntitySelected;
+		LinaEngine::ECS::ECSEntity m_entity;
+	};
+
+	struct MaterialSelectedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::MaterialSelected;
+		LinaEngine::Graphics::Material* m_material;
+	};
+
+	struct MeshSelectedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::MeshSelected;
+		LinaEngine::Graphics::Mesh* m_mesh;
+	};
+
+	struct UnselectEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::Unselect;
+	};
+
+	struct MenuItemClickedEvent
+	{
+		static constexpr LinaEngine::Action::ActionType s_actionType = LinaEngine::Action::ActionType::MenuItemClicked;
+		MenuBarItems m_item;
+	};
+}
+
+#endif
@@ -40,6 +40,7 @@ Timestamp: 6/7/2020 8:56:39 PM
 
 #include "Panels/EditorPanel.hpp"
 #include "Utility/Log.hpp"
+#include "Actions/EventBus.hpp"
 #include "Core/EditorCommon.hpp"
 #include "imgui/imgui.h"
 #include <deque>
@@ -76,7 +77,7 @@ namespace LinaEditor
 		// Wrapper for displaying log dumps
 		struct LogDumpEntry
 		{
-			LogDumpEntry(LinaEngine::Log::LogDump dump, int count) : m_dump(dump), m_count(count) {};
+			LogDumpEntry(const LinaEngine::Log::LogDump& dump, int count) : m_dump(dump), m_count(count) {};
 			LinaEngine::Log::LogDump m_dump;
 			int m_count = 1;
 		};
@@ -88,13 +89,14 @@ namespace LinaEditor
 
 		virtual void Setup() override;
 		virtual void Draw() override;
-		void OnLog(LinaEngine::Log::LogDump dump);
+		void OnLog(const LinaEngine::Log::LogDump& dump);
 
 	private:
 
 		unsigned int m_logLevelFlags = LinaEngine::Log::LogLevel::None;
 		std::vector<LogLevelIconButton> m_logLevelIconButtons;
 		std::deque<LogDumpEntry> m_logDeque;
+		LinaEngine::Action::EventToken m_onLogToken;
 	};
 }
 
@@ -54,10 +54,6 @@ namespace LinaEditor
 
 		virtual void Setup() override;
 		virtual void Draw() override;
-		
-	private:
-
-		float m_lastMSDisplayTime = 0.0f;
 
 	};
 }
@@ -40,11 +40,14 @@ Timestamp: 6/5/2020 12:54:52 AM
 #define ResourcesPanel_HPP
 
 #include "Panels/EditorPanel.hpp"
+#include "Utility/ResourceManifest.hpp"
 #include <map>
 #include <vector>
 
 namespace LinaEngine
 {
+	class JobSystem;
+
 	namespace Graphics
 	{
 		class RenderEngine;
@@ -114,8 +117,8 @@ namespace LinaEditor
 		void DrawContextMenu();
 		void ScanFolder(EditorFolder& folder);
 		void DrawFolder(EditorFolder& folder, bool isRoot = false);
-		void LoadFolderResources(EditorFolder& folder);
-		void LoadFolderDependencies(EditorFolder& folder);
+		void CollectFolderFiles(EditorFolder& folder, std::vector<EditorFile*>& textures, std::vector<EditorFile*>& meshes, std::vector<EditorFile*>& materials);
+		void LoadFolderResources(EditorFolder& folder, LinaEngine::JobSystem& jobSystem);
 		void UnloadFileResource(EditorFile& file);
 		void UnloadFileResourcesInFolder(EditorFolder& folder);
 		bool ExpandFileResource(EditorFolder& folder, const std::string& path, FileType type = FileType::Unknown);
@@ -127,6 +130,7 @@ namespace LinaEditor
 	private:
 
 		std::vector<EditorFolder> m_resourceFolders;
+		ResourceManifest m_manifest;
 	};
 }
 
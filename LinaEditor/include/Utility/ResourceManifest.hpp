@@ -0,0 +1,108 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: ResourceManifest
+
+Flat list of the files & folders in the project resources, scanned in parallel. Persisted between
+sessions so that folders which haven't changed are listed from the manifest instead of the file system.
+
+Timestamp: 10/29/2020 11:02:46 AM
+*/
+
+#pragma once
+
+#ifndef ResourceManifest_HPP
+#define ResourceManifest_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <cereal/types/unordered_map.hpp>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <mutex>
+
+namespace LinaEngine
+{
+	class JobSystem;
+	class JobCounter;
+}
+
+namespace LinaEditor
+{
+	struct ManifestEntry
+	{
+		std::string m_path = "";
+		int64 m_lastWriteTime = 0;
+		bool m_isDirectory = false;
+
+		// Paths of the files & folders inside, only for directories.
+		std::vector<std::string> m_children;
+
+		template<class Archive>
+		void serialize(Archive& archive)
+		{
+			archive(m_path, m_lastWriteTime, m_isDirectory, m_children);
+		}
+	};
+
+	class ResourceManifest
+	{
+	public:
+
+		ResourceManifest() {};
+		~ResourceManifest() {};
+
+		// Reads the manifest of the previous session, returns false if there is none.
+		bool Load(const std::string& path);
+		void Save(const std::string& path);
+
+		// Walks the directory tree on the job system, reusing the listings of the unchanged directories.
+		void Scan(const std::string& rootPath, LinaEngine::JobSystem& jobSystem);
+
+		// Returns nullptr if the path was not found during the scan.
+		const ManifestEntry* GetEntry(const std::string& path) const;
+		bool Contains(const std::string& path) const { return m_entries.find(path) != m_entries.end(); }
+		uint32 GetReusedDirectoryCount() const { return m_reusedDirectoryCount; }
+
+	private:
+
+		void ScanDirectory(const std::string& path, int64 lastWriteTime, LinaEngine::JobSystem& jobSystem, LinaEngine::JobCounter& counter);
+		bool ListFromPrevious(ManifestEntry& directory, std::vector<ManifestEntry>& entries);
+
+	private:
+
+		std::unordered_map<std::string, ManifestEntry> m_entries;
+		std::unordered_map<std::string, ManifestEntry> m_previousEntries;
+		std::mutex m_mutex;
+		uint32 m_reusedDirectoryCount = 0;
+	};
+}
+
+#endif
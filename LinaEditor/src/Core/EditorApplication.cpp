@@ -43,11 +43,10 @@ namespace LinaEditor
 {
 #define EDITOR_CAMERA_NAME "Editor Camera"
 
-	LinaEngine::Action::ActionDispatcher EditorApplication::s_editorDispatcher;
+	LinaEngine::Action::EventBus EditorApplication::s_editorEventBus;
 
 	EditorApplication::EditorApplication()
 	{
-		s_editorDispatcher.Initialize(LinaEngine::Action::ActionType::EditorActionsStartIndex, LinaEngine::Action::ActionType::EditorActionsEndIndex);
 
 	}
 
@@ -75,8 +74,7 @@ namespace LinaEditor
 
 		LinaEngine::Application::GetRenderEngine().PushLayer(m_guiLayer);
 
-		LinaEngine::Application::GetEngineDispatcher().SubscribeAction<LinaEngine::World::Level*>("##linaeditor_level_init", LinaEngine::Action::ActionType::LevelInitialized,
-			std::bind(&EditorApplication::LevelInstalled, this, std::placeholders::_1));
+		LinaEngine::Application::GetEngineEventBus().Subscribe<LinaEngine::LevelInitializedEvent>([this](const LinaEngine::LevelInitializedEvent& event) { LevelInstalled(event.m_level); });
 
 		m_freeLookSystem.Construct(LinaEngine::Application::GetECSRegistry(), LinaEngine::Application::GetInputEngine());
 		m_freeLookSystem.SystemActivation(true);
@@ -36,6 +36,7 @@ SOFTWARE.
 #include "Core/EditorApplication.hpp"
 #include "Utility/EditorUtility.hpp"
 #include "Widgets/WidgetsUtility.hpp"
+#include "Core/MemoryTracker.hpp"
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw.h"
 #include "imgui/imgui_impl_opengl3.h"
@@ -68,10 +69,12 @@ namespace LinaEditor
 
 	void GUILayer::Attach()
 	{
+		LINA_MEMORY_SCOPE(Editor);
+
 		LINA_CLIENT_INFO("Editor GUI Layer Attached");
 
 		// Listen to menu bar clicked events.
-		EditorApplication::GetEditorDispatcher().SubscribeAction<MenuBarItems>("##linaeditor_menubarclicked", LinaEngine::Action::ActionType::MenuItemClicked, std::bind(&GUILayer::DispatchMenuBarClickedAction, this, std::placeholders::_1));
+		EditorApplication::GetEditorEventBus().Subscribe<MenuItemClickedEvent>([this](const MenuItemClickedEvent& event) { DispatchMenuBarClickedAction(event.m_item); });
 
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
@@ -211,8 +214,7 @@ namespace LinaEditor
 		// Imgui first frame initialization.
 		Render();
 
-		LinaEngine::Application::GetEngineDispatcher().SubscribeAction<LinaEngine::World::Level*>("##guilayer_level_init", LinaEngine::Action::ActionType::LevelInitialized,
-			std::bind(&GUILayer::LevelInstalled, this, std::placeholders::_1));
+		LinaEngine::Application::GetEngineEventBus().Subscribe<LinaEngine::LevelInitializedEvent>([this](const LinaEngine::LevelInitializedEvent& event) { LevelInstalled(event.m_level); });
 	}
 
 	void GUILayer::Detach()
@@ -228,6 +230,8 @@ namespace LinaEditor
 
 	void GUILayer::Render()
 	{
+		LINA_MEMORY_SCOPE(Editor);
+
 		// Set draw params first.
 		LinaEngine::Application::GetRenderEngine().SetDrawParameters(m_drawParameters);
 	
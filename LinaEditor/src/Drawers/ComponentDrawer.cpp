@@ -768,6 +768,9 @@ void LinaEngine::ECS::MeshRendererComponent::COMPONENT_DRAWFUNC(LinaEngine::ECS:
 		}
 		WidgetsUtility::PopStyleVar(); WidgetsUtility::PopStyleVar();
 
+		if (renderer.m_meshID != renderer.m_selectedMeshID)
+			renderEngine.GetRenderableBVH().MarkEntityChanged(entity);
+
 		renderer.m_meshID = renderer.m_selectedMeshID;
 		renderer.m_meshPath = renderer.m_selectedMeshPath;
 
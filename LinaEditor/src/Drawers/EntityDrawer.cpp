@@ -68,7 +68,7 @@ namespace LinaEditor
 		WidgetsUtility::IncrementCursorPosY(-5);
 		ImGui::SetNextItemWidth(ImGui::GetWindowWidth() - ImGui::GetCursorPosX() - 56);
 		ImGui::InputText("##ename", entityName, IM_ARRAYSIZE(entityName));
-		ecs.get<LinaEngine::ECS::ECSEntityData>(m_selectedEntity).m_name = entityName;
+		ecs.SetEntityName(m_selectedEntity, entityName);
 		WidgetsUtility::PopStyleVar();
 
 		// Entity enabled toggle button.
@@ -377,11 +377,12 @@ namespace LinaEditor
 
 				if (it.second.m_boundTexture != nullptr)
 				{
+					LinaEngine::Application::GetRenderEngine().MarkTextureUsed(*it.second.m_boundTexture);
 					ImGui::GetWindowDrawList()->AddImage((void*)it.second.m_boundTexture->GetID(), minTexture, maxTexture, ImVec2(0, 1), ImVec2(1, 0));
 
 					if (ImGui::IsMouseHoveringRect(minTexture, maxTexture) && ImGui::IsMouseReleased(ImGuiMouseButton_Left))
 					{
-						LinaEditor::EditorApplication::GetEditorDispatcher().DispatchAction<LinaEngine::Graphics::Texture*>(LinaEngine::Action::ActionType::MaterialTextureSelected, it.second.m_boundTexture);
+						LinaEditor::EditorApplication::GetEditorEventBus().Dispatch(MaterialTextureSelectedEvent{ it.second.m_boundTexture });
 					}
 				}
 
@@ -327,9 +327,7 @@ namespace LinaEditor
 			std::string paramsPath = m_selectedTexture->GetParamsPath();
 			LinaEngine::Graphics::Texture* reimportedTexture = &renderEngine.CreateTexture2D(filePath, newParams, false, false, paramsPath);
 
-			auto pair = std::make_pair(m_selectedTexture, reimportedTexture);
-			LinaEditor::EditorApplication::GetEditorDispatcher().DispatchAction<std::pair<LinaEngine::Graphics::Texture*, LinaEngine::Graphics::Texture*>>(LinaEngine::Action::ActionType::TextureReimported,
-				pair);
+			LinaEditor::EditorApplication::GetEditorEventBus().Dispatch(TextureReimportedEvent{ m_selectedTexture, reimportedTexture });
 
 			renderEngine.UnloadTextureResource(m_selectedTexture->GetID());
 			LinaEngine::Graphics::Texture::SaveParameters(paramsPath, newParams);
@@ -364,7 +362,8 @@ namespace LinaEditor
 		ImVec2 pMin = ImVec2(ImGui::GetCursorScreenPos().x + ImGui::GetWindowWidth() / 2.0f - currentWindowX / 2.0f, ImGui::GetCursorScreenPos().y);
 		ImVec2 pMax = ImVec2(pMin.x + currentWindowX, ImGui::GetCursorScreenPos().y + desiredH);
 
-		// Draw texture
+		// Draw texture, marking it keeps the preview from being evicted while on screen.
+		LinaEngine::Application::GetRenderEngine().MarkTextureUsed(*m_selectedTexture);
 		ImGui::GetWindowDrawList()->AddImage((void*)m_selectedTexture->GetID(), pMin, pMax, ImVec2(0, 1), ImVec2(1, 0));
 	}
 
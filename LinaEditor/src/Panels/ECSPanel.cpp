@@ -47,7 +47,7 @@ namespace LinaEditor
 	void ECSPanel::Refresh()
 	{
 		m_selectedEntity = entt::null;
-		EditorApplication::GetEditorDispatcher().DispatchAction<void*>(LinaEngine::Action::ActionType::Unselect, 0);
+		EditorApplication::GetEditorEventBus().Dispatch(UnselectEvent{});
 	}
 
 	void ECSPanel::Draw()
@@ -101,14 +101,14 @@ namespace LinaEditor
 					if (WidgetsUtility::SelectableInput("entSelectable" + entityCounter, m_selectedEntity == entity, ImGuiSelectableFlags_SelectOnClick, selectedEntityName, IM_ARRAYSIZE(selectedEntityName)))
 					{
 						m_selectedEntity = entity;
-						EditorApplication::GetEditorDispatcher().DispatchAction<ECSEntity>(LinaEngine::Action::ActionType::EntitySelected, entity);
-						data.m_name = selectedEntityName;
+						EditorApplication::GetEditorEventBus().Dispatch(EntitySelectedEvent{ entity });
+						ecs.SetEntityName(entity, selectedEntityName);
 					}
 
 					// Deselect.
 					if (!ImGui::IsAnyItemHovered() && ImGui::IsWindowHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
 					{
-						EditorApplication::GetEditorDispatcher().DispatchAction<void*>(LinaEngine::Action::ActionType::Unselect, 0);
+						EditorApplication::GetEditorEventBus().Dispatch(UnselectEvent{});
 						m_selectedEntity = entt::null;
 					}
 				}
@@ -67,8 +67,9 @@ namespace LinaEditor
 
 
 	void HeaderPanel::Setup()
-	{// Logo texture
+	{// Logo texture, pinned as the header keeps drawing its id.
 		windowIcon = &LinaEngine::Application::GetRenderEngine().CreateTexture2D("resources/editor/textures/linaEngineIcon.png");
+		LinaEngine::Application::GetRenderEngine().PinTexture(*windowIcon);
 
 		// Logo animation textures
 		for (int i = 0; i < HEADER_LINALOGO_ANIMSIZE; i++)
@@ -79,6 +80,7 @@ namespace LinaEditor
 			else if (i < 100)
 				logoID = ("0" + std::to_string(i));
 			linaLogoAnimation[i] = &LinaEngine::Application::GetRenderEngine().CreateTexture2D("resources/editor/textures/LinaLogoJitterAnimation/anim " + logoID + ".png");
+			LinaEngine::Application::GetRenderEngine().PinTexture(*linaLogoAnimation[i]);
 		}
 
 		linaLogoID = linaLogoAnimation[0]->GetID();
@@ -354,6 +356,6 @@ namespace LinaEditor
 
 	void HeaderPanel::DispatchMenuBarClickedAction(const MenuBarItems& item)
 	{
-		EditorApplication::GetEditorDispatcher().DispatchAction<MenuBarItems>(LinaEngine::Action::ActionType::MenuItemClicked, item);
+		EditorApplication::GetEditorEventBus().Dispatch(MenuItemClickedEvent{ item });
 	}
 }
\ No newline at end of file
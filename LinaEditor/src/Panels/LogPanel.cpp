@@ -39,13 +39,13 @@ namespace LinaEditor
 {
 	LogPanel::~LogPanel()
 	{
-		LinaEngine::Application::GetEngineDispatcher().UnsubscribeAction("##lina_logPanel_onLog", LinaEngine::Action::ActionType::MessageLogged);
+		LinaEngine::Application::GetEngineEventBus().Unsubscribe(m_onLogToken);
 	}
 
 	void LogPanel::Setup()
 	{
 		// We set our dispatcher & subscribe in order to receive log events.
-		LinaEngine::Application::GetEngineDispatcher().SubscribeAction<LinaEngine::Log::LogDump>("##lina_logPanel_onLog", LinaEngine::Action::ActionType::MessageLogged, std::bind(&LogPanel::OnLog, this, std::placeholders::_1));
+		m_onLogToken = LinaEngine::Application::GetEngineEventBus().Subscribe<LinaEngine::MessageLoggedEvent>([this](const LinaEngine::MessageLoggedEvent& event) { OnLog(event.m_dump); });
 
 		// Add icon buttons.
 		m_logLevelIconButtons.push_back(LogLevelIconButton("ll_debug", "Debug", ICON_FA_BUG, LinaEngine::Log::LogLevel::Debug, LOGPANEL_COLOR_DEBUG_DEFAULT, LOGPANEL_COLOR_DEBUG_HOVERED, LOGPANEL_COLOR_DEBUG_PRESSED));
@@ -191,7 +191,7 @@ namespace LinaEditor
 	}
 
 
-	void LogPanel::OnLog(LinaEngine::Log::LogDump dump)
+	void LogPanel::OnLog(const LinaEngine::Log::LogDump& dump)
 	{
 		LogDumpEntry entry(dump, 1);
 
@@ -30,7 +30,13 @@ SOFTWARE.
 #include "Widgets/WidgetsUtility.hpp"
 #include "Core/Application.hpp"
 #include "Core/EditorCommon.hpp"
-#include "Core/Timer.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/AllocationCounter.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "PackageManager/PAMMemory.hpp"
+#include "Rendering/Texture.hpp"
+#include "Rendering/VertexArray.hpp"
+#include "Rendering/RenderEngine.hpp"
 #include "imgui/imgui.h"
 #include "imgui/implot/implot.h"
 
@@ -60,9 +66,38 @@ namespace LinaEditor
 
 
 
-#define MS_DISPLAY_TIME .5
-	
-	std::map<std::string, std::string> m_timerMSStorage;
+
+	static void DrawMemoryStats(const char* label, const LinaEngine::Graphics::ResourceMemoryStats& stats)
+	{
+		std::string txt = std::string(label) + " " + std::to_string(stats.m_count) + " (" + std::to_string(stats.m_evictedCount) + " evicted) CPU: "
+			+ std::to_string(stats.m_cpuBytes / 1024) + " KB GPU: " + std::to_string(stats.m_gpuBytes / 1024) + " KB";
+
+		WidgetsUtility::IncrementCursorPosX(12);
+		ImGui::Text(txt.c_str());
+	}
+
+	static void DrawAllocatorStats(const char* label, const LinaEngine::AllocatorStats& stats)
+	{
+		std::string txt = std::string(label) + " Used: " + std::to_string(stats.m_usedBytes / 1024) + " KB Peak: " + std::to_string(stats.m_peakUsedBytes / 1024)
+			+ " KB Reserved: " + std::to_string(stats.m_reservedBytes / 1024) + " KB Fragmentation: " + std::to_string((int)(stats.GetFragmentation() * 100.0f)) + "%";
+
+		WidgetsUtility::IncrementCursorPosX(12);
+		ImGui::Text(txt.c_str());
+	}
+
+	static void DrawProfilerNode(const std::vector<LinaEngine::ProfilerNode>& nodes, int32 index)
+	{
+		const LinaEngine::ProfilerNode& node = nodes[index];
+		ImGuiTreeNodeFlags flags = node.m_firstChild == -1 ? ImGuiTreeNodeFlags_Leaf : ImGuiTreeNodeFlags_DefaultOpen;
+
+		if (ImGui::TreeNodeEx((void*)(intptr_t)index, flags, "%s %.3f ms (%u)", node.m_zone->m_name, node.m_averageMs, node.m_frameCalls))
+		{
+			for (int32 child = node.m_firstChild; child != -1; child = nodes[child].m_nextSibling)
+				DrawProfilerNode(nodes, child);
+
+			ImGui::TreePop();
+		}
+	}
 
 	void ProfilerPanel::Setup()
 	{
@@ -77,8 +112,6 @@ namespace LinaEditor
 			ImGuiWindowFlags flags = ImGuiWindowFlags_NoCollapse;
 			ImGui::SetNextWindowBgAlpha(1.0f);
 
-			const std::map<std::string, LinaEngine::Timer*>& map = LinaEngine::Timer::GetTimerMap();
-
 			ImGui::Begin(PROFILER_ID, &m_show, flags);
 
 
@@ -86,27 +119,71 @@ namespace LinaEditor
 			WidgetsUtility::DrawShadowedLine(5);
 			WidgetsUtility::IncrementCursorPosY(11);
 
-			float currentTime = LinaEngine::Application::GetApp().GetTime();
-			bool displayMS = false;
-			if (currentTime > m_lastMSDisplayTime + MS_DISPLAY_TIME)
+			// Zone trees of every thread, averaged over the last frames.
+			const std::vector<LinaEngine::ProfilerThread>& threads = LinaEngine::Profiler::GetThreads();
+			for (size_t i = 0; i < threads.size(); i++)
+			{
+				const std::vector<LinaEngine::ProfilerNode>& nodes = threads[i].m_nodes;
+				if (nodes.empty() || nodes[0].m_firstChild == -1)
+					continue;
+
+				WidgetsUtility::IncrementCursorPosX(12);
+				if (ImGui::TreeNodeEx(threads[i].m_name.c_str(), ImGuiTreeNodeFlags_DefaultOpen, "%s %.2f ms", threads[i].m_name.c_str(), nodes[0].m_averageMs))
+				{
+					for (int32 child = nodes[0].m_firstChild; child != -1; child = nodes[child].m_nextSibling)
+						DrawProfilerNode(nodes, child);
+
+					ImGui::TreePop();
+				}
+			}
+
+			// Resource memory.
+			LinaEngine::Graphics::RenderEngine& renderEngine = LinaEngine::Application::GetRenderEngine();
+			WidgetsUtility::IncrementCursorPosY(6);
+			DrawMemoryStats("Textures", renderEngine.GetTextureMemoryStats());
+			DrawMemoryStats("Meshes", renderEngine.GetMeshMemoryStats());
+			DrawMemoryStats("Materials", renderEngine.GetMaterialMemoryStats());
+
+			if (renderEngine.GetCPUMemoryBudget() != 0 || renderEngine.GetGPUMemoryBudget() != 0)
 			{
-				m_lastMSDisplayTime = currentTime;
-				displayMS = true;	
+				std::string budgetTxt = "Budget CPU: " + std::to_string(renderEngine.GetCPUMemoryBudget() / 1024) + " KB GPU: " + std::to_string(renderEngine.GetGPUMemoryBudget() / 1024) + " KB";
+				WidgetsUtility::IncrementCursorPosX(12);
+				ImGui::Text(budgetTxt.c_str());
 			}
 
-			for (std::map<std::string, LinaEngine::Timer*>::const_iterator it = map.begin(); it != map.end(); ++it)
+			// Subsystem heaps & object pools.
+			for (uint32 i = 0; i < (uint32)LinaEngine::MemorySubsystem::Count; i++)
 			{
-				std::string txt = "";
-				txt = it->first + " " + m_timerMSStorage[it->first] + " ms";
+				LinaEngine::MemorySubsystem subsystem = (LinaEngine::MemorySubsystem)i;
+				if (Memory::getHeapType(subsystem) == LinaEngine::MemoryHeapType::TLSF)
+					DrawAllocatorStats((std::string(Memory::getSubsystemName(subsystem)) + " Heap").c_str(), Memory::getHeapStats(subsystem));
+			}
 
-				if (displayMS)
-					m_timerMSStorage[it->first] = std::to_string(it->second->GetDuration());
+			DrawAllocatorStats("Texture Pool", LinaEngine::Graphics::Texture::GetPoolStats());
+			DrawAllocatorStats("Vertex Array Pool", LinaEngine::Graphics::VertexArray::GetPoolStats());
 
+			// Heap allocations of the last frame, the frame loop should settle down to none.
+			if (LinaEngine::AllocationCounter::GetIsEnabled())
+			{
+				std::string allocTxt = "Heap Allocations: " + std::to_string(LinaEngine::AllocationCounter::GetFrameAllocationCount()) + " ("
+					+ std::to_string(LinaEngine::AllocationCounter::GetFrameAllocatedBytes() / 1024) + " KB) per frame";
 				WidgetsUtility::IncrementCursorPosX(12);
-				ImGui::Text(txt.c_str());
+				ImGui::Text(allocTxt.c_str());
+			}
+
+			// Tracked memory of each subsystem.
+			if (LinaEngine::MemoryTracker::GetIsEnabled())
+			{
+				for (uint32 i = 0; i < (uint32)LinaEngine::MemorySubsystem::Count; i++)
+				{
+					LinaEngine::MemorySubsystem subsystem = (LinaEngine::MemorySubsystem)i;
+					LinaEngine::MemorySubsystemStats stats = LinaEngine::MemoryTracker::GetStats(subsystem);
+					std::string trackTxt = std::string(Memory::getSubsystemName(subsystem)) + " Live: " + std::to_string(stats.m_liveBytes / 1024) + " KB Peak: "
+						+ std::to_string(stats.m_peakBytes / 1024) + " KB Allocations: " + std::to_string(stats.m_liveAllocations) + " (" + std::to_string(stats.m_frameAllocations) + " per frame)";
+					WidgetsUtility::IncrementCursorPosX(12);
+					ImGui::Text(trackTxt.c_str());
+				}
 			}
-		
-			displayMS = false;
 
 			WidgetsUtility::IncrementCursorPosX(12);
 			WidgetsUtility::IncrementCursorPosY(12);
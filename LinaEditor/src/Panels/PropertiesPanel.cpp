@@ -45,21 +45,12 @@ namespace LinaEditor
 
 	void PropertiesPanel::Setup()
 	{
-		EditorApplication::GetEditorDispatcher().SubscribeAction<LinaEngine::ECS::ECSEntity>("##lina_propsPanel_entity", LinaEngine::Action::ActionType::EntitySelected,
-			std::bind(&PropertiesPanel::EntitySelected, this, std::placeholders::_1));
-
-		EditorApplication::GetEditorDispatcher().SubscribeAction<LinaEngine::Graphics::Mesh*>("##lina_propsPanel_mesh", LinaEngine::Action::ActionType::MeshSelected,
-			std::bind(&PropertiesPanel::MeshSelected, this, std::placeholders::_1));
-
-		EditorApplication::GetEditorDispatcher().SubscribeAction<LinaEngine::Graphics::Material*>("##lina_propsPanel_material", LinaEngine::Action::ActionType::MaterialSelected,
-			std::bind(&PropertiesPanel::MaterialSelected, this, std::placeholders::_1));
-
-
-		EditorApplication::GetEditorDispatcher().SubscribeAction<LinaEngine::Graphics::Texture*>("##lina_propsPanel_texture", LinaEngine::Action::ActionType::TextureSelected,
-			std::bind(&PropertiesPanel::TextureSelected, this, std::placeholders::_1));
-
-		EditorApplication::GetEditorDispatcher().SubscribeAction<void*>("##lina_propsPanel_unselect", LinaEngine::Action::ActionType::Unselect,
-			std::bind(&PropertiesPanel::Unselect, this));
+		LinaEngine::Action::EventBus& eventBus = EditorApplication::GetEditorEventBus();
+		eventBus.Subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent& event) { EntitySelected(event.m_entity); });
+		eventBus.Subscribe<MeshSelectedEvent>([this](const MeshSelectedEvent& event) { MeshSelected(event.m_mesh); });
+		eventBus.Subscribe<MaterialSelectedEvent>([this](const MaterialSelectedEvent& event) { MaterialSelected(event.m_material); });
+		eventBus.Subscribe<TextureSelectedEvent>([this](const TextureSelectedEvent& event) { TextureSelected(event.m_texture); });
+		eventBus.Subscribe<UnselectEvent>([this](const UnselectEvent&) { Unselect(); });
 	}
 
 	void PropertiesPanel::EntitySelected(LinaEngine::ECS::ECSEntity selectedEntity)
@@ -39,9 +39,13 @@ SOFTWARE.
 #include "IconsFontAwesome5.h"
 #include "imgui/imgui.h"
 #include "imgui/ImGuiFileDialogue/ImGuiFileDialog.h"
+#include "Core/Timer.hpp"
+#include "Core/JobSystem.hpp"
+#include "Utility/ResourceManifest.hpp"
 #include <filesystem>
 
 #define ROOT_NAME "###Resources"
+#define MANIFEST_PATH "resources.manifest"
 
 namespace LinaEditor
 {
@@ -63,11 +67,8 @@ namespace LinaEditor
 
 	void ResourcesPanel::Setup()
 	{
-		LinaEditor::EditorApplication::GetEditorDispatcher().SubscribeAction<std::pair<LinaEngine::Graphics::Texture*, LinaEngine::Graphics::Texture*>>("##mrsr_textureReimport", LinaEngine::Action::ActionType::TextureReimported,
-			std::bind(&ResourcesPanel::TextureReimported, this, std::placeholders::_1));
-
-		LinaEditor::EditorApplication::GetEditorDispatcher().SubscribeAction<LinaEngine::Graphics::Texture*>("##mrsr_matTextureSelected", LinaEngine::Action::ActionType::MaterialTextureSelected,
-			std::bind(&ResourcesPanel::MaterialTextureSelected, this, std::placeholders::_1));
+		LinaEditor::EditorApplication::GetEditorEventBus().Subscribe<TextureReimportedEvent>([this](const TextureReimportedEvent& event) { TextureReimported(std::make_pair(event.m_selected, event.m_reimported)); });
+		LinaEditor::EditorApplication::GetEditorEventBus().Subscribe<MaterialTextureSelectedEvent>([this](const MaterialTextureSelectedEvent& event) { MaterialTextureSelected(event.m_texture); });
 
 		ScanRoot();
 
@@ -85,29 +86,45 @@ namespace LinaEditor
 		root.m_path = "resources";
 		m_resourceFolders.push_back(root);
 
+		LinaEngine::Timer loadTimer;
+		loadTimer.Start();
+
+		// Walk the project on the workers, folders that didn't change since the last session are listed from the manifest.
+		LinaEngine::JobSystem& jobSystem = LinaEngine::Application::GetJobSystem();
+		bool manifestLoaded = m_manifest.Load(MANIFEST_PATH);
+		m_manifest.Scan(root.m_path, jobSystem);
+
 		// Recursively fill in root.
 		s_itemIDCounter = -1;
-		std::string path = "resources";
 		ScanFolder(m_resourceFolders[0]);
 
-		// Load resources	
-		LoadFolderResources(m_resourceFolders[0]);
-		LoadFolderDependencies(m_resourceFolders[0]);
+		// Load resources, textures & meshes are loaded in the background & uploaded over the next frames.
+		LoadFolderResources(m_resourceFolders[0], jobSystem);
+		m_manifest.Save(MANIFEST_PATH);
+
+		loadTimer.Stop();
+		LINA_CORE_INFO("Folder resources scanned in {0} ms, {1} folders reused from the manifest ({2}), {3} textures & {4} meshes pending upload.", loadTimer.GetDuration(), m_manifest.GetReusedDirectoryCount(), manifestLoaded ? "found" : "not found", LinaEngine::Application::GetRenderEngine().GetPendingTextureCount(), LinaEngine::Application::GetRenderEngine().GetPendingMeshCount());
 	}
 
 	void ResourcesPanel::ScanFolder(EditorFolder& root)
 	{
-		for (const auto& entry : std::filesystem::directory_iterator(root.m_path))
+		const ManifestEntry* rootEntry = m_manifest.GetEntry(root.m_path);
+		if (rootEntry == nullptr) return;
+
+		for (const std::string& childPath : rootEntry->m_children)
 		{
-			if (entry.path().has_extension())
+			const ManifestEntry* entry = m_manifest.GetEntry(childPath);
+			if (entry == nullptr) continue;
+
+			std::string name = childPath.substr(childPath.find_last_of("/") + 1);
+
+			if (!entry->m_isDirectory)
 			{
 				// Is a file
 				EditorFile file;
-				file.m_name = entry.path().filename().string();
-				file.m_pathToFolder = entry.path().parent_path().string() + "/";
-				std::string replacedPath = entry.path().relative_path().string();
-				std::replace(replacedPath.begin(), replacedPath.end(), '\\', '/');
-				file.m_path = replacedPath;
+				file.m_name = name;
+				file.m_pathToFolder = root.m_path + "/";
+				file.m_path = childPath;
 				file.m_extension = file.m_name.substr(file.m_name.find(".") + 1);
 				file.m_type = GetFileType(file.m_extension);
 				file.m_id = ++s_itemIDCounter;
@@ -119,10 +136,8 @@ namespace LinaEditor
 			{
 				// Is a folder
 				EditorFolder folder;
-				folder.m_name = entry.path().filename().string();
-				std::string replacedPath = entry.path().relative_path().string();
-				std::replace(replacedPath.begin(), replacedPath.end(), '\\', '/');
-				folder.m_path = replacedPath;
+				folder.m_name = name;
+				folder.m_path = childPath;
 				folder.m_id = ++s_itemIDCounter;
 				folder.m_parent = &root;
 
@@ -353,7 +368,9 @@ namespace LinaEditor
 				if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
 				{
 					// Set payload to carry the texture;
-					uint32 id = LinaEngine::Application::GetRenderEngine().GetTexture(it->second.m_path).GetID();
+					LinaEngine::Graphics::Texture& texture = LinaEngine::Application::GetRenderEngine().GetTexture(it->second.m_path);
+					LinaEngine::Application::GetRenderEngine().MarkTextureUsed(texture);
+					uint32 id = texture.GetID();
 					ImGui::SetDragDropPayload(RESOURCES_MOVETEXTURE_ID, &id, sizeof(uint32));
 
 					// Display preview 
@@ -373,11 +390,11 @@ namespace LinaEditor
 
 				// Notify properties panel of file selection.
 				if (it->second.m_type == FileType::Texture2D)
-					EditorApplication::GetEditorDispatcher().DispatchAction<LinaEngine::Graphics::Texture*>(LinaEngine::Action::ActionType::TextureSelected, &LinaEngine::Application::GetRenderEngine().GetTexture(it->second.m_path));
+					EditorApplication::GetEditorEventBus().Dispatch(TextureSelectedEvent{ &LinaEngine::Application::GetRenderEngine().GetTexture(it->second.m_path) });
 				else if (it->second.m_type == FileType::Mesh)
-					EditorApplication::GetEditorDispatcher().DispatchAction<LinaEngine::Graphics::Mesh*>(LinaEngine::Action::ActionType::MeshSelected, &LinaEngine::Application::GetRenderEngine().GetMesh(it->second.m_path));
+					EditorApplication::GetEditorEventBus().Dispatch(MeshSelectedEvent{ &LinaEngine::Application::GetRenderEngine().GetMesh(it->second.m_path) });
 				else if (it->second.m_type == FileType::Material)
-					EditorApplication::GetEditorDispatcher().DispatchAction<LinaEngine::Graphics::Material*>(LinaEngine::Action::ActionType::MaterialSelected, &LinaEngine::Application::GetRenderEngine().GetMaterial(it->second.m_path));
+					EditorApplication::GetEditorEventBus().Dispatch(MaterialSelectedEvent{ &LinaEngine::Application::GetRenderEngine().GetMaterial(it->second.m_path) });
 			}
 
 			if (nodeOpen)
@@ -390,7 +407,7 @@ namespace LinaEditor
 		// Deselect.
 		if (!ImGui::IsAnyItemHovered() && ImGui::IsWindowHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
 		{
-			EditorApplication::GetEditorDispatcher().DispatchAction<void*>(LinaEngine::Action::ActionType::Unselect, 0);
+			EditorApplication::GetEditorEventBus().Dispatch(UnselectEvent{});
 			s_selectedItem = -1;
 		}
 
@@ -403,7 +420,7 @@ namespace LinaEditor
 				s_selectedFile->m_markedForErase = true;
 
 			// Deselect
-			EditorApplication::GetEditorDispatcher().DispatchAction<void*>(LinaEngine::Action::ActionType::Unselect, 0);
+			EditorApplication::GetEditorEventBus().Dispatch(UnselectEvent{});
 			s_selectedItem = -1;
 		}
 
@@ -411,93 +428,107 @@ namespace LinaEditor
 			s_hoveredFolder = nullptr;
 	}
 
-	void ResourcesPanel::LoadFolderResources(EditorFolder& folder)
+	void ResourcesPanel::CollectFolderFiles(EditorFolder& folder, std::vector<EditorFile*>& textures, std::vector<EditorFile*>& meshes, std::vector<EditorFile*>& materials)
 	{
-		LinaEngine::Graphics::RenderEngine& renderEngine = LinaEngine::Application::GetRenderEngine();
-
-		// Load files.
 		for (std::map<int, EditorFile>::iterator it = folder.m_files.begin(); it != folder.m_files.end(); ++it)
 		{
 			EditorFile& file = it->second;
 
-			// SKIP FOR NOW BC WE NEED TO MAKE SURE WE HANDLE BOTH ENGINE CREATION & EDITOR CREATION
 			if (file.m_type == FileType::Texture2D)
-			{
-				bool textureExists = renderEngine.TextureExists(file.m_path);
+				textures.push_back(&file);
+			else if (file.m_type == FileType::Material)
+				materials.push_back(&file);
+			else if (file.m_type == FileType::Mesh)
+				meshes.push_back(&file);
+		}
 
-				if (!textureExists)
-				{
-					LinaEngine::Graphics::SamplerParameters samplerParams;
-					std::string samplerParamsPath = file.m_pathToFolder + EditorUtility::RemoveExtensionFromFilename(file.m_name) + ".samplerparams";
+		// Recursively collect subfolders.
+		for (std::map<int, EditorFolder>::iterator it = folder.m_subFolders.begin(); it != folder.m_subFolders.end(); ++it)
+			CollectFolderFiles(it->second, textures, meshes, materials);
+	}
 
-					if (LinaEngine::Utility::FileExists(samplerParamsPath))
-						samplerParams = LinaEngine::Graphics::Texture::LoadParameters(samplerParamsPath);
+	void ResourcesPanel::LoadFolderResources(EditorFolder& folder, LinaEngine::JobSystem& jobSystem)
+	{
+		LinaEngine::Graphics::RenderEngine& renderEngine = LinaEngine::Application::GetRenderEngine();
 
-					renderEngine.CreateTexture2D(file.m_path, samplerParams, false, false, samplerParamsPath);
+		std::vector<EditorFile*> textures;
+		std::vector<EditorFile*> meshes;
+		std::vector<EditorFile*> materials;
+		CollectFolderFiles(folder, textures, meshes, materials);
 
-					LinaEngine::Graphics::Texture::SaveParameters(samplerParamsPath, samplerParams);
-				}
+		std::vector<LinaEngine::Graphics::SamplerParameters> samplerParams(textures.size());
+		std::vector<std::string> samplerParamsPaths(textures.size());
+		std::vector<LinaEngine::Graphics::MeshParameters> meshParams(meshes.size());
+		std::vector<std::string> meshParamsPaths(meshes.size());
+		LinaEngine::JobCounter paramsCounter;
 
-			}
-			if (file.m_type == FileType::Material)
-			{
-				bool materialExists = renderEngine.MaterialExists(file.m_path);
-				if (!materialExists)
-					renderEngine.LoadMaterialFromFile(file.m_path);
+		// Parameter files are read on the workers, the missing ones are written with the defaults.
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			EditorFile& file = *textures[i];
+			if (renderEngine.TextureExists(file.m_path)) continue;
 
-			}
-			else if (file.m_type == FileType::Mesh)
+			samplerParamsPaths[i] = file.m_pathToFolder + EditorUtility::RemoveExtensionFromFilename(file.m_name) + ".samplerparams";
+
+			LinaEngine::Graphics::SamplerParameters* params = &samplerParams[i];
+			std::string paramsPath = samplerParamsPaths[i];
+			bool paramsExist = m_manifest.Contains(paramsPath);
+
+			jobSystem.Run([params, paramsPath, paramsExist]()
 			{
-				bool meshExists = renderEngine.MeshExists(file.m_path);
+				if (paramsExist)
+					*params = LinaEngine::Graphics::Texture::LoadParameters(paramsPath);
+				else
+					LinaEngine::Graphics::Texture::SaveParameters(paramsPath, *params);
+			}, &paramsCounter);
+		}
 
-				if (!meshExists)
-				{
-					LinaEngine::Graphics::MeshParameters meshParams;
-					std::string meshParamsPath = file.m_pathToFolder + EditorUtility::RemoveExtensionFromFilename(file.m_name) + ".meshparams";
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			EditorFile& file = *meshes[i];
+			if (renderEngine.MeshExists(file.m_path)) continue;
 
-					if (LinaEngine::Utility::FileExists(meshParamsPath))
-						meshParams = LinaEngine::Graphics::Mesh::LoadParameters(meshParamsPath);
+			meshParamsPaths[i] = file.m_pathToFolder + EditorUtility::RemoveExtensionFromFilename(file.m_name) + ".meshparams";
 
-					renderEngine.CreateMesh(file.m_path, meshParams, -1, meshParamsPath);
+			LinaEngine::Graphics::MeshParameters* params = &meshParams[i];
+			std::string paramsPath = meshParamsPaths[i];
+			bool paramsExist = m_manifest.Contains(paramsPath);
 
-					LinaEngine::Graphics::Mesh::SaveParameters(meshParamsPath, meshParams);
-				}
-			}
+			jobSystem.Run([params, paramsPath, paramsExist]()
+			{
+				if (paramsExist)
+					*params = LinaEngine::Graphics::Mesh::LoadParameters(paramsPath);
+				else
+					LinaEngine::Graphics::Mesh::SaveParameters(paramsPath, *params);
+			}, &paramsCounter);
 		}
 
-		// Recursively load subfolders.
-		for (std::map<int, EditorFolder>::iterator it = folder.m_subFolders.begin(); it != folder.m_subFolders.end(); ++it)
-			LoadFolderResources(it->second);
-	}
-
-	void ResourcesPanel::LoadFolderDependencies(EditorFolder& folder)
-	{
-		LinaEngine::Graphics::RenderEngine& renderEngine = LinaEngine::Application::GetRenderEngine();
+		jobSystem.Wait(paramsCounter);
 
-		// Load files.
-		for (std::map<int, EditorFile>::iterator it = folder.m_files.begin(); it != folder.m_files.end(); ++it)
+		// Textures & meshes go first, materials look their textures up by path.
+		for (size_t i = 0; i < textures.size(); i++)
 		{
-			EditorFile& file = it->second;
-
-			// SKIP FOR NOW BC WE NEED TO MAKE SURE WE HANDLE BOTH ENGINE CREATION & EDITOR CREATION
-			if (file.m_type == FileType::Texture2D)
-			{
+			if (samplerParamsPaths[i].compare("") != 0)
+				renderEngine.CreateTexture2DAsync(textures[i]->m_path, samplerParams[i], false, false, samplerParamsPaths[i]);
+		}
 
-			}
-			if (file.m_type == FileType::Material)
-			{
-				LinaEngine::Graphics::Material& mat = renderEngine.GetMaterial(file.m_path);
-				mat.PostLoadMaterialData(renderEngine);
-			}
-			else if (file.m_type == FileType::Mesh)
-			{
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			if (meshParamsPaths[i].compare("") != 0)
+				renderEngine.CreateMeshAsync(meshes[i]->m_path, meshParams[i], -1, meshParamsPaths[i]);
+		}
 
-			}
+		for (size_t i = 0; i < materials.size(); i++)
+		{
+			if (!renderEngine.MaterialExists(materials[i]->m_path))
+				renderEngine.LoadMaterialFromFile(materials[i]->m_path);
 		}
 
-		// Recursively load subfolders.
-		for (std::map<int, EditorFolder>::iterator it = folder.m_subFolders.begin(); it != folder.m_subFolders.end(); ++it)
-			LoadFolderDependencies(it->second);
+		for (size_t i = 0; i < materials.size(); i++)
+		{
+			LinaEngine::Graphics::Material& mat = renderEngine.GetMaterial(materials[i]->m_path);
+			mat.PostLoadMaterialData(renderEngine);
+		}
 	}
 
 	void ResourcesPanel::UnloadFileResource(EditorFile& file)
@@ -49,11 +49,8 @@ namespace LinaEditor
 {
 	void ScenePanel::Setup()
 	{
-		EditorApplication::GetEditorDispatcher().SubscribeAction<LinaEngine::ECS::ECSEntity>("##lina_scenePanel_entity", LinaEngine::Action::ActionType::EntitySelected,
-			std::bind(&ScenePanel::EntitySelected, this, std::placeholders::_1));
-
-		EditorApplication::GetEditorDispatcher().SubscribeAction<void*>("##lina_scenePanel_unselect", LinaEngine::Action::ActionType::Unselect,
-			std::bind(&ScenePanel::Unselected, this));
+		EditorApplication::GetEditorEventBus().Subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent& event) { EntitySelected(event.m_entity); });
+		EditorApplication::GetEditorEventBus().Subscribe<UnselectEvent>([this](const UnselectEvent&) { Unselected(); });
 
 		LinaEngine::Application::GetECSRegistry().on_construct<LinaEngine::ECS::TransformComponent>().connect<&ScenePanel::OnTransformAdded>(this);
 	}		
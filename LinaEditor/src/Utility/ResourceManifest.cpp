@@ -0,0 +1,206 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "Utility/ResourceManifest.hpp"
+#include "Core/JobSystem.hpp"
+#include "Utility/Log.hpp"
+#include <cereal/archives/binary.hpp>
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
+
+namespace LinaEditor
+{
+	static int64 GetWriteTime(const std::filesystem::file_time_type& time)
+	{
+		return (int64)time.time_since_epoch().count();
+	}
+
+	bool ResourceManifest::Load(const std::string& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+
+		if (!stream.is_open())
+			return false;
+
+		// The manifest is only a cache, a corrupt or outdated one falls back to a full scan.
+		try
+		{
+			cereal::BinaryInputArchive iarchive(stream);
+
+			// Read the data into it.
+			iarchive(m_previousEntries);
+		}
+		catch (const cereal::Exception& e)
+		{
+			m_previousEntries.clear();
+			LINA_CLIENT_WARN("Resource manifest {0} could not be read, scanning all directories: {1}", path, e.what());
+			return false;
+		}
+
+		return true;
+	}
+
+	void ResourceManifest::Save(const std::string& path)
+	{
+		std::ofstream stream(path, std::ios::binary);
+		{
+			cereal::BinaryOutputArchive oarchive(stream); // Create an output archive
+
+			oarchive(m_entries); // Write the data to the archive
+		}
+	}
+
+	void ResourceManifest::Scan(const std::string& rootPath, LinaEngine::JobSystem& jobSystem)
+	{
+		m_entries.clear();
+		m_reusedDirectoryCount = 0;
+
+		std::error_code error;
+		int64 rootWriteTime = GetWriteTime(std::filesystem::last_write_time(rootPath, error));
+
+		// Sub directories are added to the counter before their parent's job finishes, so it only reaches zero at the end.
+		LinaEngine::JobCounter counter;
+		ScanDirectory(rootPath, rootWriteTime, jobSystem, counter);
+		jobSystem.Wait(counter);
+	}
+
+	const ManifestEntry* ResourceManifest::GetEntry(const std::string& path) const
+	{
+		const auto it = m_entries.find(path);
+		return it == m_entries.end() ? nullptr : &it->second;
+	}
+
+	void ResourceManifest::ScanDirectory(const std::string& path, int64 lastWriteTime, LinaEngine::JobSystem& jobSystem, LinaEngine::JobCounter& counter)
+	{
+		ManifestEntry directory;
+		directory.m_path = path;
+		directory.m_lastWriteTime = lastWriteTime;
+		directory.m_isDirectory = true;
+
+		std::vector<ManifestEntry> entries;
+
+		// Adding or removing entries changes the directory's write time, so an equal one means the listing is still valid.
+		if (!ListFromPrevious(directory, entries))
+		{
+			entries.clear();
+
+			// Runs on the job system, so no exceptions. Unreadable directories are listed empty, unreadable items are skipped.
+			std::error_code error;
+			std::filesystem::directory_iterator it(path, error);
+
+			for (; !error && it != std::filesystem::directory_iterator(); it.increment(error))
+			{
+				std::error_code itemError;
+				ManifestEntry entry;
+				entry.m_path = path + "/" + it->path().filename().string();
+				entry.m_isDirectory = it->is_directory(itemError);
+
+				if (!itemError)
+					entry.m_lastWriteTime = GetWriteTime(it->last_write_time(itemError));
+
+				if (itemError)
+				{
+					LINA_CLIENT_WARN("Resource {0} could not be read, skipping: {1}", entry.m_path, itemError.message());
+					continue;
+				}
+
+				entries.push_back(entry);
+			}
+
+			if (error)
+				LINA_CLIENT_WARN("Resource directory {0} could not be read: {1}", path, error.message());
+
+			// Keep the order stable between scans.
+			std::sort(entries.begin(), entries.end(), [](const ManifestEntry& a, const ManifestEntry& b) { return a.m_path < b.m_path; });
+
+			for (ManifestEntry& entry : entries)
+				directory.m_children.push_back(entry.m_path);
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_entries[path] = directory;
+
+			for (ManifestEntry& entry : entries)
+			{
+				if (!entry.m_isDirectory)
+					m_entries[entry.m_path] = entry;
+			}
+		}
+
+		// Sub directories are scanned by the other workers.
+		for (ManifestEntry& entry : entries)
+		{
+			if (entry.m_isDirectory)
+			{
+				std::string subPath = entry.m_path;
+				int64 subWriteTime = entry.m_lastWriteTime;
+				jobSystem.Run([this, subPath, subWriteTime, &jobSystem, &counter]() { ScanDirectory(subPath, subWriteTime, jobSystem, counter); }, &counter);
+			}
+		}
+	}
+
+	bool ResourceManifest::ListFromPrevious(ManifestEntry& directory, std::vector<ManifestEntry>& entries)
+	{
+		const auto previous = m_previousEntries.find(directory.m_path);
+
+		if (previous == m_previousEntries.end() || previous->second.m_lastWriteTime != directory.m_lastWriteTime)
+			return false;
+
+		for (const std::string& child : previous->second.m_children)
+		{
+			const auto previousChild = m_previousEntries.find(child);
+
+			if (previousChild == m_previousEntries.end())
+				return false;
+
+			ManifestEntry entry;
+			entry.m_path = child;
+			entry.m_isDirectory = previousChild->second.m_isDirectory;
+			entry.m_lastWriteTime = previousChild->second.m_lastWriteTime;
+
+			// Only the sub directories need a fresh write time, files are taken as they are.
+			if (entry.m_isDirectory)
+			{
+				std::error_code error;
+				entry.m_lastWriteTime = GetWriteTime(std::filesystem::last_write_time(child, error));
+
+				if (error)
+					return false;
+			}
+
+			entries.push_back(entry);
+		}
+
+		directory.m_children = previous->second.m_children;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_reusedDirectoryCount++;
+		return true;
+	}
+}
@@ -43,7 +43,12 @@ Timestamp: 12/29/2018 10:43:46 PM
 #include "Utility/Math/Color.hpp"
 #include "Core/LayerStack.hpp"
 #include "ECS/ECSSystem.hpp"
-#include "Actions/ActionDispatcher.hpp"
+#include "ECS/TransformHierarchy.hpp"
+#include "Actions/EventBus.hpp"
+#include "Core/EngineEvents.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "Core/FrameBenchmark.hpp"
 #include <functional>
 
 
@@ -56,6 +61,7 @@ namespace LinaEngine::Graphics
 {
 	class Window;
 	class RenderEngine;
+	class Texture;
 	struct WindowProperties;
 }
 
@@ -98,14 +104,34 @@ namespace LinaEngine
 		double GetTime();
 		double GetFrameTime() { return m_frameTime; }
 		void AddToMainPipeline(ECS::BaseECSSystem& system) { m_mainECSPipeline.AddSystem(system); }
+		ECS::ECSSystemList& GetMainPipeline() { return m_mainECSPipeline; }
 
-		static Action::ActionDispatcher& GetEngineDispatcher() { return s_engineDispatcher; }
+		// Updates the systems of all pipelines one by one in insertion order, for debugging.
+		void SetSerialSystemUpdates(bool serial);
+
+		// Filled from the command line by Initialize, enabled settings start a benchmark when Run is called.
+		FrameBenchmarkSettings& GetBenchmarkSettings() { return m_benchmarkSettings; }
+		const FrameBenchmark& GetBenchmark() { return m_benchmark; }
+
+		// Returned by the process, non zero when a benchmark exceeded its budgets.
+		int GetExitCode() { return m_exitCode; }
+
+		static Action::EventBus& GetEngineEventBus() { return s_engineEventBus; }
 		static Application& GetApp() { return *s_application; }
 		static Graphics::Window& GetAppWindow() { return *s_appWindow; }
 		static Graphics::RenderEngine& GetRenderEngine() { return *s_renderEngine; }
 		static Input::InputEngine& GetInputEngine() { return *s_inputEngine; }
 		static Physics::PhysicsEngine& GetPhysicsEngine() { return *s_physicsEngine; }
 		static ECS::ECSRegistry& GetECSRegistry() { return s_ecs; }
+		static JobSystem& GetJobSystem() { return s_jobSystem; }
+		static ECS::TransformHierarchy& GetTransformHierarchy() { return s_transformHierarchy; }
+
+		// Arguments the program was started with, set by the entry point before the application is created.
+		static void SetCommandLine(int argc, char** argv);
+		static bool HasCommandLineFlag(const std::string& flag);
+
+		// Argument following the flag, empty if there's none.
+		static std::string GetCommandLineValue(const std::string& flag);
 
 	protected:
 
@@ -124,14 +150,18 @@ namespace LinaEngine
 		bool OnWindowClose();
 		void OnWindowResize(Vector2 size);
 		void OnPostSceneDraw();
+		void OnTextureLoaded(Graphics::Texture& texture);
 		void KeyCallback(int key, int action);
 		void MouseCallback(int button, int action);
 		void WindowCloseCallback() {};
+		bool ParseBenchmarkSettings();
 		
 
 	private:
 
-		static Action::ActionDispatcher s_engineDispatcher;
+		static Action::EventBus s_engineEventBus;
+		static JobSystem s_jobSystem;
+		static std::vector<std::string> s_commandLine;
 
 		// Layer queue.
 		LayerStack m_layerStack;
@@ -142,6 +172,7 @@ namespace LinaEngine
 		static Graphics::RenderEngine* s_renderEngine;
 		static Physics::PhysicsEngine* s_physicsEngine;
 		static ECS::ECSRegistry s_ecs;
+		static ECS::TransformHierarchy s_transformHierarchy;
 		static Graphics::Window* s_appWindow;
 
 		Input::InputDevice* m_inputDevice = nullptr;
@@ -160,9 +191,17 @@ namespace LinaEngine
 		std::function<void()> m_windowClosedCallback;
 		std::function<void(Vector3, Vector3, Color, float)> m_drawLineCallback;
 		std::function<void()> m_postSceneDrawCallback;
+		std::function<void(Graphics::Texture&)> m_textureLoadedCallback;
 
 		int m_currentFPS = 0;
 		double m_frameTime = 0;
+		int m_exitCode = 0;
+
+		FrameBenchmarkSettings m_benchmarkSettings;
+		FrameBenchmark m_benchmark;
+
+		// Allocations made after construction & still alive at destruction are reported as leaks.
+		MemorySnapshot m_startupSnapshot;
 
 	};
 
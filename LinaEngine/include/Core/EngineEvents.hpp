@@ -0,0 +1,105 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: EngineEvents
+
+Events the application dispatches through the engine EventBus.
+
+Timestamp: 11/5/2020 3:52:40 PM
+*/
+
+#pragma once
+
+#ifndef EngineEvents_HPP
+#define EngineEvents_HPP
+
+#include "Actions/Action.hpp"
+#include "Utility/Log.hpp"
+#include "Utility/Math/Vector.hpp"
+
+namespace LinaEngine::World
+{
+	class Level;
+}
+
+namespace LinaEngine::Graphics
+{
+	class Texture;
+}
+
+namespace LinaEngine
+{
+	struct MessageLoggedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::MessageLogged;
+		const Log::LogDump& m_dump;
+	};
+
+	struct PostSceneDrawEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::PostSceneDraw;
+	};
+
+	struct LevelInstalledEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::LevelInstalled;
+		World::Level* m_level;
+	};
+
+	struct LevelInitializedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::LevelInitialized;
+		World::Level* m_level;
+	};
+
+	struct LevelUninstalledEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::LevelUninstalled;
+		World::Level* m_level;
+	};
+
+	struct WindowClosedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::WindowClosed;
+	};
+
+	struct WindowResizedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::WindowResized;
+		Vector2 m_size;
+	};
+
+	struct TextureLoadedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::TextureLoaded;
+		Graphics::Texture* m_texture;
+	};
+}
+
+#endif
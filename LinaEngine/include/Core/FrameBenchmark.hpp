@@ -0,0 +1,192 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: FrameBenchmark
+
+Deterministic benchmark runs of the main loop. While a benchmark is running the application advances
+by a fixed delta instead of the window clock, optionally moves the active camera along a path, times
+every section of the frame & quits after the configured frame count. The per frame timings are written
+as CSV, percentiles of every section as JSON. A section whose percentile exceeds its budget fails the run.
+
+Timestamp: 11/4/2020 4:21:09 PM
+*/
+
+#pragma once
+
+#ifndef FrameBenchmark_HPP
+#define FrameBenchmark_HPP
+
+#include "Utility/Math/Transformation.hpp"
+#include "ECS/ECS.hpp"
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#define FRAMEBENCHMARK_DEFAULT_FRAMES 600
+#define FRAMEBENCHMARK_DEFAULT_WARMUP_FRAMES 30
+#define FRAMEBENCHMARK_DEFAULT_DELTA (1.0 / 60.0)
+#define FRAMEBENCHMARK_DEFAULT_PERCENTILE 95.0
+#define FRAMEBENCHMARK_DEFAULT_OUTPUT "benchmark"
+#define FRAMEBENCHMARK_EXIT_BUDGET_EXCEEDED 1
+#define FRAMEBENCHMARK_EXIT_WRITE_FAILED 2
+#define FRAMEBENCHMARK_EXIT_INVALID_ARGUMENTS 3
+
+namespace LinaEngine
+{
+	enum class FrameSection
+	{
+		Input,
+		Layers,
+		LevelTick,
+		MainPipeline,
+		Physics,
+		TransformHierarchy,
+		RenderableBVH,
+		Render,
+		Frame,
+		Count
+	};
+
+	// Camera transformation at the given simulated time, the path is interpolated linearly between points.
+	struct CameraPathPoint
+	{
+		double m_time = 0.0;
+		Transformation m_transform;
+	};
+
+	struct FrameBenchmarkSettings
+	{
+		bool m_enabled = false;
+
+		// Warmup frames aren't recorded, recording also waits for the asynchronous loads to finish.
+		uint32 m_frameCount = FRAMEBENCHMARK_DEFAULT_FRAMES;
+		uint32 m_warmupFrames = FRAMEBENCHMARK_DEFAULT_WARMUP_FRAMES;
+		double m_fixedDelta = FRAMEBENCHMARK_DEFAULT_DELTA;
+
+		// Written to path.json & path.csv.
+		std::string m_outputPath = FRAMEBENCHMARK_DEFAULT_OUTPUT;
+
+		// Empty path leaves the camera to the level.
+		std::vector<CameraPathPoint> m_cameraPath;
+
+		// Milliseconds by section name, compared against the given percentile of the section.
+		std::map<std::string, double> m_budgets;
+		double m_budgetPercentile = FRAMEBENCHMARK_DEFAULT_PERCENTILE;
+	};
+
+	// Milliseconds over the recorded frames.
+	struct FrameSectionStats
+	{
+		double m_min = 0.0;
+		double m_average = 0.0;
+		double m_median = 0.0;
+		double m_p90 = 0.0;
+		double m_p95 = 0.0;
+		double m_p99 = 0.0;
+		double m_max = 0.0;
+	};
+
+	class FrameBenchmark
+	{
+	public:
+
+		FrameBenchmark() {};
+		~FrameBenchmark() {};
+
+		// Lower case names used in the reports & budgets.
+		static const char* GetSectionName(FrameSection section);
+
+		// Parses comma separated section=ms pairs, returns false if any of them is invalid.
+		static bool ParseBudgets(const std::string& text, std::map<std::string, double>& budgets);
+
+		void Start(const FrameBenchmarkSettings& settings);
+
+		// Returns false once all the frames are recorded, frames are only recorded when nothing is loading.
+		bool BeginFrame(bool loading);
+		void EndFrame();
+
+		// Moves the active camera of the registry along the path.
+		void UpdateCamera(ECS::ECSRegistry& registry);
+
+		void AddSectionTime(FrameSection section, double ms) { m_currentFrame[(size_t)section] += ms; }
+
+		// Writes the reports & returns the exit code, 0 if every budget was met.
+		int Finish();
+
+		FrameSectionStats GetStats(FrameSection section) const;
+		bool GetIsRunning() const { return m_isRunning; }
+		double GetFixedDelta() const { return m_settings.m_fixedDelta; }
+		uint32 GetRecordedFrameCount() const { return (uint32)m_frames.size(); }
+
+	private:
+
+		bool WriteCSV(const std::string& path) const;
+		bool WriteJSON(const std::string& path, bool passed) const;
+
+	private:
+
+		typedef std::array<double, (size_t)FrameSection::Count> FrameTimes;
+
+		FrameBenchmarkSettings m_settings;
+		std::vector<FrameTimes> m_frames;
+		FrameTimes m_currentFrame;
+		std::chrono::time_point<std::chrono::steady_clock> m_frameStart;
+		uint32 m_warmupFramesLeft = 0;
+		bool m_isRunning = false;
+		bool m_isRecording = false;
+	};
+
+	// Adds the time until the end of the scope to a section while a benchmark is running.
+	class FrameSectionTimer
+	{
+	public:
+
+		FrameSectionTimer(FrameBenchmark& benchmark, FrameSection section) : m_benchmark(benchmark), m_section(section)
+		{
+			if (m_benchmark.GetIsRunning())
+				m_start = std::chrono::steady_clock::now();
+		}
+
+		~FrameSectionTimer()
+		{
+			if (m_benchmark.GetIsRunning())
+				m_benchmark.AddSectionTime(m_section, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+		}
+
+	private:
+
+		FrameBenchmark& m_benchmark;
+		FrameSection m_section;
+		std::chrono::time_point<std::chrono::steady_clock> m_start;
+	};
+}
+
+#endif
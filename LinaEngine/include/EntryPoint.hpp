@@ -45,8 +45,11 @@ extern LinaEngine::Application* LinaEngine::CreateApplication();
 
 int main(int argc, char** argv)
 {
+	LinaEngine::Application::SetCommandLine(argc, argv);
 	auto app = LinaEngine::CreateApplication();
+	int exitCode = app->GetExitCode();
 	delete app;
+	return exitCode;
 }
 
 #endif
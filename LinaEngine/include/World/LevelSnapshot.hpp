@@ -0,0 +1,94 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: LevelSnapshot
+
+Component types saved with a level. Saving & loading go through the same list so the snapshot layout
+can't go out of sync, and they work on any cereal archive & registry.
+
+Timestamp: 11/4/2020 5:12:40 PM
+*/
+
+#pragma once
+
+#ifndef LevelSnapshot_HPP
+#define LevelSnapshot_HPP
+
+#include "ECS/ECS.hpp"
+#include "ECS/Components/TransformComponent.hpp"
+#include "ECS/Components/CameraComponent.hpp"
+#include "ECS/Components/FreeLookComponent.hpp"
+#include "ECS/Components/MeshRendererComponent.hpp"
+#include "ECS/Components/SpriteRendererComponent.hpp"
+#include "ECS/Components/LightComponent.hpp"
+#include "ECS/Components/RigidbodyComponent.hpp"
+
+namespace LinaEngine::World
+{
+	template<typename Archive>
+	void SaveRegistrySnapshot(const ECS::ECSRegistry& registry, Archive& archive)
+	{
+		entt::snapshot{ registry }
+			.entities(archive)
+			.template component<
+			LinaEngine::ECS::ECSEntityData,
+			LinaEngine::ECS::CameraComponent,
+			LinaEngine::ECS::FreeLookComponent,
+			LinaEngine::ECS::PointLightComponent,
+			LinaEngine::ECS::DirectionalLightComponent,
+			LinaEngine::ECS::SpotLightComponent,
+			LinaEngine::ECS::RigidbodyComponent,
+			LinaEngine::ECS::MeshRendererComponent,
+			LinaEngine::ECS::SpriteRendererComponent,
+			LinaEngine::ECS::TransformComponent
+			>(archive);
+	}
+
+	// The registry should be empty, entities keep the identifiers they were saved with.
+	template<typename Archive>
+	void LoadRegistrySnapshot(ECS::ECSRegistry& registry, Archive& archive)
+	{
+		entt::snapshot_loader{ registry }
+			.entities(archive)
+			.template component<
+			LinaEngine::ECS::ECSEntityData,
+			LinaEngine::ECS::CameraComponent,
+			LinaEngine::ECS::FreeLookComponent,
+			LinaEngine::ECS::PointLightComponent,
+			LinaEngine::ECS::DirectionalLightComponent,
+			LinaEngine::ECS::SpotLightComponent,
+			LinaEngine::ECS::RigidbodyComponent,
+			LinaEngine::ECS::MeshRendererComponent,
+			LinaEngine::ECS::SpriteRendererComponent,
+			LinaEngine::ECS::TransformComponent
+			>(archive);
+	}
+}
+
+#endif
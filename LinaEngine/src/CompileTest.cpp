@@ -68,7 +68,7 @@ SOFTWARE.
 //// Events
 //
 //#include "Actions/Action.hpp"
-//#include "Actions/ActionDispatcher.hpp"
+//#include "Actions/EventBus.hpp"
 //#include "Actions/ActionSubscriber.hpp"
 //#include "Actions/ApplicationEvent.hpp"
 //#include "Actions/Event.hpp"
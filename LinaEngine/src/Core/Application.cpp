@@ -34,24 +34,85 @@ SOFTWARE.
 #include "Rendering/Window.hpp"
 #include "Core/Layer.hpp"
 #include "World/Level.hpp"
-#include "Core/Timer.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/AllocationCounter.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "PackageManager/PAMMemory.hpp"
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
 
 
 namespace LinaEngine
 {
-	Action::ActionDispatcher Application::s_engineDispatcher;
+	Action::EventBus Application::s_engineEventBus;
+	JobSystem Application::s_jobSystem;
+	std::vector<std::string> Application::s_commandLine;
 	Input::InputEngine* Application::s_inputEngine = nullptr;
 	Graphics::RenderEngine* Application::s_renderEngine = nullptr;
 	Physics::PhysicsEngine* Application::s_physicsEngine = nullptr;
 	Graphics::Window* Application::s_appWindow = nullptr;
 	ECS::ECSRegistry Application::s_ecs;
+	ECS::TransformHierarchy Application::s_transformHierarchy;
 	Application* Application::s_application = nullptr;
 
+	// Whole string has to be a number, std::stoul would throw on garbage & accept trailing characters.
+	static bool ParseUnsigned(const std::string& text, uint32& out)
+	{
+		if (text.empty() || text[0] == '-')
+			return false;
+
+		char* end = nullptr;
+		errno = 0;
+		const unsigned long value = std::strtoul(text.c_str(), &end, 10);
+		if (errno != 0 || *end != '\0' || value > UINT32_MAX)
+			return false;
+
+		out = (uint32)value;
+		return true;
+	}
+
+	static bool ParseDouble(const std::string& text, double& out)
+	{
+		if (text.empty())
+			return false;
+
+		char* end = nullptr;
+		errno = 0;
+		const double value = std::strtod(text.c_str(), &end);
+		if (errno != 0 || *end != '\0' || !std::isfinite(value))
+			return false;
+
+		out = value;
+		return true;
+	}
+
 	Application::Application()
 	{
 		s_application = this;
 
-		s_engineDispatcher.Initialize(Action::ActionType::EngineActionsStartIndex, Action::ActionType::EngineActionsEndIndex);
+		// --log-level drops everything below the given level at the call site, --log-binary defers formatting to the decoder.
+		Log::LogLevel minimumLevel = Log::LogLevel::Trace;
+		const std::string logLevel = GetCommandLineValue("--log-level");
+		if (!logLevel.empty() && Log::ParseLevel(logLevel, minimumLevel))
+			Log::SetLevelMask(Log::GetLevelMaskFrom(minimumLevel));
+
+		AsyncLogSettings logSettings;
+		if (HasCommandLineFlag("--log-binary"))
+		{
+			logSettings.m_recordMode = LogRecordMode::Binary;
+			logSettings.m_filePath = CORE_BINARY_LOG_LOCATION;
+		}
+
+		// Started before the snapshot, the log buffer lives until shutdown & isn't a leak.
+		Log::StartAsync(logSettings);
+
+		// Pixel buffers & Bullet churn through mid-sized blocks, they get their own heaps before any engine is created.
+		m_startupSnapshot = MemoryTracker::TakeSnapshot();
+
+		Memory::setHeapType(MemorySubsystem::Graphics, MemoryHeapType::TLSF);
+		Memory::setHeapType(MemorySubsystem::Physics, MemoryHeapType::TLSF);
 
 		// Make sure log event is delegated to the application.
 		Log::s_onLog = std::bind(&Application::OnLog, this, std::placeholders::_1);
@@ -62,6 +123,14 @@ namespace LinaEngine
 
 	void Application::Initialize(Graphics::WindowProperties& props)
 	{
+		// Benchmark runs from the command line have no visible window & can't be interfered with. Invalid arguments end
+		// the run, a typo in a CI script shouldn't silently turn the budget gate off.
+		if (!ParseBenchmarkSettings())
+			m_exitCode = FRAMEBENCHMARK_EXIT_INVALID_ARGUMENTS;
+
+		if (m_benchmarkSettings.m_enabled)
+			props.m_visible = false;
+
 		// Get engine instances.
 		s_appWindow = CreateContextWindow();
 		m_inputDevice = CreateInputDevice();
@@ -84,6 +153,7 @@ namespace LinaEngine
 		m_windowClosedCallback = std::bind(&Application::OnWindowClose, this);
 		m_drawLineCallback = std::bind(&Application::OnDrawLine, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
 		m_postSceneDrawCallback = std::bind(&Application::OnPostSceneDraw, this);
+		m_textureLoadedCallback = std::bind(&Application::OnTextureLoaded, this, std::placeholders::_1);
 
 		// Set event callback for main window.
 		s_appWindow->SetKeyCallback(m_keyCallback);
@@ -91,18 +161,29 @@ namespace LinaEngine
 		s_appWindow->SetWindowResizeCallback(m_WwndowResizeCallback);
 		s_appWindow->SetWindowClosedCallback(m_windowClosedCallback);
 		s_renderEngine->SetPostSceneDrawCallback(m_postSceneDrawCallback);
+		s_renderEngine->SetTextureLoadedCallback(m_textureLoadedCallback);
 		s_renderEngine->SetViewportDisplay(Vector2::Zero, s_appWindow->GetSize());
 
+		s_jobSystem.Initialize();
+		s_transformHierarchy.Initialize(s_ecs);
 		s_inputEngine->Initialize(s_appWindow->GetNativeWindow(), m_inputDevice);
 		s_physicsEngine->Initialize(s_ecs, m_drawLineCallback);
-		s_renderEngine->Initialize(s_ecs, *s_appWindow);
+		s_renderEngine->Initialize(s_ecs, *s_appWindow, s_jobSystem);
+
+		// Systems of all pipelines are scheduled on the shared job system.
+		m_mainECSPipeline.SetJobSystem(&s_jobSystem);
+		s_physicsEngine->GetPhysicsPipeline().SetJobSystem(&s_jobSystem);
+		s_renderEngine->GetRenderingPipeline().SetJobSystem(&s_jobSystem);
 
-		m_running = true;
+		m_running = m_exitCode == 0;
 	}
 
 
 	Application::~Application()
 	{
+		s_jobSystem.Shutdown();
+		s_transformHierarchy.Shutdown();
+
 		if (s_physicsEngine)
 			delete s_physicsEngine;
 
@@ -119,15 +200,20 @@ namespace LinaEngine
 			delete s_appWindow;
 
 		LINA_CORE_TRACE("[Destructor] -> Application ({0})", typeid(*this).name());
+
+		// The leak report is written synchronously, after everything queued so far.
+		Log::StopAsync();
+		MemoryTracker::ReportAllocationsSince(m_startupSnapshot, "Memory leaks");
 	}
 
 	void Application::OnLog(Log::LogDump dump)
 	{
-		// Dump to cout
-		std::cout << dump.m_message << std::endl;
+		// The async writer handles the console, this is only reached directly once it's stopped.
+		if (!Log::GetIsAsync())
+			std::cout << dump.m_message << '\n';
 
 		// Dispatch the action to any listener.
-		s_engineDispatcher.DispatchAction<Log::LogDump>(Action::ActionType::MessageLogged, dump);
+		s_engineEventBus.Dispatch(MessageLoggedEvent{ dump });
 	}
 
 	void Application::Run()
@@ -140,62 +226,144 @@ namespace LinaEngine
 		double previousFPSCountTime = 0;
 		double frameTime = 0;
 
-		while (m_running)
+		LINA_PROFILE_THREAD("Main");
+
+		// Headless runs can record the first frames with --profile-capture <frames> [--profile-capture-path <path>].
+		if (HasCommandLineFlag("--profile-capture"))
 		{
-			LINA_TIMER_START("Main Loop");
+			const std::string frames = GetCommandLineValue("--profile-capture");
+			const std::string path = GetCommandLineValue("--profile-capture-path");
+			uint32 frameCount = PROFILER_DEFAULT_CAPTURE_FRAMES;
 
-			LINA_TIMER_START("Input Engine Tick");
+			if (frames.empty() || (ParseUnsigned(frames, frameCount) && frameCount > 0))
+				Profiler::BeginCapture(frameCount, path.empty() ? PROFILER_DEFAULT_CAPTURE_PATH : path);
+			else
+			{
+				LINA_CORE_ERR("Invalid --profile-capture frame count {0}, expected a positive integer.", frames);
+				m_exitCode = FRAMEBENCHMARK_EXIT_INVALID_ARGUMENTS;
+				m_running = false;
+			}
+		}
 
-			// Update input engine.
-			s_inputEngine->Tick();
+		if (m_benchmarkSettings.m_enabled && m_running)
+			m_benchmark.Start(m_benchmarkSettings);
 
-			LINA_TIMER_STOP("Input Engine Tick");
+		while (m_running)
+		{
+			// Benchmark runs quit on their own once all frames are recorded.
+			if (m_benchmark.GetIsRunning() && !m_benchmark.BeginFrame(s_renderEngine->GetPendingTextureCount() + s_renderEngine->GetPendingMeshCount() > 0))
+			{
+				m_exitCode = m_benchmark.Finish();
+				m_running = false;
+				break;
+			}
 
-			double newTime = s_appWindow->GetTime();
-			double frameTime = newTime - currentTime;
-			m_frameTime = frameTime;
-			currentTime = newTime;
+			// Zones closed during the last frame are collected.
+			LINA_PROFILE_FRAME();
 
-			LINA_TIMER_START("Application Layers Tick");
+			// Transient data of two frames ago is released, heap allocations are counted per frame.
+			FrameArena::BeginFrame();
+			AllocationCounter::BeginFrame();
+			MemoryTracker::BeginFrame();
 
-			// Update layers.
-			for (Layer* layer : m_layerStack)
-				layer->Tick(frameTime);
+			// Messages written by the log thread reach the listeners & the editor on the main thread.
+			Log::DispatchPending();
 
-			LINA_TIMER_STOP("Application Layers Tick");
+			// Counters of the last frame, only kept while a capture is running.
+			LINA_PROFILE_COUNTER("Draw Calls", s_renderEngine->GetFrameDrawCalls());
+			LINA_PROFILE_COUNTER("Heap Allocations", AllocationCounter::GetFrameAllocationCount());
+			LINA_PROFILE_COUNTER("Uploaded Bytes", s_renderEngine->GetFrameUploadedBytes());
 
-			LINA_TIMER_START("Current Level Tick");
+			LINA_PROFILE_SCOPE("Main Loop");
 
-			// Update current level.
-			if (m_activeLevelExists)
-				m_currentLevel->Tick(frameTime);
+			{
+				LINA_PROFILE_SCOPE("Input Engine Tick");
+				FrameSectionTimer sectionTimer(m_benchmark, FrameSection::Input);
 
-			LINA_TIMER_STOP("Current Level Tick");
+				// Update input engine.
+				s_inputEngine->Tick();
+			}
 
-			LINA_TIMER_START("Main Pipeline Tick");
+			double newTime = s_appWindow->GetTime();
+			double frameTime = m_benchmark.GetIsRunning() ? m_benchmark.GetFixedDelta() : newTime - currentTime;
+			m_frameTime = frameTime;
+			currentTime = newTime;
 
-			m_mainECSPipeline.UpdateSystems(frameTime);
+			{
+				LINA_PROFILE_SCOPE("Application Layers Tick");
+				FrameSectionTimer sectionTimer(m_benchmark, FrameSection::Layers);
 
-			LINA_TIMER_STOP("Main Pipeline Tick");
+				// Update layers.
+				for (Layer* layer : m_layerStack)
+					layer->Tick(frameTime);
+			}
+
+			{
+				LINA_MEMORY_SCOPE(ECS);
+
+				{
+					LINA_PROFILE_SCOPE("Current Level Tick");
+					FrameSectionTimer sectionTimer(m_benchmark, FrameSection::LevelTick);
+
+					// Update current level.
+					if (m_activeLevelExists)
+						m_currentLevel->Tick(frameTime);
+				}
+
+				{
+					LINA_PROFILE_SCOPE("Main Pipeline Tick");
+					FrameSectionTimer sectionTimer(m_benchmark, FrameSection::MainPipeline);
+					m_mainECSPipeline.UpdateSystems(frameTime);
+				}
+			}
 
 			if (frameTime > 0.25)
 				frameTime = 0.25;
 
 			accumulator += frameTime;
 
-			while (accumulator >= dt)
 			{
-				LINA_TIMER_START("Physics Tick");
-				s_physicsEngine->Tick(dt);
-				LINA_TIMER_STOP("Physics Tick");
-				t += dt;
-				accumulator -= dt;
+				FrameSectionTimer sectionTimer(m_benchmark, FrameSection::Physics);
+
+				while (accumulator >= dt)
+				{
+					LINA_MEMORY_SCOPE(Physics);
+					LINA_PROFILE_SCOPE("Physics Tick");
+					s_physicsEngine->Tick(dt);
+					t += dt;
+					accumulator -= dt;
+				}
+			}
+
+			// Scripted camera of benchmark runs overrides the level's.
+			if (m_benchmark.GetIsRunning())
+				m_benchmark.UpdateCamera(s_ecs);
+
+			{
+				// World matrices are needed by the renderers, so it's updated after gameplay & physics.
+				LINA_MEMORY_SCOPE(ECS);
+				LINA_PROFILE_SCOPE("Transform Hierarchy Tick");
+				FrameSectionTimer sectionTimer(m_benchmark, FrameSection::TransformHierarchy);
+				s_transformHierarchy.Update(&s_jobSystem);
 			}
 
-			LINA_TIMER_START("Render");
+			LINA_MEMORY_SCOPE(Graphics);
+
+			{
+				// Moved renderers are refit, the tree rebuilds itself in the background when it degrades.
+				LINA_PROFILE_SCOPE("Renderable BVH Tick");
+				FrameSectionTimer sectionTimer(m_benchmark, FrameSection::RenderableBVH);
+				s_renderEngine->GetRenderableBVH().Update(s_transformHierarchy.GetChangedEntities(), &s_jobSystem);
+			}
 
 			if (m_canRender)
 			{
+				LINA_PROFILE_SCOPE("Render");
+				FrameSectionTimer sectionTimer(m_benchmark, FrameSection::Render);
+
+				// Upload the resources loaded in the background.
+				s_renderEngine->ProcessAsyncUploads();
+
 				// render level.
 				if (m_activeLevelExists)
 					s_renderEngine->Render();
@@ -204,8 +372,6 @@ namespace LinaEngine
 				s_renderEngine->Swap();
 			}
 
-			LINA_TIMER_STOP("Render");
-
 			// Simple FPS count
 			fpsCounter++;
 
@@ -219,17 +385,96 @@ namespace LinaEngine
 			if (m_firstRun)
 				m_firstRun = false;
 
-			LINA_TIMER_STOP("Main Loop");
+			if (m_benchmark.GetIsRunning())
+				m_benchmark.EndFrame();
+		}
+
+		// Frames recorded so far are written if the loop exits during a capture.
+		Profiler::EndCapture();
+	}
+
+	bool Application::ParseBenchmarkSettings()
+	{
+		// --benchmark [frames] [--benchmark-delta <s>] [--benchmark-warmup <frames>] [--benchmark-output <path>]
+		// [--benchmark-budget <section=ms,...>] [--benchmark-percentile <p>]
+		if (!HasCommandLineFlag("--benchmark"))
+			return true;
+
+		const std::string frames = GetCommandLineValue("--benchmark");
+		const std::string delta = GetCommandLineValue("--benchmark-delta");
+		const std::string warmup = GetCommandLineValue("--benchmark-warmup");
+		const std::string output = GetCommandLineValue("--benchmark-output");
+		const std::string budgets = GetCommandLineValue("--benchmark-budget");
+		const std::string percentile = GetCommandLineValue("--benchmark-percentile");
+
+		m_benchmarkSettings.m_enabled = true;
+
+		if (!frames.empty() && (!ParseUnsigned(frames, m_benchmarkSettings.m_frameCount) || m_benchmarkSettings.m_frameCount == 0))
+		{
+			LINA_CORE_ERR("Invalid --benchmark frame count {0}, expected a positive integer.", frames);
+			return false;
+		}
 
+		if (!delta.empty() && (!ParseDouble(delta, m_benchmarkSettings.m_fixedDelta) || m_benchmarkSettings.m_fixedDelta <= 0.0))
+		{
+			LINA_CORE_ERR("Invalid --benchmark-delta {0}, expected a positive number of seconds.", delta);
+			return false;
+		}
+
+		if (!warmup.empty() && !ParseUnsigned(warmup, m_benchmarkSettings.m_warmupFrames))
+		{
+			LINA_CORE_ERR("Invalid --benchmark-warmup {0}, expected a non-negative integer.", warmup);
+			return false;
 		}
 
-		Timer::UnloadTimers();
+		if (!output.empty())
+			m_benchmarkSettings.m_outputPath = output;
+
+		if (!percentile.empty() && (!ParseDouble(percentile, m_benchmarkSettings.m_budgetPercentile) || m_benchmarkSettings.m_budgetPercentile <= 0.0 || m_benchmarkSettings.m_budgetPercentile > 100.0))
+		{
+			LINA_CORE_ERR("Invalid --benchmark-percentile {0}, expected a number in (0, 100].", percentile);
+			return false;
+		}
+
+		if (!budgets.empty() && !FrameBenchmark::ParseBudgets(budgets, m_benchmarkSettings.m_budgets))
+		{
+			LINA_CORE_ERR("Invalid benchmark budgets {0}, expected section=ms pairs separated by commas.", budgets);
+			return false;
+		}
+
+		return true;
+	}
+
+	void Application::SetCommandLine(int argc, char** argv)
+	{
+		s_commandLine.assign(argv, argv + argc);
+	}
+
+	bool Application::HasCommandLineFlag(const std::string& flag)
+	{
+		return std::find(s_commandLine.begin(), s_commandLine.end(), flag) != s_commandLine.end();
+	}
+
+	std::string Application::GetCommandLineValue(const std::string& flag)
+	{
+		std::vector<std::string>::iterator it = std::find(s_commandLine.begin(), s_commandLine.end(), flag);
+		if (it == s_commandLine.end() || it + 1 == s_commandLine.end() || (it + 1)->rfind("--", 0) == 0)
+			return "";
+
+		return *(it + 1);
+	}
+
+	void Application::SetSerialSystemUpdates(bool serial)
+	{
+		m_mainECSPipeline.SetSerialMode(serial);
+		s_physicsEngine->GetPhysicsPipeline().SetSerialMode(serial);
+		s_renderEngine->GetRenderingPipeline().SetSerialMode(serial);
 	}
 
 	bool Application::OnWindowClose()
 	{
 		m_running = false;
-		s_engineDispatcher.DispatchAction<void*>(Action::ActionType::WindowClosed, 0);
+		s_engineEventBus.Dispatch(WindowClosedEvent{});
 		return true;
 	}
 
@@ -242,18 +487,27 @@ namespace LinaEngine
 
 		s_renderEngine->SetViewportDisplay(Vector2::Zero, size);
 
-		s_engineDispatcher.DispatchAction<Vector2>(Action::ActionType::WindowResized, size);
+		s_engineEventBus.Dispatch(WindowResizedEvent{ size });
 	}
 
 	void Application::OnPostSceneDraw()
 	{
 		s_physicsEngine->OnPostSceneDraw();
 
-		s_engineDispatcher.DispatchAction<void*>(Action::ActionType::PostSceneDraw, 0);
+		s_engineEventBus.Dispatch(PostSceneDrawEvent{});
+	}
+
+	void Application::OnTextureLoaded(Graphics::Texture& texture)
+	{
+		s_engineEventBus.Dispatch(TextureLoadedEvent{ &texture });
 	}
 
 	void Application::KeyCallback(int key, int action)
 	{
+		// Captures the next frames for chrome://tracing or Perfetto.
+		if (Profiler::GetIsEnabled() && key == Input::InputCode::Key::F11 && action == 1 && !Profiler::GetIsCapturing())
+			Profiler::BeginCapture(PROFILER_DEFAULT_CAPTURE_FRAMES, PROFILER_DEFAULT_CAPTURE_PATH);
+
 		s_inputEngine->DispatchKeyAction(static_cast<LinaEngine::Input::InputCode::Key>(key), action);
 	}
 
@@ -276,17 +530,19 @@ namespace LinaEngine
 		if (m_currentLevel != nullptr)
 			UninstallLevel(*m_currentLevel);
 
+		LINA_MEMORY_SCOPE(ECS);
 		bool install = level.Install(loadFromFile, path, levelName);
 
-		s_engineDispatcher.DispatchAction<World::Level*>(Action::ActionType::LevelInstalled, &level);
+		s_engineEventBus.Dispatch(LevelInstalledEvent{ &level });
 		return install;
 	}
 
 	void Application::InitializeLevel(LinaEngine::World::Level& level)
 	{
+		LINA_MEMORY_SCOPE(ECS);
 		m_currentLevel = &level;
 		m_currentLevel->Initialize();
-		s_engineDispatcher.DispatchAction<World::Level*>(Action::ActionType::LevelInitialized, &level);
+		s_engineEventBus.Dispatch(LevelInitializedEvent{ &level });
 		m_activeLevelExists = true;
 	}
 
@@ -301,7 +557,7 @@ namespace LinaEngine
 
 		level.Uninstall();
 		s_ecs.clear();
-		s_engineDispatcher.DispatchAction<World::Level*>(Action::ActionType::LevelUninstalled, &level);
+		s_engineEventBus.Dispatch(LevelUninstalledEvent{ &level });
 	}
 
 	void Application::OnDrawLine(Vector3 from, Vector3 to, Color color, float width)
@@ -0,0 +1,308 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: FrameBenchmark
+
+Timestamp: 11/4/2020 4:21:09 PM
+*/
+
+#include "Core/FrameBenchmark.hpp"
+#include "ECS/Components/TransformComponent.hpp"
+#include "ECS/Components/CameraComponent.hpp"
+#include "Utility/Log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace LinaEngine
+{
+	namespace
+	{
+		// Nearest rank on sorted samples.
+		double GetPercentile(const std::vector<double>& sorted, double percentile)
+		{
+			if (sorted.empty())
+				return 0.0;
+
+			const size_t rank = (size_t)std::ceil(percentile / 100.0 * (double)sorted.size());
+			return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+		}
+	}
+
+	const char* FrameBenchmark::GetSectionName(FrameSection section)
+	{
+		switch (section)
+		{
+		case FrameSection::Input: return "input";
+		case FrameSection::Layers: return "layers";
+		case FrameSection::LevelTick: return "level_tick";
+		case FrameSection::MainPipeline: return "main_pipeline";
+		case FrameSection::Physics: return "physics";
+		case FrameSection::TransformHierarchy: return "transform_hierarchy";
+		case FrameSection::RenderableBVH: return "renderable_bvh";
+		case FrameSection::Render: return "render";
+		case FrameSection::Frame: return "frame";
+		default: return "";
+		}
+	}
+
+	bool FrameBenchmark::ParseBudgets(const std::string& text, std::map<std::string, double>& budgets)
+	{
+		size_t begin = 0;
+
+		while (begin < text.size())
+		{
+			size_t end = text.find(',', begin);
+			if (end == std::string::npos)
+				end = text.size();
+
+			const std::string pair = text.substr(begin, end - begin);
+			const size_t separator = pair.find('=');
+			if (separator == std::string::npos)
+				return false;
+
+			const std::string name = pair.substr(0, separator);
+			bool known = false;
+			for (size_t i = 0; i < (size_t)FrameSection::Count; i++)
+				known |= name == GetSectionName((FrameSection)i);
+
+			char* parsedEnd = nullptr;
+			const std::string value = pair.substr(separator + 1);
+			const double ms = std::strtod(value.c_str(), &parsedEnd);
+			if (!known || value.empty() || *parsedEnd != '\0')
+				return false;
+
+			budgets[name] = ms;
+			begin = end + 1;
+		}
+
+		return true;
+	}
+
+	void FrameBenchmark::Start(const FrameBenchmarkSettings& settings)
+	{
+		m_settings = settings;
+		m_frames.clear();
+		m_frames.reserve(settings.m_frameCount);
+		m_warmupFramesLeft = settings.m_warmupFrames;
+		m_isRunning = true;
+		m_isRecording = false;
+
+		LINA_CORE_INFO("Benchmark started, {0} frames with a fixed delta of {1} s.", settings.m_frameCount, settings.m_fixedDelta);
+	}
+
+	bool FrameBenchmark::BeginFrame(bool loading)
+	{
+		if (m_frames.size() >= m_settings.m_frameCount)
+			return false;
+
+		if (m_warmupFramesLeft > 0)
+			m_warmupFramesLeft--;
+
+		// Once recording starts every frame counts, loads triggered by the level itself are part of the run.
+		m_isRecording = m_isRecording || (m_warmupFramesLeft == 0 && !loading);
+		m_currentFrame.fill(0.0);
+		m_frameStart = std::chrono::steady_clock::now();
+		return true;
+	}
+
+	void FrameBenchmark::EndFrame()
+	{
+		if (!m_isRecording)
+			return;
+
+		m_currentFrame[(size_t)FrameSection::Frame] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+		m_frames.push_back(m_currentFrame);
+	}
+
+	void FrameBenchmark::UpdateCamera(ECS::ECSRegistry& registry)
+	{
+		const std::vector<CameraPathPoint>& path = m_settings.m_cameraPath;
+		if (path.empty())
+			return;
+
+		// The path starts with the first recorded frame, the camera waits at the first point until then.
+		const double time = (double)m_frames.size() * m_settings.m_fixedDelta;
+		size_t next = 0;
+		while (next < path.size() && path[next].m_time <= time)
+			next++;
+
+		Transformation transform;
+		if (next == 0)
+			transform = path.front().m_transform;
+		else if (next == path.size())
+			transform = path.back().m_transform;
+		else
+		{
+			Transformation from = path[next - 1].m_transform;
+			Transformation to = path[next].m_transform;
+			const float t = (float)((time - path[next - 1].m_time) / (path[next].m_time - path[next - 1].m_time));
+			transform.m_location = Vector3::Lerp(from.m_location, to.m_location, t);
+			transform.m_rotation = Quaternion::Slerp(from.m_rotation, to.m_rotation, t);
+		}
+
+		auto view = registry.view<ECS::TransformComponent, ECS::CameraComponent>();
+		for (auto entity : view)
+		{
+			if (!view.get<ECS::CameraComponent>(entity).m_isEnabled)
+				continue;
+
+			ECS::TransformComponent& camera = view.get<ECS::TransformComponent>(entity);
+			camera.transform.m_location = transform.m_location;
+			camera.transform.m_rotation = transform.m_rotation;
+		}
+	}
+
+	FrameSectionStats FrameBenchmark::GetStats(FrameSection section) const
+	{
+		FrameSectionStats stats;
+		if (m_frames.empty())
+			return stats;
+
+		std::vector<double> samples;
+		samples.reserve(m_frames.size());
+		for (const FrameTimes& frame : m_frames)
+			samples.push_back(frame[(size_t)section]);
+
+		std::sort(samples.begin(), samples.end());
+
+		double sum = 0.0;
+		for (double sample : samples)
+			sum += sample;
+
+		stats.m_min = samples.front();
+		stats.m_max = samples.back();
+		stats.m_average = sum / (double)samples.size();
+		stats.m_median = GetPercentile(samples, 50.0);
+		stats.m_p90 = GetPercentile(samples, 90.0);
+		stats.m_p95 = GetPercentile(samples, 95.0);
+		stats.m_p99 = GetPercentile(samples, 99.0);
+		return stats;
+	}
+
+	int FrameBenchmark::Finish()
+	{
+		m_isRunning = false;
+		bool passed = true;
+
+		for (std::map<std::string, double>::const_iterator it = m_settings.m_budgets.begin(); it != m_settings.m_budgets.end(); ++it)
+		{
+			for (size_t i = 0; i < (size_t)FrameSection::Count; i++)
+			{
+				if (it->first != GetSectionName((FrameSection)i))
+					continue;
+
+				std::vector<double> samples;
+				for (const FrameTimes& frame : m_frames)
+					samples.push_back(frame[i]);
+
+				std::sort(samples.begin(), samples.end());
+				const double ms = GetPercentile(samples, m_settings.m_budgetPercentile);
+
+				if (ms > it->second)
+				{
+					LINA_CORE_ERR("Benchmark budget exceeded, {0} p{1} is {2} ms, budget is {3} ms.", it->first, m_settings.m_budgetPercentile, ms, it->second);
+					passed = false;
+				}
+			}
+		}
+
+		const bool written = WriteCSV(m_settings.m_outputPath + ".csv") && WriteJSON(m_settings.m_outputPath + ".json", passed);
+		const FrameSectionStats frame = GetStats(FrameSection::Frame);
+		LINA_CORE_INFO("Benchmark finished, {0} frames, frame average {1} ms, p95 {2} ms, p99 {3} ms.", m_frames.size(), frame.m_average, frame.m_p95, frame.m_p99);
+
+		if (!written)
+		{
+			LINA_CORE_ERR("Benchmark results could not be written to {0}", m_settings.m_outputPath);
+			return FRAMEBENCHMARK_EXIT_WRITE_FAILED;
+		}
+
+		return passed ? 0 : FRAMEBENCHMARK_EXIT_BUDGET_EXCEEDED;
+	}
+
+	bool FrameBenchmark::WriteCSV(const std::string& path) const
+	{
+		std::ofstream stream(path);
+		if (!stream.is_open())
+			return false;
+
+		stream << "frame";
+		for (size_t i = 0; i < (size_t)FrameSection::Count; i++)
+			stream << "," << GetSectionName((FrameSection)i) << "_ms";
+		stream << "\n";
+
+		char buffer[32];
+		for (size_t frame = 0; frame < m_frames.size(); frame++)
+		{
+			stream << frame;
+			for (size_t i = 0; i < (size_t)FrameSection::Count; i++)
+			{
+				std::snprintf(buffer, sizeof(buffer), ",%.4f", m_frames[frame][i]);
+				stream << buffer;
+			}
+			stream << "\n";
+		}
+
+		return stream.good();
+	}
+
+	bool FrameBenchmark::WriteJSON(const std::string& path, bool passed) const
+	{
+		std::ofstream stream(path);
+		if (!stream.is_open())
+			return false;
+
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer), "{\n\t\"frames\": %zu,\n\t\"fixed_delta\": %.6f,\n\t\"budget_percentile\": %.2f,\n\t\"passed\": %s,\n\t\"sections\": {\n",
+			m_frames.size(), m_settings.m_fixedDelta, m_settings.m_budgetPercentile, passed ? "true" : "false");
+		stream << buffer;
+
+		for (size_t i = 0; i < (size_t)FrameSection::Count; i++)
+		{
+			const FrameSectionStats stats = GetStats((FrameSection)i);
+			std::snprintf(buffer, sizeof(buffer), "\t\t\"%s\": { \"min\": %.4f, \"average\": %.4f, \"median\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f",
+				GetSectionName((FrameSection)i), stats.m_min, stats.m_average, stats.m_median, stats.m_p90, stats.m_p95, stats.m_p99, stats.m_max);
+			stream << buffer;
+
+			std::map<std::string, double>::const_iterator budget = m_settings.m_budgets.find(GetSectionName((FrameSection)i));
+			if (budget != m_settings.m_budgets.end())
+			{
+				std::snprintf(buffer, sizeof(buffer), ", \"budget\": %.4f", budget->second);
+				stream << buffer;
+			}
+
+			stream << (i + 1 < (size_t)FrameSection::Count ? " },\n" : " }\n");
+		}
+
+		stream << "\t}\n}\n";
+		return stream.good();
+	}
+}
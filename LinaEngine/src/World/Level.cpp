@@ -27,18 +27,13 @@ SOFTWARE.
 */
 
 #include "World/Level.hpp"
-#include "ECS/ECS.hpp"
+#include "World/LevelSnapshot.hpp"
 #include "Core/Application.hpp"
-#include "ECS/Components/TransformComponent.hpp"
-#include "ECS/Components/CameraComponent.hpp"
-#include "ECS/Components/FreeLookComponent.hpp"
-#include "ECS/Components/MeshRendererComponent.hpp"
-#include "ECS/Components/SpriteRendererComponent.hpp"
-#include "ECS/Components/LightComponent.hpp"
-#include "ECS/Components/RigidbodyComponent.hpp"
 #include <cereal/archives/json.hpp>
 #include <stdio.h>
 #include <cereal/archives/binary.hpp>
+#include <cereal/types/vector.hpp>
+#include <cereal/types/utility.hpp>
 #include <fstream>
 
 
@@ -60,21 +55,33 @@ namespace LinaEngine::World
 		std::ofstream registrySnapshotStream(path + "/" + levelName + "_ecsSnapshot.linasnapshot");
 		{
 			cereal::BinaryOutputArchive oarchive(registrySnapshotStream); // Create an output archive
+			SaveRegistrySnapshot(registry, oarchive);
+		}
 
-			entt::snapshot{ registry }
-				.entities(oarchive)
-				.component<
-				LinaEngine::ECS::ECSEntityData, 
-				LinaEngine::ECS::CameraComponent,
-				LinaEngine::ECS::FreeLookComponent,
-				LinaEngine::ECS::PointLightComponent,
-				LinaEngine::ECS::DirectionalLightComponent,
-				LinaEngine::ECS::SpotLightComponent,
-				LinaEngine::ECS::RigidbodyComponent,
-				LinaEngine::ECS::MeshRendererComponent,
-				LinaEngine::ECS::SpriteRendererComponent,
-				LinaEngine::ECS::TransformComponent
-				>(oarchive);
+		// Transform parents are kept apart from the snapshot so levels saved before hierarchies still load.
+		std::ofstream hierarchyStream(path + "/" + levelName + "_hierarchy.linasnapshot");
+		{
+			cereal::BinaryOutputArchive oarchive(hierarchyStream);
+			std::vector<std::pair<uint32, uint32>> parentPairs;
+			LinaEngine::Application::GetTransformHierarchy().GetParentPairs(parentPairs);
+			oarchive(parentPairs);
+		}
+
+		// Same goes for the entity tags.
+		std::ofstream tagStream(path + "/" + levelName + "_tags.linasnapshot");
+		{
+			cereal::BinaryOutputArchive oarchive(tagStream);
+			std::vector<std::pair<uint32, std::string>> tags;
+			auto view = registry.view<LinaEngine::ECS::ECSEntityData>();
+
+			for (LinaEngine::ECS::ECSEntity entity : view)
+			{
+				const std::string& tag = view.get<LinaEngine::ECS::ECSEntityData>(entity).m_tag;
+				if (!tag.empty())
+					tags.push_back(std::make_pair((uint32)entt::to_integral(entity), tag));
+			}
+
+			oarchive(tags);
 		}
 
 		std::ofstream levelDataStream(path + "/" + levelName + ".linaleveldata");
@@ -104,22 +111,31 @@ namespace LinaEngine::World
 		std::ifstream regSnapshotStream(path + "/" + levelName + "_ecsSnapshot.linasnapshot");
 		{
 			cereal::BinaryInputArchive iarchive(regSnapshotStream);
+			LoadRegistrySnapshot(registry, iarchive);
+		}
 
-			entt::snapshot_loader{ registry }
-				.entities(iarchive)
-				.component<
-				LinaEngine::ECS::ECSEntityData,
-				LinaEngine::ECS::CameraComponent,
-				LinaEngine::ECS::FreeLookComponent,
-				LinaEngine::ECS::PointLightComponent,
-				LinaEngine::ECS::DirectionalLightComponent,
-				LinaEngine::ECS::SpotLightComponent,
-				LinaEngine::ECS::RigidbodyComponent,
-				LinaEngine::ECS::MeshRendererComponent,
-				LinaEngine::ECS::SpriteRendererComponent,
-				LinaEngine::ECS::TransformComponent
-				>(iarchive);
-				
+		std::ifstream hierarchyStream(path + "/" + levelName + "_hierarchy.linasnapshot");
+		if (hierarchyStream.is_open())
+		{
+			cereal::BinaryInputArchive iarchive(hierarchyStream);
+			std::vector<std::pair<uint32, uint32>> parentPairs;
+			iarchive(parentPairs);
+			LinaEngine::Application::GetTransformHierarchy().SetParentPairs(parentPairs);
+		}
+
+		std::ifstream tagStream(path + "/" + levelName + "_tags.linasnapshot");
+		if (tagStream.is_open())
+		{
+			cereal::BinaryInputArchive iarchive(tagStream);
+			std::vector<std::pair<uint32, std::string>> tags;
+			iarchive(tags);
+
+			for (const std::pair<uint32, std::string>& tag : tags)
+			{
+				const LinaEngine::ECS::ECSEntity entity = (LinaEngine::ECS::ECSEntity)tag.first;
+				if (registry.valid(entity) && registry.has<LinaEngine::ECS::ECSEntityData>(entity))
+					registry.SetEntityTag(entity, tag.second);
+			}
 		}
 
 	}
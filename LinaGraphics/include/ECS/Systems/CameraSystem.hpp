@@ -59,7 +59,7 @@ namespace LinaEngine::ECS
 		virtual void UpdateComponents(float delta) override;
 
 		// Construct the system.
-		void Construct(ECSRegistry& registry) { BaseECSSystem::Construct(registry); }
+		void Construct(ECSRegistry& registry);
 
 		// Get view matrix.
 		Matrix& GetViewMatrix() { return m_view; }
@@ -64,12 +64,7 @@ namespace LinaEngine::ECS
 
 		LightingSystem() {};
 
-		void Construct(ECSRegistry& registry, RenderDevice& rdIn, Graphics::RenderEngine& renderEngineIn)
-		{
-			BaseECSSystem::Construct(registry);
-			m_renderDevice = &rdIn;
-			m_renderEngine = &renderEngineIn;
-		}
+		void Construct(ECSRegistry& registry, RenderDevice& rdIn, Graphics::RenderEngine& renderEngineIn);
 
 		DirectionalLightComponent* GetDirLight() { return std::get<1>(m_directionalLight); }
 		virtual void UpdateComponents(float delta) override;
@@ -79,7 +74,28 @@ namespace LinaEngine::ECS
 		Matrix GetDirLightBiasMatrix();
 		std::vector<Matrix> GetPointLightMatrices();
 		Color& GetAmbientColor() { return m_ambientColor; }
-		Vector3& GetDirectionalLightPos();
+		Vector3 GetDirectionalLightPos();
+
+	private:
+
+		// Uniform names are built once per light index instead of concatenated on every shader update.
+		struct PointLightUniforms
+		{
+			std::string m_position;
+			std::string m_color;
+		};
+
+		struct SpotLightUniforms
+		{
+			std::string m_position;
+			std::string m_color;
+			std::string m_direction;
+			std::string m_cutoff;
+			std::string m_outerCutoff;
+		};
+
+		const PointLightUniforms& GetPointLightUniforms(int index);
+		const SpotLightUniforms& GetSpotLightUniforms(int index);
 
 	private:
 
@@ -88,6 +104,10 @@ namespace LinaEngine::ECS
 		std::tuple < TransformComponent*, DirectionalLightComponent*> m_directionalLight;
 		std::vector<std::tuple<TransformComponent*, PointLightComponent*>> m_pointLights;
 		std::vector<std::tuple<TransformComponent*, SpotLightComponent*>> m_spotLights;
+		std::vector<PointLightUniforms> m_pointLightUniforms;
+		std::vector<SpotLightUniforms> m_spotLightUniforms;
+		std::string m_dirLightColorUniform;
+		std::string m_dirLightDirectionUniform;
 		Color m_ambientColor = Color(0.0f, 0.0f, 0.0f);
 	};
 }
@@ -45,7 +45,7 @@ Timestamp: 4/27/2019 5:38:44 PM
 #include "Rendering/RenderingCommon.hpp"
 #include "Rendering/RenderTarget.hpp"
 #include "Rendering/VertexArray.hpp"
-#include <queue>
+#include "Core/FrameArena.hpp"
 
 namespace LinaEngine
 {
@@ -76,14 +76,19 @@ namespace LinaEngine::ECS
 
 	public:
 
-		typedef std::tuple<Graphics::BatchDrawData, Graphics::BatchModelData>  BatchPair;
+		// Transparent objects are drawn one by one sorted back to front, so they aren't batched.
+		struct TransparentDrawData
+		{
+			Graphics::BatchDrawData m_drawData;
+			Matrix m_model;
+			Matrix m_inverseTransposeModel;
+		};
 
-		struct BatchComparison
+		struct TransparentComparison
 		{
-			bool const operator()(const BatchPair& lhs, const BatchPair& rhs) const
+			bool const operator()(const TransparentDrawData& lhs, const TransparentDrawData& rhs) const
 			{
-				
-				return std::get<0>(lhs).m_distance < std::get<0>(rhs).m_distance;
+				return lhs.m_drawData.m_distance > rhs.m_drawData.m_distance;
 			}
 		};
 
@@ -97,18 +102,16 @@ namespace LinaEngine::ECS
 
 		MeshRendererSystem() {};
 
-		void Construct(ECSRegistry& registry, Graphics::RenderEngine& renderEngineIn, RenderDevice& renderDeviceIn)
-		{
-			BaseECSSystem::Construct(registry);
-			m_renderEngine = &renderEngineIn;
-			m_renderDevice = &renderDeviceIn;
-		}
+		void Construct(ECSRegistry& registry, Graphics::RenderEngine& renderEngineIn, RenderDevice& renderDeviceIn);
 
 		void RenderOpaque(Graphics::VertexArray& vertexArray, Graphics::Material& material, const Matrix& transformIn);
 		void RenderTransparent(Graphics::VertexArray& vertexArray, Graphics::Material& material, const Matrix& transformIn, float priority);
 		void FlushOpaque(Graphics::DrawParams& drawParams, Graphics::Material* overrideMaterial = nullptr, bool completeFlush = true);
 		void FlushTransparent(Graphics::DrawParams& drawParams, Graphics::Material* overrideMaterial = nullptr, bool completeFlush = true);
 
+		// Drops the gathered draws without drawing them, the batches keep their memory.
+		void ClearBatches();
+
 		virtual void UpdateComponents(float delta) override;
 
 
@@ -117,9 +120,13 @@ namespace LinaEngine::ECS
 		RenderDevice* m_renderDevice = nullptr;
 		Graphics::RenderEngine* m_renderEngine = nullptr;
 
-		// Map & queue to see the list of same vertex array & textures to compress them into single draw call.
+		// Map to see the list of same vertex array & textures to compress them into single draw call, the entries
+		// & their vectors are kept between frames so a steady scene doesn't allocate.
 		std::map<Graphics::BatchDrawData, Graphics::BatchModelData, BatchDrawDataComp> m_opaqueRenderBatch;
-		std::priority_queue<BatchPair, std::vector<BatchPair>, BatchComparison> m_transparentRenderBatch;
+
+		// Gathered every frame into the frame arena & sorted on the first flush.
+		FrameVector<TransparentDrawData> m_transparentRenderBatch;
+		bool m_transparentBatchSorted = false;
 	};
 }
 
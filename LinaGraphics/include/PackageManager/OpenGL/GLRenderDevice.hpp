@@ -85,6 +85,9 @@ namespace LinaEngine::Graphics
 		// Creates a texture on GL.
 		uint32 CreateTexture2D(Vector2 size, const void* data,  SamplerParameters samplerParams ,bool compress, bool useBorder = false, Color borderColor = Color::White);
 
+		// Creates a texture on GL with a mip chain generated on the CPU, levels[0] is the base level.
+		uint32 CreateTexture2DMipmapped(Vector2 size, const std::vector<const void*>& levels, SamplerParameters samplerParams, bool compress);
+
 		// Creates an HDRI texture
 		uint32 CreateTextureHDRI(Vector2 size, float* data, SamplerParameters samplerParams);
 
@@ -94,6 +97,9 @@ namespace LinaEngine::Graphics
 		// Creates an empty cubemap texture.
 		uint32 CreateCubemapTextureEmpty(Vector2 size, SamplerParameters samplerParams);
 
+		// Creates a float cubemap texture, data is ordered as [mip * 6 + face].
+		uint32 CreateCubemapTextureHDRI(Vector2 size, SamplerParameters samplerParams, const std::vector<float*>& data, uint32 mipCount = 1);
+
 		// Creates a multisampled texture
 		uint32 CreateTexture2DMSAA(Vector2 size, SamplerParameters samplerParams, int sampleCount);
 
@@ -127,6 +133,9 @@ namespace LinaEngine::Graphics
 		// Releases a previously created vertex array by id from GL.
 		uint32 ReleaseVertexArray(uint32 vao, bool checkMap = true);
 
+		// Bytes allocated for the vertex & index buffers of a vertex array, including grown instance buffers.
+		uintptr GetVertexArrayMemorySize(uint32 vao) const;
+
 		// Creates a texture sampler on GL.
 		uint32 CreateSampler(SamplerParameters samplerParams);
 
@@ -178,6 +187,9 @@ namespace LinaEngine::Graphics
 		// Generate mipmaps for a texture
 		void GenerateTextureMipmaps(uint32 texture, TextureBindMode bindMode);
 
+		// Reads back float data of a texture level, face is only used for cubemaps.
+		void GetTextureDataFloat(uint32 texture, TextureBindMode bindMode, uint32 face, uint32 mipLevel, PixelFormat format, float* data);
+
 		// Binds a rbo to an existing fbo
 		void BlitFrameBuffers(uint32 readFBO, uint32 readWidth, uint32 readHeight, uint32 writeFBO, uint32 writeWidth, uint32 writeHeight, BufferBit mask, SamplerFilter filter);
 
@@ -266,6 +278,10 @@ namespace LinaEngine::Graphics
 		// Sets viewport dimensions
 		void SetViewport(Vector2 pos, Vector2 size);
 
+		// Draw calls issued since the last reset.
+		uint32 GetDrawCallCount() const { return m_drawCallCount; }
+		void ResetDrawCallCount() { m_drawCallCount = 0; }
+
 
 	private:
 
@@ -347,6 +363,9 @@ namespace LinaEngine::Graphics
 		bool m_shouldWriteDepth = true;
 		bool m_isDepthTestEnabled = true;
 		Color m_currentClearColor = Color::Black;
+
+		// Draw calls issued since the last reset.
+		uint32 m_drawCallCount = 0;
 		
 	};
 }
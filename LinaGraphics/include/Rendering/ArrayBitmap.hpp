@@ -42,6 +42,7 @@ Timestamp: 4/14/2019 11:59:32 AM
 #define ArrayBitmap_HPP
 
 #include "Core/SizeDefinitions.hpp"
+#include "Core/Common.hpp"
 #include "Utility/Log.hpp"
 #include <string>
 
@@ -51,15 +52,28 @@ namespace LinaEngine::Graphics
 	{
 	public:
 
+		// Empty bitmaps don't allocate, so they are cheap to place on the stack before a Load.
+		ArrayBitmap() {};
+
 		// Param constructors including width, height, pixel array and offsets
-		ArrayBitmap(int32 width = 1, int32 height = 1);
+		ArrayBitmap(int32 width, int32 height);
 		ArrayBitmap(int32 width, int32 height, int32* pixels);
 		ArrayBitmap(int32 width, int32 height, int32* pixels, int32 offsetX, int32 offsetY, int32 rowOffset);
 		~ArrayBitmap();
 
-		// Load the bitmap from a file in resources.
+		// Pixels are moved, never copied.
+		ArrayBitmap(ArrayBitmap&& other) noexcept;
+		ArrayBitmap& operator=(ArrayBitmap&& other) noexcept;
+
+		// Load the bitmap from a file in resources, the decoded buffer is adopted without a copy.
 		int Load(const std::string& fileName);
 
+		// Takes ownership of pixels allocated with Memory::malloc.
+		void Adopt(int32 width, int32 height, int32* pixels);
+
+		// Gives up the ownership of the pixels, caller needs to Memory::free them.
+		int32* Release();
+
 		// Save the bitmap into a file in resources.
 		bool Save(const std::string& fileName) const;
 
@@ -67,6 +81,9 @@ namespace LinaEngine::Graphics
 		static unsigned char* LoadImmediate(const char* filename, int& w, int& h,  int& nrchannels);
 		static float* LoadImmediateHDRI(const char* fileName, int& w, int& h, int& nrChannels);
 
+		// Frees the data returned from the immediate loads.
+		static void FreeImmediate(void* data);
+
 		// Clr colors.
 		void Clear(int32 color);
 
@@ -100,6 +117,8 @@ namespace LinaEngine::Graphics
 
 		uintptr GetPixelsSize() const { return (uintptr)(m_width * m_heigth) * sizeof(m_pixels[0]); }
 
+		DISALLOW_COPY_AND_ASSIGN(ArrayBitmap)
+
 	};
 }
 
@@ -0,0 +1,77 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: HDRICache
+
+Disk cache for the image based lighting data computed from an HDRI, keyed by the hash of
+the source file. Holds the irradiance SH coefficients, prefiltered cubemap mips & BRDF LUT.
+
+Timestamp: 10/31/2020 5:02:40 PM
+*/
+
+#pragma once
+
+#ifndef HDRICache_HPP
+#define HDRICache_HPP
+
+#include "Rendering/SphericalHarmonics.hpp"
+#include <cereal/types/vector.hpp>
+#include <string>
+
+namespace LinaEngine::Graphics
+{
+	#define HDRI_CACHE_VERSION 1
+	#define HDRI_CACHE_FOLDER "resources/cache/hdri/"
+
+	struct HDRICache
+	{
+		uint32 m_version = HDRI_CACHE_VERSION;
+		unsigned long long m_sourceHash = 0;
+		SHCoefficients m_irradianceSH;
+		int32 m_prefilterSize = 0;
+		uint32 m_prefilterMipCount = 0;
+		int32 m_brdfSize = 0;
+
+		// RGB float data, prefilter levels are ordered as [mip * 6 + face].
+		std::vector<std::vector<float>> m_prefilterData;
+		std::vector<float> m_brdfData;
+
+		// Returns false if the file doesn't exist or was written by an older version.
+		static bool Load(const std::string& path, HDRICache& cache);
+		static void Save(const std::string& path, const HDRICache& cache);
+		static std::string GetCachePath(unsigned long long sourceHash);
+
+		template<class Archive>
+		void serialize(Archive& archive)
+		{
+			archive(m_version, m_sourceHash, m_irradianceSH, m_prefilterSize, m_prefilterMipCount, m_brdfSize, m_prefilterData, m_brdfData);
+		}
+	};
+}
+
+#endif
@@ -77,6 +77,9 @@ namespace LinaEngine::Graphics
 		// Accessor for num m_Indices.
 		uint32 GetIndexCount() const { return m_indices.size(); }
 
+		// Size of the index & element data in bytes.
+		size_t GetMemorySize() const;
+
 	private:
 
 		// Index & element data.
@@ -171,6 +171,7 @@ namespace LinaEngine::Graphics
 
 		int GetID() const { return m_materialID; }
 		const std::string& GetPath() const { return m_path; }
+		uint32 GetRefCount() const { return m_refCount; }
 		Shaders GetShaderType() { return m_shaderType; }
 		uint32 GetShaderID() { return m_shaderID; }
 
@@ -212,6 +213,7 @@ namespace LinaEngine::Graphics
 		friend class RenderContext;
 
 		int m_materialID = -1;
+		uint32 m_refCount = 0;
 		std::string m_path = "";
 		uint32 m_shaderID = 0;
 	
@@ -44,6 +44,7 @@ Timestamp: 5/6/2019 4:23:45 PM
 #include "Rendering/Texture.hpp"
 #include "Rendering/IndexedModel.hpp"
 #include "Rendering/Material.hpp"
+#include "Utility/Math/AABB.hpp"
 
 namespace LinaEngine::Graphics
 {
@@ -98,16 +99,34 @@ namespace LinaEngine::Graphics
 		const std::string& GetPath() const { return m_path; }
 		const std::string& GetParamsPath() const { return m_paramsPath; }
 		const int GetID() const { return m_meshID; }
+		bool GetIsLoading() const { return m_isLoading; }
+		bool GetIsEvicted() const { return m_isEvicted; }
+		uint32 GetRefCount() const { return m_refCount; }
+
+		// Size of the imported model data kept on the CPU.
+		size_t GetMemorySize();
+
+		// Size of the uploaded vertex & index buffers, 0 until the upload & after eviction.
+		size_t GetGPUMemorySize() const;
+
+		// Bounds of the vertex positions of all indexed models, kept when the mesh is evicted.
+		void CalculateLocalBounds();
+		const AABB& GetLocalBounds() const { return m_localBounds; }
 
 
 	private:
 
 		friend class RenderEngine;
 		int m_meshID = -1;
+		bool m_isLoading = false;
+		bool m_isEvicted = false;
+		uint32 m_refCount = 0;
+		uint64 m_lastUsedFrame = 0;
 		std::string m_path = "";
 		std::string m_paramsPath = "";
 
 		MeshParameters m_parameters;
+		AABB m_localBounds = AABB(Vector3(-0.5f), Vector3(0.5f));
 		std::vector<VertexArray*> m_vertexArrays;
 		std::vector<IndexedModel> m_indexedModelArray;
 		std::vector<ModelMaterial> m_materialSpecArray;
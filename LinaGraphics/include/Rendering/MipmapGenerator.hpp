@@ -0,0 +1,77 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: MipmapGenerator
+
+Builds mip chains for 8 bit images on the CPU using stb_image_resize, so textures can be
+uploaded with all their levels instead of relying on the driver. sRGB images are filtered in
+linear space. Independent of the render device, can be used while cooking resources.
+
+Timestamp: 11/1/2020 1:46:22 PM
+*/
+
+#pragma once
+
+#ifndef MipmapGenerator_HPP
+#define MipmapGenerator_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include <vector>
+
+namespace LinaEngine
+{
+	class JobSystem;
+}
+
+namespace LinaEngine::Graphics
+{
+	struct MipLevel
+	{
+		int32 m_width = 0;
+		int32 m_height = 0;
+		std::vector<uint8> m_pixels;
+	};
+
+	class MipmapGenerator
+	{
+	public:
+
+		// Number of levels in a full chain, including the base level.
+		static uint32 GetMipCount(int32 width, int32 height);
+
+		// Generates all levels below the base into outLevels, each level is filtered from the previous one.
+		// Large levels are split into row bands scheduled on the job system, pass null to run on the calling thread.
+		// Safe to call from a job, the calling thread runs other jobs while it waits for the bands.
+		static void Generate(const uint8* pixels, int32 width, int32 height, int32 channels, bool isSRGB, bool wrap, std::vector<MipLevel>& outLevels, JobSystem* jobSystem = nullptr);
+
+		// Generates the chains of several images, e.g. cubemap faces, scheduling all of them per level.
+		static void GenerateBatch(const std::vector<const uint8*>& images, int32 width, int32 height, int32 channels, bool isSRGB, bool wrap, std::vector<std::vector<MipLevel>>& outLevels, JobSystem* jobSystem = nullptr);
+	};
+}
+
+#endif
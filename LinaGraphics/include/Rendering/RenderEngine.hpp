@@ -50,14 +50,23 @@ Timestamp: 4/15/2019 12:26:31 PM
 #include "Rendering/ModelLoader.hpp"
 #include "Rendering/VertexArray.hpp"
 #include "Rendering/RenderBuffer.hpp"
+#include "Rendering/MipmapGenerator.hpp"
+#include "Rendering/ArrayBitmap.hpp"
+#include "Rendering/RenderableBVH.hpp"
 #include "Mesh.hpp"
 #include "UniformBuffer.hpp"
 #include "Window.hpp"
 #include "RenderContext.hpp"
 #include "Utility/Math/Color.hpp"
 #include "Core/LayerStack.hpp"
+#include "Core/JobSystem.hpp"
+#include "Utility/HandleAllocator.hpp"
 #include <functional>
 #include <set>
+#include <mutex>
+#include <unordered_map>
+#include <queue>
+#include <chrono>
 
 namespace LinaEngine
 {
@@ -72,6 +81,9 @@ namespace LinaEngine
 namespace LinaEngine::Graphics
 {
 	class Shader;
+	class ArrayBitmap;
+	struct SHCoefficients;
+	struct HDRICache;
 
 	struct BufferValueRecord
 	{
@@ -79,6 +91,42 @@ namespace LinaEngine::Graphics
 		float zFar;
 	};
 
+	// Keeps track of a texture that is being decoded on the worker threads.
+	struct AsyncTextureRequest
+	{
+		Texture* m_texture = nullptr;
+		ArrayBitmap m_bitmap;
+		std::vector<MipLevel> m_mipLevels;
+		SamplerParameters m_samplerParams;
+		bool m_compress = false;
+		bool m_useDefaultFormats = false;
+		int m_nrComponents = -1;
+		std::string m_path = "";
+		std::function<void(Texture&)> m_onLoaded;
+	};
+
+	// Keeps track of a mesh that is being imported on the worker threads.
+	struct AsyncMeshRequest
+	{
+		Mesh* m_mesh = nullptr;
+		MeshParameters m_meshParams;
+		std::string m_path = "";
+		std::vector<IndexedModel> m_indexedModels;
+		std::vector<ModelMaterial> m_materialSpecs;
+		std::vector<uint32> m_materialIndices;
+		std::vector<VertexArray*> m_vertexArrays;
+		std::function<void(Mesh&)> m_onLoaded;
+	};
+
+	// Memory used by a resource type, GPU sizes are estimates.
+	struct ResourceMemoryStats
+	{
+		uint32 m_count = 0;
+		uint32 m_evictedCount = 0;
+		size_t m_cpuBytes = 0;
+		size_t m_gpuBytes = 0;
+	};
+
 	class RenderEngine
 	{
 	public:
@@ -93,17 +141,46 @@ namespace LinaEngine::Graphics
 			m_postSceneDrawCallback = cb;
 		}
 
+		// Setter for the callback invoked whenever an asynchronously loaded texture is uploaded.
+		void SetTextureLoadedCallback(std::function<void(Texture&)>& cb)
+		{
+			m_textureLoadedCallback = cb;
+		}
+
+		// Max milliseconds spent on uploading asynchronously loaded resources per frame.
+		void SetUploadBudget(double budgetMS) { m_uploadBudgetMS = budgetMS; }
+		uint32 GetPendingTextureCount() { return (uint32)m_pendingTextures.size(); }
+		uint32 GetPendingMeshCount() { return (uint32)m_pendingMeshes.size(); }
+
+		// Draw calls of the last swapped frame & bytes uploaded by the last call to ProcessAsyncUploads.
+		uint32 GetFrameDrawCalls() { return m_frameDrawCalls; }
+		size_t GetFrameUploadedBytes() { return m_frameUploadedBytes; }
+
+		// Primitive drawn in place of meshes that are still being imported or failed to import.
+		void SetFallbackPrimitive(Primitives primitive) { m_fallbackPrimitive = primitive; }
+		Primitives GetFallbackPrimitive() { return m_fallbackPrimitive; }
+
+		// Memory budgets in bytes, 0 means unlimited. Unreferenced textures & meshes are evicted in LRU order when exceeded.
+		void SetMemoryBudget(size_t cpuBytes, size_t gpuBytes) { m_cpuMemoryBudget = cpuBytes; m_gpuMemoryBudget = gpuBytes; }
+		size_t GetCPUMemoryBudget() { return m_cpuMemoryBudget; }
+		size_t GetGPUMemoryBudget() { return m_gpuMemoryBudget; }
+		const ResourceMemoryStats& GetTextureMemoryStats() { return m_textureMemoryStats; }
+		const ResourceMemoryStats& GetMeshMemoryStats() { return m_meshMemoryStats; }
+		const ResourceMemoryStats& GetMaterialMemoryStats() { return m_materialMemoryStats; }
+
 		Vector2 GetViewportSize()
 		{
 			return m_viewportSize;
 		}
 
 		ECS::CameraSystem* GetCameraSystem() { return &m_cameraSystem; }
+		ECS::ECSSystemList& GetRenderingPipeline() { return m_renderingPipeline; }
+		RenderableBVH& GetRenderableBVH() { return m_renderableBVH; }
 		Texture& GetHDRICubemap() { return m_hdriCubemap; }
 
 		void SetCurrentPLightCount(int count) { m_currentPointLightCount = count; }
 		void SetCurrentSLightCount(int count) { m_currentSpotLightCount = count; }
-		void Initialize(LinaEngine::ECS::ECSRegistry& ecsIn, Window& appWindow);
+		void Initialize(LinaEngine::ECS::ECSRegistry& ecsIn, Window& appWindow, JobSystem& jobSystem);
 		void Render();
 		void RenderLayers();
 		void Swap();
@@ -115,8 +192,10 @@ namespace LinaEngine::Graphics
 		Material& LoadMaterialFromFile(const std::string& path = "");
 		void MaterialUpdated(Material& mat);
 		Texture& CreateTexture2D(const std::string& filePath, SamplerParameters samplerParams = SamplerParameters(), bool compress = false, bool useDefaultFormats = false, const std::string& paramsPath = "");
+		Texture& CreateTexture2DAsync(const std::string& filePath, SamplerParameters samplerParams = SamplerParameters(), bool compress = false, bool useDefaultFormats = false, const std::string& paramsPath = "", std::function<void(Texture&)> onLoaded = nullptr);
 		Texture& CreateTextureHDRI(const std::string filePath);
 		Mesh& CreateMesh (const std::string& filePath, MeshParameters meshParams = MeshParameters(), int id = -1, const std::string& paramsPath = "");
+		Mesh& CreateMeshAsync(const std::string& filePath, MeshParameters meshParams = MeshParameters(), int id = -1, const std::string& paramsPath = "", std::function<void(Mesh&)> onLoaded = nullptr);
 		Shader& CreateShader(Shaders shader, const std::string& path, bool usesGeometryShader = false);
 		Material& GetMaterial(int id);
 		Material& GetMaterial(const std::string& path);
@@ -147,6 +226,26 @@ namespace LinaEngine::Graphics
 		// Updates shader uniforms with material data.
 		void UpdateShaderData(Material* mat);
 
+		// Uploads the textures & meshes loaded by the workers to the GPU, limited by the upload budget.
+		void ProcessAsyncUploads();
+
+		// Marks the mesh as used in this frame, evicted meshes are reloaded.
+		void MarkMeshUsed(Mesh& mesh);
+
+		// Same for textures drawn outside of materials, e.g. editor previews. Evicted textures are reloaded & the
+		// default texture is drawn meanwhile.
+		void MarkTextureUsed(Texture& texture);
+
+		// Pinned textures are never evicted, for consumers that keep the GL id around, e.g. editor icons.
+		void PinTexture(Texture& texture) { texture.m_pinCount++; }
+		void UnpinTexture(Texture& texture) { if (texture.m_pinCount != 0) texture.m_pinCount--; }
+
+		// Recounts the references of meshes & materials from the components, and of textures from the referenced materials.
+		void CountResourceReferences();
+
+		// Evicts unreferenced resources, least recently used first, until the memory is within the budgets.
+		void EvictUnusedResources();
+
 		// Returns the final render texture.
 		void* GetFinalImage();
 
@@ -170,6 +269,15 @@ namespace LinaEngine::Graphics
 		bool ValidateEngineShaders();
 		void ConstructEngineMaterials();
 		void ConstructEnginePrimitives();
+		void LoadTextureAsync(Texture* texture, SamplerParameters samplerParams, bool compress, bool useDefaultFormats, std::function<void(Texture&)> onLoaded);
+		void ImportMeshAsync(Mesh& mesh, std::function<void(Mesh&)> onLoaded);
+
+		// Allocates for -1, otherwise claims the given handle or a fresh one if its slot is taken.
+		int AcquireMeshHandle(int id, const std::string& filePath);
+		void ReloadTexture(Texture& texture);
+		void EvictTexture(Texture& texture);
+		void EvictMesh(Mesh& mesh);
+		void UpdateMemoryStats();
 		void ConstructRenderTargets();
 		void SetupDrawParameters();
 		void DumpMemory();
@@ -186,11 +294,18 @@ namespace LinaEngine::Graphics
 		void CalculateHDRIPrefilter(Matrix& captureProjection, Matrix views[6]);
 		void CalculateHDRIBRDF(Matrix& captureProjection, Matrix views[6]);
 
+		// CPU irradiance & disk caching of the IBL maps.
+		bool CalculateHDRIIrradianceSH(const std::string& hdriPath, SHCoefficients& sh);
+		void ConstructHDRIIrradianceMap(const SHCoefficients& sh);
+		void ReadHDRICacheData(HDRICache& cache);
+		void LoadHDRICacheData(HDRICache& cache);
+
 
 	private:
 
 		RenderDevice m_renderDevice;
 		Window* m_appWindow;
+		LinaEngine::ECS::ECSRegistry* m_ecs = nullptr;
 
 		RenderTarget m_primaryRenderTarget;
 		RenderTarget m_pingPongRenderTarget1;
@@ -251,14 +366,46 @@ namespace LinaEngine::Graphics
 		LinaEngine::ECS::SpriteRendererSystem m_spriteRendererSystem;
 		LinaEngine::ECS::LightingSystem m_lightingSystem;
 		LinaEngine::ECS::ECSSystemList m_renderingPipeline;
+		RenderableBVH m_renderableBVH;
 
 		std::map<int, Texture*> m_loadedTextures;
 		std::map<int, Mesh> m_loadedMeshes;
 		std::map<int, Material> m_loadedMaterials;
+
+		// Path indices & handles of the loaded resources.
+		std::unordered_map<std::string, int> m_texturePaths;
+		std::unordered_map<std::string, int> m_meshPaths;
+		std::unordered_map<std::string, int> m_materialPaths;
+		HandleAllocator m_meshHandles;
+		HandleAllocator m_materialHandles;
 		std::map<int, Shader> m_loadedShaders;
 		std::set<Material*> m_shadowMappedMaterials;
 		std::set<Material*> m_hdriMaterials;
 
+		// Async resource loading, decoding runs on the application's job system.
+		JobSystem* m_jobSystem = nullptr;
+		JobCounter m_asyncLoadCounter;
+		std::mutex m_completedTexturesMutex;
+		std::queue<AsyncTextureRequest*> m_completedTextures;
+		std::map<std::string, Texture*> m_pendingTextures;
+		std::mutex m_completedMeshesMutex;
+		std::queue<AsyncMeshRequest*> m_completedMeshes;
+		std::queue<AsyncMeshRequest*> m_meshUploads;
+		std::map<std::string, int> m_pendingMeshes;
+		Primitives m_fallbackPrimitive = Primitives::Cube;
+
+		// Resource memory management.
+		std::map<std::string, Texture*> m_evictedTextures;
+		ResourceMemoryStats m_textureMemoryStats;
+		ResourceMemoryStats m_meshMemoryStats;
+		ResourceMemoryStats m_materialMemoryStats;
+		size_t m_cpuMemoryBudget = 0;
+		size_t m_gpuMemoryBudget = 0;
+		uint64 m_frameIndex = 0;
+
+		// Scratch for uniform names built while drawing.
+		std::string m_uniformNameBuffer;
+
 	private:
 
 		uint32 m_skyboxVAO = 0;
@@ -276,7 +423,13 @@ namespace LinaEngine::Graphics
 		Vector2 m_viewportSize = Vector2::Zero;
 
 		std::function<void()> m_postSceneDrawCallback;
+		std::function<void(Texture&)> m_textureLoadedCallback;
 		bool m_firstFrameDrawn = false;
+		double m_uploadBudgetMS = 4.0;
+		std::chrono::time_point<std::chrono::high_resolution_clock> m_asyncBatchStart;
+		uint32 m_asyncBatchCount = 0;
+		uint32 m_frameDrawCalls = 0;
+		size_t m_frameUploadedBytes = 0;
 
 
 		DISALLOW_COPY_ASSIGN_MOVE(RenderEngine)
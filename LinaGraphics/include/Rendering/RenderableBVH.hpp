@@ -0,0 +1,126 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: RenderableBVH
+
+Dynamic AABB tree over the world bounds of the entities with mesh & sprite renderers. Entities moved by
+the transform hierarchy are refit every frame, added & removed renderers are picked up through the
+registry signals. Queries report entities.
+
+Timestamp: 11/3/2020 7:21:45 PM
+*/
+
+#pragma once
+
+#ifndef RenderableBVH_HPP
+#define RenderableBVH_HPP
+
+#include "ECS/ECSSystem.hpp"
+#include "Utility/DynamicAABBTree.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace LinaEngine
+{
+	class JobSystem;
+}
+
+namespace LinaEngine::Graphics
+{
+	class RenderEngine;
+
+	class RenderableBVH
+	{
+	public:
+
+		RenderableBVH() {};
+		~RenderableBVH();
+
+		void Initialize(ECS::ECSRegistry& registry, RenderEngine& renderEngine);
+		void Shutdown();
+
+		// Adds & removes the changed renderers, refits the moved ones & lets the tree rebuild in the background.
+		void Update(const std::vector<ECS::ECSEntity>& movedEntities, JobSystem* jobSystem = nullptr);
+
+		// Bounds are recalculated on the next update, for changes the registry doesn't signal like a new mesh id.
+		void MarkEntityChanged(ECS::ECSEntity entity) { m_changedEntities.push_back(entity); }
+		void MarkMeshChanged(int meshID);
+
+		// Callbacks receive the entity & return false to stop the query.
+		template<typename Callback>
+		void QueryFrustum(const Frustum& frustum, Callback callback) const
+		{
+			m_tree.QueryFrustum(frustum, [&callback](uint32 data) { return callback((ECS::ECSEntity)data); });
+		}
+
+		template<typename Callback>
+		void QueryAABB(const AABB& aabb, Callback callback) const
+		{
+			m_tree.QueryAABB(aabb, [&callback](uint32 data) { return callback((ECS::ECSEntity)data); });
+		}
+
+		template<typename Callback>
+		void QuerySphere(const Vector3& center, float radius, Callback callback) const
+		{
+			m_tree.QuerySphere(center, radius, [&callback](uint32 data) { return callback((ECS::ECSEntity)data); });
+		}
+
+		// Callback receives the entity & the distance to its fat bounds, returns the distance to clip the ray to.
+		template<typename Callback>
+		void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Callback callback) const
+		{
+			m_tree.RayCast(origin, direction, maxDistance, [&callback](uint32 data, float distance) { return callback((ECS::ECSEntity)data, distance); });
+		}
+
+		// Entities whose bounds may be visible from the view projection.
+		void GetVisibleEntities(const Matrix& viewProjection, std::vector<ECS::ECSEntity>& entities) const;
+
+		// World bounds of a renderer, false if the entity isn't one.
+		bool GetWorldBounds(ECS::ECSEntity entity, AABB& bounds);
+
+		const DynamicAABBTree& GetTree() const { return m_tree; }
+		DynamicAABBTree& GetTree() { return m_tree; }
+
+	private:
+
+		void OnRendererChanged(entt::registry& registry, entt::entity entity) { m_changedEntities.push_back(entity); }
+		void RefreshEntity(ECS::ECSEntity entity);
+
+	private:
+
+		ECS::ECSRegistry* m_registry = nullptr;
+		RenderEngine* m_renderEngine = nullptr;
+		DynamicAABBTree m_tree;
+		std::unordered_map<ECS::ECSEntity, uint32> m_proxies;
+		std::vector<ECS::ECSEntity> m_changedEntities;
+
+		DISALLOW_COPY_ASSIGN_MOVE(RenderableBVH)
+	};
+}
+
+#endif
@@ -341,6 +341,7 @@ namespace LinaEngine::Graphics
 		bool vSyncEnabled;
 		bool m_decorated = true;
 		bool m_resizable = true;
+		bool m_visible = true;
 		WindowState m_windowState;
 
 		WindowProperties()
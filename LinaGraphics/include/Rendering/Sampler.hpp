@@ -52,7 +52,14 @@ namespace LinaEngine::Graphics
 		// Destructor releases sampler data through render engine
 		~Sampler()
 		{
-			m_engineBoundID = m_renderDevice->ReleaseSampler(m_engineBoundID);
+			Release();
+		}
+
+		// Releases the sampler data, it can be constructed again afterwards.
+		void Release()
+		{
+			if (m_renderDevice != nullptr)
+				m_engineBoundID = m_renderDevice->ReleaseSampler(m_engineBoundID);
 		}
 
 		void Construct(RenderDevice& deviceIn, SamplerParameters samplerParams, TextureBindMode bindMode)
@@ -0,0 +1,87 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: SphericalHarmonics
+
+CPU side projection of HDRI environments into 3 band (9 coefficient) spherical harmonics,
+used for generating diffuse irradiance without running a convolution pass on the GPU.
+
+Timestamp: 10/31/2020 3:18:05 PM
+*/
+
+#pragma once
+
+#ifndef SphericalHarmonics_HPP
+#define SphericalHarmonics_HPP
+
+#include "Core/SizeDefinitions.hpp"
+#include "Utility/Math/Vector.hpp"
+#include <vector>
+
+namespace LinaEngine
+{
+	class JobSystem;
+}
+
+namespace LinaEngine::Graphics
+{
+	struct SHCoefficients
+	{
+		// RGB radiance coefficients, ordered by band: L00, L1-1, L10, L11, L2-2, L2-1, L20, L21, L22
+		float m_values[9][3] = { {0.0f} };
+
+		template<class Archive>
+		void serialize(Archive& archive)
+		{
+			archive(m_values);
+		}
+	};
+
+	class SphericalHarmonics
+	{
+	public:
+
+		// Projects an equirectangular float image (row 0 is v = 0) into SH radiance coefficients.
+		// Rows are split into jobs on the given job system, runs on the calling thread if it's null.
+		static SHCoefficients ProjectEquirectangular(const float* data, int32 width, int32 height, int32 channels, JobSystem* jobSystem = nullptr);
+
+		// Returns irradiance / PI for the given normal, matching the values of a convolved irradiance map.
+		static Vector3 EvaluateIrradiance(const SHCoefficients& sh, const Vector3& normal);
+
+		// Fills 6 RGB float faces in GL cubemap face order with the evaluated irradiance.
+		static void GenerateIrradianceCubemap(const SHCoefficients& sh, int32 faceSize, std::vector<std::vector<float>>& faces);
+
+		// Returns the direction through the center of a cubemap texel in GL face order.
+		static Vector3 GetCubemapDirection(uint32 face, int32 x, int32 y, int32 faceSize);
+
+		// Evaluates the 9 basis functions for a normalized direction.
+		static void EvaluateBasis(const Vector3& dir, float basis[9]);
+	};
+}
+
+#endif
@@ -43,6 +43,7 @@ Timestamp: 1/7/2019 1:55:47 PM
 
 #include "Rendering/RenderingCommon.hpp"
 #include "Core/Common.hpp"
+#include "Core/PoolAllocator.hpp"
 #include "PackageManager/PAMRenderDevice.hpp"
 #include "Sampler.hpp"
 
@@ -50,9 +51,12 @@ namespace LinaEngine::Graphics
 {
 	class ArrayBitmap;
 	class DDSTexture;
+	struct MipLevel;
 
 	class Texture
 	{
+		// Textures are created & destroyed one by one as resources stream in.
+		LINA_POOLED_CLASS(Texture, Graphics)
 
 	public:
 
@@ -60,12 +64,16 @@ namespace LinaEngine::Graphics
 		~Texture();
 
 		Texture& Construct(RenderDevice& deviceIn, const class ArrayBitmap& data, SamplerParameters samplerParams, bool shouldCompress, const std::string& path = "");
+		Texture& ConstructMipmapped(RenderDevice& deviceIn, const class ArrayBitmap& data, const std::vector<MipLevel>& mipLevels, SamplerParameters samplerParams, bool shouldCompress, const std::string& path = "");
 		Texture& ConstructCubemap(RenderDevice& deviceIn, SamplerParameters samplerParams, const std::vector<class ArrayBitmap*>& data, bool compress, const std::string& path = "");
 		Texture& ConstructHDRI(RenderDevice& deviceIn, SamplerParameters samplerParams, Vector2 size, float* data, const std::string& path = "");
+		Texture& ConstructCubemapHDRI(RenderDevice& deviceIn, SamplerParameters samplerParams, Vector2 size, const std::vector<float*>& data, uint32 mipCount = 1, const std::string& path = "");
 		Texture& ConstructRTCubemapTexture(RenderDevice& deviceIn, Vector2 size, SamplerParameters samplerParams, const std::string& path = "");
 		Texture& ConstructRTTexture(RenderDevice& deviceIn, Vector2 size, SamplerParameters samplerParams, bool useBorder = false, const std::string& path = "");
 		Texture& ConstructRTTextureMSAA(RenderDevice& deviceIn, Vector2 size, SamplerParameters samplerParams, int sampleCount, const std::string& path = "");
 		Texture& ConstructEmpty(RenderDevice& deviceIn, SamplerParameters samplerParams = SamplerParameters(), const std::string& path = "");
+		// Frees the GPU resources, the texture object stays valid & can be constructed again.
+		void Release();
 		static SamplerParameters LoadParameters(const std::string& path);
 		static void SaveParameters(const std::string& path, SamplerParameters params);
 		uint32 GetID() const { return m_id; };
@@ -77,6 +85,10 @@ namespace LinaEngine::Graphics
 		bool GetIsEmpty() { return m_isEmpty; }
 		const std::string& GetPath() const { return m_path; }
 		const std::string& GetParamsPath() const { return m_paramsPath; }
+		size_t GetMemorySize() const { return m_memorySize; }
+		uint32 GetRefCount() const { return m_refCount; }
+		bool GetIsEvicted() const { return m_isEvicted; }
+		bool GetIsPinned() const { return m_pinCount != 0; }
 
 	private:
 
@@ -93,6 +105,14 @@ namespace LinaEngine::Graphics
 		std::string m_path = "";
 		std::string m_paramsPath = "";
 
+		// Resource management.
+		size_t m_memorySize = 0;
+		uint32 m_refCount = 0;
+		uint32 m_pinCount = 0;
+		uint64 m_lastUsedFrame = 0;
+		bool m_isEvictable = false;
+		bool m_isEvicted = false;
+
 	};
 }
 
@@ -40,6 +40,7 @@ Timestamp: 4/26/2019 12:30:15 AM
 #define VertexArray_HPP
 
 #include "Core/SizeDefinitions.hpp"
+#include "Core/PoolAllocator.hpp"
 #include "RenderingCommon.hpp"
 #include "PackageManager/PAMRenderDevice.hpp"
 #include "IndexedModel.hpp"
@@ -49,6 +50,9 @@ namespace LinaEngine::Graphics
 
 	class VertexArray
 	{
+		// Every sub mesh allocates one.
+		LINA_POOLED_CLASS(VertexArray, Graphics)
+
 	public:
 
 		VertexArray() : m_engineBoundID(0), m_IndexCount(0), m_renderDevice(nullptr) {};
@@ -79,6 +83,11 @@ namespace LinaEngine::Graphics
 			return m_IndexCount;  
 		}
 
+		uintptr GetMemorySize() const
+		{
+			return m_renderDevice == nullptr ? 0 : m_renderDevice->GetVertexArrayMemorySize(m_engineBoundID);
+		}
+
 	private:
 
 		RenderDevice* m_renderDevice = nullptr;
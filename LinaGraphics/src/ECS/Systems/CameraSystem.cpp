@@ -34,6 +34,17 @@ SOFTWARE.
 
 namespace LinaEngine::ECS
 {
+	void CameraSystem::Construct(ECSRegistry& registry)
+	{
+		BaseECSSystem::Construct(registry);
+
+		// Other systems read the active camera data.
+		SetName("CameraSystem");
+		ReadsComponent<TransformComponent>();
+		ReadsComponent<CameraComponent>();
+		WritesResource<CameraSystem>();
+	}
+
 
 	void CameraSystem::UpdateComponents(float delta)
 	{
@@ -67,7 +78,9 @@ namespace LinaEngine::ECS
 			m_currentCameraTransform = &transform;
 			
 			// Actual camera view matrix.
-			m_view = Matrix::InitLookAt(transform.transform.m_location, transform.transform.m_location + transform.transform.m_rotation.GetForward(), transform.transform.m_rotation.GetUp());
+			const Vector3 location = transform.GetWorldLocation();
+			const Quaternion rotation = transform.GetWorldRotation();
+			m_view = Matrix::InitLookAt(location, location + rotation.GetForward(), rotation.GetUp());
 
 			// Update projection matrix.
 			m_projection = Matrix::Perspective(camera.m_fieldOfView / 2, m_aspectRatio, camera.m_zNear, camera.m_zFar);		
@@ -77,14 +90,15 @@ namespace LinaEngine::ECS
 
 	Vector3 CameraSystem::GetCameraLocation()
 	{
-		return (m_currentCameraComponent == nullptr || m_currentCameraTransform == nullptr)? Vector3(Vector3::Zero): m_currentCameraTransform->transform.m_location;
+		return (m_currentCameraComponent == nullptr || m_currentCameraTransform == nullptr)? Vector3(Vector3::Zero): m_currentCameraTransform->GetWorldLocation();
 	}
 
 	Matrix CameraSystem::GetLightMatrix(DirectionalLightComponent* c)
 	{
 		if (c == nullptr) return Matrix();
 		Matrix lightProjection = Matrix::Orthographic(c->m_shadowOrthoProjection.x, c->m_shadowOrthoProjection.y, c->m_shadowOrthoProjection.z, c->m_shadowOrthoProjection.w, c->m_shadowZNear, c->m_shadowZFar);;
-		Matrix lightView = Matrix::InitLookAt(m_currentCameraTransform->transform.m_location, m_currentCameraTransform->transform.m_location + m_currentCameraTransform->transform.m_rotation.GetForward().Normalized(), Vector3::Up);
+		const Vector3 location = m_currentCameraTransform->GetWorldLocation();
+		Matrix lightView = Matrix::InitLookAt(location, location + m_currentCameraTransform->GetWorldRotation().GetForward().Normalized(), Vector3::Up);
 		return lightProjection * lightView;
 	}
 
@@ -31,12 +31,28 @@ SOFTWARE.
 
 namespace LinaEngine::ECS
 {
+	void LightingSystem::Construct(ECSRegistry& registry, RenderDevice& rdIn, Graphics::RenderEngine& renderEngineIn)
+	{
+		BaseECSSystem::Construct(registry);
+		m_renderDevice = &rdIn;
+		m_renderEngine = &renderEngineIn;
+
+		m_dirLightColorUniform = SC_DIRECTIONALLIGHT + SC_LIGHTCOLOR;
+		m_dirLightDirectionUniform = SC_DIRECTIONALLIGHT + SC_LIGHTDIRECTION;
+
+		SetName("LightingSystem");
+		ReadsComponent<TransformComponent>();
+		ReadsComponent<DirectionalLightComponent>();
+		ReadsComponent<PointLightComponent>();
+		ReadsComponent<SpotLightComponent>();
+	}
+
 
 	const float DIRLIGHT_DISTANCE_OFFSET = 10;
 
 	void LightingSystem::UpdateComponents(float delta)
 	{
-		// Flush lights every update.
+		// Flush lights every update, the vectors keep their capacity.
 		std::get<0>(m_directionalLight) = nullptr;
 		std::get<1>(m_directionalLight) = nullptr;
 		m_pointLights.clear();
@@ -92,9 +108,9 @@ namespace LinaEngine::ECS
 		DirectionalLightComponent* dirLight = std::get<1>(m_directionalLight);
 		if (dirLightTransform != nullptr && dirLight != nullptr)
 		{
-			Vector3 direction = Vector3::Zero - dirLightTransform->transform.m_location;
-			m_renderDevice->UpdateShaderUniformColor(shaderID, SC_DIRECTIONALLIGHT + SC_LIGHTCOLOR, dirLight->m_color);
-			m_renderDevice->UpdateShaderUniformVector3(shaderID, SC_DIRECTIONALLIGHT + SC_LIGHTDIRECTION, direction.Normalized());
+			Vector3 direction = Vector3::Zero - dirLightTransform->GetWorldLocation();
+			m_renderDevice->UpdateShaderUniformColor(shaderID, m_dirLightColorUniform, dirLight->m_color);
+			m_renderDevice->UpdateShaderUniformVector3(shaderID, m_dirLightDirectionUniform, direction.Normalized());
 			//m_RenderDevice->UpdateShaderUniformVector3(shaderID, SC_DIRECTIONALLIGHT + SC_LIGHTPOSITION, dirLightTransform->transform.location);
 		}
 
@@ -105,8 +121,9 @@ namespace LinaEngine::ECS
 		{
 			TransformComponent* transform = std::get<0>(*it);
 			PointLightComponent* pointLight = std::get<1>(*it);
-			m_renderDevice->UpdateShaderUniformVector3(shaderID, SC_POINTLIGHTS + "[" + std::to_string(currentPointLightCount) + "]" + SC_LIGHTPOSITION, transform->transform.m_location);
-			m_renderDevice->UpdateShaderUniformColor(shaderID, SC_POINTLIGHTS + "[" + std::to_string(currentPointLightCount) + "]" + SC_LIGHTCOLOR, pointLight->m_color);
+			const PointLightUniforms& uniforms = GetPointLightUniforms(currentPointLightCount);
+			m_renderDevice->UpdateShaderUniformVector3(shaderID, uniforms.m_position, transform->GetWorldLocation());
+			m_renderDevice->UpdateShaderUniformColor(shaderID, uniforms.m_color, pointLight->m_color);
 			//m_RenderDevice->UpdateShaderUniformFloat(shaderID, SC_POINTLIGHTS + "[" + std::to_string(currentPointLightCount) + "]" + SC_LIGHTDISTANCE, pointLight->distance);
 			currentPointLightCount++;
 		}
@@ -118,12 +135,13 @@ namespace LinaEngine::ECS
 		{
 			TransformComponent* transform = std::get<0>(*it);
 			SpotLightComponent* spotLight = std::get<1>(*it);
+			const SpotLightUniforms& uniforms = GetSpotLightUniforms(currentSpotLightCount);
 
-			m_renderDevice->UpdateShaderUniformVector3(shaderID, SC_SPOTLIGHTS + "[" + std::to_string(currentSpotLightCount) + "]" + SC_LIGHTPOSITION, transform->transform.m_location);
-			m_renderDevice->UpdateShaderUniformColor(shaderID, SC_SPOTLIGHTS + "[" + std::to_string(currentSpotLightCount) + "]" + SC_LIGHTCOLOR, spotLight->m_color);
-			m_renderDevice->UpdateShaderUniformVector3(shaderID, SC_SPOTLIGHTS + "[" + std::to_string(currentSpotLightCount) + "]" + SC_LIGHTDIRECTION, transform->transform.m_rotation.GetForward());
-			m_renderDevice->UpdateShaderUniformFloat(shaderID, SC_SPOTLIGHTS + "[" + std::to_string(currentSpotLightCount) + "]" + SC_LIGHTCUTOFF, spotLight->m_cutoff);
-			m_renderDevice->UpdateShaderUniformFloat(shaderID, SC_SPOTLIGHTS + "[" + std::to_string(currentSpotLightCount) + "]" + SC_LIGHTOUTERCUTOFF, spotLight->m_outerCutoff);
+			m_renderDevice->UpdateShaderUniformVector3(shaderID, uniforms.m_position, transform->GetWorldLocation());
+			m_renderDevice->UpdateShaderUniformColor(shaderID, uniforms.m_color, spotLight->m_color);
+			m_renderDevice->UpdateShaderUniformVector3(shaderID, uniforms.m_direction, transform->GetWorldRotation().GetForward());
+			m_renderDevice->UpdateShaderUniformFloat(shaderID, uniforms.m_cutoff, spotLight->m_cutoff);
+			m_renderDevice->UpdateShaderUniformFloat(shaderID, uniforms.m_outerCutoff, spotLight->m_outerCutoff);
 			//m_RenderDevice->UpdateShaderUniformFloat(shaderID, SC_SPOTLIGHTS + "[" + std::to_string(currentSpotLightCount) + "]" + SC_LIGHTDISTANCE, spotLight->distance);
 			currentSpotLightCount++;
 		}
@@ -132,6 +150,37 @@ namespace LinaEngine::ECS
 		m_renderEngine->SetCurrentSLightCount(currentSpotLightCount);
 	}
 
+	const LightingSystem::PointLightUniforms& LightingSystem::GetPointLightUniforms(int index)
+	{
+		while (m_pointLightUniforms.size() <= (size_t)index)
+		{
+			std::string prefix = SC_POINTLIGHTS + "[" + std::to_string(m_pointLightUniforms.size()) + "]";
+			PointLightUniforms uniforms;
+			uniforms.m_position = prefix + SC_LIGHTPOSITION;
+			uniforms.m_color = prefix + SC_LIGHTCOLOR;
+			m_pointLightUniforms.push_back(uniforms);
+		}
+
+		return m_pointLightUniforms[index];
+	}
+
+	const LightingSystem::SpotLightUniforms& LightingSystem::GetSpotLightUniforms(int index)
+	{
+		while (m_spotLightUniforms.size() <= (size_t)index)
+		{
+			std::string prefix = SC_SPOTLIGHTS + "[" + std::to_string(m_spotLightUniforms.size()) + "]";
+			SpotLightUniforms uniforms;
+			uniforms.m_position = prefix + SC_LIGHTPOSITION;
+			uniforms.m_color = prefix + SC_LIGHTCOLOR;
+			uniforms.m_direction = prefix + SC_LIGHTDIRECTION;
+			uniforms.m_cutoff = prefix + SC_LIGHTCUTOFF;
+			uniforms.m_outerCutoff = prefix + SC_LIGHTOUTERCUTOFF;
+			m_spotLightUniforms.push_back(uniforms);
+		}
+
+		return m_spotLightUniforms[index];
+	}
+
 	void LightingSystem::ResetLightData()
 	{
 		m_renderEngine->SetCurrentPLightCount(0);
@@ -148,7 +197,7 @@ namespace LinaEngine::ECS
 		if (directionalLightTransform == nullptr || light == nullptr) return Matrix();
 
 		Matrix lightProjection = Matrix::Orthographic(light->m_shadowOrthoProjection.x, light->m_shadowOrthoProjection.y, light->m_shadowOrthoProjection.z, light->m_shadowOrthoProjection.w, light->m_shadowZNear, light->m_shadowZFar);
-		Matrix lightView = Matrix::TransformMatrix(directionalLightTransform->transform.m_location, directionalLightTransform->transform.m_rotation, Vector3::One);
+		Matrix lightView = Matrix::TransformMatrix(directionalLightTransform->GetWorldLocation(), directionalLightTransform->GetWorldRotation(), Vector3::One);
 
 		//Matrix lightView = Matrix::InitRotationFromDirection(directionalLightTransform->transform.rotation.GetForward(), directionalLightTransform->transform.rotation.GetUp());
 		//Matrix lightView = Matrix::InitLookAt(directionalLightTransform == nullptr ? Vector3::Zero : directionalLightTransform->transform.location, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
@@ -173,11 +222,11 @@ namespace LinaEngine::ECS
 		return GetDirectionalLightMatrix() * biasMatrix;
 	}
 
-	Vector3& LightingSystem::GetDirectionalLightPos()
+	Vector3 LightingSystem::GetDirectionalLightPos()
 	{
 		TransformComponent* directionalLightTransform = std::get<0>(m_directionalLight);
 		if (directionalLightTransform == nullptr) return Vector3::Zero;
-		return directionalLightTransform->transform.m_location;
+		return directionalLightTransform->GetWorldLocation();
 	}
 
 	std::vector<Matrix> LightingSystem::GetPointLightMatrices()
@@ -32,15 +32,35 @@ SOFTWARE.
 #include "Rendering/Mesh.hpp"
 #include "Rendering/RenderEngine.hpp"
 #include "Rendering/Material.hpp"
+#include "Utility/Math/MatrixBatch.hpp"
+#include <algorithm>
 
 namespace LinaEngine::ECS
 {
+	void MeshRendererSystem::Construct(ECSRegistry& registry, Graphics::RenderEngine& renderEngineIn, RenderDevice& renderDeviceIn)
+	{
+		BaseECSSystem::Construct(registry);
+		m_renderEngine = &renderEngineIn;
+		m_renderDevice = &renderDeviceIn;
+
+		// Marking meshes as used touches the render engine, the camera location is read for sorting.
+		SetName("MeshRendererSystem");
+		ReadsComponent<TransformComponent>();
+		ReadsComponent<MeshRendererComponent>();
+		ReadsResource<CameraSystem>();
+		WritesResource<Graphics::RenderEngine>();
+	}
+
 
 
 	void MeshRendererSystem::UpdateComponents(float delta)
 	{
 		auto view = m_ecs->view<TransformComponent, MeshRendererComponent>();
 
+		// Last frame's list lives in the arena's other buffer, a fresh one is gathered.
+		m_transparentRenderBatch = FrameVector<TransparentDrawData>();
+		m_transparentBatchSorted = false;
+
 		for (auto entity : view)
 		{
 			MeshRendererComponent& renderer = view.get<MeshRendererComponent>(entity);
@@ -54,20 +74,25 @@ namespace LinaEngine::ECS
 			// We get the materials, then according to their surface types we add the mesh
 			// data into either opaque queue or the transparent queue.
 			Graphics::Material& mat = m_renderEngine->GetMaterial(renderer.m_materialID);
-			Graphics::Mesh& mesh = m_renderEngine->GetMesh(renderer.m_meshID);
+			Graphics::Mesh* mesh = &m_renderEngine->GetMesh(renderer.m_meshID);
+			m_renderEngine->MarkMeshUsed(*mesh);
+
+			// Draw the fallback primitive while the mesh is being imported or reloaded, or if it failed to import.
+			if (mesh->GetVertexArrays().size() == 0)
+				mesh = &m_renderEngine->GetPrimitive(m_renderEngine->GetFallbackPrimitive());
 
 			if (mat.GetSurfaceType() == Graphics::MaterialSurfaceType::Opaque)
 			{
-				for (int i = 0; i < mesh.GetVertexArrays().size(); i++)
-					RenderOpaque(*mesh.GetVertexArray(i), mat, transform.transform.ToMatrix());
+				for (int i = 0; i < mesh->GetVertexArrays().size(); i++)
+					RenderOpaque(*mesh->GetVertexArray(i), mat, transform.m_worldMatrix);
 			}
 			else
 			{
 				// Transparent queue is a priority queue unlike the opaque one, so we set the priority as distance to the camera.
-				float priority = (m_renderEngine->GetCameraSystem()->GetCameraLocation() - transform.transform.m_location).MagnitudeSqrt();
+				float priority = (m_renderEngine->GetCameraSystem()->GetCameraLocation() - transform.GetWorldLocation()).MagnitudeSqrt();
 
-				for (int i = 0; i < mesh.GetVertexArrays().size(); i++)
-					RenderTransparent(*mesh.GetVertexArray(i), mat, transform.transform.ToMatrix(), priority);
+				for (int i = 0; i < mesh->GetVertexArrays().size(); i++)
+					RenderTransparent(*mesh->GetVertexArray(i), mat, transform.m_worldMatrix, priority);
 			}
 		}
 
@@ -81,22 +106,19 @@ namespace LinaEngine::ECS
 		drawData.m_vertexArray = &vertexArray;
 		drawData.m_material = &material;
 		m_opaqueRenderBatch[drawData].m_models.push_back(transformIn);
-		m_opaqueRenderBatch[drawData].m_inverseTransposeModels.push_back(transformIn.Transpose().Inverse());
 	}
 
 	void MeshRendererSystem::RenderTransparent(Graphics::VertexArray& vertexArray, Graphics::Material& material, const Matrix& transformIn,float priority)
 	{
 		// Render commands basically add the necessary
 		// draw data into the maps/lists etc.
-		Graphics::BatchDrawData drawData;
-		drawData.m_vertexArray = &vertexArray;
-		drawData.m_material = &material;
-		drawData.m_distance = priority;
-
-		Graphics::BatchModelData modelData;
-		modelData.m_models.push_back(transformIn);
-		modelData.m_inverseTransposeModels.push_back(transformIn.Transpose().Inverse());
-		m_transparentRenderBatch.emplace(std::make_pair(drawData, modelData));	
+		TransparentDrawData data;
+		data.m_drawData.m_vertexArray = &vertexArray;
+		data.m_drawData.m_material = &material;
+		data.m_drawData.m_distance = priority;
+		data.m_model = transformIn;
+		data.m_inverseTransposeModel = transformIn.ToNormalMatrixAffine();
+		m_transparentRenderBatch.push_back(data);
 	}
 
 	void MeshRendererSystem::FlushOpaque(Graphics::DrawParams& drawParams, Graphics::Material* overrideMaterial, bool completeFlush)
@@ -114,6 +136,14 @@ namespace LinaEngine::ECS
 
 			Graphics::VertexArray* vertexArray = drawData.m_vertexArray;
 			Matrix* models = &modelData.m_models[0];
+
+			// Normal matrices are calculated in one batch, flushes that don't clear the data reuse them.
+			if (modelData.m_inverseTransposeModels.size() != numTransforms)
+			{
+				modelData.m_inverseTransposeModels.resize(numTransforms);
+				MatrixBatch::NormalMatrices(models, &modelData.m_inverseTransposeModels[0], (uint32)numTransforms);
+			}
+
 			Matrix* inverseTransposeModels = &modelData.m_inverseTransposeModels[0];
 
 			// Get the material for drawing, object's own material or overriden material.
@@ -141,41 +171,43 @@ namespace LinaEngine::ECS
 		// When flushed, all the data is delegated to the render device to do the actual
 		// drawing. Then the data is cleared if complete flush is requested.
 
-		// Empty out the queue
-		while (!m_transparentRenderBatch.empty())
+		// Farthest first.
+		if (!m_transparentBatchSorted)
 		{
-			BatchPair pair = m_transparentRenderBatch.top();
-
-			Graphics::BatchDrawData& drawData = std::get<0>(pair);
-			Graphics::BatchModelData& modelData = std::get<1>(pair);
-			size_t numTransforms = modelData.m_models.size();
-			if (numTransforms == 0) continue;
+			std::sort(m_transparentRenderBatch.begin(), m_transparentRenderBatch.end(), TransparentComparison());
+			m_transparentBatchSorted = true;
+		}
 
-			Graphics::VertexArray* vertexArray = drawData.m_vertexArray;
-			Matrix* models = &modelData.m_models[0];
-			Matrix* inverseTransposeModels = &modelData.m_inverseTransposeModels[0];
+		for (TransparentDrawData& data : m_transparentRenderBatch)
+		{
+			Graphics::VertexArray* vertexArray = data.m_drawData.m_vertexArray;
 
 			// Get the material for drawing, object's own material or overriden material.
-			Graphics::Material* mat = overrideMaterial == nullptr ? drawData.m_material : overrideMaterial;
+			Graphics::Material* mat = overrideMaterial == nullptr ? data.m_drawData.m_material : overrideMaterial;
 
 			// Draw call.
 			// Update the buffer w/ each transform.
-			vertexArray->UpdateBuffer(5, models, numTransforms * sizeof(Matrix));
-			vertexArray->UpdateBuffer(6, inverseTransposeModels, numTransforms * sizeof(Matrix));
+			vertexArray->UpdateBuffer(5, &data.m_model, sizeof(Matrix));
+			vertexArray->UpdateBuffer(6, &data.m_inverseTransposeModel, sizeof(Matrix));
 
 			m_renderEngine->UpdateShaderData(mat);
-			m_renderDevice->Draw(vertexArray->GetID(), drawParams, numTransforms, vertexArray->GetIndexCount(), false);
+			m_renderDevice->Draw(vertexArray->GetID(), drawParams, 1, vertexArray->GetIndexCount(), false);
+		}
 
-			// Clear the buffer.
-			if (completeFlush)
-			{
-				modelData.m_models.clear();
-				modelData.m_inverseTransposeModels.clear();
-			}
+		// Clear the buffer, the memory is released along with the frame.
+		if (completeFlush)
+			m_transparentRenderBatch = FrameVector<TransparentDrawData>();
+	}
 
-			m_transparentRenderBatch.pop();
+	void MeshRendererSystem::ClearBatches()
+	{
+		for (std::map<Graphics::BatchDrawData, Graphics::BatchModelData>::iterator it = m_opaqueRenderBatch.begin(); it != m_opaqueRenderBatch.end(); ++it)
+		{
+			it->second.m_models.clear();
+			it->second.m_inverseTransposeModels.clear();
 		}
-		
-	}
 
-}
\ No newline at end of file
+		m_transparentRenderBatch = FrameVector<TransparentDrawData>();
+		m_transparentBatchSorted = false;
+	}
+}
@@ -30,6 +30,7 @@ SOFTWARE.
 #include "ECS/Components/TransformComponent.hpp"
 #include "ECS/Components/SpriteRendererComponent.hpp"
 #include "Rendering/RenderEngine.hpp"
+#include "Utility/Math/MatrixBatch.hpp"
 
 namespace LinaEngine::ECS
 {
@@ -40,6 +41,11 @@ namespace LinaEngine::ECS
 		m_renderDevice = &renderDeviceIn;
 		Graphics::ModelLoader::LoadQuad(m_quadModel);
 		m_spriteVertexArray.Construct(*m_renderDevice, m_quadModel, Graphics::BufferUsage::USAGE_STATIC_COPY);
+
+		SetName("SpriteRendererSystem");
+		ReadsComponent<TransformComponent>();
+		ReadsComponent<SpriteRendererComponent>();
+		ReadsResource<Graphics::RenderEngine>();
 	}
 
 	void SpriteRendererSystem::UpdateComponents(float delta)
@@ -58,14 +64,13 @@ namespace LinaEngine::ECS
 			if (renderer.m_materialID < 0) continue;
 
 			Graphics::Material& mat = m_renderEngine->GetMaterial(renderer.m_materialID);
-			Render(mat, transform.transform.ToMatrix());
+			Render(mat, transform.m_worldMatrix);
 		}
 	}
 
 	void SpriteRendererSystem::Render(Graphics::Material& material, const Matrix& transformIn)
 	{
 		m_renderBatch[&material].m_models.push_back(transformIn);
-		m_renderBatch[&material].m_inverseTransposeModels.push_back(transformIn.Transpose().Inverse());
 	}
 
 	void SpriteRendererSystem::Flush(Graphics::DrawParams& drawParams, Graphics::Material* overrideMaterial, bool completeFlush)
@@ -81,6 +86,14 @@ namespace LinaEngine::ECS
 			if (numTransforms == 0) continue;
 
 			Matrix* models = &modelData.m_models[0];
+
+			// Normal matrices are calculated in one batch, flushes that don't clear the data reuse them.
+			if (modelData.m_inverseTransposeModels.size() != numTransforms)
+			{
+				modelData.m_inverseTransposeModels.resize(numTransforms);
+				MatrixBatch::NormalMatrices(models, &modelData.m_inverseTransposeModels[0], (uint32)numTransforms);
+			}
+
 			Matrix* inverseTransposeModels = &modelData.m_inverseTransposeModels[0];
 
 			// Get the material for drawing, object's own material or overriden material.
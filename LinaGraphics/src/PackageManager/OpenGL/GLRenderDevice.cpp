@@ -281,6 +281,36 @@ namespace LinaEngine::Graphics
 		return textureHandle;
 	}
 
+	uint32 GLRenderDevice::CreateTexture2DMipmapped(Vector2 size, const std::vector<const void*>& levels, SamplerParameters samplerParams, bool compress)
+	{
+		// Declare formats, target & handle for the texture.
+		GLint format = GetOpenGLFormat(samplerParams.m_textureParams.m_pixelFormat);
+		GLint internalFormat = GetOpenGLInternalFormat(samplerParams.m_textureParams.m_internalPixelFormat, compress);
+		GLenum textureTarget = GL_TEXTURE_2D;
+		GLuint textureHandle;
+
+		// Generate texture & bind to program.
+		glGenTextures(1, &textureHandle);
+		glBindTexture(textureTarget, textureHandle);
+
+		// Upload every level, no driver side generation needed.
+		for (GLint level = 0; level < (GLint)levels.size(); level++)
+		{
+			GLsizei levelWidth = std::max(1, (int)size.x >> level);
+			GLsizei levelHeight = std::max(1, (int)size.y >> level);
+			glTexImage2D(textureTarget, level, internalFormat, levelWidth, levelHeight, 0, format, GL_UNSIGNED_BYTE, levels[level]);
+		}
+
+		// OpenGL texture params.
+		SetupTextureParameters(textureTarget, samplerParams);
+		glTexParameteri(textureTarget, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(textureTarget, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+
+		glBindTexture(textureTarget, 0);
+
+		return textureHandle;
+	}
+
 	uint32 GLRenderDevice::CreateTextureHDRI(Vector2 size, float* data, SamplerParameters samplerParams)
 	{
 		// Declare formats, target & handle for the texture.
@@ -376,6 +406,33 @@ namespace LinaEngine::Graphics
 		return textureHandle;
 	}
 
+	uint32 GLRenderDevice::CreateCubemapTextureHDRI(Vector2 size, SamplerParameters samplerParams, const std::vector<float*>& data, uint32 mipCount)
+	{
+		GLuint textureHandle;
+		// Declare formats, target & handle for the texture.
+		GLint format = GetOpenGLFormat(samplerParams.m_textureParams.m_pixelFormat);
+		GLint internalFormat = GetOpenGLInternalFormat(samplerParams.m_textureParams.m_internalPixelFormat, false);
+
+		// Generate texture & bind to program.
+		glGenTextures(1, &textureHandle);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, textureHandle);
+
+		// Loop through each mip & face to upload the data.
+		for (GLuint mip = 0; mip < mipCount; mip++)
+		{
+			GLsizei mipWidth = std::max(1, (int)size.x >> mip);
+			GLsizei mipHeight = std::max(1, (int)size.y >> mip);
+
+			for (GLuint i = 0; i < 6; i++)
+				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, internalFormat, mipWidth, mipHeight, 0, format, GL_FLOAT, data[mip * 6 + i]);
+		}
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		return textureHandle;
+	}
+
 	uint32 GLRenderDevice::CreateTexture2DMSAA(Vector2 size, SamplerParameters samplerParams, int sampleCount)
 	{
 		// Declare formats, target & handle for the texture.
@@ -610,6 +667,18 @@ namespace LinaEngine::Graphics
 		return 0;
 	}
 
+	uintptr GLRenderDevice::GetVertexArrayMemorySize(uint32 vao) const
+	{
+		std::map<uint32, VertexArrayData>::const_iterator it = m_vaoMap.find(vao);
+		if (it == m_vaoMap.end()) return 0;
+
+		uintptr memorySize = 0;
+		for (uint32 i = 0; i < it->second.numBuffers; i++)
+			memorySize += it->second.bufferSizes[i];
+
+		return memorySize;
+	}
+
 	uint32 GLRenderDevice::CreateSkyboxVertexArray()
 	{
 		unsigned int skyboxVAO, skyboxVBO;
@@ -947,6 +1016,16 @@ namespace LinaEngine::Graphics
 		glGenerateMipmap(bindMode);
 	}
 
+	void GLRenderDevice::GetTextureDataFloat(uint32 texture, TextureBindMode bindMode, uint32 face, uint32 mipLevel, PixelFormat format, float* data)
+	{
+		GLenum target = bindMode == TextureBindMode::BINDTEXTURE_CUBEMAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : (GLenum)bindMode;
+		glBindTexture(bindMode, texture);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glGetTexImage(target, mipLevel, GetOpenGLFormat(format), GL_FLOAT, data);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindTexture(bindMode, 0);
+	}
+
 	void GLRenderDevice::BlitFrameBuffers(uint32 readFBO, uint32 readWidth, uint32 readHeight, uint32 writeFBO, uint32 writeWidth, uint32 writeHeight, BufferBit mask, SamplerFilter filter)
 	{
 		if (m_boundReadFBO != readFBO)
@@ -1166,6 +1245,7 @@ namespace LinaEngine::Graphics
 				glDrawElementsInstanced(drawParams.primitiveType, (GLsizei)numElements, GL_UNSIGNED_INT, 0, numInstances);
 		}
 
+		m_drawCallCount++;
 
 	}
 
@@ -1174,6 +1254,7 @@ namespace LinaEngine::Graphics
 		// This function requires you to set model matrix in the debuglines shader.
 		glLineWidth(width);
 		glDrawArrays(GL_LINES, 0, 2);
+		m_drawCallCount++;
 	}
 
 	void GLRenderDevice::DrawLine(uint32 shader, const Matrix& model, const Vector3& from, const Vector3& to, float width)
@@ -1206,6 +1287,7 @@ namespace LinaEngine::Graphics
 		glBindVertexArray(vao);
 		glDrawArrays(GL_LINES, 0, 2);
 		glBindVertexArray(0);
+		m_drawCallCount++;
 
 		//delete buffers
 		glDeleteVertexArrays(1, &vao);
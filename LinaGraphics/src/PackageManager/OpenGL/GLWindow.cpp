@@ -81,6 +81,7 @@ namespace LinaEngine::Graphics
 		glfwWindowHint(GLFW_SAMPLES, 4);
 		glfwWindowHint(GLFW_DECORATED, m_windowProperties.m_decorated);
 		glfwWindowHint(GLFW_RESIZABLE, m_windowProperties.m_resizable);
+		glfwWindowHint(GLFW_VISIBLE, m_windowProperties.m_visible);
 
 		if (propsIn.m_windowState == WindowState::Iconified)
 			glfwWindowHint(GLFW_ICONIFIED, GLFW_TRUE);
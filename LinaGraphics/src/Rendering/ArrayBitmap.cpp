@@ -26,17 +26,22 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#define STB_IMAGE_IMPLEMENTATION 
 #include "Rendering/ArrayBitmap.hpp"  
-#include "Utility/stb/stb_image.h"
 #include "PackageManager/PAMMemory.hpp"
 
+// Decoded buffers come from the engine allocator so bitmaps can adopt them as they are.
+#define STBI_MALLOC(size) Memory::malloc(size, Memory::DefaultAlignment, LinaEngine::MemorySubsystem::Graphics)
+#define STBI_REALLOC(ptr, size) Memory::realloc(ptr, size, Memory::DefaultAlignment, LinaEngine::MemorySubsystem::Graphics)
+#define STBI_FREE(ptr) Memory::free(ptr)
+#define STB_IMAGE_IMPLEMENTATION 
+#include "Utility/stb/stb_image.h"
+
 namespace LinaEngine::Graphics
 {
 	ArrayBitmap::ArrayBitmap(int32 widthIn, int32 heightIn) : m_width(widthIn), m_heigth(heightIn)
 	{
 		LINA_CORE_ASSERT(m_width > 0 && m_heigth > 0, " Can not construct bitmap! Width & height must be bigger than 0! Width: {0}, Height: {1} ", m_width, m_heigth);
-		m_pixels = (int32*)Memory::malloc(GetPixelsSize());
+		m_pixels = (int32*)Memory::malloc(GetPixelsSize(), Memory::DefaultAlignment, MemorySubsystem::Graphics);
 	}
 
 	ArrayBitmap::ArrayBitmap(int32 widthIn, int32 heightIn, int32* pixelsIn) : m_width(widthIn), m_heigth(heightIn)
@@ -44,7 +49,7 @@ namespace LinaEngine::Graphics
 		LINA_CORE_ASSERT(m_width > 0 && m_heigth > 0, " Can not construct bitmap! Width & height must be bigger than 0! Width: {0}, Height: {1} ", m_width, m_heigth);
 		LINA_CORE_ASSERT(pixelsIn == nullptr, " Can not construct bitmap! Pixels are null");
 		uintptr size = GetPixelsSize();
-		m_pixels = (int32*)Memory::malloc(size);
+		m_pixels = (int32*)Memory::malloc(size, Memory::DefaultAlignment, MemorySubsystem::Graphics);
 		Memory::memcpy(m_pixels, pixelsIn, size);
 	}
 
@@ -55,7 +60,7 @@ namespace LinaEngine::Graphics
 		LINA_CORE_ASSERT(offsetX > 0 && offsetY > 0 && rowOffset > 0, "Can not construct bitmap, offsets are not right! X: {0}, Y: {1}, Row: {2}", offsetX, offsetY, rowOffset);
 
 		uintptr size = GetPixelsSize();
-		m_pixels = (int32*)Memory::malloc(size);
+		m_pixels = (int32*)Memory::malloc(size, Memory::DefaultAlignment, MemorySubsystem::Graphics);
 		int32* pixelsSrc = pixelsIn + offsetY + offsetX * rowOffset;
 
 		for (uintptr i = 0; i < (uintptr)m_heigth;
@@ -69,6 +74,42 @@ namespace LinaEngine::Graphics
 		m_pixels = (int32*)Memory::free(m_pixels);
 	}
 
+	ArrayBitmap::ArrayBitmap(ArrayBitmap&& other) noexcept : m_width(other.m_width), m_heigth(other.m_heigth), m_pixels(other.m_pixels)
+	{
+		other.m_width = other.m_heigth = 0;
+		other.m_pixels = nullptr;
+	}
+
+	ArrayBitmap& ArrayBitmap::operator=(ArrayBitmap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Adopt(other.m_width, other.m_heigth, other.m_pixels);
+			other.m_width = other.m_heigth = 0;
+			other.m_pixels = nullptr;
+		}
+
+		return *this;
+	}
+
+	void ArrayBitmap::Adopt(int32 width, int32 height, int32* pixels)
+	{
+		if (m_pixels != pixels)
+			Memory::free(m_pixels);
+
+		m_width = width;
+		m_heigth = height;
+		m_pixels = pixels;
+	}
+
+	int32* ArrayBitmap::Release()
+	{
+		int32* pixels = m_pixels;
+		m_width = m_heigth = 0;
+		m_pixels = nullptr;
+		return pixels;
+	}
+
 	int ArrayBitmap::Load(const std::string& fileName)
 	{
 		int32 texWidth, texHeight, nrComps;
@@ -80,18 +121,8 @@ namespace LinaEngine::Graphics
 			return -1;
 		}
 
-		if (texWidth == m_width && texHeight == m_heigth) {
-			Memory::memcpy(m_pixels, data, GetPixelsSize());
-		}
-		else {
-			m_width = texWidth;
-			m_heigth = texHeight;
-			m_pixels = (int32*)Memory::free(m_pixels);
-			m_pixels = (int32*)Memory::malloc(GetPixelsSize());
-			Memory::memcpy(m_pixels, data, GetPixelsSize());
-		}
-
-		stbi_image_free(data);
+		// Decoder output is allocated by Memory, take it over instead of copying.
+		Adopt(texWidth, texHeight, (int32*)data);
 		return nrComps;
 	}
 
@@ -117,6 +148,11 @@ namespace LinaEngine::Graphics
 		return stbi_loadf(fileName, &w, &h, &nrChannels, 0);
 	}
 
+	void ArrayBitmap::FreeImmediate(void* data)
+	{
+		stbi_image_free(data);
+	}
+
 	void ArrayBitmap::Clear(int32 color)
 	{
 		Memory::memset(m_pixels, color, GetPixelsSize());
@@ -0,0 +1,88 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: HDRICache
+
+Timestamp: 10/31/2020 5:02:40 PM
+*/
+
+#include "Rendering/HDRICache.hpp"
+#include "Utility/Log.hpp"
+#include <cereal/archives/binary.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace LinaEngine::Graphics
+{
+	bool HDRICache::Load(const std::string& path, HDRICache& cache)
+	{
+		std::ifstream stream(path, std::ios::binary);
+
+		if (!stream)
+			return false;
+
+		try
+		{
+			cereal::BinaryInputArchive iarchive(stream);
+			iarchive(cache);
+		}
+		catch (const std::exception& e)
+		{
+			LINA_CORE_WARN("HDRI cache {0} could not be read, it will be regenerated. {1}", path, e.what());
+			return false;
+		}
+
+		return cache.m_version == HDRI_CACHE_VERSION;
+	}
+
+	void HDRICache::Save(const std::string& path, const HDRICache& cache)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+		std::ofstream stream(path, std::ios::binary);
+
+		if (!stream)
+		{
+			LINA_CORE_WARN("HDRI cache {0} could not be written.", path);
+			return;
+		}
+
+		cereal::BinaryOutputArchive oarchive(stream);
+		oarchive(cache);
+	}
+
+	std::string HDRICache::GetCachePath(unsigned long long sourceHash)
+	{
+		std::stringstream ss;
+		ss << HDRI_CACHE_FOLDER << std::hex << std::setw(16) << std::setfill('0') << sourceHash << ".ibl";
+		return ss.str();
+	}
+}
@@ -118,5 +118,15 @@ namespace LinaEngine::Graphics
 
 		return renderDevice.CreateVertexArray(vertexData, vertexElementSizes, vertexElementTypes, numVertexComponents, numInstanceComponents, numVertices, &m_indices[0], numIndices, bufferUsage);
 	}
+
+	size_t IndexedModel::GetMemorySize() const
+	{
+		size_t memorySize = m_indices.size() * sizeof(uint32);
+
+		for (uint32 i = 0; i < m_elements.size(); i++)
+			memorySize += m_elements[i].size() * sizeof(float);
+
+		return memorySize;
+	}
 }
 
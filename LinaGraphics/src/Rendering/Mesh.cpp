@@ -45,6 +45,48 @@ namespace LinaEngine::Graphics
 		m_materialIndexArray.clear();
 	}
 
+	size_t Mesh::GetMemorySize()
+	{
+		size_t memorySize = 0;
+
+		for (uint32 i = 0; i < m_indexedModelArray.size(); i++)
+			memorySize += m_indexedModelArray[i].GetMemorySize();
+
+		return memorySize;
+	}
+
+	size_t Mesh::GetGPUMemorySize() const
+	{
+		size_t memorySize = 0;
+
+		for (uint32 i = 0; i < m_vertexArrays.size(); i++)
+			memorySize += m_vertexArrays[i]->GetMemorySize();
+
+		return memorySize;
+	}
+
+	void Mesh::CalculateLocalBounds()
+	{
+		bool found = false;
+
+		for (uint32 i = 0; i < m_indexedModelArray.size(); i++)
+		{
+			// First element is always the positions.
+			std::vector<std::vector<float>>& elements = m_indexedModelArray[i].GetElements();
+			if (elements.empty())
+				continue;
+
+			const std::vector<float>& positions = elements[0];
+
+			for (size_t j = 0; j + 2 < positions.size(); j += 3)
+			{
+				const glm::vec3 position = glm::vec3(positions[j], positions[j + 1], positions[j + 2]);
+				m_localBounds = found ? AABB::Merge(m_localBounds, AABB(position, position)) : AABB(position, position);
+				found = true;
+			}
+		}
+	}
+
 	MeshParameters Mesh::LoadParameters(const std::string& path)
 	{
 		MeshParameters params;
@@ -0,0 +1,141 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: MipmapGenerator
+
+Timestamp: 11/1/2020 1:46:22 PM
+*/
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "Rendering/MipmapGenerator.hpp"
+#include "Core/JobSystem.hpp"
+#include "Utility/stb/stb_image_resize.h"
+#include <algorithm>
+#include <functional>
+
+namespace LinaEngine::Graphics
+{
+	// Output rows per job, smaller levels are resized as a single job.
+	#define MIP_BAND_ROWS 64
+
+	// Resizes the given output rows, the region maps them back onto the whole source so
+	// filter taps crossing band borders read the real neighbors & bands are seamless.
+	static void ResizeBand(const uint8* src, int32 srcWidth, int32 srcHeight, MipLevel& dst, int32 rowBegin, int32 rowEnd, int32 channels, bool isSRGB, bool wrap)
+	{
+		const float t0 = (float)rowBegin / (float)dst.m_height;
+		const float t1 = (float)rowEnd / (float)dst.m_height;
+		const stbir_edge edge = wrap ? STBIR_EDGE_WRAP : STBIR_EDGE_CLAMP;
+		const int alphaChannel = channels == 4 ? 3 : STBIR_ALPHA_CHANNEL_NONE;
+		uint8* output = dst.m_pixels.data() + (size_t)rowBegin * dst.m_width * channels;
+
+		stbir_resize_region(src, srcWidth, srcHeight, srcWidth * channels, output, dst.m_width, rowEnd - rowBegin, dst.m_width * channels,
+			STBIR_TYPE_UINT8, channels, alphaChannel, 0, edge, edge, STBIR_FILTER_DEFAULT, STBIR_FILTER_DEFAULT,
+			isSRGB ? STBIR_COLORSPACE_SRGB : STBIR_COLORSPACE_LINEAR, nullptr, 0.0f, t0, 1.0f, t1);
+	}
+
+	static void RunJobs(const std::vector<std::function<void()>>& jobs, JobSystem* jobSystem)
+	{
+		if (jobSystem == nullptr || jobSystem->GetWorkerCount() == 0 || jobs.size() == 1)
+		{
+			for (const std::function<void()>& job : jobs)
+				job();
+
+			return;
+		}
+
+		JobCounter counter;
+
+		for (const std::function<void()>& job : jobs)
+			jobSystem->Run(job, &counter);
+
+		jobSystem->Wait(counter);
+	}
+
+	uint32 MipmapGenerator::GetMipCount(int32 width, int32 height)
+	{
+		uint32 count = 1;
+		int32 size = std::max(width, height);
+
+		while (size > 1)
+		{
+			size >>= 1;
+			count++;
+		}
+
+		return count;
+	}
+
+	void MipmapGenerator::Generate(const uint8* pixels, int32 width, int32 height, int32 channels, bool isSRGB, bool wrap, std::vector<MipLevel>& outLevels, JobSystem* jobSystem)
+	{
+		std::vector<std::vector<MipLevel>> levels;
+		GenerateBatch({ pixels }, width, height, channels, isSRGB, wrap, levels, jobSystem);
+		outLevels = std::move(levels[0]);
+	}
+
+	void MipmapGenerator::GenerateBatch(const std::vector<const uint8*>& images, int32 width, int32 height, int32 channels, bool isSRGB, bool wrap, std::vector<std::vector<MipLevel>>& outLevels, JobSystem* jobSystem)
+	{
+		const uint32 levelCount = GetMipCount(width, height) - 1;
+		outLevels.clear();
+		outLevels.resize(images.size());
+
+		for (std::vector<MipLevel>& levels : outLevels)
+			levels.resize(levelCount);
+
+		// Levels depend on the previous one, images & row bands within a level are independent.
+		std::vector<std::function<void()>> jobs;
+
+		for (uint32 level = 0; level < levelCount; level++)
+		{
+			const int32 srcWidth = std::max(1, width >> level);
+			const int32 srcHeight = std::max(1, height >> level);
+			const int32 dstWidth = std::max(1, width >> (level + 1));
+			const int32 dstHeight = std::max(1, height >> (level + 1));
+			jobs.clear();
+
+			for (size_t image = 0; image < images.size(); image++)
+			{
+				const uint8* src = level == 0 ? images[image] : outLevels[image][level - 1].m_pixels.data();
+				MipLevel& dst = outLevels[image][level];
+				dst.m_width = dstWidth;
+				dst.m_height = dstHeight;
+				dst.m_pixels.resize((size_t)dstWidth * dstHeight * channels);
+
+				for (int32 row = 0; row < dstHeight; row += MIP_BAND_ROWS)
+				{
+					const int32 rowEnd = std::min(dstHeight, row + MIP_BAND_ROWS);
+					jobs.push_back([src, srcWidth, srcHeight, &dst, row, rowEnd, channels, isSRGB, wrap]()
+						{
+							ResizeBand(src, srcWidth, srcHeight, dst, row, rowEnd, channels, isSRGB, wrap);
+						});
+				}
+			}
+
+			RunJobs(jobs, jobSystem);
+		}
+	}
+}
@@ -32,10 +32,17 @@ SOFTWARE.
 #include "Rendering/RenderConstants.hpp"
 #include "Rendering/Shader.hpp"
 #include "Rendering/ArrayBitmap.hpp"
+#include "Rendering/SphericalHarmonics.hpp"
+#include "Rendering/HDRICache.hpp"
 #include "ECS/Components/CameraComponent.hpp"
+#include "ECS/Components/MeshRendererComponent.hpp"
+#include "ECS/Components/SpriteRendererComponent.hpp"
 #include "ECS/ECS.hpp"
 #include "Utility/UtilityFunctions.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "Core/Profiler.hpp"
 #include "PackageManager/OpenGL/GLRenderDevice.hpp"
+#include <algorithm>
 
 
 namespace LinaEngine::Graphics
@@ -53,6 +60,8 @@ namespace LinaEngine::Graphics
 	constexpr int UNIFORMBUFFER_DEBUGDATA_BINDPOINT = 2;
 	constexpr auto UNIFORMBUFFER_DEBUGDATA_NAME = "DebugData";
 
+	constexpr uint64 MEMORY_CHECK_INTERVAL = 60;
+
 	RenderEngine::RenderEngine()
 	{
 		LINA_CORE_TRACE("[Constructor] -> RenderEngine ({0})", typeid(*this).name());
@@ -60,6 +69,44 @@ namespace LinaEngine::Graphics
 
 	RenderEngine::~RenderEngine()
 	{
+		m_renderableBVH.Shutdown();
+
+		// Wait for decoding, then release the textures that never made it to the GPU. The application shuts the job
+		// system down first, which already finishes them.
+		if (m_jobSystem != nullptr && m_jobSystem->GetIsInitialized())
+			m_jobSystem->Wait(m_asyncLoadCounter);
+
+		while (!m_completedTextures.empty())
+		{
+			delete m_completedTextures.front();
+			m_completedTextures.pop();
+		}
+
+		for (std::map<std::string, Texture*>::iterator it = m_pendingTextures.begin(); it != m_pendingTextures.end(); it++)
+			delete it->second;
+
+		m_pendingTextures.clear();
+
+		for (std::map<std::string, Texture*>::iterator it = m_evictedTextures.begin(); it != m_evictedTextures.end(); it++)
+			delete it->second;
+
+		m_evictedTextures.clear();
+
+		while (!m_completedMeshes.empty())
+		{
+			m_meshUploads.push(m_completedMeshes.front());
+			m_completedMeshes.pop();
+		}
+
+		while (!m_meshUploads.empty())
+		{
+			for (uint32 i = 0; i < m_meshUploads.front()->m_vertexArrays.size(); i++)
+				delete m_meshUploads.front()->m_vertexArrays[i];
+
+			delete m_meshUploads.front();
+			m_meshUploads.pop();
+		}
+
 		// Delete textures.
 		for (std::map<int, Texture*>::iterator it = m_loadedTextures.begin(); it != m_loadedTextures.end(); it++)
 			delete it->second;
@@ -76,10 +123,12 @@ namespace LinaEngine::Graphics
 		LINA_CORE_TRACE("[Destructor] -> RenderEngine ({0})", typeid(*this).name());
 	}
 
-	void RenderEngine::Initialize(LinaEngine::ECS::ECSRegistry& ecsReg, Window& appWindow)
+	void RenderEngine::Initialize(LinaEngine::ECS::ECSRegistry& ecsReg, Window& appWindow, JobSystem& jobSystem)
 	{
 		// Set references.
 		m_appWindow = &appWindow;
+		m_ecs = &ecsReg;
+		m_jobSystem = &jobSystem;
 
 		// Flip loaded images.
 		ArrayBitmap::SetImageFlip(true);
@@ -141,6 +190,9 @@ namespace LinaEngine::Graphics
 		m_renderingPipeline.AddSystem(m_spriteRendererSystem);
 		m_renderingPipeline.AddSystem(m_lightingSystem);
 
+		// Spatial index over the mesh & sprite renderers.
+		m_renderableBVH.Initialize(ecsReg, *this);
+
 		// Set debug values.
 		m_debugData.visualizeDepth = false;
 
@@ -150,7 +202,10 @@ namespace LinaEngine::Graphics
 	{
 		// DrawShadows();
 
-		Draw();
+		{
+			LINA_PROFILE_SCOPE("Draw Scene");
+			Draw();
+		}
 
 		if (!m_firstFrameDrawn)
 		{
@@ -158,12 +213,27 @@ namespace LinaEngine::Graphics
 			m_firstFrameDrawn = true;
 		}
 
+		// Check the resource budgets every now and then.
+		m_frameIndex++;
+		if (m_frameIndex % MEMORY_CHECK_INTERVAL == 0)
+		{
+			UpdateMemoryStats();
+
+			bool overCPUBudget = m_cpuMemoryBudget != 0 && m_textureMemoryStats.m_cpuBytes + m_meshMemoryStats.m_cpuBytes + m_materialMemoryStats.m_cpuBytes > m_cpuMemoryBudget;
+			bool overGPUBudget = m_gpuMemoryBudget != 0 && m_textureMemoryStats.m_gpuBytes + m_meshMemoryStats.m_gpuBytes > m_gpuMemoryBudget;
+
+			if (overCPUBudget || overGPUBudget)
+				EvictUnusedResources();
+		}
+
 		//DrawOperationsDefault();
 
 	}
 
 	void RenderEngine::RenderLayers()
 	{
+		LINA_PROFILE_SCOPE("Render Layers");
+
 		// Draw GUI Layers
 		for (Layer* layer : m_guiLayerStack)
 			layer->Render();
@@ -171,6 +241,8 @@ namespace LinaEngine::Graphics
 
 	void RenderEngine::Swap()
 	{
+		m_frameDrawCalls = m_renderDevice.GetDrawCallCount();
+		m_renderDevice.ResetDrawCallCount();
 
 		// Update window.
 		m_appWindow->Tick();
@@ -197,12 +269,13 @@ namespace LinaEngine::Graphics
 	Material& RenderEngine::CreateMaterial(Shaders shader, const std::string& path)
 	{
 		// Create material & set it's shader.
-		int id = Utility::GetUniqueID();
+		int id = m_materialHandles.Allocate();
 		Material& mat = m_loadedMaterials[id];
 		SetMaterialShader(mat, shader);
 		SetMaterialContainers(mat);
 		mat.m_materialID = id;
 		mat.m_path = path.compare("") == 0 ? INTERNAL_MAT_PATH : path;
+		m_materialPaths.emplace(mat.m_path, id);
 		return m_loadedMaterials[id];
 	}
 
@@ -210,12 +283,13 @@ namespace LinaEngine::Graphics
 	Material& RenderEngine::LoadMaterialFromFile(const std::string& path)
 	{
 		// Create material & set it's shader.
-		int id = Utility::GetUniqueID();
+		int id = m_materialHandles.Allocate();
 		Material& mat = m_loadedMaterials[id];
 		Material::LoadMaterialData(mat, path);
 		SetMaterialContainers(mat);
 		mat.m_materialID = id;
 		mat.m_path = path;
+		m_materialPaths.emplace(mat.m_path, id);
 		return m_loadedMaterials[id];
 	}
 
@@ -233,16 +307,34 @@ namespace LinaEngine::Graphics
 		}
 	}
 
+	// Builds the mip chain on the CPU if the texture wants mipmaps, sRGB textures are filtered in linear space.
+	static void GenerateTextureMips(const ArrayBitmap& bitmap, const SamplerParameters& samplerParams, bool useDefaultFormats, std::vector<MipLevel>& levels, JobSystem* jobSystem)
+	{
+		const TextureParameters& params = samplerParams.m_textureParams;
+
+		if (!params.m_generateMipMaps)
+			return;
+
+		const bool isSRGB = !useDefaultFormats && (params.m_internalPixelFormat == PixelFormat::FORMAT_SRGB || params.m_internalPixelFormat == PixelFormat::FORMAT_SRGBA);
+		const bool wrap = params.m_wrapS == SamplerWrapMode::WRAP_REPEAT || params.m_wrapS == SamplerWrapMode::WRAP_REPEAT_MIRROR;
+		const uint8* pixels = reinterpret_cast<const uint8*>(bitmap.GetPixelArray());
+
+		// Bitmaps are always decoded as RGBA.
+		MipmapGenerator::Generate(pixels, bitmap.GetWidth(), bitmap.GetHeight(), 4, isSRGB, wrap, levels, jobSystem);
+	}
+
 	Texture& RenderEngine::CreateTexture2D(const std::string& filePath, SamplerParameters samplerParams, bool compress, bool useDefaultFormats, const std::string& paramsPath)
 	{
+		// Resources are created from level & editor code, they belong to the graphics heap regardless.
+		LINA_MEMORY_SCOPE(Graphics);
+
 		// Create pixel data.
-		ArrayBitmap* textureBitmap = new ArrayBitmap();
+		ArrayBitmap textureBitmap;
 
-		int nrComponents = textureBitmap->Load(filePath);
+		int nrComponents = textureBitmap.Load(filePath);
 		if (nrComponents == -1)
 		{
 			LINA_CORE_WARN("Texture with the path {0} doesn't exist, returning empty texture", filePath);
-			delete textureBitmap;
 			return m_defaultTexture;
 		}
 
@@ -259,14 +351,20 @@ namespace LinaEngine::Graphics
 
 		}
 
-		// Create texture & construct.
+		// Create mips, texture & construct.
+		std::vector<MipLevel> mipLevels;
+		GenerateTextureMips(textureBitmap, samplerParams, useDefaultFormats, mipLevels, m_jobSystem);
+
 		Texture* texture = new Texture();
-		texture->Construct(m_renderDevice, *textureBitmap, samplerParams, compress, filePath);
+		if (mipLevels.empty())
+			texture->Construct(m_renderDevice, textureBitmap, samplerParams, compress, filePath);
+		else
+			texture->ConstructMipmapped(m_renderDevice, textureBitmap, mipLevels, samplerParams, compress, filePath);
+
 		m_loadedTextures[texture->GetID()] = texture;
+		m_texturePaths.emplace(filePath, texture->GetID());
 		texture->m_paramsPath = paramsPath;
-
-		// Delete pixel data.
-		delete textureBitmap;
+		texture->m_isEvictable = true;
 
 		LINA_CORE_TRACE("Texture created. {0}", filePath);
 
@@ -274,8 +372,217 @@ namespace LinaEngine::Graphics
 		return *m_loadedTextures[texture->GetID()];
 	}
 
+	Texture& RenderEngine::CreateTexture2DAsync(const std::string& filePath, SamplerParameters samplerParams, bool compress, bool useDefaultFormats, const std::string& paramsPath, std::function<void(Texture&)> onLoaded)
+	{
+		LINA_MEMORY_SCOPE(Graphics);
+
+		// Already in flight.
+		if (m_pendingTextures.find(filePath) != m_pendingTextures.end())
+			return *m_pendingTextures[filePath];
+
+		if (!Utility::FileExists(filePath))
+		{
+			LINA_CORE_WARN("Texture with the path {0} doesn't exist, returning empty texture", filePath);
+			return m_defaultTexture;
+		}
+
+		// The handle stays empty until the upload, so the default texture is bound in its place.
+		Texture* texture = new Texture();
+		texture->m_path = filePath;
+		texture->m_paramsPath = paramsPath;
+		LoadTextureAsync(texture, samplerParams, compress, useDefaultFormats, onLoaded);
+		return *texture;
+	}
+
+	void RenderEngine::LoadTextureAsync(Texture* texture, SamplerParameters samplerParams, bool compress, bool useDefaultFormats, std::function<void(Texture&)> onLoaded)
+	{
+		texture->m_isEvictable = true;
+		m_pendingTextures[texture->m_path] = texture;
+
+		if (m_asyncBatchCount == 0)
+			m_asyncBatchStart = std::chrono::high_resolution_clock::now();
+
+		m_asyncBatchCount++;
+
+		AsyncTextureRequest* request = new AsyncTextureRequest();
+		request->m_texture = texture;
+		request->m_samplerParams = samplerParams;
+		request->m_compress = compress;
+		request->m_useDefaultFormats = useDefaultFormats;
+		request->m_path = texture->m_path;
+		request->m_onLoaded = onLoaded;
+
+		// Decode on a worker, hand the pixels back for the upload.
+		m_jobSystem->Run([this, request]()
+		{
+			LINA_MEMORY_SCOPE(Graphics);
+			request->m_nrComponents = request->m_bitmap.Load(request->m_path);
+
+			// Already on a worker, other textures in the batch keep the rest of the workers busy.
+			if (request->m_nrComponents != -1)
+				GenerateTextureMips(request->m_bitmap, request->m_samplerParams, request->m_useDefaultFormats, request->m_mipLevels, nullptr);
+
+			std::unique_lock<std::mutex> lock(m_completedTexturesMutex);
+			m_completedTextures.push(request);
+		}, &m_asyncLoadCounter);
+	}
+
+	void RenderEngine::ProcessAsyncUploads()
+	{
+		LINA_PROFILE_SCOPE("Async Uploads");
+		m_frameUploadedBytes = 0;
+
+		std::chrono::time_point<std::chrono::high_resolution_clock> start = std::chrono::high_resolution_clock::now();
+
+		while (true)
+		{
+			AsyncTextureRequest* request = nullptr;
+
+			{
+				std::unique_lock<std::mutex> lock(m_completedTexturesMutex);
+
+				if (m_completedTextures.empty())
+					break;
+
+				request = m_completedTextures.front();
+				m_completedTextures.pop();
+			}
+
+			Texture* texture = request->m_texture;
+			m_pendingTextures.erase(request->m_path);
+
+			if (request->m_nrComponents == -1)
+			{
+				// Keep the handle valid, it stays as an empty texture.
+				LINA_CORE_WARN("Texture with the path {0} could not be decoded, keeping it empty.", request->m_path);
+				texture->ConstructEmpty(m_renderDevice, SamplerParameters(), request->m_path);
+			}
+			else
+			{
+				SamplerParameters& samplerParams = request->m_samplerParams;
+
+				if (request->m_useDefaultFormats)
+				{
+					int nrComponents = request->m_nrComponents;
+					if (nrComponents == 1)
+						samplerParams.m_textureParams.m_internalPixelFormat = samplerParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_R;
+					if (nrComponents == 2)
+						samplerParams.m_textureParams.m_internalPixelFormat = samplerParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_RG;
+					else if (nrComponents == 3)
+						samplerParams.m_textureParams.m_internalPixelFormat = samplerParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_RGB;
+					else if (nrComponents == 4)
+						samplerParams.m_textureParams.m_internalPixelFormat = samplerParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_RGBA;
+				}
+
+				if (request->m_mipLevels.empty())
+					texture->Construct(m_renderDevice, request->m_bitmap, samplerParams, request->m_compress, request->m_path);
+				else
+					texture->ConstructMipmapped(m_renderDevice, request->m_bitmap, request->m_mipLevels, samplerParams, request->m_compress, request->m_path);
+
+				m_frameUploadedBytes += texture->GetMemorySize();
+				LINA_CORE_TRACE("Texture created. {0}", request->m_path);
+			}
+
+			m_loadedTextures[texture->GetID()] = texture;
+			m_texturePaths.emplace(request->m_path, texture->GetID());
+
+			// Pixels are on the GPU, free them before the callbacks.
+			request->m_bitmap = ArrayBitmap();
+			request->m_mipLevels.clear();
+
+			if (request->m_onLoaded)
+				request->m_onLoaded(*texture);
+
+			if (m_textureLoadedCallback)
+				m_textureLoadedCallback(*texture);
+
+			delete request;
+
+			if (m_pendingTextures.empty())
+			{
+				std::chrono::duration<double, std::milli> batchMS = std::chrono::high_resolution_clock::now() - m_asyncBatchStart;
+				LINA_CORE_INFO("Async texture batch finished, {0} textures in {1} ms.", m_asyncBatchCount, batchMS.count());
+				m_asyncBatchCount = 0;
+			}
+
+			// Continue with the next frame if we're out of budget.
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+			if (elapsed.count() >= m_uploadBudgetMS)
+				return;
+		}
+
+		// Collect the meshes imported by the workers, they might take several frames to upload.
+		{
+			std::unique_lock<std::mutex> lock(m_completedMeshesMutex);
+
+			while (!m_completedMeshes.empty())
+			{
+				m_meshUploads.push(m_completedMeshes.front());
+				m_completedMeshes.pop();
+			}
+		}
+
+		while (!m_meshUploads.empty())
+		{
+			AsyncMeshRequest* request = m_meshUploads.front();
+			bool outOfBudget = false;
+
+			// Construct one vertex array at a time so that large models are spread over frames.
+			while (request->m_vertexArrays.size() < request->m_indexedModels.size())
+			{
+				VertexArray* vertexArray = new VertexArray();
+				IndexedModel& model = request->m_indexedModels[request->m_vertexArrays.size()];
+				vertexArray->Construct(m_renderDevice, model, BufferUsage::USAGE_STATIC_COPY);
+				request->m_vertexArrays.push_back(vertexArray);
+				m_frameUploadedBytes += model.GetMemorySize();
+
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+				if (elapsed.count() >= m_uploadBudgetMS)
+				{
+					outOfBudget = true;
+					break;
+				}
+			}
+
+			if (request->m_vertexArrays.size() < request->m_indexedModels.size())
+				return;
+
+			m_meshUploads.pop();
+
+			// Swap the data in all at once, the fallback primitive is drawn until then.
+			Mesh* mesh = request->m_mesh;
+			mesh->m_indexedModelArray = std::move(request->m_indexedModels);
+			mesh->m_materialSpecArray = std::move(request->m_materialSpecs);
+			mesh->m_materialIndexArray = std::move(request->m_materialIndices);
+			mesh->m_vertexArrays = std::move(request->m_vertexArrays);
+			mesh->m_isLoading = false;
+			mesh->CalculateLocalBounds();
+			m_renderableBVH.MarkMeshChanged(mesh->GetID());
+			m_pendingMeshes.erase(request->m_path);
+
+			if (mesh->m_indexedModelArray.size() == 0)
+			{
+				LINA_CORE_WARN("Indexed model array is empty! The model with the name: {0} could not be found or model scene does not contain any mesh! Fallback primitive will be drawn instead.", request->m_path);
+			}
+			else
+			{
+				LINA_CORE_TRACE("Mesh created. {0}", request->m_path);
+			}
+
+			if (request->m_onLoaded)
+				request->m_onLoaded(*mesh);
+
+			delete request;
+
+			if (outOfBudget)
+				return;
+		}
+	}
+
 	Texture& RenderEngine::CreateTextureHDRI(const std::string filePath)
 	{
+		LINA_MEMORY_SCOPE(Graphics);
+
 		// Create pixel data.
 		int w, h, nrComponents;
 		float* data = ArrayBitmap::LoadImmediateHDRI(filePath.c_str(), w, h, nrComponents);
@@ -295,16 +602,36 @@ namespace LinaEngine::Graphics
 
 		Texture* texture = new Texture();
 		texture->ConstructHDRI(m_renderDevice, samplerParams, Vector2(w, h), data, filePath);
+		ArrayBitmap::FreeImmediate(data);
 		m_loadedTextures[texture->GetID()] = texture;
+		m_texturePaths.emplace(filePath, texture->GetID());
 
 		// Return
 		return *m_loadedTextures[texture->GetID()];
 	}
 
+	int RenderEngine::AcquireMeshHandle(int id, const std::string& filePath)
+	{
+		if (id == -1)
+			return m_meshHandles.Allocate();
+
+		// Restored handles can collide with one that was allocated before them, the mesh in that slot is kept.
+		if (HandleAllocator::IsHandle(id) && !m_meshHandles.Acquire(id))
+		{
+			const int newID = m_meshHandles.Allocate();
+			LINA_CORE_WARN("Mesh handle {0} of {1} is in use by another mesh, the mesh is assigned the handle {2} instead.", id, filePath, newID);
+			return newID;
+		}
+
+		return id;
+	}
+
 	Mesh& RenderEngine::CreateMesh(const std::string& filePath, MeshParameters meshParams, int id, const std::string& paramsPath)
 	{
-		// Internal meshes are created with non-negative ids, user loaded ones should have default id of -1.
-		if (id == -1) id = Utility::GetUniqueID();
+		LINA_MEMORY_SCOPE(Graphics);
+
+		// Internal meshes are created with fixed ids, user loaded ones should have default id of -1.
+		id = AcquireMeshHandle(id, filePath);
 
 		Mesh& mesh = m_loadedMeshes[id];
 		mesh.SetParameters(meshParams);
@@ -317,6 +644,8 @@ namespace LinaEngine::Graphics
 			return GetPrimitive(Primitives::Plane);
 		}
 
+		mesh.CalculateLocalBounds();
+
 		// Create vertex array for each mesh.
 		for (uint32 i = 0; i < mesh.GetIndexedModels().size(); i++)
 		{
@@ -329,11 +658,55 @@ namespace LinaEngine::Graphics
 		mesh.m_meshID = id;
 		mesh.m_path = filePath;
 		mesh.m_paramsPath = paramsPath;
+		m_meshPaths.emplace(filePath, id);
 
 		LINA_CORE_TRACE("Mesh created. {0}", filePath);
 		return m_loadedMeshes[id];
 	}
 
+	Mesh& RenderEngine::CreateMeshAsync(const std::string& filePath, MeshParameters meshParams, int id, const std::string& paramsPath, std::function<void(Mesh&)> onLoaded)
+	{
+		LINA_MEMORY_SCOPE(Graphics);
+
+		// Already in flight.
+		if (m_pendingMeshes.find(filePath) != m_pendingMeshes.end())
+			return m_loadedMeshes[m_pendingMeshes[filePath]];
+
+		id = AcquireMeshHandle(id, filePath);
+
+		// The handle is valid right away, renderers draw the fallback primitive until the upload.
+		Mesh& mesh = m_loadedMeshes[id];
+		mesh.SetParameters(meshParams);
+		mesh.m_meshID = id;
+		mesh.m_path = filePath;
+		mesh.m_paramsPath = paramsPath;
+		m_meshPaths.emplace(filePath, id);
+		ImportMeshAsync(mesh, onLoaded);
+		return mesh;
+	}
+
+	void RenderEngine::ImportMeshAsync(Mesh& mesh, std::function<void(Mesh&)> onLoaded)
+	{
+		mesh.m_isLoading = true;
+		m_pendingMeshes[mesh.m_path] = mesh.m_meshID;
+
+		AsyncMeshRequest* request = new AsyncMeshRequest();
+		request->m_mesh = &mesh;
+		request->m_meshParams = mesh.m_parameters;
+		request->m_path = mesh.m_path;
+		request->m_onLoaded = onLoaded;
+
+		// Parse & build the indexed models on a worker, vertex arrays are constructed on the render thread.
+		m_jobSystem->Run([this, request]()
+		{
+			LINA_MEMORY_SCOPE(Graphics);
+			ModelLoader::LoadModel(request->m_path, request->m_indexedModels, request->m_materialIndices, request->m_materialSpecs, request->m_meshParams);
+
+			std::unique_lock<std::mutex> lock(m_completedMeshesMutex);
+			m_completedMeshes.push(request);
+		}, &m_asyncLoadCounter);
+	}
+
 	Shader& RenderEngine::CreateShader(Shaders shader, const std::string& path, bool usesGeometryShader)
 	{
 		// Create shader
@@ -365,17 +738,16 @@ namespace LinaEngine::Graphics
 
 	Material& RenderEngine::GetMaterial(const std::string& path)
 	{
-		const auto it = std::find_if(m_loadedMaterials.begin(), m_loadedMaterials.end(), [path]
-		(const auto& item) -> bool { return item.second.GetPath().compare(path) == 0; });
+		const auto it = m_materialPaths.find(path);
 
-		if (it == m_loadedMaterials.end())
+		if (it == m_materialPaths.end())
 		{
 			// Mesh not found.
 			LINA_CORE_WARN("Material with the path {0} was not found, returning un-constructed material...", path);
 			return Material();
 		}
 
-		return it->second;
+		return m_loadedMaterials[it->second];
 	}
 
 	Texture& RenderEngine::GetTexture(int id)
@@ -392,17 +764,22 @@ namespace LinaEngine::Graphics
 
 	Texture& RenderEngine::GetTexture(const std::string& path)
 	{
-		const auto it = std::find_if(m_loadedTextures.begin(), m_loadedTextures.end(), [path]
-		(const auto& item) -> bool { return item.second->GetPath().compare(path) == 0; });
+		if (m_pendingTextures.find(path) != m_pendingTextures.end())
+			return *m_pendingTextures[path];
 
-		if (it == m_loadedTextures.end())
+		if (m_evictedTextures.find(path) != m_evictedTextures.end())
+			return *m_evictedTextures[path];
+
+		const auto it = m_texturePaths.find(path);
+
+		if (it == m_texturePaths.end())
 		{
 			// Mesh not found.
 			LINA_CORE_WARN("Texture with the path {0} was not found, returning un-constructed texture...", path);
 			return Texture();
 		}
 
-		return *it->second;
+		return *m_loadedTextures[it->second];
 	}
 
 	Mesh& RenderEngine::GetMesh(int id)
@@ -419,17 +796,16 @@ namespace LinaEngine::Graphics
 
 	Mesh& RenderEngine::GetMesh(const std::string& path)
 	{
-		const auto it = std::find_if(m_loadedMeshes.begin(), m_loadedMeshes.end(), [path]
-		(const auto& item) -> bool { return item.second.GetPath().compare(path) == 0; });
+		const auto it = m_meshPaths.find(path);
 
-		if (it == m_loadedMeshes.end())
+		if (it == m_meshPaths.end())
 		{
 			// Mesh not found.
 			LINA_CORE_WARN("Mesh with the path {0} was not found, returning un-constructed mesh...", path);
 			return Mesh();
 		}
 
-		return it->second;
+		return m_loadedMeshes[it->second];
 	}
 
 	Shader& RenderEngine::GetShader(Shaders shader)
@@ -596,6 +972,10 @@ namespace LinaEngine::Graphics
 			return;
 		}
 
+		const auto it = m_texturePaths.find(m_loadedTextures[id]->GetPath());
+		if (it != m_texturePaths.end() && it->second == id)
+			m_texturePaths.erase(it);
+
 		delete m_loadedTextures[id];
 		m_loadedTextures.erase(id);
 	}
@@ -608,6 +988,17 @@ namespace LinaEngine::Graphics
 			return;
 		}
 
+		if (m_loadedMeshes[id].GetIsLoading())
+		{
+			LINA_CORE_WARN("Mesh is still being imported! Aborting... ");
+			return;
+		}
+
+		const auto it = m_meshPaths.find(m_loadedMeshes[id].GetPath());
+		if (it != m_meshPaths.end() && it->second == id)
+			m_meshPaths.erase(it);
+
+		m_meshHandles.Release(id);
 		m_loadedMeshes.erase(id);
 	}
 
@@ -623,20 +1014,24 @@ namespace LinaEngine::Graphics
 		if (m_shadowMappedMaterials.find(&m_loadedMaterials[id]) != m_shadowMappedMaterials.end())
 			m_shadowMappedMaterials.erase(&m_loadedMaterials[id]);
 
+		const auto it = m_materialPaths.find(m_loadedMaterials[id].GetPath());
+		if (it != m_materialPaths.end() && it->second == id)
+			m_materialPaths.erase(it);
+
+		m_materialHandles.Release(id);
 		m_loadedMaterials.erase(id);
 	}
 
 	bool RenderEngine::MaterialExists(int id)
 	{
 		if (id < 0) return false;
+		if (HandleAllocator::IsHandle(id)) return m_materialHandles.IsValid(id);
 		return !(m_loadedMaterials.find(id) == m_loadedMaterials.end());
 	}
 
 	bool RenderEngine::MaterialExists(const std::string& path)
 	{
-		const auto it = std::find_if(m_loadedMaterials.begin(), m_loadedMaterials.end(), [path]
-		(const auto& it) -> bool { 	return it.second.GetPath().compare(path) == 0; 	});
-		return it != m_loadedMaterials.end();
+		return m_materialPaths.find(path) != m_materialPaths.end();
 	}
 
 	bool RenderEngine::TextureExists(int id)
@@ -647,22 +1042,22 @@ namespace LinaEngine::Graphics
 
 	bool RenderEngine::TextureExists(const std::string& path)
 	{
-		const auto it = std::find_if(m_loadedTextures.begin(), m_loadedTextures.end(), [path]
-		(const auto& it) -> bool { 	return it.second->GetPath().compare(path) == 0; 	});
-		return it != m_loadedTextures.end();
+		if (m_pendingTextures.find(path) != m_pendingTextures.end() || m_evictedTextures.find(path) != m_evictedTextures.end())
+			return true;
+
+		return m_texturePaths.find(path) != m_texturePaths.end();
 	}
 
 	bool RenderEngine::MeshExists(int id)
 	{
 		if (id < 0) return false;
+		if (HandleAllocator::IsHandle(id)) return m_meshHandles.IsValid(id);
 		return !(m_loadedMeshes.find(id) == m_loadedMeshes.end());
 	}
 
 	bool RenderEngine::MeshExists(const std::string& path)
 	{
-		const auto it = std::find_if(m_loadedMeshes.begin(), m_loadedMeshes.end(), [path]
-		(const auto& it) -> bool { 	return it.second.GetPath().compare(path) == 0; 	});
-		return it != m_loadedMeshes.end();
+		return m_meshPaths.find(path) != m_meshPaths.end();
 	}
 
 	bool RenderEngine::ShaderExists(Shaders shader)
@@ -670,6 +1065,214 @@ namespace LinaEngine::Graphics
 		return !(m_loadedShaders.find(shader) == m_loadedShaders.end());
 	}
 
+	void RenderEngine::MarkMeshUsed(Mesh& mesh)
+	{
+		mesh.m_lastUsedFrame = m_frameIndex;
+
+		if (mesh.m_isEvicted)
+		{
+			LINA_CORE_TRACE("Reloading evicted mesh {0}", mesh.m_path);
+			mesh.m_isEvicted = false;
+			ImportMeshAsync(mesh, nullptr);
+		}
+	}
+
+	void RenderEngine::MarkTextureUsed(Texture& texture)
+	{
+		texture.m_lastUsedFrame = m_frameIndex;
+
+		if (texture.m_isEvicted)
+			ReloadTexture(texture);
+	}
+
+	void RenderEngine::ReloadTexture(Texture& texture)
+	{
+		LINA_CORE_TRACE("Reloading evicted texture {0}", texture.m_path);
+		texture.m_isEvicted = false;
+		m_evictedTextures.erase(texture.m_path);
+		LoadTextureAsync(&texture, texture.GetSampler().GetSamplerParameters(), texture.m_isCompressed, false, nullptr);
+	}
+
+	void RenderEngine::EvictTexture(Texture& texture)
+	{
+		// The object is kept alive for the materials pointing to it, only the GPU data is freed.
+		const auto it = m_texturePaths.find(texture.m_path);
+		if (it != m_texturePaths.end() && it->second == texture.GetID())
+			m_texturePaths.erase(it);
+
+		m_loadedTextures.erase(texture.GetID());
+		texture.Release();
+		texture.m_isEvicted = true;
+		m_evictedTextures[texture.m_path] = &texture;
+	}
+
+	void RenderEngine::EvictMesh(Mesh& mesh)
+	{
+		// Handle stays valid, renderers draw the fallback primitive until it's reloaded.
+		for (uint32 i = 0; i < mesh.m_vertexArrays.size(); i++)
+			delete mesh.m_vertexArrays[i];
+
+		mesh.m_vertexArrays.clear();
+		mesh.m_indexedModelArray.clear();
+		mesh.m_materialSpecArray.clear();
+		mesh.m_materialIndexArray.clear();
+		mesh.m_isEvicted = true;
+	}
+
+	void RenderEngine::CountResourceReferences()
+	{
+		for (std::map<int, Texture*>::iterator it = m_loadedTextures.begin(); it != m_loadedTextures.end(); it++)
+			it->second->m_refCount = 0;
+
+		for (std::map<int, Mesh>::iterator it = m_loadedMeshes.begin(); it != m_loadedMeshes.end(); it++)
+			it->second.m_refCount = 0;
+
+		for (std::map<int, Material>::iterator it = m_loadedMaterials.begin(); it != m_loadedMaterials.end(); it++)
+			it->second.m_refCount = 0;
+
+		// Components.
+		auto meshView = m_ecs->view<LinaEngine::ECS::MeshRendererComponent>();
+		for (auto entity : meshView)
+		{
+			LinaEngine::ECS::MeshRendererComponent& renderer = meshView.get<LinaEngine::ECS::MeshRendererComponent>(entity);
+
+			if (MeshExists(renderer.m_meshID))
+				m_loadedMeshes[renderer.m_meshID].m_refCount++;
+
+			if (MaterialExists(renderer.m_materialID))
+				m_loadedMaterials[renderer.m_materialID].m_refCount++;
+		}
+
+		auto spriteView = m_ecs->view<LinaEngine::ECS::SpriteRendererComponent>();
+		for (auto entity : spriteView)
+		{
+			LinaEngine::ECS::SpriteRendererComponent& renderer = spriteView.get<LinaEngine::ECS::SpriteRendererComponent>(entity);
+
+			if (MaterialExists(renderer.m_materialID))
+				m_loadedMaterials[renderer.m_materialID].m_refCount++;
+		}
+
+		// Materials used by the engine itself.
+		if (m_skyboxMaterial != nullptr)
+			m_skyboxMaterial->m_refCount++;
+
+		for (Material* mat : m_hdriMaterials)
+			mat->m_refCount++;
+
+		// Textures are referenced by the materials that are in use.
+		for (std::map<int, Material>::iterator it = m_loadedMaterials.begin(); it != m_loadedMaterials.end(); it++)
+		{
+			if (it->second.m_refCount == 0) continue;
+
+			for (std::map<std::string, MaterialSampler2D>::iterator sampler = it->second.m_sampler2Ds.begin(); sampler != it->second.m_sampler2Ds.end(); sampler++)
+			{
+				if (sampler->second.m_boundTexture != nullptr)
+					sampler->second.m_boundTexture->m_refCount++;
+			}
+		}
+	}
+
+	void RenderEngine::EvictUnusedResources()
+	{
+		CountResourceReferences();
+		UpdateMemoryStats();
+
+		// Unreferenced resources that are not in use this frame, oldest first.
+		std::vector<std::pair<uint64, Texture*>> textures;
+		std::vector<std::pair<uint64, Mesh*>> meshes;
+
+		// Layers draw after the frame index is advanced, so their marks from the last frame still count as in use.
+		for (std::map<int, Texture*>::iterator it = m_loadedTextures.begin(); it != m_loadedTextures.end(); it++)
+		{
+			Texture* texture = it->second;
+			if (texture->m_isEvictable && texture->m_refCount == 0 && texture->m_pinCount == 0 && texture->m_lastUsedFrame + 1 < m_frameIndex)
+				textures.push_back(std::make_pair(texture->m_lastUsedFrame, texture));
+		}
+
+		// Primitives have fixed ids & are never evicted.
+		for (std::map<int, Mesh>::iterator it = m_loadedMeshes.begin(); it != m_loadedMeshes.end(); it++)
+		{
+			Mesh& mesh = it->second;
+			if (HandleAllocator::IsHandle(it->first) && !mesh.m_isLoading && !mesh.m_isEvicted && mesh.m_refCount == 0 && mesh.m_lastUsedFrame < m_frameIndex)
+				meshes.push_back(std::make_pair(mesh.m_lastUsedFrame, &mesh));
+		}
+
+		std::sort(textures.begin(), textures.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		std::sort(meshes.begin(), meshes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		size_t cpuBytes = m_textureMemoryStats.m_cpuBytes + m_meshMemoryStats.m_cpuBytes + m_materialMemoryStats.m_cpuBytes;
+		size_t gpuBytes = m_textureMemoryStats.m_gpuBytes + m_meshMemoryStats.m_gpuBytes;
+		size_t textureIndex = 0, meshIndex = 0;
+		uint32 evictedCount = 0;
+
+		while (textureIndex < textures.size() || meshIndex < meshes.size())
+		{
+			bool overCPUBudget = m_cpuMemoryBudget != 0 && cpuBytes > m_cpuMemoryBudget;
+			bool overGPUBudget = m_gpuMemoryBudget != 0 && gpuBytes > m_gpuMemoryBudget;
+			if (!overCPUBudget && !overGPUBudget) break;
+
+			// Textures only take GPU memory, skip them if only the CPU budget is exceeded.
+			bool pickTexture = textureIndex < textures.size() && overGPUBudget;
+			if (pickTexture && meshIndex < meshes.size())
+				pickTexture = textures[textureIndex].first <= meshes[meshIndex].first;
+
+			if (pickTexture)
+			{
+				Texture* texture = textures[textureIndex++].second;
+				gpuBytes -= texture->m_memorySize;
+				EvictTexture(*texture);
+			}
+			else if (meshIndex < meshes.size())
+			{
+				Mesh* mesh = meshes[meshIndex++].second;
+				cpuBytes -= mesh->GetMemorySize();
+				gpuBytes -= mesh->GetGPUMemorySize();
+				EvictMesh(*mesh);
+			}
+			else
+				break;
+
+			evictedCount++;
+		}
+
+		UpdateMemoryStats();
+
+		if (evictedCount != 0)
+			LINA_CORE_INFO("Evicted {0} unused resources, CPU: {1} KB GPU: {2} KB", evictedCount, cpuBytes / 1024, gpuBytes / 1024);
+	}
+
+	void RenderEngine::UpdateMemoryStats()
+	{
+		m_textureMemoryStats = ResourceMemoryStats();
+		m_meshMemoryStats = ResourceMemoryStats();
+		m_materialMemoryStats = ResourceMemoryStats();
+
+		for (std::map<int, Texture*>::iterator it = m_loadedTextures.begin(); it != m_loadedTextures.end(); it++)
+		{
+			m_textureMemoryStats.m_count++;
+			m_textureMemoryStats.m_gpuBytes += it->second->m_memorySize;
+		}
+
+		m_textureMemoryStats.m_evictedCount = (uint32)m_evictedTextures.size();
+		m_textureMemoryStats.m_count += m_textureMemoryStats.m_evictedCount;
+
+		for (std::map<int, Mesh>::iterator it = m_loadedMeshes.begin(); it != m_loadedMeshes.end(); it++)
+		{
+			m_meshMemoryStats.m_count++;
+			m_meshMemoryStats.m_cpuBytes += it->second.GetMemorySize();
+			m_meshMemoryStats.m_gpuBytes += it->second.GetGPUMemorySize();
+
+			if (it->second.m_isEvicted)
+				m_meshMemoryStats.m_evictedCount++;
+		}
+
+		for (std::map<int, Material>::iterator it = m_loadedMaterials.begin(); it != m_loadedMaterials.end(); it++)
+		{
+			m_materialMemoryStats.m_count++;
+			m_materialMemoryStats.m_cpuBytes += sizeof(Material) + it->second.m_sampler2Ds.size() * sizeof(MaterialSampler2D);
+		}
+	}
+
 	void RenderEngine::ConstructEngineShaders()
 	{
 		// Unlit.
@@ -928,6 +1531,11 @@ namespace LinaEngine::Graphics
 		m_loadedMeshes.clear();
 		m_loadedTextures.clear();
 		m_loadedMaterials.clear();
+		m_texturePaths.clear();
+		m_meshPaths.clear();
+		m_materialPaths.clear();
+		m_meshHandles = HandleAllocator();
+		m_materialHandles = HandleAllocator();
 	}
 
 	void RenderEngine::DrawShadows()
@@ -1175,12 +1783,19 @@ namespace LinaEngine::Graphics
 
 		for (auto const& d : (*data).m_sampler2Ds)
 		{
+			// Keep track of the usage, evicted textures are loaded back & the default one is bound meanwhile.
+			if (d.second.m_isActive && d.second.m_boundTexture != nullptr)
+				MarkTextureUsed(*d.second.m_boundTexture);
+
 			// Set whether the texture is active or not.
+			// Uniform names are built in a reused string to avoid allocating per draw.
 			bool isActive = (d.second.m_isActive && d.second.m_boundTexture != nullptr && !d.second.m_boundTexture->GetIsEmpty()) ? true : false;
-			m_renderDevice.UpdateShaderUniformInt(data->m_shaderID, d.first + MAT_EXTENSION_ISACTIVE, isActive);
+			m_uniformNameBuffer.assign(d.first).append(MAT_EXTENSION_ISACTIVE);
+			m_renderDevice.UpdateShaderUniformInt(data->m_shaderID, m_uniformNameBuffer, isActive);
 
 			// Set the texture to corresponding active unit.
-			m_renderDevice.UpdateShaderUniformInt(data->m_shaderID, d.first + MAT_EXTENSION_TEXTURE2D, d.second.m_unit);
+			m_uniformNameBuffer.assign(d.first).append(MAT_EXTENSION_TEXTURE2D);
+			m_renderDevice.UpdateShaderUniformInt(data->m_shaderID, m_uniformNameBuffer, d.second.m_unit);
 
 			// Set texture
 			if (isActive)
@@ -1215,11 +1830,34 @@ namespace LinaEngine::Graphics
 			Matrix::InitLookAtRH(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
 		};
 
-		// Calculate HDRI, Irradiance, Prefilter and BRDF
+		// Environment cubemap is always rendered, it's used by the skybox.
 		CalculateHDRICubemap(hdriTexture, captureProjection, captureViews);
-		CalculateHDRIIrradiance(captureProjection, captureViews);
-		CalculateHDRIPrefilter(captureProjection, captureViews);
-		CalculateHDRIBRDF(captureProjection, captureViews);
+
+		// Irradiance, prefilter & BRDF are loaded from the cache if the source file didn't change.
+		const std::string& hdriPath = hdriTexture.GetPath();
+		unsigned long long sourceHash = hdriPath.empty() ? 0 : Utility::HashFileContents(hdriPath);
+		HDRICache cache;
+
+		if (sourceHash != 0 && HDRICache::Load(HDRICache::GetCachePath(sourceHash), cache) && cache.m_sourceHash == sourceHash)
+			LoadHDRICacheData(cache);
+		else
+		{
+			if (CalculateHDRIIrradianceSH(hdriPath, cache.m_irradianceSH))
+				ConstructHDRIIrradianceMap(cache.m_irradianceSH);
+			else
+				CalculateHDRIIrradiance(captureProjection, captureViews);
+
+			CalculateHDRIPrefilter(captureProjection, captureViews);
+			CalculateHDRIBRDF(captureProjection, captureViews);
+
+			if (sourceHash != 0)
+			{
+				cache.m_sourceHash = sourceHash;
+				ReadHDRICacheData(cache);
+				HDRICache::Save(HDRICache::GetCachePath(sourceHash), cache);
+			}
+		}
+
 		m_renderDevice.SetFBO(0);
 		m_renderDevice.SetViewport(m_viewportPos, m_viewportSize);
 
@@ -1393,6 +2031,97 @@ namespace LinaEngine::Graphics
 		m_renderDevice.Draw(m_screenQuadVAO, m_fullscreenQuadDP, 0, 6, true);
 	}
 
+	bool RenderEngine::CalculateHDRIIrradianceSH(const std::string& hdriPath, SHCoefficients& sh)
+	{
+		int w, h, nrComponents;
+		float* data = hdriPath.empty() ? nullptr : ArrayBitmap::LoadImmediateHDRI(hdriPath.c_str(), w, h, nrComponents);
+
+		if (!data)
+			return false;
+
+		sh = SphericalHarmonics::ProjectEquirectangular(data, w, h, nrComponents, m_jobSystem);
+
+		ArrayBitmap::FreeImmediate(data);
+		return true;
+	}
+
+	void RenderEngine::ConstructHDRIIrradianceMap(const SHCoefficients& sh)
+	{
+		// Generate sampler.
+		SamplerParameters irradianceParams;
+		irradianceParams.m_textureParams.m_wrapR = irradianceParams.m_textureParams.m_wrapS = irradianceParams.m_textureParams.m_wrapT = SamplerWrapMode::WRAP_CLAMP_EDGE;
+		irradianceParams.m_textureParams.m_magFilter = SamplerFilter::FILTER_LINEAR;
+		irradianceParams.m_textureParams.m_minFilter = SamplerFilter::FILTER_LINEAR;
+		irradianceParams.m_textureParams.m_internalPixelFormat = PixelFormat::FORMAT_RGB16F;
+		irradianceParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_RGB;
+		irradianceParams.m_textureParams.m_generateMipMaps = false;
+
+		// Evaluate the irradiance per texel & upload.
+		const int32 irradianceMapResolution = 32;
+		std::vector<std::vector<float>> faces;
+		SphericalHarmonics::GenerateIrradianceCubemap(sh, irradianceMapResolution, faces);
+
+		std::vector<float*> faceData;
+		for (uint32 i = 0; i < 6; i++)
+			faceData.push_back(faces[i].data());
+
+		m_hdriIrradianceMap.ConstructCubemapHDRI(m_renderDevice, irradianceParams, Vector2(irradianceMapResolution, irradianceMapResolution), faceData);
+	}
+
+	void RenderEngine::ReadHDRICacheData(HDRICache& cache)
+	{
+		// Prefilter levels.
+		cache.m_prefilterSize = (int32)m_hdriPrefilterMap.GetSize().x;
+		cache.m_prefilterMipCount = 5;
+		cache.m_prefilterData.resize(cache.m_prefilterMipCount * 6);
+
+		for (uint32 mip = 0; mip < cache.m_prefilterMipCount; mip++)
+		{
+			const int32 mipSize = std::max(1, cache.m_prefilterSize >> mip);
+
+			for (uint32 i = 0; i < 6; i++)
+			{
+				std::vector<float>& data = cache.m_prefilterData[mip * 6 + i];
+				data.resize((size_t)mipSize * mipSize * 3);
+				m_renderDevice.GetTextureDataFloat(m_hdriPrefilterMap.GetID(), TextureBindMode::BINDTEXTURE_CUBEMAP, i, mip, PixelFormat::FORMAT_RGB, data.data());
+			}
+		}
+
+		// BRDF LUT.
+		cache.m_brdfSize = (int32)m_HDRILutMap.GetSize().x;
+		cache.m_brdfData.resize((size_t)cache.m_brdfSize * cache.m_brdfSize * 3);
+		m_renderDevice.GetTextureDataFloat(m_HDRILutMap.GetID(), TextureBindMode::BINDTEXTURE_TEXTURE2D, 0, 0, PixelFormat::FORMAT_RGB, cache.m_brdfData.data());
+	}
+
+	void RenderEngine::LoadHDRICacheData(HDRICache& cache)
+	{
+		ConstructHDRIIrradianceMap(cache.m_irradianceSH);
+
+		// Prefilter map with the cached mip chain.
+		SamplerParameters prefilterParams;
+		prefilterParams.m_textureParams.m_generateMipMaps = false;
+		prefilterParams.m_textureParams.m_wrapR = prefilterParams.m_textureParams.m_wrapS = prefilterParams.m_textureParams.m_wrapT = SamplerWrapMode::WRAP_CLAMP_EDGE;
+		prefilterParams.m_textureParams.m_minFilter = SamplerFilter::FILTER_LINEAR_MIPMAP_LINEAR;
+		prefilterParams.m_textureParams.m_magFilter = SamplerFilter::FILTER_LINEAR;
+		prefilterParams.m_textureParams.m_internalPixelFormat = PixelFormat::FORMAT_RGB16F;
+		prefilterParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_RGB;
+
+		std::vector<float*> prefilterData;
+		for (std::vector<float>& level : cache.m_prefilterData)
+			prefilterData.push_back(level.data());
+
+		m_hdriPrefilterMap.ConstructCubemapHDRI(m_renderDevice, prefilterParams, Vector2(cache.m_prefilterSize, cache.m_prefilterSize), prefilterData, cache.m_prefilterMipCount);
+
+		// BRDF LUT.
+		SamplerParameters brdfParams;
+		brdfParams.m_textureParams.m_wrapR = brdfParams.m_textureParams.m_wrapS = brdfParams.m_textureParams.m_wrapT = SamplerWrapMode::WRAP_CLAMP_EDGE;
+		brdfParams.m_textureParams.m_magFilter = SamplerFilter::FILTER_LINEAR;
+		brdfParams.m_textureParams.m_minFilter = SamplerFilter::FILTER_LINEAR;
+		brdfParams.m_textureParams.m_internalPixelFormat = PixelFormat::FORMAT_RGB16F;
+		brdfParams.m_textureParams.m_pixelFormat = PixelFormat::FORMAT_RGB;
+		m_HDRILutMap.ConstructHDRI(m_renderDevice, brdfParams, Vector2(cache.m_brdfSize, cache.m_brdfSize), cache.m_brdfData.data());
+	}
+
 	void RenderEngine::SetHDRIData(Material* mat)
 	{
 		if (mat == nullptr)
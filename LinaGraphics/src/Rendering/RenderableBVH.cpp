@@ -0,0 +1,177 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: RenderableBVH
+
+Timestamp: 11/3/2020 7:21:45 PM
+*/
+
+#include "Rendering/RenderableBVH.hpp"
+#include "Rendering/RenderEngine.hpp"
+#include "ECS/Components/TransformComponent.hpp"
+#include "ECS/Components/MeshRendererComponent.hpp"
+#include "ECS/Components/SpriteRendererComponent.hpp"
+
+namespace LinaEngine::Graphics
+{
+	RenderableBVH::~RenderableBVH()
+	{
+		Shutdown();
+	}
+
+	void RenderableBVH::Initialize(ECS::ECSRegistry& registry, RenderEngine& renderEngine)
+	{
+		m_registry = &registry;
+		m_renderEngine = &renderEngine;
+
+		m_registry->on_construct<ECS::TransformComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_destroy<ECS::TransformComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_construct<ECS::MeshRendererComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_update<ECS::MeshRendererComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_destroy<ECS::MeshRendererComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_construct<ECS::SpriteRendererComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_update<ECS::SpriteRendererComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_destroy<ECS::SpriteRendererComponent>().connect<&RenderableBVH::OnRendererChanged>(this);
+	}
+
+	void RenderableBVH::Shutdown()
+	{
+		if (m_registry == nullptr)
+			return;
+
+		m_registry->on_construct<ECS::TransformComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_destroy<ECS::TransformComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_construct<ECS::MeshRendererComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_update<ECS::MeshRendererComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_destroy<ECS::MeshRendererComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_construct<ECS::SpriteRendererComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_update<ECS::SpriteRendererComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry->on_destroy<ECS::SpriteRendererComponent>().disconnect<&RenderableBVH::OnRendererChanged>(this);
+		m_registry = nullptr;
+
+		m_tree.Clear();
+		m_proxies.clear();
+		m_changedEntities.clear();
+	}
+
+	void RenderableBVH::Update(const std::vector<ECS::ECSEntity>& movedEntities, JobSystem* jobSystem)
+	{
+		if (m_registry == nullptr)
+			return;
+
+		// Signals fire before the components are removed, so the changes are applied here instead.
+		for (ECS::ECSEntity entity : m_changedEntities)
+			RefreshEntity(entity);
+
+		m_changedEntities.clear();
+
+		for (ECS::ECSEntity entity : movedEntities)
+		{
+			auto it = m_proxies.find(entity);
+			AABB bounds;
+
+			if (it != m_proxies.end() && GetWorldBounds(entity, bounds))
+				m_tree.MoveProxy(it->second, bounds);
+		}
+
+		m_tree.Update(jobSystem);
+	}
+
+	void RenderableBVH::MarkMeshChanged(int meshID)
+	{
+		if (m_registry == nullptr)
+			return;
+
+		auto view = m_registry->view<ECS::MeshRendererComponent>();
+
+		for (ECS::ECSEntity entity : view)
+		{
+			if (view.get<ECS::MeshRendererComponent>(entity).m_meshID == meshID)
+				m_changedEntities.push_back(entity);
+		}
+	}
+
+	void RenderableBVH::GetVisibleEntities(const Matrix& viewProjection, std::vector<ECS::ECSEntity>& entities) const
+	{
+		QueryFrustum(Frustum::FromMatrix(viewProjection), [&entities](ECS::ECSEntity entity)
+			{
+				entities.push_back(entity);
+				return true;
+			});
+	}
+
+	bool RenderableBVH::GetWorldBounds(ECS::ECSEntity entity, AABB& bounds)
+	{
+		if (!m_registry->valid(entity))
+			return false;
+
+		ECS::TransformComponent* transform = m_registry->try_get<ECS::TransformComponent>(entity);
+		ECS::MeshRendererComponent* meshRenderer = m_registry->try_get<ECS::MeshRendererComponent>(entity);
+		ECS::SpriteRendererComponent* spriteRenderer = m_registry->try_get<ECS::SpriteRendererComponent>(entity);
+
+		if (transform == nullptr || (meshRenderer == nullptr && spriteRenderer == nullptr))
+			return false;
+
+		AABB localBounds;
+
+		if (meshRenderer != nullptr)
+		{
+			// Renderers draw the fallback primitive for the meshes that don't exist.
+			if (m_renderEngine->MeshExists(meshRenderer->m_meshID))
+				localBounds = m_renderEngine->GetMesh(meshRenderer->m_meshID).GetLocalBounds();
+			else
+				localBounds = m_renderEngine->GetPrimitive(m_renderEngine->GetFallbackPrimitive()).GetLocalBounds();
+		}
+
+		// Sprites are unit quads on the XY plane.
+		if (spriteRenderer != nullptr)
+		{
+			const AABB quadBounds = AABB(Vector3(-0.5f, -0.5f, 0.0f), Vector3(0.5f, 0.5f, 0.0f));
+			localBounds = meshRenderer != nullptr ? AABB::Merge(localBounds, quadBounds) : quadBounds;
+		}
+
+		bounds = localBounds.Transformed(transform->m_worldMatrix);
+		return true;
+	}
+
+	void RenderableBVH::RefreshEntity(ECS::ECSEntity entity)
+	{
+		auto it = m_proxies.find(entity);
+
+		// Recreated instead of moved so that boxes that shrink don't keep their old fat bounds.
+		if (it != m_proxies.end())
+		{
+			m_tree.DestroyProxy(it->second);
+			m_proxies.erase(it);
+		}
+
+		AABB bounds;
+		if (GetWorldBounds(entity, bounds))
+			m_proxies[entity] = m_tree.CreateProxy(bounds, (uint32)entt::to_integral(entity));
+	}
+}
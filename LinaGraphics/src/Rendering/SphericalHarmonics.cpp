@@ -0,0 +1,282 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: SphericalHarmonics
+
+Timestamp: 10/31/2020 3:18:05 PM
+*/
+
+#include "Rendering/SphericalHarmonics.hpp"
+#include "Core/JobSystem.hpp"
+#include "PackageManager/PAMSIMD.hpp"
+#include <cmath>
+#include <algorithm>
+
+#if (SIMD_CPU_ARCH != SIMD_CPU_ARCH_OTHER) && (SIMD_SUPPORTED_LEVEL >= SIMD_LEVEL_x86_SSE)
+#define LINA_SH_USE_SSE 1
+#else
+#define LINA_SH_USE_SSE 0
+#endif
+
+namespace LinaEngine::Graphics
+{
+	// Basis normalization constants.
+	static const float SH_Y00 = 0.282095f;
+	static const float SH_Y1 = 0.488603f;
+	static const float SH_Y2 = 1.092548f;
+	static const float SH_Y20 = 0.315392f;
+	static const float SH_Y22 = 0.546274f;
+	static const double SH_PI = 3.14159265358979323846;
+
+	// Cosine lobe convolution per band, divided by PI.
+	static const float s_bandScale[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+
+	static void ProjectRows(const float* data, int32 width, int32 height, int32 channels, int32 rowBegin, int32 rowEnd, const float* cosPhi, const float* sinPhi, double out[9][3])
+	{
+		const double texelSolidAngle = (2.0 * SH_PI / width) * (SH_PI / height);
+
+		for (int32 row = rowBegin; row < rowEnd; row++)
+		{
+			const double latitude = ((row + 0.5) / height - 0.5) * SH_PI;
+			const float y = (float)std::sin(latitude);
+			const float cosLat = (float)std::cos(latitude);
+			const float* rowData = data + (size_t)row * width * channels;
+			float rowSum[9][3] = { {0.0f} };
+			int32 i = 0;
+
+#if LINA_SH_USE_SSE
+			__m128 acc[9][3];
+			for (int k = 0; k < 9; k++)
+				acc[k][0] = acc[k][1] = acc[k][2] = _mm_setzero_ps();
+
+			const __m128 cl = _mm_set1_ps(cosLat);
+			const __m128 yv = _mm_set1_ps(y);
+			const __m128 b0 = _mm_set1_ps(SH_Y00);
+			const __m128 b1 = _mm_set1_ps(SH_Y1 * y);
+			const __m128 c1 = _mm_set1_ps(SH_Y1);
+			const __m128 c2 = _mm_set1_ps(SH_Y2);
+			const __m128 c20 = _mm_set1_ps(SH_Y20);
+			const __m128 c22 = _mm_set1_ps(SH_Y22);
+			const __m128 three = _mm_set1_ps(3.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			for (; i + 3 < width; i += 4)
+			{
+				const __m128 x = _mm_mul_ps(cl, _mm_loadu_ps(cosPhi + i));
+				const __m128 z = _mm_mul_ps(cl, _mm_loadu_ps(sinPhi + i));
+
+				__m128 b[9];
+				b[0] = b0;
+				b[1] = b1;
+				b[2] = _mm_mul_ps(c1, z);
+				b[3] = _mm_mul_ps(c1, x);
+				b[4] = _mm_mul_ps(c2, _mm_mul_ps(x, yv));
+				b[5] = _mm_mul_ps(c2, _mm_mul_ps(yv, z));
+				b[6] = _mm_mul_ps(c20, _mm_sub_ps(_mm_mul_ps(three, _mm_mul_ps(z, z)), one));
+				b[7] = _mm_mul_ps(c2, _mm_mul_ps(x, z));
+				b[8] = _mm_mul_ps(c22, _mm_sub_ps(_mm_mul_ps(x, x), _mm_mul_ps(yv, yv)));
+
+				const float* p = rowData + (size_t)i * channels;
+				const __m128 color[3] =
+				{
+					_mm_set_ps(p[3 * channels], p[2 * channels], p[channels], p[0]),
+					_mm_set_ps(p[3 * channels + 1], p[2 * channels + 1], p[channels + 1], p[1]),
+					_mm_set_ps(p[3 * channels + 2], p[2 * channels + 2], p[channels + 2], p[2])
+				};
+
+				for (int k = 0; k < 9; k++)
+				{
+					acc[k][0] = _mm_add_ps(acc[k][0], _mm_mul_ps(b[k], color[0]));
+					acc[k][1] = _mm_add_ps(acc[k][1], _mm_mul_ps(b[k], color[1]));
+					acc[k][2] = _mm_add_ps(acc[k][2], _mm_mul_ps(b[k], color[2]));
+				}
+			}
+
+			// Horizontal sums of the lanes.
+			for (int k = 0; k < 9; k++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					float lanes[4];
+					_mm_storeu_ps(lanes, acc[k][c]);
+					rowSum[k][c] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+				}
+			}
+#endif
+
+			// Scalar path & remainder of the vectorized path.
+			for (; i < width; i++)
+			{
+				float basis[9];
+				SphericalHarmonics::EvaluateBasis(Vector3(cosLat * cosPhi[i], y, cosLat * sinPhi[i]), basis);
+
+				const float* p = rowData + (size_t)i * channels;
+				for (int k = 0; k < 9; k++)
+				{
+					rowSum[k][0] += basis[k] * p[0];
+					rowSum[k][1] += basis[k] * p[1];
+					rowSum[k][2] += basis[k] * p[2];
+				}
+			}
+
+			// Every texel on a row covers the same solid angle.
+			const double weight = texelSolidAngle * cosLat;
+			for (int k = 0; k < 9; k++)
+			{
+				out[k][0] += rowSum[k][0] * weight;
+				out[k][1] += rowSum[k][1] * weight;
+				out[k][2] += rowSum[k][2] * weight;
+			}
+		}
+	}
+
+	SHCoefficients SphericalHarmonics::ProjectEquirectangular(const float* data, int32 width, int32 height, int32 channels, JobSystem* jobSystem)
+	{
+		SHCoefficients result;
+
+		if (data == nullptr || width <= 0 || height <= 0 || channels < 3)
+			return result;
+
+		// Longitude only depends on the column, so trig is computed once per column.
+		std::vector<float> cosPhi(width), sinPhi(width);
+		for (int32 i = 0; i < width; i++)
+		{
+			const double phi = ((i + 0.5) / width - 0.5) * 2.0 * SH_PI;
+			cosPhi[i] = (float)std::cos(phi);
+			sinPhi[i] = (float)std::sin(phi);
+		}
+
+		// Each job writes its own partial sum, partials are added in order so results are deterministic.
+		const int32 jobCount = jobSystem == nullptr || jobSystem->GetWorkerCount() == 0 ? 1 : std::min(height, (int32)jobSystem->GetThreadCount() * 4);
+		const int32 rowsPerJob = (height + jobCount - 1) / jobCount;
+		std::vector<double> partials((size_t)jobCount * 27, 0.0);
+
+		if (jobCount == 1)
+			ProjectRows(data, width, height, channels, 0, height, cosPhi.data(), sinPhi.data(), reinterpret_cast<double(*)[3]>(partials.data()));
+		else
+		{
+			JobCounter counter;
+
+			for (int32 job = 0; job < jobCount; job++)
+			{
+				jobSystem->Run([&, job]()
+					{
+						const int32 rowBegin = std::min(height, job * rowsPerJob);
+						const int32 rowEnd = std::min(height, rowBegin + rowsPerJob);
+						ProjectRows(data, width, height, channels, rowBegin, rowEnd, cosPhi.data(), sinPhi.data(), reinterpret_cast<double(*)[3]>(partials.data() + (size_t)job * 27));
+					}, &counter);
+			}
+
+			jobSystem->Wait(counter);
+		}
+
+		for (int32 job = 0; job < jobCount; job++)
+		{
+			for (int k = 0; k < 9; k++)
+			{
+				for (int c = 0; c < 3; c++)
+					result.m_values[k][c] += (float)partials[(size_t)job * 27 + k * 3 + c];
+			}
+		}
+
+		return result;
+	}
+
+	void SphericalHarmonics::EvaluateBasis(const Vector3& dir, float basis[9])
+	{
+		basis[0] = SH_Y00;
+		basis[1] = SH_Y1 * dir.y;
+		basis[2] = SH_Y1 * dir.z;
+		basis[3] = SH_Y1 * dir.x;
+		basis[4] = SH_Y2 * dir.x * dir.y;
+		basis[5] = SH_Y2 * dir.y * dir.z;
+		basis[6] = SH_Y20 * (3.0f * dir.z * dir.z - 1.0f);
+		basis[7] = SH_Y2 * dir.x * dir.z;
+		basis[8] = SH_Y22 * (dir.x * dir.x - dir.y * dir.y);
+	}
+
+	Vector3 SphericalHarmonics::EvaluateIrradiance(const SHCoefficients& sh, const Vector3& normal)
+	{
+		float basis[9];
+		EvaluateBasis(normal, basis);
+
+		Vector3 result = Vector3::Zero;
+		for (int k = 0; k < 9; k++)
+		{
+			const float weight = basis[k] * s_bandScale[k];
+			result.x += sh.m_values[k][0] * weight;
+			result.y += sh.m_values[k][1] * weight;
+			result.z += sh.m_values[k][2] * weight;
+		}
+
+		// Clamp negative lobes caused by ringing around very bright sources.
+		return result.Max(Vector3::Zero);
+	}
+
+	Vector3 SphericalHarmonics::GetCubemapDirection(uint32 face, int32 x, int32 y, int32 faceSize)
+	{
+		const float sc = 2.0f * (x + 0.5f) / faceSize - 1.0f;
+		const float tc = 2.0f * (y + 0.5f) / faceSize - 1.0f;
+		Vector3 dir;
+
+		switch (face)
+		{
+		case 0: dir = Vector3(1.0f, -tc, -sc); break;
+		case 1: dir = Vector3(-1.0f, -tc, sc); break;
+		case 2: dir = Vector3(sc, 1.0f, tc); break;
+		case 3: dir = Vector3(sc, -1.0f, -tc); break;
+		case 4: dir = Vector3(sc, -tc, 1.0f); break;
+		default: dir = Vector3(-sc, -tc, -1.0f); break;
+		}
+
+		return dir.Normalized();
+	}
+
+	void SphericalHarmonics::GenerateIrradianceCubemap(const SHCoefficients& sh, int32 faceSize, std::vector<std::vector<float>>& faces)
+	{
+		faces.resize(6);
+
+		for (uint32 face = 0; face < 6; face++)
+		{
+			std::vector<float>& pixels = faces[face];
+			pixels.resize((size_t)faceSize * faceSize * 3);
+
+			for (int32 y = 0; y < faceSize; y++)
+			{
+				for (int32 x = 0; x < faceSize; x++)
+				{
+					const Vector3 irradiance = EvaluateIrradiance(sh, GetCubemapDirection(face, x, y, faceSize));
+					const size_t index = ((size_t)y * faceSize + x) * 3;
+					pixels[index] = irradiance.x;
+					pixels[index + 1] = irradiance.y;
+					pixels[index + 2] = irradiance.z;
+				}
+			}
+		}
+	}
+}
@@ -28,16 +28,39 @@ SOFTWARE.
 
 #include "Rendering/Texture.hpp"  
 #include "Rendering/ArrayBitmap.hpp"
+#include "Rendering/MipmapGenerator.hpp"
 #include <stdio.h>
 #include <cereal/archives/binary.hpp>
 #include <fstream>
 
 namespace LinaEngine::Graphics
 {
-	Texture::~Texture()
+	// Approximate GPU memory of a 2D texture, compressed textures are assumed to be 4:1.
+	static size_t CalculateMemorySize(Vector2 size, SamplerParameters& samplerParams, bool compressed)
 	{
-		m_id = m_renderDevice->ReleaseTexture2D(m_id);
+		size_t bytesPerPixel = 4;
+		PixelFormat format = samplerParams.m_textureParams.m_internalPixelFormat;
+
+		if (format == PixelFormat::FORMAT_R) bytesPerPixel = 1;
+		else if (format == PixelFormat::FORMAT_RG || format == PixelFormat::FORMAT_DEPTH16) bytesPerPixel = 2;
+		else if (format == PixelFormat::FORMAT_RGB || format == PixelFormat::FORMAT_SRGB) bytesPerPixel = 3;
+		else if (format == PixelFormat::FORMAT_RGB16F) bytesPerPixel = 6;
+		else if (format == PixelFormat::FORMAT_RGBA16F) bytesPerPixel = 8;
+
+		size_t memorySize = (size_t)size.x * (size_t)size.y * bytesPerPixel;
 
+		// Mip chain adds a third.
+		if (samplerParams.m_textureParams.m_generateMipMaps)
+			memorySize += memorySize / 3;
+
+		return compressed ? memorySize / 4 : memorySize;
+	}
+
+	Texture::~Texture()
+	{
+		// Textures that are still being loaded asynchronously have no device resources yet.
+		if (m_renderDevice != nullptr)
+			m_id = m_renderDevice->ReleaseTexture2D(m_id);
 	}
 
 	Texture& Texture::Construct(RenderDevice& deviceIn, const ArrayBitmap& data, SamplerParameters samplerParams, bool shouldCompress, const std::string& path)
@@ -52,10 +75,33 @@ namespace LinaEngine::Graphics
 		m_hasMipMaps = samplerParams.m_textureParams.m_generateMipMaps;
 		m_isEmpty = false;
 		m_path = path;
+		m_memorySize = CalculateMemorySize(m_size, samplerParams, shouldCompress);
 		return *this;
 	}
 
 
+	Texture& Texture::ConstructMipmapped(RenderDevice& deviceIn, const ArrayBitmap& data, const std::vector<MipLevel>& mipLevels, SamplerParameters samplerParams, bool shouldCompress, const std::string& path)
+	{
+		std::vector<const void*> levels;
+		levels.push_back(data.GetPixelArray());
+
+		for (const MipLevel& level : mipLevels)
+			levels.push_back(level.m_pixels.data());
+
+		m_renderDevice = &deviceIn;
+		m_size = Vector2(data.GetWidth(), data.GetHeight());
+		m_bindMode = TextureBindMode::BINDTEXTURE_TEXTURE2D;
+		m_sampler.Construct(deviceIn, samplerParams, m_bindMode);
+		m_id = m_renderDevice->CreateTexture2DMipmapped(m_size, levels, samplerParams, shouldCompress);
+		m_sampler.SetTargetTextureID(m_id);
+		m_isCompressed = shouldCompress;
+		m_hasMipMaps = true;
+		m_isEmpty = false;
+		m_path = path;
+		m_memorySize = CalculateMemorySize(m_size, samplerParams, shouldCompress);
+		return *this;
+	}
+
 	Texture& Texture::ConstructCubemap(RenderDevice& deviceIn, SamplerParameters samplerParams, const std::vector<ArrayBitmap*>& data, bool shouldCompress, const std::string& path)
 	{
 		if (data.size() != 6)
@@ -96,6 +142,29 @@ namespace LinaEngine::Graphics
 		m_hasMipMaps = samplerParams.m_textureParams.m_generateMipMaps;
 		m_isEmpty = false;
 		m_path = path;
+		m_memorySize = CalculateMemorySize(m_size, samplerParams, false);
+		return *this;
+	}
+
+	Texture& Texture::ConstructCubemapHDRI(RenderDevice& deviceIn, SamplerParameters samplerParams, Vector2 size, const std::vector<float*>& data, uint32 mipCount, const std::string& path)
+	{
+		if (data.size() != (size_t)mipCount * 6)
+		{
+			LINA_CORE_WARN("Could not construct HDRI cubemap texture! Data size needs to be 6 per mip level, returning un-constructed texture...");
+			return *this;
+		}
+
+		m_renderDevice = &deviceIn;
+		m_size = size;
+		m_bindMode = TextureBindMode::BINDTEXTURE_CUBEMAP;
+		m_sampler.Construct(deviceIn, samplerParams, m_bindMode);
+		m_id = m_renderDevice->CreateCubemapTextureHDRI(m_size, samplerParams, data, mipCount);
+		m_sampler.SetTargetTextureID(m_id);
+		m_isCompressed = false;
+		m_hasMipMaps = mipCount > 1;
+		m_isEmpty = false;
+		m_path = path;
+		m_memorySize = CalculateMemorySize(m_size, samplerParams, false) * 6;
 		return *this;
 	}
 
@@ -166,6 +235,16 @@ namespace LinaEngine::Graphics
 		return *this;
 	}
 
+	void Texture::Release()
+	{
+		if (m_renderDevice != nullptr)
+			m_id = m_renderDevice->ReleaseTexture2D(m_id);
+
+		m_sampler.Release();
+		m_isEmpty = true;
+		m_memorySize = 0;
+	}
+
 	SamplerParameters Texture::LoadParameters(const std::string& path)
 	{
 		SamplerParameters params;
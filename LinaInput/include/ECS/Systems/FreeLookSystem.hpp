@@ -52,11 +52,7 @@ namespace LinaEngine::ECS
 	{
 	public:
 
-		void Construct(ECSRegistry& registry, LinaEngine::Input::InputEngine& inputEngineIn)
-		{
-			BaseECSSystem::Construct(registry);
-			m_inputEngine = &inputEngineIn;
-		}
+		void Construct(ECSRegistry& registry, LinaEngine::Input::InputEngine& inputEngineIn);
 
 		virtual void UpdateComponents(float delta) override;
 
@@ -44,8 +44,7 @@ Timestamp: 4/13/2019 10:02:03 PM
 
 namespace LinaEngine::Input
 {
-#define LINA_ACTION_CALLBACK(x) std::bind(&x, this)
-#define LINA_ACTION_CALLBACK_PARAM1(x) std::bind(&x, this, std::placeholders::_1)
+#define LINA_ACTION_CALLBACK(x) LinaEngine::Action::Delegate<void()>::Bind<&x>(this)
 
 	class InputMouseButtonBinder : public IInputSubscriber
 	{
@@ -57,8 +56,8 @@ namespace LinaEngine::Input
 		// Upon initialization we immediately listen to target mouse events.
 		void Initialize(InputCode::Mouse button = InputCode::Mouse::MouseUnknown)
 		{
-			SubscribeMousePressedAction("buttonDown", LINA_ACTION_CALLBACK(InputMouseButtonBinder::OnButtonDown), button);
-			SubscribeMouseReleasedAction("buttonUp", LINA_ACTION_CALLBACK(InputMouseButtonBinder::OnButtonUp), button);
+			SubscribeMousePressedAction(LINA_ACTION_CALLBACK(InputMouseButtonBinder::OnButtonDown), button);
+			SubscribeMouseReleasedAction(LINA_ACTION_CALLBACK(InputMouseButtonBinder::OnButtonUp), button);
 		}
 
 		void OnButtonDown() { m_isPressed = true; }
@@ -78,12 +77,12 @@ namespace LinaEngine::Input
 		virtual ~InputKeyAxisBinder() {};
 
 		// Upon initialization we immediately listen to target key events.
-		void Initialize(InputCode::Key positive, InputCode::Key negative, const std::string& id)
+		void Initialize(InputCode::Key positive, InputCode::Key negative)
 		{
-			SubscribeKeyPressedAction(id + "posD", LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnPositiveKeyDown), positive);
-			SubscribeKeyPressedAction(id + "negD", LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnNegativeKeyDown), negative);
-			SubscribeKeyReleasedAction(id + "posU", LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnPositiveKeyUp), positive);
-			SubscribeKeyReleasedAction(id + "negU", LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnNegativeKeyUp), negative);
+			SubscribeKeyPressedAction(LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnPositiveKeyDown), positive);
+			SubscribeKeyPressedAction(LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnNegativeKeyDown), negative);
+			SubscribeKeyReleasedAction(LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnPositiveKeyUp), positive);
+			SubscribeKeyReleasedAction(LINA_ACTION_CALLBACK(InputKeyAxisBinder::OnNegativeKeyUp), negative);
 		}
 
 		void OnPositiveKeyDown()
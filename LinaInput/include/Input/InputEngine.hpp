@@ -41,7 +41,8 @@ Timestamp: 4/14/2019 7:46:20 PM
 
 #include "Utility/Math/Vector.hpp"
 #include "Input/InputCommon.hpp"
-#include "Actions/ActionDispatcher.hpp"
+#include "Input/InputEvents.hpp"
+#include "Actions/EventBus.hpp"
 #include "InputDevice.hpp"
 #include "InputAxisBinder.hpp"
 namespace LinaEngine::Input
@@ -88,20 +89,20 @@ namespace LinaEngine::Input
 		void DispatchKeyAction(InputCode::Key key, int action)
 		{
 			if (action == 1)
-				s_inputDispatcher.DispatchAction<InputCode::Key>(LinaEngine::Action::ActionType::KeyPressed, key);
+				s_inputEventBus.Dispatch(KeyPressedEvent{ key });
 			else if (action == 0)
-				s_inputDispatcher.DispatchAction<InputCode::Key>(LinaEngine::Action::ActionType::KeyReleased, key);
+				s_inputEventBus.Dispatch(KeyReleasedEvent{ key });
 		}
 
 		void DispatchMouseAction(InputCode::Mouse button, int action)
 		{
 			if (action == 1)
-				s_inputDispatcher.DispatchAction<InputCode::Mouse>(LinaEngine::Action::ActionType::MouseButtonPressed, button);
+				s_inputEventBus.Dispatch(MouseButtonPressedEvent{ button });
 			else if (action == 0)
-				s_inputDispatcher.DispatchAction<InputCode::Mouse>(LinaEngine::Action::ActionType::MouseButtonReleased, button);
+				s_inputEventBus.Dispatch(MouseButtonReleasedEvent{ button });
 		}
 
-		static Action::ActionDispatcher& GetInputDispatcher() { return s_inputDispatcher; }
+		static Action::EventBus& GetInputEventBus() { return s_inputEventBus; }
 
 	private:
 
@@ -109,7 +110,7 @@ namespace LinaEngine::Input
 		InputKeyAxisBinder m_horizontalKeyAxis;
 		InputKeyAxisBinder m_verticalKeyAxis;
 
-		static Action::ActionDispatcher s_inputDispatcher;
+		static Action::EventBus s_inputEventBus;
 		InputDevice* m_inputDevice = nullptr;
 
 		DISALLOW_COPY_ASSIGN_MOVE(InputEngine)
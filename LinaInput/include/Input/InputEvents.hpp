@@ -0,0 +1,72 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Class: InputEvents
+
+Events the input engine dispatches through its EventBus.
+
+Timestamp: 11/5/2020 3:38:27 PM
+*/
+
+#pragma once
+
+#ifndef InputEvents_HPP
+#define InputEvents_HPP
+
+#include "Input/InputMappings.hpp"
+#include "Actions/Action.hpp"
+
+namespace LinaEngine::Input
+{
+	struct KeyPressedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::KeyPressed;
+		InputCode::Key m_key;
+	};
+
+	struct KeyReleasedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::KeyReleased;
+		InputCode::Key m_key;
+	};
+
+	struct MouseButtonPressedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::MouseButtonPressed;
+		InputCode::Mouse m_button;
+	};
+
+	struct MouseButtonReleasedEvent
+	{
+		static constexpr Action::ActionType s_actionType = Action::ActionType::MouseButtonReleased;
+		InputCode::Mouse m_button;
+	};
+}
+
+#endif
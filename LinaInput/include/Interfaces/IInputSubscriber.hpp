@@ -40,8 +40,8 @@ Timestamp: 4/4/2019 2:29:37 AM
 #define IInputSubscriber_HPP
 
 #include "Input/InputMappings.hpp"
-#include <string>
-#include <functional>
+#include "Actions/EventBus.hpp"
+#include <vector>
 
 namespace LinaEngine::Input
 {
@@ -51,21 +51,35 @@ namespace LinaEngine::Input
 	public:
 
 		IInputSubscriber() { };
-		virtual ~IInputSubscriber() {};
+		virtual ~IInputSubscriber();
 
 	protected:
 		
-		void SubscribeKeyPressedAction(const std::string& handlerID, std::function<void(InputCode::Key)>&& cb, InputCode::Key key = InputCode::Key::Unknown);
-		void SubscribeKeyReleasedAction(const std::string& handlerID, std::function<void(InputCode::Key)>&& cb, InputCode::Key key = InputCode::Key::Unknown);
-		void SubscribeMouseButtonPressedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse button = InputCode::Mouse::MouseUnknown);
-		void SubscribeMouseButtonReleasedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse button = InputCode::Mouse::MouseUnknown);
-		void SubscribeMousePressedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse mouse = InputCode::Mouse::MouseUnknown);
-		void SubscribeMouseReleasedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse mouse = InputCode::Mouse::MouseUnknown);
-		
+		// Unknown key & button values listen to every key or button, subscriptions end with the subscriber.
+		void SubscribeKeyPressedAction(const Action::Delegate<void()>& cb, InputCode::Key key = InputCode::Key::Unknown);
+		void SubscribeKeyReleasedAction(const Action::Delegate<void()>& cb, InputCode::Key key = InputCode::Key::Unknown);
+		void SubscribeMouseButtonPressedAction(const Action::Delegate<void()>& cb, InputCode::Mouse button = InputCode::Mouse::MouseUnknown);
+		void SubscribeMouseButtonReleasedAction(const Action::Delegate<void()>& cb, InputCode::Mouse button = InputCode::Mouse::MouseUnknown);
+		void SubscribeMousePressedAction(const Action::Delegate<void()>& cb, InputCode::Mouse mouse = InputCode::Mouse::MouseUnknown);
+		void SubscribeMouseReleasedAction(const Action::Delegate<void()>& cb, InputCode::Mouse mouse = InputCode::Mouse::MouseUnknown);
+
+	private:
+
+		struct InputSubscription
+		{
+			Action::Delegate<void()> m_callback;
+			Action::EventToken m_token;
+			int m_code = 0;
+			bool m_useCode = false;
+		};
+
+		uint32 AddSubscription(const Action::Delegate<void()>& cb, int code, bool useCode);
+		void OnInputEvent(uint32 index, int code);
 
 	private:
 
+		std::vector<InputSubscription> m_subscriptions;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -35,6 +35,19 @@ SOFTWARE.
 
 namespace LinaEngine::ECS
 {
+	void FreeLookSystem::Construct(ECSRegistry& registry, LinaEngine::Input::InputEngine& inputEngineIn)
+	{
+		BaseECSSystem::Construct(registry);
+		m_inputEngine = &inputEngineIn;
+
+		// Changing the cursor mode calls into the windowing API.
+		SetName("FreeLookSystem");
+		WritesComponent<TransformComponent>();
+		WritesComponent<FreeLookComponent>();
+		WritesResource<LinaEngine::Input::InputEngine>();
+		SetMainThreadOnly(true);
+	}
+
 	float targetXAngle = 0.0f;
 	float targetYAngle = 0.0f;
 
@@ -30,14 +30,13 @@ SOFTWARE.
 
 namespace LinaEngine::Input
 {
-	Action::ActionDispatcher InputEngine::s_inputDispatcher;
+	Action::EventBus InputEngine::s_inputEventBus;
 
 	void InputEngine::Initialize(void* contextWindowPointer, InputDevice* inputDevice)
 	{
 		m_inputDevice = inputDevice;
-		s_inputDispatcher.Initialize(Action::ActionType::InputActionsStartIndex, Action::ActionType::InputActionsEndIndex);
-		m_horizontalKeyAxis.Initialize(InputCode::Key::D, InputCode::Key::A, "##lina_horBinder");
-		m_verticalKeyAxis.Initialize(InputCode::Key::W, InputCode::Key::S, "##lina_verBinder");
+		m_horizontalKeyAxis.Initialize(InputCode::Key::D, InputCode::Key::A);
+		m_verticalKeyAxis.Initialize(InputCode::Key::W, InputCode::Key::S);
 		m_inputDevice->Initialize(contextWindowPointer);
 	}
 }
\ No newline at end of file
@@ -20,55 +20,63 @@ Timestamp: 10/18/2020 2:53:28 PM
 
 #include "Interfaces/IInputSubscriber.hpp"
 #include "Input/InputEngine.hpp"
-#include "Actions/Action.hpp"
 
 namespace LinaEngine::Input
 {
-		void IInputSubscriber::SubscribeKeyPressedAction(const std::string& handlerID, std::function<void(InputCode::Key)>&& cb, InputCode::Key key)
+		IInputSubscriber::~IInputSubscriber()
 		{
-			if (key != InputCode::Key::Unknown)
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Key>(handlerID, LinaEngine::Action::ActionType::KeyPressed, cb, key);
-			else
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Key>(handlerID, LinaEngine::Action::ActionType::KeyPressed, cb);
+			for (InputSubscription& subscription : m_subscriptions)
+				InputEngine::GetInputEventBus().Unsubscribe(subscription.m_token);
 		}
 
-		void IInputSubscriber::SubscribeKeyReleasedAction(const std::string& handlerID, std::function<void(InputCode::Key)>&& cb, InputCode::Key key)
+		void IInputSubscriber::SubscribeKeyPressedAction(const Action::Delegate<void()>& cb, InputCode::Key key)
 		{
-			if (key != InputCode::Key::Unknown)
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Key>(handlerID, LinaEngine::Action::ActionType::KeyReleased, cb, key);
-			else
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Key>(handlerID, LinaEngine::Action::ActionType::KeyReleased, cb);
+			const uint32 index = AddSubscription(cb, key, key != InputCode::Key::Unknown);
+			m_subscriptions[index].m_token = InputEngine::GetInputEventBus().Subscribe<KeyPressedEvent>([this, index](const KeyPressedEvent& event) { OnInputEvent(index, event.m_key); });
 		}
 
-		void IInputSubscriber::SubscribeMouseButtonPressedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse button)
+		void IInputSubscriber::SubscribeKeyReleasedAction(const Action::Delegate<void()>& cb, InputCode::Key key)
 		{
-			if (button != InputCode::Mouse::MouseUnknown)
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonPressed, cb, button);
-			else
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonPressed, cb);
+			const uint32 index = AddSubscription(cb, key, key != InputCode::Key::Unknown);
+			m_subscriptions[index].m_token = InputEngine::GetInputEventBus().Subscribe<KeyReleasedEvent>([this, index](const KeyReleasedEvent& event) { OnInputEvent(index, event.m_key); });
 		}
 
-		void IInputSubscriber::SubscribeMouseButtonReleasedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse button)
+		void IInputSubscriber::SubscribeMouseButtonPressedAction(const Action::Delegate<void()>& cb, InputCode::Mouse button)
 		{
-			if (button != InputCode::Mouse::MouseUnknown)
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonReleased, cb, button);
-			else
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonReleased, cb);
+			const uint32 index = AddSubscription(cb, button, button != InputCode::Mouse::MouseUnknown);
+			m_subscriptions[index].m_token = InputEngine::GetInputEventBus().Subscribe<MouseButtonPressedEvent>([this, index](const MouseButtonPressedEvent& event) { OnInputEvent(index, event.m_button); });
 		}
 
-		void IInputSubscriber::SubscribeMousePressedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse mouse )
+		void IInputSubscriber::SubscribeMouseButtonReleasedAction(const Action::Delegate<void()>& cb, InputCode::Mouse button)
 		{
-			if (mouse != InputCode::Mouse::MouseUnknown)
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonPressed, cb, mouse);
-			else
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonPressed, cb);
+			const uint32 index = AddSubscription(cb, button, button != InputCode::Mouse::MouseUnknown);
+			m_subscriptions[index].m_token = InputEngine::GetInputEventBus().Subscribe<MouseButtonReleasedEvent>([this, index](const MouseButtonReleasedEvent& event) { OnInputEvent(index, event.m_button); });
 		}
 
-		void IInputSubscriber::SubscribeMouseReleasedAction(const std::string& handlerID, std::function<void(InputCode::Mouse)>&& cb, InputCode::Mouse mouse )
+		void IInputSubscriber::SubscribeMousePressedAction(const Action::Delegate<void()>& cb, InputCode::Mouse mouse)
 		{
-			if (mouse != InputCode::Mouse::MouseUnknown)
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonReleased, cb, mouse);
-			else
-				InputEngine::GetInputDispatcher().SubscribeAction<InputCode::Mouse>(handlerID, LinaEngine::Action::ActionType::MouseButtonReleased, cb);
+			SubscribeMouseButtonPressedAction(cb, mouse);
 		}
-}
\ No newline at end of file
+
+		void IInputSubscriber::SubscribeMouseReleasedAction(const Action::Delegate<void()>& cb, InputCode::Mouse mouse)
+		{
+			SubscribeMouseButtonReleasedAction(cb, mouse);
+		}
+
+		uint32 IInputSubscriber::AddSubscription(const Action::Delegate<void()>& cb, int code, bool useCode)
+		{
+			InputSubscription subscription;
+			subscription.m_callback = cb;
+			subscription.m_code = code;
+			subscription.m_useCode = useCode;
+			m_subscriptions.push_back(subscription);
+			return (uint32)m_subscriptions.size() - 1;
+		}
+
+		void IInputSubscriber::OnInputEvent(uint32 index, int code)
+		{
+			const InputSubscription& subscription = m_subscriptions[index];
+			if (!subscription.m_useCode || subscription.m_code == code)
+				subscription.m_callback();
+		}
+}
@@ -0,0 +1,62 @@
+/*
+This file is a part of: Lina Engine
+https://github.com/inanevin/LinaEngine
+
+Author: Inan Evin
+http://www.inanevin.com
+
+Copyright (c) [2018-2020] [Inan Evin]
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+Class: Main
+
+Turns binary logs written with --log-binary back into text.
+Usage: LinaLogDecoder <input.linalog> [output.txt]
+
+Output defaults to the input path with .txt appended. Exits with 1 if the input isn't a binary log.
+
+Timestamp: 11/5/2020 2:16:44 PM
+*/
+
+#include "Utility/Log.hpp"
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: LinaLogDecoder <input.linalog> [output.txt]" << std::endl;
+		return 1;
+	}
+
+	const std::string inputPath = argv[1];
+	const std::string outputPath = argc > 2 ? argv[2] : inputPath + ".txt";
+
+	if (!LinaEngine::Log::DecodeBinaryLog(inputPath, outputPath))
+	{
+		std::cout << inputPath << " is not a binary log or could not be read." << std::endl;
+		return 1;
+	}
+
+	std::cout << "Decoded " << inputPath << " into " << outputPath << std::endl;
+	return 0;
+}
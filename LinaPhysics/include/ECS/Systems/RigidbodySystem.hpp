@@ -59,11 +59,7 @@ namespace LinaEngine::ECS
 
 		virtual void UpdateComponents(float delta) override;
 
-		void Construct(ECSRegistry& registry, LinaEngine::Physics::PhysicsEngine* physicsEngine) 
-		{ 
-			BaseECSSystem::Construct(registry);
-			m_physicsEngine = physicsEngine; 
-		}
+		void Construct(ECSRegistry& registry, LinaEngine::Physics::PhysicsEngine* physicsEngine);
 
 	private:
 
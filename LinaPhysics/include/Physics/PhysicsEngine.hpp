@@ -41,6 +41,7 @@ Timestamp: 5/1/2019 2:35:28 AM
 
 #include "ECS/Systems/RigidbodySystem.hpp"
 #include "PhysicsGizmoDrawer.hpp"
+#include "Utility/HandleAllocator.hpp"
 #include "btBulletDynamicsCommon.h"
 
 namespace LinaEngine
@@ -81,6 +82,7 @@ namespace LinaEngine::Physics
 
 		btRigidBody* GetActiveRigidbody(int id) { return m_bodies[id]; }
 		void SetDebugDraw(bool enabled) { m_debugDrawEnabled = enabled; }
+		LinaEngine::ECS::ECSSystemList& GetPhysicsPipeline() { return m_physicsPipeline; }
 
 	private:
 
@@ -100,6 +102,7 @@ namespace LinaEngine::Physics
 		LinaEngine::ECS::ECSSystemList m_physicsPipeline;
 
 		std::map<int, btRigidBody*> m_bodies;		
+		HandleAllocator m_bodyHandles;
 		bool m_debugDrawEnabled = false;
 
 		DISALLOW_COPY_ASSIGN_MOVE(PhysicsEngine)
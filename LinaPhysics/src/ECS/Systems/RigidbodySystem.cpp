@@ -29,10 +29,22 @@ SOFTWARE.
 #include "ECS/Systems/RigidbodySystem.hpp"
 #include "ECS/Components/TransformComponent.hpp"
 #include "ECS/Components/RigidbodyComponent.hpp"
+#include "ECS/TransformHierarchy.hpp"
 #include "Physics/PhysicsEngine.hpp"
 
 namespace LinaEngine::ECS
 {
+	void RigidbodySystem::Construct(ECSRegistry& registry, LinaEngine::Physics::PhysicsEngine* physicsEngine)
+	{
+		BaseECSSystem::Construct(registry);
+		m_physicsEngine = physicsEngine;
+
+		SetName("RigidbodySystem");
+		ReadsComponent<RigidbodyComponent>();
+		WritesComponent<TransformComponent>();
+		ReadsResource<LinaEngine::Physics::PhysicsEngine>();
+	}
+
 	void RigidbodySystem::UpdateComponents(float delta)
 	{
 		auto view = m_ecs->view<TransformComponent, RigidbodyComponent>();
@@ -52,14 +64,21 @@ namespace LinaEngine::ECS
 			btTransform btTrans;
 			rb->getMotionState()->getWorldTransform(btTrans);
 
-			transform.transform.m_location.x = btTrans.getOrigin().getX();
-			transform.transform.m_location.y = btTrans.getOrigin().getY();
-			transform.transform.m_location.z = btTrans.getOrigin().getZ();
+			const Vector3 location(btTrans.getOrigin().getX(), btTrans.getOrigin().getY(), btTrans.getOrigin().getZ());
+			const Quaternion rotation(btTrans.getRotation().getX(), btTrans.getRotation().getY(), btTrans.getRotation().getZ(), btTrans.getRotation().getW());
+
+			if (transform.m_parent == entt::null)
+			{
+				transform.transform.m_location = location;
+				transform.transform.m_rotation = rotation;
+				continue;
+			}
 
-			transform.transform.m_rotation.x = btTrans.getRotation().getX();
-			transform.transform.m_rotation.y = btTrans.getRotation().getY();
-			transform.transform.m_rotation.z = btTrans.getRotation().getZ();
-			transform.transform.m_rotation.w = btTrans.getRotation().getW();
+			// The body is in world space, parented transforms are stored relative to their parent.
+			const Matrix parentWorld = TransformHierarchy::CalculateWorldMatrix(*m_ecs, transform.m_parent);
+			const glm::vec4 localLocation = parentWorld.InverseAffine() * glm::vec4(location.x, location.y, location.z, 1.0f);
+			transform.transform.m_location = Vector3(localLocation.x, localLocation.y, localLocation.z);
+			transform.transform.m_rotation = Quaternion(parentWorld.GetRotation().Inverse() * rotation);
 		}
 	}
 }
@@ -30,14 +30,31 @@ SOFTWARE.
 #include "Utility/Log.hpp"
 #include "ECS/Components/RigidbodyComponent.hpp"
 #include "ECS/Components/TransformComponent.hpp"
+#include "ECS/TransformHierarchy.hpp"
 #include "Utility/UtilityFunctions.hpp"
 #include "Utility/Math/Color.hpp"
+#include "PackageManager/PAMMemory.hpp"
+#include "Core/Profiler.hpp"
+#include "LinearMath/btAlignedAllocator.h"
 
 namespace LinaEngine::Physics
 {
+	static void* BulletAllocate(size_t size, int alignment)
+	{
+		return Memory::malloc(size, (uint32)alignment, MemorySubsystem::Physics);
+	}
+
+	static void BulletFree(void* ptr)
+	{
+		Memory::free(ptr);
+	}
+
 	PhysicsEngine::PhysicsEngine()
 	{
 		LINA_CORE_TRACE("[Constructor] -> Physics Engine ({0})", typeid(*this).name());
+
+		// Bodies, shapes, motion states & the world's internals all go through the physics heap.
+		btAlignedAllocSetCustomAligned(BulletAllocate, BulletFree);
 	}
 
 	PhysicsEngine::~PhysicsEngine()
@@ -112,7 +129,12 @@ namespace LinaEngine::Physics
 	void PhysicsEngine::Tick(float fixedDelta)
 	{
 		// Update physics.
-		m_world->stepSimulation(fixedDelta, 10);
+		{
+			LINA_PROFILE_SCOPE("Step Simulation");
+			m_world->stepSimulation(fixedDelta, 10);
+		}
+
+		LINA_PROFILE_SCOPE("Physics Pipeline");
 		m_physicsPipeline.UpdateSystems(fixedDelta);
 	}
 
@@ -135,7 +157,12 @@ namespace LinaEngine::Physics
 
 		btTransform transform;
 		transform.setIdentity();
-		transform.setOrigin(btVector3(tr.transform.m_location.x, tr.transform.m_location.y, tr.transform.m_location.z));
+		// Bodies are simulated in world space, the hierarchy may not have run yet so parented ones walk their chain.
+		const Matrix world = tr.m_parent == entt::null ? Matrix::TransformMatrix(tr.transform.m_location, tr.transform.m_rotation, tr.transform.m_scale)
+			: LinaEngine::ECS::TransformHierarchy::CalculateWorldMatrix(reg, ent);
+		const Quaternion rotation = world.GetRotation();
+		transform.setOrigin(btVector3(world[3][0], world[3][1], world[3][2]));
+		transform.setRotation(btQuaternion(rotation.x, rotation.y, rotation.z, rotation.w));
 
 		btScalar mass(rb.m_mass);
 
@@ -156,7 +183,7 @@ namespace LinaEngine::Physics
 
 		// Register the body to the map and assign it to the world
 		// so that its simulated.
-		int id = LinaEngine::Utility::GetUniqueID();
+		int id = m_bodyHandles.Allocate();
 		m_bodies[id] = body;
 		rb.m_bodyID = id;
 
@@ -175,6 +202,7 @@ namespace LinaEngine::Physics
 		m_world->removeRigidBody(rb);
 
 		m_bodies.erase(rbComp.m_bodyID);
+		m_bodyHandles.Release(rbComp.m_bodyID);
 	}
 
 	void PhysicsEngine::OnRigidbodyUpdated(entt::registry& reg, entt::entity ent)
@@ -0,0 +1,91 @@
+/*
+Author: Inan Evin
+www.inanevin.com
+
+Copyright 2018 Inan Evin
+
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, 
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions 
+and limitations under the License.
+
+Class: StressTestLevel
+
+Procedurally built level for measuring the engine under load. Entity, light, rigidbody, sprite
+& transparent object counts are configurable and everything is placed from a seeded generator,
+so the same settings always build the same level.
+
+Timestamp: 11/5/2020 9:14:03 AM
+
+*/
+
+#pragma once
+
+#ifndef StressTestLevel_HPP
+#define StressTestLevel_HPP
+
+#include "World/Level.hpp"
+#include "ECS/ECSSystem.hpp"
+#include "Utility/Math/Vector.hpp"
+#include <random>
+#include <vector>
+
+struct StressTestSettings
+{
+	uint32 m_entityCount = 1000;
+	uint32 m_materialCount = 16;
+	uint32 m_pointLightCount = 16;
+	uint32 m_spotLightCount = 8;
+	uint32 m_rigidbodyCount = 200;
+	uint32 m_spriteCount = 200;
+	uint32 m_transparentCount = 100;
+	uint32 m_moverCount = 100;
+	uint32 m_seed = 1;
+};
+
+class StressTestLevel : public LinaEngine::World::Level
+{
+public:
+
+	StressTestLevel() {};
+	~StressTestLevel() {};
+
+	// Reads --stress [entities] & the optional per feature counts, returns false if --stress is not given.
+	static bool ParseSettings(StressTestSettings& settings);
+
+	void SetSettings(const StressTestSettings& settings) { m_settings = settings; }
+	const StressTestSettings& GetSettings() const { return m_settings; }
+
+	virtual bool Install(bool loadFromFile, const std::string& path, const std::string& levelName) override;
+	virtual void Initialize() override;
+	virtual void Tick(float delta) override;
+
+private:
+
+	void CreateMaterials(std::mt19937& rng);
+	void SpawnCamera();
+	void SpawnMeshes(std::mt19937& rng);
+	void SpawnLights(std::mt19937& rng);
+	void SpawnRigidbodies(std::mt19937& rng);
+	void SpawnSprites(std::mt19937& rng);
+	void SpawnTransparentObjects(std::mt19937& rng);
+	LinaEngine::Vector3 RandomLocation(std::mt19937& rng, float minHeight, float maxHeight);
+
+private:
+
+	StressTestSettings m_settings;
+	float m_areaExtent = 0.0f;
+	float m_time = 0.0f;
+	std::vector<int> m_opaqueMaterials;
+	std::vector<int> m_transparentMaterials;
+	int m_spriteMaterial = -1;
+
+	// Movers bob around their spawn location so transforms, bounds & batches change every frame.
+	std::vector<LinaEngine::ECS::ECSEntity> m_movers;
+	std::vector<LinaEngine::Vector3> m_moverOrigins;
+};
+
+#endif
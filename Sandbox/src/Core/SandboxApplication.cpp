@@ -23,6 +23,7 @@ Timestamp: 12/29/2018 11:15:41 PM
 #include "Rendering/RenderEngine.hpp"
 #include "Physics/PhysicsEngine.hpp"
 #include "Levels/Example1Level.hpp"
+#include "Levels/StressTestLevel.hpp"
 #include "Input/InputEngine.hpp"
 #include "Core/EditorApplication.hpp"
 
@@ -46,8 +47,17 @@ class SandboxApplication : public LinaEngine::Application
 
 		m_editor.Setup();
 		
-		InstallLevel(m_startupLevel);
-		InitializeLevel(m_startupLevel);
+		// --stress replaces the startup level with the procedural stress test, see StressTestLevel::ParseSettings.
+		LinaEngine::World::Level* startupLevel = &m_startupLevel;
+		StressTestSettings stressSettings;
+		if (StressTestLevel::ParseSettings(stressSettings))
+		{
+			m_stressTestLevel.SetSettings(stressSettings);
+			startupLevel = &m_stressTestLevel;
+		}
+
+		InstallLevel(*startupLevel);
+		InitializeLevel(*startupLevel);
 
 		// Refresh after level init.
 		m_editor.Refresh();
@@ -69,6 +79,7 @@ class SandboxApplication : public LinaEngine::Application
 		
 		LinaEditor::EditorApplication m_editor;
 		Example1Level m_startupLevel;
+		StressTestLevel m_stressTestLevel;
 
 	};
 
@@ -0,0 +1,421 @@
+
+/*
+Author: Inan Evin
+www.inanevin.com
+
+Copyright 2018 Inan Evin
+
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions
+and limitations under the License.
+
+Class: StressTestLevel
+Timestamp: 11/5/2020 9:14:03 AM
+
+*/
+
+#include "Levels/StressTestLevel.hpp"
+#include "Rendering/RenderConstants.hpp"
+#include "Rendering/RenderEngine.hpp"
+#include "Rendering/Material.hpp"
+#include "ECS/Components/TransformComponent.hpp"
+#include "ECS/Components/CameraComponent.hpp"
+#include "ECS/Components/FreeLookComponent.hpp"
+#include "ECS/Components/MeshRendererComponent.hpp"
+#include "ECS/Components/SpriteRendererComponent.hpp"
+#include "ECS/Components/LightComponent.hpp"
+#include "ECS/Components/RigidbodyComponent.hpp"
+#include "Core/Application.hpp"
+#include "Utility/Math/Math.hpp"
+#include <cstdlib>
+#include <cerrno>
+
+using namespace LinaEngine;
+using namespace LinaEngine::Graphics;
+using namespace LinaEngine::ECS;
+
+#define STRESS_ENTITY_SPACING 3.0f
+#define STRESS_PHYSICS_EXTENT 40.0f
+#define STRESS_STACK_HEIGHT 10
+#define STRESS_PILE_COUNT 4
+#define STRESS_CAMERA_PATH_POINTS 8
+
+namespace
+{
+	float RandomRange(std::mt19937& rng, float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(rng);
+	}
+
+	uint32 RandomIndex(std::mt19937& rng, size_t count)
+	{
+		return std::uniform_int_distribution<uint32>(0, (uint32)count - 1)(rng);
+	}
+
+	void ReadCount(const std::string& flag, uint32& count)
+	{
+		const std::string value = Application::GetCommandLineValue(flag);
+		if (value.empty())
+			return;
+
+		// Malformed counts keep the default instead of throwing out of the startup.
+		char* end = nullptr;
+		errno = 0;
+		const unsigned long parsed = std::strtoul(value.c_str(), &end, 10);
+		if (value[0] == '-' || errno != 0 || *end != '\0' || parsed > UINT32_MAX)
+		{
+			LINA_CLIENT_WARN("Invalid value {0} for {1}, keeping {2}.", value, flag, count);
+			return;
+		}
+
+		count = (uint32)parsed;
+	}
+}
+
+bool StressTestLevel::ParseSettings(StressTestSettings& settings)
+{
+	// --stress [entities] [--stress-seed <n>] [--stress-materials <n>] [--stress-point-lights <n>] [--stress-spot-lights <n>]
+	// [--stress-rigidbodies <n>] [--stress-sprites <n>] [--stress-transparent <n>] [--stress-movers <n>]
+	if (!Application::HasCommandLineFlag("--stress"))
+		return false;
+
+	ReadCount("--stress", settings.m_entityCount);
+
+	// Feature counts follow the entity count unless given explicitly, so --stress 100000 is enough for a scale run.
+	settings.m_pointLightCount = Math::Max(settings.m_entityCount / 64, 4u);
+	settings.m_spotLightCount = Math::Max(settings.m_entityCount / 128, 2u);
+	settings.m_rigidbodyCount = settings.m_entityCount / 5;
+	settings.m_spriteCount = settings.m_entityCount / 5;
+	settings.m_transparentCount = settings.m_entityCount / 10;
+	settings.m_moverCount = settings.m_entityCount / 10;
+
+	ReadCount("--stress-seed", settings.m_seed);
+	ReadCount("--stress-materials", settings.m_materialCount);
+	ReadCount("--stress-point-lights", settings.m_pointLightCount);
+	ReadCount("--stress-spot-lights", settings.m_spotLightCount);
+	ReadCount("--stress-rigidbodies", settings.m_rigidbodyCount);
+	ReadCount("--stress-sprites", settings.m_spriteCount);
+	ReadCount("--stress-transparent", settings.m_transparentCount);
+	ReadCount("--stress-movers", settings.m_moverCount);
+
+	if (settings.m_materialCount == 0)
+		settings.m_materialCount = 1;
+
+	return true;
+}
+
+bool StressTestLevel::Install(bool loadFromFile, const std::string& path, const std::string& levelName)
+{
+	LINA_CLIENT_WARN("Stress test level install, {0} entities, seed {1}.", m_settings.m_entityCount, m_settings.m_seed);
+	return true;
+}
+
+void StressTestLevel::Initialize()
+{
+	ECSRegistry& ecs = Application::GetECSRegistry();
+	ecs.clear();
+	m_movers.clear();
+	m_moverOrigins.clear();
+	m_time = 0.0f;
+
+	// Entities are laid out on a square that grows with the count, keeping the density the same at every scale.
+	m_areaExtent = Math::Sqrt((float)m_settings.m_entityCount) * STRESS_ENTITY_SPACING * 0.5f;
+
+	// Each feature draws from its own generator, changing one count doesn't move everything else.
+	std::mt19937 materialRng(m_settings.m_seed);
+	std::mt19937 meshRng(m_settings.m_seed + 1);
+	std::mt19937 lightRng(m_settings.m_seed + 2);
+	std::mt19937 bodyRng(m_settings.m_seed + 3);
+	std::mt19937 spriteRng(m_settings.m_seed + 4);
+	std::mt19937 transparentRng(m_settings.m_seed + 5);
+
+	CreateMaterials(materialRng);
+	SpawnCamera();
+	SpawnMeshes(meshRng);
+	SpawnLights(lightRng);
+	SpawnRigidbodies(bodyRng);
+	SpawnSprites(spriteRng);
+	SpawnTransparentObjects(transparentRng);
+
+	LINA_CLIENT_WARN("Stress test level initialized with {0} entities.", ecs.alive());
+}
+
+void StressTestLevel::Tick(float delta)
+{
+	m_time += delta;
+
+	ECSRegistry& ecs = Application::GetECSRegistry();
+	for (size_t i = 0; i < m_movers.size(); i++)
+	{
+		TransformComponent& transform = ecs.get<TransformComponent>(m_movers[i]);
+		const float phase = m_time + (float)i * 0.37f;
+		transform.transform.m_location = m_moverOrigins[i] + Vector3(Math::Sin(phase) * 2.0f, Math::Cos(phase * 1.3f), Math::Cos(phase) * 2.0f);
+	}
+}
+
+void StressTestLevel::CreateMaterials(std::mt19937& rng)
+{
+	RenderEngine& renderEngine = Application::GetRenderEngine();
+	m_opaqueMaterials.clear();
+	m_transparentMaterials.clear();
+
+	Material& skybox = renderEngine.CreateMaterial(Shaders::Skybox_Gradient);
+	skybox.SetColor(MAT_STARTCOLOR, Color(0.2f, 0.2f, 0.25f));
+	skybox.SetColor(MAT_ENDCOLOR, Color(0.6f, 0.7f, 0.8f));
+	renderEngine.SetSkyboxMaterial(skybox);
+
+	// Lit & unlit materials are mixed so batches switch shaders as well as uniforms.
+	for (uint32 i = 0; i < m_settings.m_materialCount; i++)
+	{
+		const Color color(RandomRange(rng, 0.1f, 1.0f), RandomRange(rng, 0.1f, 1.0f), RandomRange(rng, 0.1f, 1.0f));
+
+		if (i % 4 == 3)
+		{
+			Material& unlit = renderEngine.CreateMaterial(Shaders::Standard_Unlit);
+			unlit.SetColor(MAT_OBJECTCOLORPROPERTY, color);
+			m_opaqueMaterials.push_back(unlit.GetID());
+		}
+		else
+		{
+			Material& lit = renderEngine.CreateMaterial(Shaders::PBR_Lit);
+			lit.SetColor(MAT_OBJECTCOLORPROPERTY, color);
+			lit.SetFloat(MAT_METALLICMULTIPLIER, RandomRange(rng, 0.0f, 1.0f));
+			lit.SetFloat(MAT_ROUGHNESSMULTIPLIER, RandomRange(rng, 0.1f, 1.0f));
+			m_opaqueMaterials.push_back(lit.GetID());
+		}
+
+		Material& transparent = renderEngine.CreateMaterial(Shaders::Standard_Unlit);
+		transparent.SetColor(MAT_OBJECTCOLORPROPERTY, Color(color.r, color.g, color.b, RandomRange(rng, 0.2f, 0.7f)));
+		transparent.SetInt(MAT_SURFACETYPE, MaterialSurfaceType::Transparent);
+		m_transparentMaterials.push_back(transparent.GetID());
+	}
+
+	Material& sprite = renderEngine.CreateMaterial(Shaders::Standard_Sprite);
+	m_spriteMaterial = sprite.GetID();
+}
+
+void StressTestLevel::SpawnCamera()
+{
+	ECSRegistry& ecs = Application::GetECSRegistry();
+	const float height = Math::Max(m_areaExtent * 0.25f, 10.0f);
+
+	ECSEntity camera = ecs.CreateEntity("Stress Camera");
+	TransformComponent cameraTransform;
+	cameraTransform.transform.m_location = Vector3(0.0f, height, -m_areaExtent);
+	cameraTransform.transform.m_rotation = Quaternion::LookAt(cameraTransform.transform.m_location, Vector3::Zero, Vector3::Up);
+	ecs.emplace<TransformComponent>(camera, cameraTransform);
+
+	CameraComponent cameraComponent;
+	cameraComponent.m_zFar = Math::Max(m_areaExtent * 4.0f, 1000.0f);
+	ecs.emplace<CameraComponent>(camera, cameraComponent);
+	ecs.emplace<FreeLookComponent>(camera, FreeLookComponent());
+
+	// Benchmark runs without a recorded path orbit the level, so every run sees the same frames.
+	FrameBenchmarkSettings& benchmarkSettings = Application::GetApp().GetBenchmarkSettings();
+	if (!benchmarkSettings.m_enabled || !benchmarkSettings.m_cameraPath.empty())
+		return;
+
+	const double duration = (double)benchmarkSettings.m_frameCount * benchmarkSettings.m_fixedDelta;
+	for (uint32 i = 0; i <= STRESS_CAMERA_PATH_POINTS; i++)
+	{
+		const float angle = Math::ToRadians(360.0f * (float)i / (float)STRESS_CAMERA_PATH_POINTS);
+		CameraPathPoint point;
+		point.m_time = duration * (double)i / (double)STRESS_CAMERA_PATH_POINTS;
+		point.m_transform.m_location = Vector3(Math::Sin(angle) * m_areaExtent, height, -Math::Cos(angle) * m_areaExtent);
+		point.m_transform.m_rotation = Quaternion::LookAt(point.m_transform.m_location, Vector3::Zero, Vector3::Up);
+		benchmarkSettings.m_cameraPath.push_back(point);
+	}
+}
+
+void StressTestLevel::SpawnMeshes(std::mt19937& rng)
+{
+	RenderEngine& renderEngine = Application::GetRenderEngine();
+	ECSRegistry& ecs = Application::GetECSRegistry();
+	const Primitives meshes[] = { Primitives::Cube, Primitives::Sphere, Primitives::Icosphere, Primitives::Cone, Primitives::Cylinder };
+
+	for (uint32 i = 0; i < m_settings.m_entityCount; i++)
+	{
+		const Primitives primitive = meshes[RandomIndex(rng, sizeof(meshes) / sizeof(meshes[0]))];
+		Material& material = renderEngine.GetMaterial(m_opaqueMaterials[RandomIndex(rng, m_opaqueMaterials.size())]);
+
+		ECSEntity entity = ecs.CreateEntity("Stress Mesh");
+		TransformComponent transform;
+		transform.transform.m_location = RandomLocation(rng, 0.5f, 10.0f);
+		transform.transform.m_rotation = Quaternion::Euler(RandomRange(rng, 0.0f, 360.0f), RandomRange(rng, 0.0f, 360.0f), 0.0f);
+		transform.transform.m_scale = Vector3::One * RandomRange(rng, 0.25f, 1.0f);
+		ecs.emplace<TransformComponent>(entity, transform);
+
+		MeshRendererComponent renderer;
+		renderer.m_meshID = primitive;
+		renderer.m_meshPath = renderEngine.GetPrimitive(primitive).GetPath();
+		renderer.m_materialID = material.GetID();
+		renderer.m_materialPath = material.GetPath();
+		ecs.emplace<MeshRendererComponent>(entity, renderer);
+
+		if (i < m_settings.m_moverCount)
+		{
+			m_movers.push_back(entity);
+			m_moverOrigins.push_back(transform.transform.m_location);
+		}
+	}
+}
+
+void StressTestLevel::SpawnLights(std::mt19937& rng)
+{
+	ECSRegistry& ecs = Application::GetECSRegistry();
+
+	ECSEntity sun = ecs.CreateEntity("Stress Sun");
+	TransformComponent sunTransform;
+	sunTransform.transform.m_location = Vector3(0.0f, 20.0f, 0.0f);
+	sunTransform.transform.m_rotation = Quaternion::Euler(60.0f, 30.0f, 0.0f);
+	ecs.emplace<TransformComponent>(sun, sunTransform);
+	ecs.emplace<DirectionalLightComponent>(sun, DirectionalLightComponent());
+
+	for (uint32 i = 0; i < m_settings.m_pointLightCount; i++)
+	{
+		ECSEntity entity = ecs.CreateEntity("Stress Point Light");
+		TransformComponent transform;
+		transform.transform.m_location = RandomLocation(rng, 1.0f, 6.0f);
+		ecs.emplace<TransformComponent>(entity, transform);
+
+		PointLightComponent light;
+		light.m_color = Color(RandomRange(rng, 0.2f, 1.0f), RandomRange(rng, 0.2f, 1.0f), RandomRange(rng, 0.2f, 1.0f));
+		light.m_distance = RandomRange(rng, 5.0f, 20.0f);
+		ecs.emplace<PointLightComponent>(entity, light);
+	}
+
+	for (uint32 i = 0; i < m_settings.m_spotLightCount; i++)
+	{
+		ECSEntity entity = ecs.CreateEntity("Stress Spot Light");
+		TransformComponent transform;
+		transform.transform.m_location = RandomLocation(rng, 6.0f, 12.0f);
+		transform.transform.m_rotation = Quaternion::Euler(RandomRange(rng, 60.0f, 120.0f), RandomRange(rng, 0.0f, 360.0f), 0.0f);
+		ecs.emplace<TransformComponent>(entity, transform);
+
+		SpotLightComponent light;
+		light.m_color = Color(RandomRange(rng, 0.2f, 1.0f), RandomRange(rng, 0.2f, 1.0f), RandomRange(rng, 0.2f, 1.0f));
+		light.m_distance = RandomRange(rng, 10.0f, 30.0f);
+		ecs.emplace<SpotLightComponent>(entity, light);
+	}
+}
+
+void StressTestLevel::SpawnRigidbodies(std::mt19937& rng)
+{
+	if (m_settings.m_rigidbodyCount == 0)
+		return;
+
+	RenderEngine& renderEngine = Application::GetRenderEngine();
+	ECSRegistry& ecs = Application::GetECSRegistry();
+	const float extent = Math::Min(m_areaExtent, STRESS_PHYSICS_EXTENT);
+
+	// Rigidbodies are created when both the transform & the rigidbody exist, transforms have to be emplaced first.
+	auto spawnBody = [&](const std::string& name, Primitives primitive, const Vector3& location, const Vector3& scale, const RigidbodyComponent& body)
+	{
+		Material& material = renderEngine.GetMaterial(m_opaqueMaterials[RandomIndex(rng, m_opaqueMaterials.size())]);
+		ECSEntity entity = ecs.CreateEntity(name);
+		TransformComponent transform;
+		transform.transform.m_location = location;
+		transform.transform.m_scale = scale;
+		ecs.emplace<TransformComponent>(entity, transform);
+
+		MeshRendererComponent renderer;
+		renderer.m_meshID = primitive;
+		renderer.m_meshPath = renderEngine.GetPrimitive(primitive).GetPath();
+		renderer.m_materialID = material.GetID();
+		renderer.m_materialPath = material.GetPath();
+		ecs.emplace<MeshRendererComponent>(entity, renderer);
+		ecs.emplace<RigidbodyComponent>(entity, body);
+	};
+
+	RigidbodyComponent ground;
+	ground.m_collisionShape = CollisionShape::BOX;
+	ground.m_halfExtents = Vector3(extent, 0.5f, extent);
+	spawnBody("Stress Ground", Primitives::Cube, Vector3(0.0f, -0.5f, 0.0f), ground.m_halfExtents, ground);
+
+	// Half of the bodies are boxes stacked into towers, the rest are spheres dropped onto a few piles.
+	RigidbodyComponent box;
+	box.m_collisionShape = CollisionShape::BOX;
+	box.m_halfExtents = Vector3(0.5f, 0.5f, 0.5f);
+	box.m_mass = 1.0f;
+
+	const uint32 boxCount = m_settings.m_rigidbodyCount / 2;
+	Vector3 stackBase;
+	for (uint32 i = 0; i < boxCount; i++)
+	{
+		const uint32 level = i % STRESS_STACK_HEIGHT;
+		if (level == 0)
+			stackBase = Vector3(RandomRange(rng, -extent, extent) * 0.9f, 0.5f, RandomRange(rng, -extent, extent) * 0.9f);
+
+		spawnBody("Stress Box", Primitives::Cube, stackBase + Vector3(0.0f, (float)level * 1.01f, 0.0f), box.m_halfExtents, box);
+	}
+
+	RigidbodyComponent sphere;
+	sphere.m_collisionShape = CollisionShape::Sphere;
+	sphere.m_radius = 0.5f;
+	sphere.m_mass = 1.0f;
+
+	Vector3 piles[STRESS_PILE_COUNT];
+	for (uint32 i = 0; i < STRESS_PILE_COUNT; i++)
+		piles[i] = Vector3(RandomRange(rng, -extent, extent) * 0.5f, 0.0f, RandomRange(rng, -extent, extent) * 0.5f);
+
+	const uint32 sphereCount = m_settings.m_rigidbodyCount - boxCount;
+	for (uint32 i = 0; i < sphereCount; i++)
+	{
+		const Vector3 offset(RandomRange(rng, -2.0f, 2.0f), 2.0f + (float)(i / STRESS_PILE_COUNT) * 1.1f, RandomRange(rng, -2.0f, 2.0f));
+		spawnBody("Stress Sphere", Primitives::Sphere, piles[i % STRESS_PILE_COUNT] + offset, Vector3::One * sphere.m_radius, sphere);
+	}
+}
+
+void StressTestLevel::SpawnSprites(std::mt19937& rng)
+{
+	ECSRegistry& ecs = Application::GetECSRegistry();
+	Material& material = Application::GetRenderEngine().GetMaterial(m_spriteMaterial);
+
+	SpriteRendererComponent sprite;
+	sprite.m_materialID = material.GetID();
+	sprite.m_materialPath = material.GetPath();
+
+	for (uint32 i = 0; i < m_settings.m_spriteCount; i++)
+	{
+		ECSEntity entity = ecs.CreateEntity("Stress Sprite");
+		TransformComponent transform;
+		transform.transform.m_location = RandomLocation(rng, 0.5f, 3.0f);
+		transform.transform.m_scale = Vector3::One * RandomRange(rng, 0.5f, 1.5f);
+		ecs.emplace<TransformComponent>(entity, transform);
+		ecs.emplace<SpriteRendererComponent>(entity, sprite);
+	}
+}
+
+void StressTestLevel::SpawnTransparentObjects(std::mt19937& rng)
+{
+	RenderEngine& renderEngine = Application::GetRenderEngine();
+	ECSRegistry& ecs = Application::GetECSRegistry();
+
+	for (uint32 i = 0; i < m_settings.m_transparentCount; i++)
+	{
+		const Primitives primitive = i % 2 == 0 ? Primitives::Cube : Primitives::Sphere;
+		Material& material = renderEngine.GetMaterial(m_transparentMaterials[RandomIndex(rng, m_transparentMaterials.size())]);
+
+		ECSEntity entity = ecs.CreateEntity("Stress Transparent");
+		TransformComponent transform;
+		transform.transform.m_location = RandomLocation(rng, 1.0f, 8.0f);
+		transform.transform.m_scale = Vector3::One * RandomRange(rng, 0.5f, 2.0f);
+		ecs.emplace<TransformComponent>(entity, transform);
+
+		MeshRendererComponent renderer;
+		renderer.m_meshID = primitive;
+		renderer.m_meshPath = renderEngine.GetPrimitive(primitive).GetPath();
+		renderer.m_materialID = material.GetID();
+		renderer.m_materialPath = material.GetPath();
+		ecs.emplace<MeshRendererComponent>(entity, renderer);
+	}
+}
+
+Vector3 StressTestLevel::RandomLocation(std::mt19937& rng, float minHeight, float maxHeight)
+{
+	return Vector3(RandomRange(rng, -m_areaExtent, m_areaExtent), RandomRange(rng, minHeight, maxHeight), RandomRange(rng, -m_areaExtent, m_areaExtent));
+}